@@ -0,0 +1,134 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * accum_reg.c
+ *
+ *   Tests the cached accumulators of L_ACCUM, by comparing the
+ *   windowed statistics with those made from scratch:
+ *       accumWindowedMean()         pixWindowedMean()
+ *       accumWindowedMeanSquare()   pixWindowedMeanSquare()
+ *       accumWindowedStats()        pixWindowedStats()
+ *       pixSauvolaBinarizeAccum()   pixSauvolaBinarize()
+ *   One L_ACCUM is used for all window sizes.
+ */
+
+#include "allheaders.h"
+
+static l_float32 FPixMaxDiff(FPIX *fpix1, FPIX *fpix2);
+
+static const l_int32  nsizes = 5;
+static const l_int32  wsize[] = {2, 3, 5, 12, 40};
+static const l_int32  hsize[] = {2, 6, 5, 3, 25};
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, wc, hc;
+FPIX         *fpixv1, *fpixv2, *fpixrv1, *fpixrv2;
+L_ACCUM      *acc;
+PIX          *pixs, *pixm1, *pixm2, *pixms1, *pixms2;
+PIX          *pixth1, *pixth2, *pixd1, *pixd2;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+    pixs = pixRead("test8.jpg");
+    acc = accumCreate(pixs);
+
+    for (i = 0; i < nsizes; i++) {
+        wc = wsize[i];
+        hc = hsize[i];
+
+            /* Mean and mean square, zero border */
+        pixm1 = pixWindowedMean(pixs, wc, hc, 0, 1);
+        pixm2 = accumWindowedMean(acc, wc, hc, 0);
+        regTestComparePix(rp, pixm1, pixm2);  /* 0 + 7 * i */
+        pixDestroy(&pixm1);
+        pixDestroy(&pixm2);
+        pixms1 = pixWindowedMeanSquare(pixs, wc, hc, 0);
+        pixms2 = accumWindowedMeanSquare(acc, wc, hc, 0);
+        regTestComparePix(rp, pixms1, pixms2);  /* 1 + 7 * i */
+        pixDestroy(&pixms1);
+        pixDestroy(&pixms2);
+
+            /* All the stats at once */
+        pixWindowedStats(pixs, wc, hc, 0, &pixm1, &pixms1, &fpixv1, &fpixrv1);
+        accumWindowedStats(acc, wc, hc, 0, &pixm2, &pixms2, &fpixv2, &fpixrv2);
+        regTestComparePix(rp, pixm1, pixm2);  /* 2 + 7 * i */
+        regTestComparePix(rp, pixms1, pixms2);  /* 3 + 7 * i */
+        regTestCompareValues(rp, 0.0, FPixMaxDiff(fpixv1, fpixv2), 0.0);
+                                              /* 4 + 7 * i */
+        regTestCompareValues(rp, 0.0, FPixMaxDiff(fpixrv1, fpixrv2), 0.0);
+                                              /* 5 + 7 * i */
+        pixDestroy(&pixm1);
+        pixDestroy(&pixm2);
+        pixDestroy(&pixms1);
+        pixDestroy(&pixms2);
+        fpixDestroy(&fpixv1);
+        fpixDestroy(&fpixv2);
+        fpixDestroy(&fpixrv1);
+        fpixDestroy(&fpixrv2);
+
+            /* Sauvola binarization, which uses a mirrored border */
+        pixSauvolaBinarize(pixs, wc, 0.35, 1, NULL, NULL, &pixth1, &pixd1);
+        pixSauvolaBinarizeAccum(pixs, acc, wc, 0.35, NULL, NULL,
+                                &pixth2, &pixd2);
+        regTestComparePix(rp, pixd1, pixd2);  /* 6 + 7 * i */
+        pixDestroy(&pixth1);
+        pixDestroy(&pixth2);
+        pixDestroy(&pixd1);
+        pixDestroy(&pixd2);
+    }
+
+    accumDestroy(&acc);
+    pixDestroy(&pixs);
+    return regTestCleanup(rp);
+}
+
+
+static l_float32
+FPixMaxDiff(FPIX  *fpix1,
+            FPIX  *fpix2)
+{
+l_int32     i, w1, h1, w2, h2;
+l_float32   diff, maxdiff;
+l_float32  *data1, *data2;
+
+    fpixGetDimensions(fpix1, &w1, &h1);
+    fpixGetDimensions(fpix2, &w2, &h2);
+    if (w1 != w2 || h1 != h2)
+        return 1.0e10;
+    data1 = fpixGetData(fpix1);
+    data2 = fpixGetData(fpix2);
+    maxdiff = 0.0;
+    for (i = 0; i < w1 * h1; i++) {
+        diff = L_ABS(data1[i] - data2[i]);
+        maxdiff = L_MAX(maxdiff, diff);
+    }
+    return maxdiff;
+}
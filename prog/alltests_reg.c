@@ -45,24 +45,34 @@
 #include "allheaders.h"
 
 static const char *tests[] = {
+                              "accum_reg",
                               "alphaops_reg",
                               "alphaxform_reg",
                               "binarize_reg",
+                              "boxindex_reg",
+                              "bucketq_reg",
+                              "cmapnear_reg",
                               "coloring_reg",
                               "colormask_reg",
                               "colorquant_reg",
                               "compare_reg",
+                              "conncomplabel_reg",
                               "convolve_reg",
+                              "correlscore_reg",
                               "dewarp_reg",
+                              "dheap_reg",
                          /*   "distance_reg", */
                               "dna_reg",
                               "dwamorph1_reg",
                               "enhance_reg",
+                              "eucliddist_reg",
                               "findpattern_reg",
                               "fpix_reg",
+                              "gaussian_reg",
                               "gifio_reg",
                               "graymorph2_reg",
                               "hardlight_reg",
+                              "hashmap_reg",
                               "ioformats_reg",
                               "kernel_reg",
                               "maze_reg",
@@ -77,6 +87,7 @@ static const char *tests[] = {
                               "rankbin_reg",
                               "rankhisto_reg",
                               "rasteropip_reg",
+                              "rle_reg",
                               "rotateorth_reg",
                               "rotate1_reg",
                               "rotate2_reg",
@@ -86,11 +97,13 @@ static const char *tests[] = {
                               "shear_reg",
                               "shear2_reg",
                               "skew_reg",
+                              "skewproj_reg",
                               "splitcomp_reg",
                               "subpixel_reg",
                               "threshnorm_reg",
                               "translate_reg",
                               "warper_reg",
+                              "whiteblocks_reg",
                               "writetext_reg",
                              };
 
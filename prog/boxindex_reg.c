@@ -0,0 +1,215 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * boxindex_reg.c
+ *
+ *   Tests the queries of the L_BoxIndex against the boxa functions
+ *   that scan all the boxes:
+ *       boxindexIntersectsBox()     boxaIntersectsBox()
+ *       boxindexContainedInBox()    boxaContainedInBox()
+ *       boxindexGetNearest()        boxaGetNearestToPt()
+ *   for the default cell size and for small and large cells.
+ */
+
+#include "allheaders.h"
+
+static l_int32 TestRegions(BOXA *boxa, L_BOXINDEX *bi, l_int32 nqueries,
+                           l_int32 contained);
+static l_int32 TestNearest(BOXA *boxa, L_BOXINDEX *bi, l_int32 nqueries,
+                           l_int32 k);
+static l_int32 CompareSelected(BOXA *boxa, NUMA *na, BOXA *boxas);
+
+static const l_int32  ncellsizes = 3;
+static const l_int32  cellsizes[] = {0, 20, 500};
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, x, y, w, h;
+BOX          *box;
+BOXA         *boxa;
+L_BOXINDEX   *bi;
+PIX          *pixs;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+        /* Connected components of a page, with some larger
+         * random boxes on top */
+    pixs = pixRead("rabi.png");
+    boxa = pixConnComp(pixs, NULL, 8);
+    srand(3);
+    for (i = 0; i < 200; i++) {
+        x = rand() % 2400;
+        y = rand() % 3100;
+        w = 1 + rand() % 300;
+        h = 1 + rand() % 300;
+        box = boxCreate(x, y, w, h);
+        boxaAddBox(boxa, box, L_INSERT);
+    }
+    fprintf(stderr, "Number of boxes: %d\n", boxaGetCount(boxa));
+
+    for (i = 0; i < ncellsizes; i++) {
+        bi = boxindexCreate(boxa, cellsizes[i]);
+        regTestCompareValues(rp, boxaGetCount(boxa), boxindexGetCount(bi), 0);
+                                                       /* 0 + 4 * i */
+        regTestCompareValues(rp, 0, TestRegions(boxa, bi, 300, 0), 0);
+                                                       /* 1 + 4 * i */
+        regTestCompareValues(rp, 0, TestRegions(boxa, bi, 300, 1), 0);
+                                                       /* 2 + 4 * i */
+        regTestCompareValues(rp, 0, TestNearest(boxa, bi, 300, 5), 0);
+                                                       /* 3 + 4 * i */
+        boxindexDestroy(&bi);
+    }
+
+    boxaDestroy(&boxa);
+    pixDestroy(&pixs);
+    return regTestCleanup(rp);
+}
+
+
+    /* Returns the number of queries that give different results */
+static l_int32
+TestRegions(BOXA        *boxa,
+            L_BOXINDEX  *bi,
+            l_int32      nqueries,
+            l_int32      contained)
+{
+l_int32  i, nerrors;
+BOX     *box;
+BOXA    *boxas;
+NUMA    *na;
+
+    nerrors = 0;
+    for (i = 0; i < nqueries; i++) {
+        box = boxCreate(rand() % 2700, rand() % 3400,
+                        1 + rand() % 600, 1 + rand() % 600);
+        if (contained) {
+            na = boxindexContainedInBox(bi, box);
+            boxas = boxaContainedInBox(boxa, box);
+        }
+        else {
+            na = boxindexIntersectsBox(bi, box);
+            boxas = boxaIntersectsBox(boxa, box);
+        }
+        if (CompareSelected(boxa, na, boxas))
+            nerrors++;
+        numaDestroy(&na);
+        boxaDestroy(&boxas);
+        boxDestroy(&box);
+    }
+    if (nerrors > 0)
+        fprintf(stderr, "%s: %d errors\n",
+                (contained) ? "Contained" : "Intersects", nerrors);
+    return nerrors;
+}
+
+
+    /* Returns the number of queries that give different results */
+static l_int32
+TestNearest(BOXA        *boxa,
+            L_BOXINDEX  *bi,
+            l_int32      nqueries,
+            l_int32      k)
+{
+l_int32    i, j, n, x, y, index, same, nerrors;
+l_float32  cx, cy, dist, val;
+BOX       *box1, *box2;
+NUMA      *na, *nadist, *naall, *nasort;
+
+    n = boxaGetCount(boxa);
+    nerrors = 0;
+    for (i = 0; i < nqueries; i++) {
+        x = rand() % 2700;
+        y = rand() % 3400;
+        na = boxindexGetNearest(bi, x, y, k, &nadist);
+
+            /* The nearest box */
+        box1 = boxaGetNearestToPt(boxa, x, y);
+        numaGetIValue(na, 0, &index);
+        box2 = boxaGetBox(boxa, index, L_CLONE);
+        boxEqual(box1, box2, &same);
+        boxDestroy(&box1);
+        boxDestroy(&box2);
+
+            /* The distances to the k nearest boxes */
+        naall = numaCreate(n);
+        for (j = 0; j < n; j++) {
+            box1 = boxaGetBox(boxa, j, L_CLONE);
+            boxGetCenter(box1, &cx, &cy);
+            numaAddNumber(naall, (cx - x) * (cx - x) + (cy - y) * (cy - y));
+            boxDestroy(&box1);
+        }
+        nasort = numaSort(NULL, naall, L_SORT_INCREASING);
+        if (numaGetCount(na) != k)
+            same = 0;
+        for (j = 0; j < k && same; j++) {
+            numaGetFValue(nadist, j, &dist);
+            numaGetFValue(nasort, j, &val);
+            if (dist != val)
+                same = 0;
+        }
+        if (!same)
+            nerrors++;
+
+        numaDestroy(&na);
+        numaDestroy(&nadist);
+        numaDestroy(&naall);
+        numaDestroy(&nasort);
+    }
+    if (nerrors > 0)
+        fprintf(stderr, "Nearest: %d errors\n", nerrors);
+    return nerrors;
+}
+
+
+    /* Returns 0 if the boxes in @boxa selected by @na are the
+     * same as those in @boxas, in the same order; 1 otherwise */
+static l_int32
+CompareSelected(BOXA  *boxa,
+                NUMA  *na,
+                BOXA  *boxas)
+{
+l_int32  i, n, index, same;
+BOX     *box1, *box2;
+
+    n = numaGetCount(na);
+    if (n != boxaGetCount(boxas))
+        return 1;
+    for (i = 0; i < n; i++) {
+        numaGetIValue(na, i, &index);
+        box1 = boxaGetBox(boxa, index, L_CLONE);
+        box2 = boxaGetBox(boxas, i, L_CLONE);
+        boxEqual(box1, box2, &same);
+        boxDestroy(&box1);
+        boxDestroy(&box2);
+        if (!same)
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * bucketq_reg.c
+ *
+ *   Tests the bucket priority queue (L_BucketQ):
+ *     (1) Items removed from a full queue come out in the same order
+ *         of priority as given by numaSort(), and in fifo order
+ *         for equal priority.  Enough items are added to extend
+ *         the pool.
+ *     (2) With interleaved adds and removes, the priorities removed
+ *         are the same as those removed from a L_Heap with the same
+ *         keys, and the pool is not made larger than the largest
+ *         number of items that are simultaneously in the queue.
+ */
+
+#include "allheaders.h"
+
+struct TestItem {
+    l_float32  key;    /* first field, as required by the L_Heap */
+    l_int32    data;
+};
+typedef struct TestItem  TESTITEM;
+
+static l_int32 TestFullQueue(l_int32 direction, l_int32 nitems);
+static l_int32 TestInterleaved(l_int32 direction, l_int32 nops);
+
+static const l_int32  NBUCKETS = 256;
+
+
+main(int    argc,
+     char **argv)
+{
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+    srand(13);
+    regTestCompareValues(rp, 0, TestFullQueue(L_SORT_INCREASING, 3000), 0);
+                                                                 /* 0 */
+    regTestCompareValues(rp, 0, TestFullQueue(L_SORT_DECREASING, 3000), 0);
+                                                                 /* 1 */
+    regTestCompareValues(rp, 0, TestInterleaved(L_SORT_INCREASING, 20000),
+                         0);  /* 2 */
+    regTestCompareValues(rp, 0, TestInterleaved(L_SORT_DECREASING, 20000),
+                         0);  /* 3 */
+    return regTestCleanup(rp);
+}
+
+
+    /* Returns the number of errors found */
+static l_int32
+TestFullQueue(l_int32  direction,
+              l_int32  nitems)
+{
+l_int32     i, nerrors, priority, data, lastp, lastdata, val;
+L_BUCKETQ  *bq;
+NUMA       *na, *nasort;
+
+    bq = bqueueCreate(NBUCKETS, direction, 0);
+    na = numaCreate(nitems);
+    for (i = 0; i < nitems; i++) {
+        priority = rand() % NBUCKETS;
+        numaAddNumber(na, priority);
+        bqueueAdd(bq, priority, i, 2 * i, i);
+    }
+    nasort = numaSort(NULL, na, direction);
+
+    nerrors = 0;
+    if (bqueueGetCount(bq) != nitems)
+        nerrors++;
+    lastp = lastdata = -1;
+    for (i = 0; i < nitems; i++) {
+        if (bqueueRemove(bq, &priority, NULL, NULL, &data)) {
+            nerrors++;
+            break;
+        }
+        numaGetIValue(nasort, i, &val);
+        if (priority != val)
+            nerrors++;
+        if (priority == lastp && data < lastdata)  /* not fifo */
+            nerrors++;
+        lastp = priority;
+        lastdata = data;
+    }
+    if (bqueueGetCount(bq) != 0)
+        nerrors++;
+    if (bqueueRemove(bq, &priority, NULL, NULL, NULL) == 0)  /* empty */
+        nerrors++;
+    if (nerrors > 0)
+        fprintf(stderr, "Full queue: %d errors\n", nerrors);
+
+    bqueueDestroy(&bq);
+    numaDestroy(&na);
+    numaDestroy(&nasort);
+    return nerrors;
+}
+
+
+    /* Returns the number of errors found */
+static l_int32
+TestInterleaved(l_int32  direction,
+                l_int32  nops)
+{
+l_int32     i, nerrors, priority, x, y, data, count, maxcount;
+L_BUCKETQ  *bq;
+L_HEAP     *lh;
+TESTITEM   *item;
+
+    bq = bqueueCreate(NBUCKETS, direction, 0);
+    lh = lheapCreate(0, direction);
+    nerrors = 0;
+    count = maxcount = 0;
+    for (i = 0; i < nops; i++) {
+        if (count == 0 || rand() % 3 != 0) {  /* add */
+            priority = rand() % NBUCKETS;
+            bqueueAdd(bq, priority, i, -i, i);
+            item = (TESTITEM *)CALLOC(1, sizeof(TESTITEM));
+            item->key = (l_float32)priority;
+            item->data = i;
+            lheapAdd(lh, item);
+            count++;
+            maxcount = L_MAX(maxcount, count);
+        }
+        else {  /* remove */
+            bqueueRemove(bq, &priority, &x, &y, &data);
+            item = (TESTITEM *)lheapRemove(lh);
+            if (priority != (l_int32)item->key)
+                nerrors++;
+            if (x != data || y != -data)
+                nerrors++;
+            FREE(item);
+            count--;
+        }
+        if (bqueueGetCount(bq) != count)
+            nerrors++;
+    }
+    if (bq->nused > maxcount)  /* removed items were not reused */
+        nerrors++;
+    if (nerrors > 0)
+        fprintf(stderr, "Interleaved: %d errors\n", nerrors);
+
+    bqueueDestroy(&bq);
+    lheapDestroy(&lh, TRUE);
+    return nerrors;
+}
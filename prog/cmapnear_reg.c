@@ -0,0 +1,263 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * cmapnear_reg.c
+ *
+ *   Tests the accelerated nearest color search of cmapnearCreate()
+ *   and cmapnearGetIndex() against an exhaustive search over the
+ *   colormap, for each octcube level in {1 ... 5} and for both
+ *   distance metrics.
+ *
+ *   The query colors include both sides of every level 5 cell
+ *   boundary, and therefore of the boundaries at all lower levels,
+ *   as well as a set of random colors.  The colormaps include one
+ *   with repeated and equidistant colors, for which the lowest
+ *   index must be returned.
+ */
+
+#include "allheaders.h"
+
+static const l_int32  NRANDOM = 20000;
+
+static PIXCMAP *MakeGridCmap(void);
+static PIXCMAP *MakeRandomCmap(l_int32 ncolors);
+static l_int32 TestCmapNear(PIXCMAP *cmap, l_int32 metric);
+static l_int32 FindNearest(PIXCMAP *cmap, l_int32 metric, l_int32 rval,
+                           l_int32 gval, l_int32 bval);
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, rval, gval, bval, index1, index2;
+L_CMAPNEAR   *cn;
+PIX          *pixs, *pixt;
+PIXCMAP      *cmap;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+    srand(5);
+
+        /* A few colors scattered over the color space */
+    cmap = MakeRandomCmap(7);
+    regTestCompareValues(rp, 0, TestCmapNear(cmap, L_MANHATTAN_DISTANCE),
+                         0.0);  /* 0 */
+    regTestCompareValues(rp, 0, TestCmapNear(cmap, L_EUCLIDEAN_DISTANCE),
+                         0.0);  /* 1 */
+    pixcmapDestroy(&cmap);
+
+        /* A full colormap of random colors */
+    cmap = MakeRandomCmap(256);
+    regTestCompareValues(rp, 0, TestCmapNear(cmap, L_MANHATTAN_DISTANCE),
+                         0.0);  /* 2 */
+    regTestCompareValues(rp, 0, TestCmapNear(cmap, L_EUCLIDEAN_DISTANCE),
+                         0.0);  /* 3 */
+    pixcmapDestroy(&cmap);
+
+        /* A regular grid with repeated colors, which has many ties */
+    cmap = MakeGridCmap();
+    regTestCompareValues(rp, 0, TestCmapNear(cmap, L_MANHATTAN_DISTANCE),
+                         0.0);  /* 4 */
+    regTestCompareValues(rp, 0, TestCmapNear(cmap, L_EUCLIDEAN_DISTANCE),
+                         0.0);  /* 5 */
+    pixcmapDestroy(&cmap);
+
+        /* A colormap made by quantizing a real image */
+    pixs = pixRead("fish24.jpg");
+    pixt = pixOctreeColorQuant(pixs, 200, 0);
+    cmap = pixGetColormap(pixt);
+    regTestCompareValues(rp, 0, TestCmapNear(cmap, L_MANHATTAN_DISTANCE),
+                         0.0);  /* 6 */
+    regTestCompareValues(rp, 0, TestCmapNear(cmap, L_EUCLIDEAN_DISTANCE),
+                         0.0);  /* 7 */
+
+        /* The default level is 4, and the euclidean result is that
+         * of pixcmapGetNearestIndex() */
+    cn = cmapnearCreate(cmap, 0, L_EUCLIDEAN_DISTANCE);
+    regTestCompareValues(rp, 4, cn->level, 0.0);  /* 8 */
+    for (i = 0; i < NRANDOM; i++) {
+        rval = rand() & 0xff;
+        gval = rand() & 0xff;
+        bval = rand() & 0xff;
+        cmapnearGetIndex(cn, rval, gval, bval, &index1);
+        pixcmapGetNearestIndex(cmap, rval, gval, bval, &index2);
+        if (index1 != index2)
+            break;
+    }
+    regTestCompareValues(rp, NRANDOM, i, 0.0);  /* 9 */
+    cmapnearDestroy(&cn);
+
+        /* Invalid input */
+    cn = cmapnearCreate(cmap, 6, L_EUCLIDEAN_DISTANCE);
+    regTestCompareValues(rp, 1, (cn == NULL), 0.0);  /* 10 */
+    cn = cmapnearCreate(cmap, 3, 0);
+    regTestCompareValues(rp, 1, (cn == NULL), 0.0);  /* 11 */
+    pixDestroy(&pixt);
+    pixDestroy(&pixs);
+
+    cmap = pixcmapCreate(8);
+    cn = cmapnearCreate(cmap, 3, L_EUCLIDEAN_DISTANCE);
+    regTestCompareValues(rp, 1, (cn == NULL), 0.0);  /* 12 */
+    pixcmapDestroy(&cmap);
+
+    return regTestCleanup(rp);
+}
+
+
+    /* 64 grid colors at 4 levels per component, followed by a
+     * repeat of the first 32 and then colors halfway between
+     * some pairs of grid colors */
+static PIXCMAP *
+MakeGridCmap(void)
+{
+l_int32   i, rval, gval, bval;
+PIXCMAP  *cmap;
+
+    cmap = pixcmapCreate(8);
+    for (i = 0; i < 64; i++)
+        pixcmapAddColor(cmap, 85 * (i >> 4), 85 * ((i >> 2) & 3),
+                        85 * (i & 3));
+    for (i = 0; i < 32; i++) {
+        pixcmapGetColor(cmap, i, &rval, &gval, &bval);
+        pixcmapAddColor(cmap, rval, gval, bval);
+    }
+    for (i = 0; i < 48; i++)
+        pixcmapAddColor(cmap, 85 * (i >> 4) + 42, 85 * ((i >> 2) & 3),
+                        85 * (i & 3) + 43);
+    return cmap;
+}
+
+
+static PIXCMAP *
+MakeRandomCmap(l_int32  ncolors)
+{
+l_int32   i;
+PIXCMAP  *cmap;
+
+    cmap = pixcmapCreate(8);
+    for (i = 0; i < ncolors; i++)
+        pixcmapAddColor(cmap, rand() & 0xff, rand() & 0xff, rand() & 0xff);
+    return cmap;
+}
+
+
+    /* Returns the number of queries, over all levels, for which the
+     * accelerated search differs from the exhaustive one */
+static l_int32
+TestCmapNear(PIXCMAP  *cmap,
+             l_int32   metric)
+{
+l_int32      i, j, k, n, level, nerrors, index;
+l_int32      rval, gval, bval, nvals;
+l_int32      vals[64];
+l_int32     *expected, *rvals, *gvals, *bvals;
+L_CMAPNEAR  *cn;
+
+        /* Both sides of each level 5 cell boundary */
+    for (i = 0, nvals = 0; i < 32; i++) {
+        vals[nvals++] = 8 * i;
+        vals[nvals++] = 8 * i + 7;
+    }
+
+    n = nvals * nvals * nvals + NRANDOM;
+    expected = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    rvals = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    gvals = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    bvals = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    for (i = 0, n = 0; i < nvals; i++) {
+        for (j = 0; j < nvals; j++) {
+            for (k = 0; k < nvals; k++) {
+                rvals[n] = vals[i];
+                gvals[n] = vals[j];
+                bvals[n++] = vals[k];
+            }
+        }
+    }
+    for (i = 0; i < NRANDOM; i++) {
+        rvals[n] = rand() & 0xff;
+        gvals[n] = rand() & 0xff;
+        bvals[n++] = rand() & 0xff;
+    }
+    for (i = 0; i < n; i++)
+        expected[i] = FindNearest(cmap, metric, rvals[i], gvals[i], bvals[i]);
+
+    nerrors = 0;
+    for (level = 1; level <= 5; level++) {
+        if ((cn = cmapnearCreate(cmap, level, metric)) == NULL) {
+            nerrors++;
+            continue;
+        }
+        for (i = 0; i < n; i++) {
+            cmapnearGetIndex(cn, rvals[i], gvals[i], bvals[i], &index);
+            if (index != expected[i])
+                nerrors++;
+        }
+        cmapnearDestroy(&cn);
+    }
+    if (nerrors)
+        fprintf(stderr, "TestCmapNear (metric %d): %d errors\n",
+                metric, nerrors);
+
+    FREE(expected);
+    FREE(rvals);
+    FREE(gvals);
+    FREE(bvals);
+    return nerrors;
+}
+
+
+    /* Exhaustive search; ties go to the lowest index */
+static l_int32
+FindNearest(PIXCMAP  *cmap,
+            l_int32   metric,
+            l_int32   rval,
+            l_int32   gval,
+            l_int32   bval)
+{
+l_int32  i, n, dr, dg, db, dist, mindist, index;
+l_int32  rc, gc, bc;
+
+    n = pixcmapGetCount(cmap);
+    mindist = 0x7fffffff;
+    index = -1;
+    for (i = 0; i < n; i++) {
+        pixcmapGetColor(cmap, i, &rc, &gc, &bc);
+        dr = rval - rc;
+        dg = gval - gc;
+        db = bval - bc;
+        if (metric == L_MANHATTAN_DISTANCE)
+            dist = L_ABS(dr) + L_ABS(dg) + L_ABS(db);
+        else
+            dist = dr * dr + dg * dg + db * db;
+        if (dist < mindist) {
+            mindist = dist;
+            index = i;
+        }
+    }
+    return index;
+}
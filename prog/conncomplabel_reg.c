@@ -0,0 +1,343 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * conncomplabel_reg.c
+ *
+ *   Tests the labeling of connected components in one raster scan,
+ *   pixConnCompLabel() and pixConnCompSelect(), against pixConnComp(),
+ *   for 4 and 8 connectivity:
+ *     (1) the bounding boxes, areas, centroids and perimeters in
+ *         the L_CCSTATS
+ *     (2) the labels in the label image
+ *     (3) the components kept by a filter, both in the statistics
+ *         and in the mask
+ */
+
+#include "allheaders.h"
+
+static l_int32 TestStats(PIX *pixs, l_int32 connectivity);
+static l_int32 TestSelect(PIX *pixs, l_int32 connectivity,
+                          l_int32 minarea);
+static void FindCentroid(PIX *pix, l_float32 *pcx, l_float32 *pcy);
+static l_int32 CountPerimeter(PIX *pix);
+static l_int32 KeepMedium(L_CCSTATS *stats, l_int32 index, void *data);
+
+static const l_int32  MAX_WIDTH = 60;
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, j, conn;
+BOX          *box;
+PIX          *pixt, *pix1, *pix2;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+        /* Part of a page of text, and random pixels that make
+         * components of complicated shape */
+    pixt = pixRead("rabi.png");
+    box = boxCreate(300, 400, 1000, 800);
+    pix1 = pixClipRectangle(pixt, box, NULL);
+    boxDestroy(&box);
+    pixDestroy(&pixt);
+    pix2 = pixCreate(301, 203, 1);
+    srand(7);
+    for (i = 0; i < 203; i++) {
+        for (j = 0; j < 301; j++) {
+            if (rand() % 100 < 45)
+                pixSetPixel(pix2, j, i, 1);
+        }
+    }
+
+    for (i = 0; i < 2; i++) {
+        conn = (i == 0) ? 4 : 8;
+        fprintf(stderr, "Connectivity %d\n", conn);
+        regTestCompareValues(rp, 0, TestStats(pix1, conn), 0);  /* 0, 4 */
+        regTestCompareValues(rp, 0, TestStats(pix2, conn), 0);  /* 1, 5 */
+        regTestCompareValues(rp, 0, TestSelect(pix1, conn, 30), 0);
+                                                                /* 2, 6 */
+        regTestCompareValues(rp, 0, TestSelect(pix2, conn, 5), 0);
+                                                                /* 3, 7 */
+    }
+
+    pixDestroy(&pix1);
+    pixDestroy(&pix2);
+    return regTestCleanup(rp);
+}
+
+
+    /* Returns the number of components with a different box, area,
+     * centroid, perimeter or labels, plus 1 if the number of
+     * components or of labeled pixels is different */
+static l_int32
+TestStats(PIX     *pixs,
+          l_int32  connectivity)
+{
+l_int32     i, n, x, y, w, h, bx, by, bw, bh, area, count, nerrors;
+l_uint32    label, val;
+l_float32   cx, cy;
+BOXA       *boxa;
+L_CCSTATS  *stats;
+PIX        *pix, *pixd;
+PIXA       *pixa;
+
+    boxa = pixConnComp(pixs, &pixa, connectivity);
+    pixd = pixConnCompLabel(pixs, connectivity, NULL, NULL, &stats);
+    n = boxaGetCount(boxa);
+    nerrors = 0;
+    if (ccstatsGetCount(stats) != n) {
+        nerrors++;
+        n = L_MIN(n, ccstatsGetCount(stats));
+    }
+    for (i = 0; i < n; i++) {
+        boxaGetBoxGeometry(boxa, i, &bx, &by, &bw, &bh);
+        if (stats->x[i] != bx || stats->y[i] != by ||
+            stats->w[i] != bw || stats->h[i] != bh) {
+            nerrors++;
+            continue;
+        }
+        pix = pixaGetPix(pixa, i, L_CLONE);
+        pixCountPixels(pix, &area, NULL);
+        FindCentroid(pix, &cx, &cy);
+        if (stats->area[i] != area ||
+            L_ABS(stats->cx[i] - (bx + cx)) > 0.01 ||
+            L_ABS(stats->cy[i] - (by + cy)) > 0.01 ||
+            stats->perim[i] != CountPerimeter(pix)) {
+            nerrors++;
+            pixDestroy(&pix);
+            continue;
+        }
+
+            /* In the box, the label is i + 1 exactly on the component */
+        for (y = 0; y < bh; y++) {
+            for (x = 0; x < bw; x++) {
+                pixGetPixel(pix, x, y, &val);
+                pixGetPixel(pixd, bx + x, by + y, &label);
+                if ((label == i + 1) != (val == 1))
+                    break;
+            }
+            if (x < bw) break;
+        }
+        if (y < bh)
+            nerrors++;
+        pixDestroy(&pix);
+    }
+
+        /* Only the fg pixels are labeled */
+    pixGetDimensions(pixs, &w, &h, NULL);
+    count = 0;
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+            pixGetPixel(pixs, x, y, &val);
+            pixGetPixel(pixd, x, y, &label);
+            if ((label != 0) != (val == 1))
+                count++;
+        }
+    }
+    if (count > 0)
+        nerrors++;
+
+    if (nerrors > 0)
+        fprintf(stderr, "Stats: %d errors\n", nerrors);
+    ccstatsDestroy(&stats);
+    boxaDestroy(&boxa);
+    pixaDestroy(&pixa);
+    pixDestroy(&pixd);
+    return nerrors;
+}
+
+
+    /* Returns the number of errors in the components kept by
+     * KeepMedium(), comparing with a selection from pixConnComp() */
+static l_int32
+TestSelect(PIX     *pixs,
+           l_int32  connectivity,
+           l_int32  minarea)
+{
+l_int32     i, k, n, x, y, w, h, bx, by, bw, bh, area, same, nerrors;
+l_uint32    label, val;
+BOXA       *boxa;
+L_CCSTATS  *stats1, *stats2, *stats;
+NUMA       *na;
+PIX        *pix, *pixd1, *pixd2, *pixd3, *pixm;
+PIXA       *pixa, *pixas;
+
+        /* Expected components */
+    boxa = pixConnComp(pixs, &pixa, connectivity);
+    n = boxaGetCount(boxa);
+    na = numaCreate(n);
+    for (i = 0; i < n; i++) {
+        boxaGetBoxGeometry(boxa, i, NULL, NULL, &bw, NULL);
+        pix = pixaGetPix(pixa, i, L_CLONE);
+        pixCountPixels(pix, &area, NULL);
+        numaAddNumber(na, (area >= minarea && bw <= MAX_WIDTH) ? 1 : 0);
+        pixDestroy(&pix);
+    }
+    pixas = pixaSelectWithIndicator(pixa, na, NULL);
+    n = pixaGetCount(pixas);
+    pixGetDimensions(pixs, &w, &h, NULL);
+    pixd1 = pixaDisplay(pixas, w, h);
+
+        /* The mask, and the mask of the labeled pixels */
+    nerrors = 0;
+    pixd2 = pixConnCompSelect(pixs, connectivity, KeepMedium, &minarea,
+                              &stats1);
+    pixd3 = pixConnCompLabel(pixs, connectivity, KeepMedium, &minarea,
+                             &stats2);
+    pixEqual(pixd1, pixd2, &same);
+    if (!same)
+        nerrors++;
+    pixm = pixCreate(w, h, 1);
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+            pixGetPixel(pixd3, x, y, &label);
+            if (label > 0)
+                pixSetPixel(pixm, x, y, 1);
+        }
+    }
+    pixEqual(pixd1, pixm, &same);
+    if (!same)
+        nerrors++;
+
+        /* The kept components are renumbered in order */
+    if (ccstatsGetCount(stats1) != n || ccstatsGetCount(stats2) != n) {
+        nerrors++;
+        n = 0;
+    }
+    for (i = 0; i < n; i++) {
+        pixaGetBoxGeometry(pixas, i, &bx, &by, &bw, &bh);
+        for (k = 0; k < 2; k++) {
+            stats = (k == 0) ? stats1 : stats2;
+            if (stats->x[i] != bx || stats->y[i] != by ||
+                stats->w[i] != bw || stats->h[i] != bh)
+                nerrors++;
+        }
+        pix = pixaGetPix(pixas, i, L_CLONE);
+        for (y = 0; y < bh; y++) {
+            for (x = 0; x < bw; x++) {
+                pixGetPixel(pix, x, y, &val);
+                pixGetPixel(pixd3, bx + x, by + y, &label);
+                if (val == 1 && label != i + 1)
+                    break;
+            }
+            if (x < bw) break;
+        }
+        if (y < bh)
+            nerrors++;
+        pixDestroy(&pix);
+    }
+
+    if (nerrors > 0)
+        fprintf(stderr, "Select: %d errors\n", nerrors);
+    ccstatsDestroy(&stats1);
+    ccstatsDestroy(&stats2);
+    numaDestroy(&na);
+    boxaDestroy(&boxa);
+    pixaDestroy(&pixa);
+    pixaDestroy(&pixas);
+    pixDestroy(&pixd1);
+    pixDestroy(&pixd2);
+    pixDestroy(&pixd3);
+    pixDestroy(&pixm);
+    return nerrors;
+}
+
+
+    /* Centroid of the fg pixels, summed in double precision; as
+     * pixCentroid() sums in single precision, it is not accurate
+     * enough for very large components */
+static void
+FindCentroid(PIX        *pix,
+             l_float32  *pcx,
+             l_float32  *pcy)
+{
+l_int32    x, y, w, h, count;
+l_uint32   val;
+l_float64  xsum, ysum;
+
+    pixGetDimensions(pix, &w, &h, NULL);
+    count = 0;
+    xsum = ysum = 0.0;
+    for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+            pixGetPixel(pix, x, y, &val);
+            if (val == 0) continue;
+            count++;
+            xsum += x;
+            ysum += y;
+        }
+    }
+    *pcx = (count > 0) ? xsum / count : 0.0;
+    *pcy = (count > 0) ? ysum / count : 0.0;
+    return;
+}
+
+
+    /* Number of sides between a fg pixel and a bg pixel, including
+     * sides on the boundary of the pix */
+static l_int32
+CountPerimeter(PIX  *pix)
+{
+l_int32  i, count, sum;
+PIX     *pixb, *pixt;
+
+    pixb = pixAddBorder(pix, 1, 0);
+    sum = 0;
+    for (i = 0; i < 4; i++) {
+        pixt = pixCopy(NULL, pixb);
+        if (i == 0)
+            pixRasterop(pixt, 0, 0, pixGetWidth(pixb), pixGetHeight(pixb),
+                        PIX_DST & PIX_NOT(PIX_SRC), pixb, 1, 0);
+        else if (i == 1)
+            pixRasterop(pixt, 0, 0, pixGetWidth(pixb), pixGetHeight(pixb),
+                        PIX_DST & PIX_NOT(PIX_SRC), pixb, -1, 0);
+        else if (i == 2)
+            pixRasterop(pixt, 0, 0, pixGetWidth(pixb), pixGetHeight(pixb),
+                        PIX_DST & PIX_NOT(PIX_SRC), pixb, 0, 1);
+        else
+            pixRasterop(pixt, 0, 0, pixGetWidth(pixb), pixGetHeight(pixb),
+                        PIX_DST & PIX_NOT(PIX_SRC), pixb, 0, -1);
+        pixCountPixels(pixt, &count, NULL);
+        sum += count;
+        pixDestroy(&pixt);
+    }
+    pixDestroy(&pixb);
+    return sum;
+}
+
+
+    /* Keeps components with at least *data pixels that are not wide */
+static l_int32
+KeepMedium(L_CCSTATS  *stats,
+           l_int32     index,
+           void       *data)
+{
+    return (stats->area[index] >= *(l_int32 *)data &&
+            stats->w[index] <= MAX_WIDTH) ? 1 : 0;
+}
@@ -0,0 +1,376 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * correlscore_reg.c
+ *
+ *   Tests the fast correlation scores against scores found with
+ *   rasterop:
+ *       pixCorrelationScore()             pixCorrelationScoreSimple()
+ *       pixCorrelationScoreShifted()      AND with rasterop and count
+ *       pixCorrelationScoreThresholded()  AND with rasterop and count
+ *       pixCorrelationScoreMulti()        pixCorrelationScore()
+ *   using the generic implementation and the best one for the cpu.
+ */
+
+#include <math.h>
+#include "allheaders.h"
+
+static l_int32 TestScore(PIXA *pixa, NUMA *naarea, PTA *pta, l_int32 *tab,
+                         l_int32 ntests);
+static l_int32 TestShifted(PIXA *pixa, NUMA *naarea, PTA *pta, l_int32 *tab,
+                           l_int32 ntests);
+static l_int32 TestThresholded(PIXA *pixa, NUMA *naarea, PTA *pta,
+                               l_int32 *tab, l_int32 ntests);
+static l_int32 TestMulti(PIXA *pixa, NUMA *naarea, PTA *pta, l_int32 *tab,
+                         l_int32 ntests);
+static l_int32 CountAnd(PIX *pix1, PIX *pix2, l_int32 delx, l_int32 dely,
+                        l_int32 *tab);
+static l_int32 RoundShift(l_float32 del);
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, n, area, besttier, tier;
+l_int32      *centtab, *sumtab;
+l_float32     x, y;
+BOX          *box;
+BOXA         *boxa;
+NUMA         *naarea;
+PIX          *pixs, *pixc, *pix;
+PIXA         *pixa;
+PTA          *pta;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+        /* Connected components of part of a page, with their
+         * areas and centroids */
+    pixs = pixRead("rabi.png");
+    box = boxCreate(200, 300, 1500, 1500);
+    pixc = pixClipRectangle(pixs, box, NULL);
+    boxa = pixConnComp(pixc, &pixa, 8);
+    boxaDestroy(&boxa);
+    n = pixaGetCount(pixa);
+    fprintf(stderr, "Number of components: %d\n", n);
+    centtab = makePixelCentroidTab8();
+    sumtab = makePixelSumTab8();
+    naarea = numaCreate(n);
+    pta = ptaCreate(n);
+    for (i = 0; i < n; i++) {
+        pix = pixaGetPix(pixa, i, L_CLONE);
+        pixCountPixels(pix, &area, sumtab);
+        pixCentroid(pix, centtab, sumtab, &x, &y);
+        numaAddNumber(naarea, area);
+        ptaAddPt(pta, x, y);
+        pixDestroy(&pix);
+    }
+
+    srand(5);
+    besttier = l_cpuGetBestTier();
+    for (i = 0; i < 2; i++) {
+        tier = (i == 0) ? L_CPU_TIER_GENERIC : besttier;
+        l_cpuSetTier(tier);
+        fprintf(stderr, "Tier: %s\n", l_cpuGetTierName(tier));
+        regTestCompareValues(rp, 0, TestScore(pixa, naarea, pta, sumtab,
+                                              5000), 0);  /* 0 + 4 * i */
+        regTestCompareValues(rp, 0, TestShifted(pixa, naarea, pta, sumtab,
+                                                5000), 0);  /* 1 + 4 * i */
+        regTestCompareValues(rp, 0, TestThresholded(pixa, naarea, pta, sumtab,
+                                                    5000), 0);  /* 2 + 4 * i */
+        regTestCompareValues(rp, 0, TestMulti(pixa, naarea, pta, sumtab,
+                                              50), 0);  /* 3 + 4 * i */
+    }
+
+    FREE(centtab);
+    FREE(sumtab);
+    numaDestroy(&naarea);
+    ptaDestroy(&pta);
+    pixaDestroy(&pixa);
+    boxDestroy(&box);
+    pixDestroy(&pixc);
+    pixDestroy(&pixs);
+    return regTestCleanup(rp);
+}
+
+
+    /* Returns the number of pairs that give different scores */
+static l_int32
+TestScore(PIXA     *pixa,
+          NUMA     *naarea,
+          PTA      *pta,
+          l_int32  *tab,
+          l_int32   ntests)
+{
+l_int32    i, n, i1, i2, area1, area2, maxdiff, nerrors;
+l_float32  x1, y1, x2, y2, delx, dely, score1, score2;
+PIX       *pix1, *pix2;
+
+    n = pixaGetCount(pixa);
+    nerrors = 0;
+    for (i = 0; i < ntests; i++) {
+        i1 = rand() % n;
+        i2 = rand() % n;
+        pix1 = pixaGetPix(pixa, i1, L_CLONE);
+        pix2 = pixaGetPix(pixa, i2, L_CLONE);
+        numaGetIValue(naarea, i1, &area1);
+        numaGetIValue(naarea, i2, &area2);
+        ptaGetPt(pta, i1, &x1, &y1);
+        ptaGetPt(pta, i2, &x2, &y2);
+        delx = x1 - x2 + 0.25 * (rand() % 41 - 20);
+        dely = y1 - y2 + 0.25 * (rand() % 41 - 20);
+        maxdiff = (i % 2) ? 2 : 10000;
+        score1 = pixCorrelationScore(pix1, pix2, area1, area2, delx, dely,
+                                     maxdiff, maxdiff, tab);
+        score2 = pixCorrelationScoreSimple(pix1, pix2, area1, area2,
+                                           delx, dely, maxdiff, maxdiff, tab);
+        if (score1 != score2)
+            nerrors++;
+        pixDestroy(&pix1);
+        pixDestroy(&pix2);
+    }
+    if (nerrors > 0)
+        fprintf(stderr, "Score: %d errors\n", nerrors);
+    return nerrors;
+}
+
+
+    /* Returns the number of shifts that give a different score */
+static l_int32
+TestShifted(PIXA     *pixa,
+            NUMA     *naarea,
+            PTA      *pta,
+            l_int32  *tab,
+            l_int32   ntests)
+{
+l_int32    i, n, i1, i2, area1, area2, delx, dely, count, nerrors;
+l_float32  x1, y1, x2, y2, score1, score2;
+PIX       *pix1, *pix2;
+
+    n = pixaGetCount(pixa);
+    nerrors = 0;
+    for (i = 0; i < ntests; i++) {
+        i1 = rand() % n;
+        i2 = rand() % n;
+        pix1 = pixaGetPix(pixa, i1, L_CLONE);
+        pix2 = pixaGetPix(pixa, i2, L_CLONE);
+        numaGetIValue(naarea, i1, &area1);
+        numaGetIValue(naarea, i2, &area2);
+        ptaGetPt(pta, i1, &x1, &y1);
+        ptaGetPt(pta, i2, &x2, &y2);
+
+            /* Mostly near the centroid alignment; some with
+             * little or no overlap */
+        if (i % 5 == 0) {
+            delx = rand() % 161 - 80;
+            dely = rand() % 161 - 80;
+        } else {
+            delx = RoundShift(x1 - x2) + rand() % 7 - 3;
+            dely = RoundShift(y1 - y2) + rand() % 7 - 3;
+        }
+        score1 = pixCorrelationScoreShifted(pix1, pix2, area1, area2,
+                                            delx, dely, tab);
+        count = CountAnd(pix1, pix2, delx, dely, tab);
+        score2 = (l_float32)count * (l_float32)count /
+                 ((l_float32)area1 * (l_float32)area2);
+        if (score1 != score2)
+            nerrors++;
+        pixDestroy(&pix1);
+        pixDestroy(&pix2);
+    }
+    if (nerrors > 0)
+        fprintf(stderr, "Shifted: %d errors\n", nerrors);
+    return nerrors;
+}
+
+
+    /* Returns the number of pairs where the decision is different */
+static l_int32
+TestThresholded(PIXA     *pixa,
+                NUMA     *naarea,
+                PTA      *pta,
+                l_int32  *tab,
+                l_int32   ntests)
+{
+l_int32    i, j, n, i1, i2, w1, h1, w2, h2, area1, area2, idelx, idely;
+l_int32    count, thresh, same, match1, match2, nerrors;
+l_int32   *downcount;
+l_float32  x1, y1, x2, y2, delx, dely, score_threshold, val;
+NUMA      *narow;
+PIX       *pix1, *pix2;
+
+    n = pixaGetCount(pixa);
+    nerrors = 0;
+    for (i = 0; i < ntests; i++) {
+        i1 = rand() % n;
+        i2 = (i % 2) ? i1 : rand() % n;
+        pix1 = pixaGetPix(pixa, i1, L_CLONE);
+        pix2 = pixaGetPix(pixa, i2, L_CLONE);
+        pixGetDimensions(pix1, &w1, &h1, NULL);
+        pixGetDimensions(pix2, &w2, &h2, NULL);
+        numaGetIValue(naarea, i1, &area1);
+        numaGetIValue(naarea, i2, &area2);
+        ptaGetPt(pta, i1, &x1, &y1);
+        ptaGetPt(pta, i2, &x2, &y2);
+        delx = x1 - x2 + rand() % 5 - 2;
+        dely = y1 - y2 + rand() % 5 - 2;
+        score_threshold = 0.05 * (rand() % 20 + 1);
+
+            /* Number of ON pixels below each row of pix1 */
+        narow = pixCountPixelsByRow(pix1, tab);
+        downcount = (l_int32 *)CALLOC(h1, sizeof(l_int32));
+        for (j = h1 - 2; j >= 0; j--) {
+            numaGetFValue(narow, j + 1, &val);
+            downcount[j] = downcount[j + 1] + (l_int32)val;
+        }
+
+        match1 = pixCorrelationScoreThresholded(pix1, pix2, area1, area2,
+                                                delx, dely, 5, 5, tab,
+                                                downcount, score_threshold);
+        same = (L_ABS(w1 - w2) <= 5 && L_ABS(h1 - h2) <= 5);
+        idelx = RoundShift(delx);
+        idely = RoundShift(dely);
+        count = CountAnd(pix1, pix2, idelx, idely, tab);
+        thresh = (l_int32)ceil(sqrt(score_threshold * area1 * area2));
+        match2 = (same && count >= thresh) ? TRUE : FALSE;
+        if (match1 != match2)
+            nerrors++;
+        FREE(downcount);
+        numaDestroy(&narow);
+        pixDestroy(&pix1);
+        pixDestroy(&pix2);
+    }
+    if (nerrors > 0)
+        fprintf(stderr, "Thresholded: %d errors\n", nerrors);
+    return nerrors;
+}
+
+
+    /* Returns the number of scores that differ from the single
+     * pair scores, with and without an index array */
+static l_int32
+TestMulti(PIXA     *pixa,
+          NUMA     *naarea,
+          PTA      *pta,
+          l_int32  *tab,
+          l_int32   ntests)
+{
+l_int32    i, j, n, i1, i2, area1, area2, nerrors;
+l_float32  x1, y1, x2, y2, score1, score2;
+NUMA      *nascore, *naindex;
+PIX       *pix1, *pix2;
+
+    n = pixaGetCount(pixa);
+    nerrors = 0;
+    for (i = 0; i < ntests; i++) {
+        i1 = rand() % n;
+        pix1 = pixaGetPix(pixa, i1, L_CLONE);
+        numaGetIValue(naarea, i1, &area1);
+        ptaGetPt(pta, i1, &x1, &y1);
+
+            /* All exemplars */
+        nascore = pixCorrelationScoreMulti(pix1, area1, x1, y1, pixa,
+                                           naarea, pta, NULL, 3, 3, tab);
+        if (numaGetCount(nascore) != n)
+            nerrors++;
+        for (j = 0; j < n && j < numaGetCount(nascore); j++) {
+            pix2 = pixaGetPix(pixa, j, L_CLONE);
+            numaGetIValue(naarea, j, &area2);
+            ptaGetPt(pta, j, &x2, &y2);
+            score1 = pixCorrelationScore(pix1, pix2, area1, area2,
+                                         x1 - x2, y1 - y2, 3, 3, tab);
+            numaGetFValue(nascore, j, &score2);
+            if (score1 != score2)
+                nerrors++;
+            pixDestroy(&pix2);
+        }
+        numaDestroy(&nascore);
+
+            /* Selected exemplars, in random order and with repeats */
+        naindex = numaCreate(0);
+        for (j = 0; j < 100; j++)
+            numaAddNumber(naindex, rand() % n);
+        nascore = pixCorrelationScoreMulti(pix1, area1, x1, y1, pixa,
+                                           naarea, pta, naindex, 30, 30,
+                                           NULL);
+        if (numaGetCount(nascore) != 100)
+            nerrors++;
+        for (j = 0; j < 100 && j < numaGetCount(nascore); j++) {
+            numaGetIValue(naindex, j, &i2);
+            pix2 = pixaGetPix(pixa, i2, L_CLONE);
+            numaGetIValue(naarea, i2, &area2);
+            ptaGetPt(pta, i2, &x2, &y2);
+            score1 = pixCorrelationScore(pix1, pix2, area1, area2,
+                                         x1 - x2, y1 - y2, 30, 30, tab);
+            numaGetFValue(nascore, j, &score2);
+            if (score1 != score2)
+                nerrors++;
+            pixDestroy(&pix2);
+        }
+        numaDestroy(&nascore);
+        numaDestroy(&naindex);
+        pixDestroy(&pix1);
+    }
+    if (nerrors > 0)
+        fprintf(stderr, "Multi: %d errors\n", nerrors);
+    return nerrors;
+}
+
+
+    /* Number of ON pixels in the AND of pix1 and pix2, with pix2
+     * translated by (delx, dely); as in pixCorrelationScoreSimple() */
+static l_int32
+CountAnd(PIX      *pix1,
+         PIX      *pix2,
+         l_int32   delx,
+         l_int32   dely,
+         l_int32  *tab)
+{
+l_int32  w1, h1, w2, h2, count;
+PIX     *pixt;
+
+    pixGetDimensions(pix1, &w1, &h1, NULL);
+    pixGetDimensions(pix2, &w2, &h2, NULL);
+    pixt = pixCreateTemplate(pix1);
+    pixRasterop(pixt, delx, dely, w2, h2, PIX_SRC, pix2, 0, 0);
+    pixRasterop(pixt, 0, 0, w1, h1, PIX_SRC & PIX_DST, pix1, 0, 0);
+    pixCountPixels(pixt, &count, tab);
+    pixDestroy(&pixt);
+    return count;
+}
+
+
+    /* Rounds a centroid difference to the nearest integer, as in
+     * pixCorrelationScore() */
+static l_int32
+RoundShift(l_float32  del)
+{
+    if (del >= 0)
+        return (l_int32)(del + 0.5);
+    else
+        return (l_int32)(del - 0.5);
+}
@@ -0,0 +1,252 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * dheap_reg.c
+ *
+ *   Tests the heaps that hold items by value:
+ *     (1) The keys removed from a L_DHeap, for arity 4 and 2, are in
+ *         the order given by numaSort(), and each item is removed once.
+ *     (2) dheapSortStrictOrder() orders the array as numaSort() does,
+ *         and dheapSort() restores the heap order after the direction
+ *         is switched.
+ *     (3) With interleaved adds and removes of monotone integer keys,
+ *         the keys removed from a L_RHeap are the same as those
+ *         removed from a L_DHeap, and an item with a key less than
+ *         the last one removed is rejected.
+ */
+
+#include "allheaders.h"
+
+struct DItem {
+    l_float32  key;    /* first field, as required by the L_DHeap */
+    l_int32    index;
+};
+typedef struct DItem  DITEM;
+
+struct RItem {
+    l_uint32   key;    /* first field, as required by the L_RHeap */
+    l_int32    index;
+};
+typedef struct RItem  RITEM;
+
+static l_int32 TestRemoval(l_int32 direction, l_int32 arity, l_int32 n);
+static l_int32 TestSort(l_int32 direction, l_int32 n);
+static l_int32 TestRadix(l_int32 nops);
+
+
+main(int    argc,
+     char **argv)
+{
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+    srand(7);
+    regTestCompareValues(rp, 0, TestRemoval(L_SORT_INCREASING, 4, 2000), 0);
+                                                                   /* 0 */
+    regTestCompareValues(rp, 0, TestRemoval(L_SORT_DECREASING, 4, 2000), 0);
+                                                                   /* 1 */
+    regTestCompareValues(rp, 0, TestRemoval(L_SORT_INCREASING, 2, 2000), 0);
+                                                                   /* 2 */
+    regTestCompareValues(rp, 0, TestRemoval(L_SORT_DECREASING, 2, 2000), 0);
+                                                                   /* 3 */
+    regTestCompareValues(rp, 0, TestSort(L_SORT_INCREASING, 1000), 0);
+                                                                   /* 4 */
+    regTestCompareValues(rp, 0, TestSort(L_SORT_DECREASING, 1000), 0);
+                                                                   /* 5 */
+    regTestCompareValues(rp, 0, TestRadix(50000), 0);  /* 6 */
+    return regTestCleanup(rp);
+}
+
+
+    /* Returns the number of errors found */
+static l_int32
+TestRemoval(l_int32  direction,
+            l_int32  arity,
+            l_int32  n)
+{
+l_int32     i, nerrors;
+l_int32    *found;
+l_float32   val;
+DITEM       item;
+L_DHEAP    *dh;
+NUMA       *na, *nasort;
+
+    dh = dheapCreate(sizeof(DITEM), 0, direction);
+    dh->arity = arity;
+    na = numaCreate(n);
+    for (i = 0; i < n; i++) {
+        item.key = (l_float32)(rand() % 500) / 7.0;  /* has repeats */
+        item.index = i;
+        numaAddNumber(na, item.key);
+        dheapAdd(dh, &item);
+    }
+    nasort = numaSort(NULL, na, direction);
+
+    nerrors = 0;
+    found = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    for (i = 0; i < n; i++) {
+        if (dheapRemove(dh, &item)) {
+            nerrors++;
+            break;
+        }
+        numaGetFValue(nasort, i, &val);
+        if (item.key != val)
+            nerrors++;
+        numaGetFValue(na, item.index, &val);
+        if (item.key != val || found[item.index]++)
+            nerrors++;
+    }
+    if (dheapGetCount(dh) != 0 || dheapRemove(dh, &item) == 0)
+        nerrors++;
+    if (nerrors > 0)
+        fprintf(stderr, "Removal (arity %d): %d errors\n", arity, nerrors);
+
+    FREE(found);
+    dheapDestroy(&dh);
+    numaDestroy(&na);
+    numaDestroy(&nasort);
+    return nerrors;
+}
+
+
+    /* Returns the number of errors found */
+static l_int32
+TestSort(l_int32  direction,
+         l_int32  n)
+{
+l_int32     i, nerrors, other;
+l_float32   val;
+DITEM       item;
+DITEM      *array;
+L_DHEAP    *dh;
+NUMA       *na, *nasort;
+
+    dh = dheapCreate(sizeof(DITEM), 0, direction);
+    na = numaCreate(n);
+    for (i = 0; i < n; i++) {
+        item.key = (l_float32)rand() / (l_float32)RAND_MAX;
+        item.index = i;
+        numaAddNumber(na, item.key);
+        dheapAdd(dh, &item);
+    }
+    nerrors = 0;
+
+        /* Strict order, which is also heap order */
+    dheapSortStrictOrder(dh);
+    nasort = numaSort(NULL, na, direction);
+    array = (DITEM *)dh->array;
+    for (i = 0; i < n; i++) {
+        numaGetFValue(nasort, i, &val);
+        if (array[i].key != val)
+            nerrors++;
+    }
+    numaDestroy(&nasort);
+
+        /* Switch the direction and restore the heap order */
+    other = (direction == L_SORT_INCREASING) ? L_SORT_DECREASING
+                                             : L_SORT_INCREASING;
+    dh->direction = other;
+    dheapSort(dh);
+    nasort = numaSort(NULL, na, other);
+    for (i = 0; i < n; i++) {
+        dheapRemove(dh, &item);
+        numaGetFValue(nasort, i, &val);
+        if (item.key != val)
+            nerrors++;
+    }
+    if (nerrors > 0)
+        fprintf(stderr, "Sort: %d errors\n", nerrors);
+
+    dheapDestroy(&dh);
+    numaDestroy(&na);
+    numaDestroy(&nasort);
+    return nerrors;
+}
+
+
+    /* Returns the number of errors found */
+static l_int32
+TestRadix(l_int32  nops)
+{
+l_int32   i, nerrors, count;
+l_uint32  lastkey;
+DITEM     ditem;
+RITEM     ritem;
+L_DHEAP  *dh;
+L_RHEAP  *rh;
+
+    dh = dheapCreate(sizeof(DITEM), 0, L_SORT_INCREASING);
+    rh = rheapCreate(sizeof(RITEM));
+    nerrors = 0;
+    count = 0;
+    lastkey = 0;
+    for (i = 0; i < nops; i++) {
+        if (count == 0 || rand() % 2 == 0) {  /* add; keys < 2^24 */
+            ritem.key = lastkey + rand() % 100;  /* monotone; has repeats */
+            ritem.index = i;
+            rheapAdd(rh, &ritem);
+            ditem.key = (l_float32)ritem.key;
+            ditem.index = i;
+            dheapAdd(dh, &ditem);
+            count++;
+        }
+        else {  /* remove */
+            rheapRemove(rh, &ritem);
+            dheapRemove(dh, &ditem);
+            if ((l_float32)ritem.key != ditem.key || ritem.key < lastkey)
+                nerrors++;
+            lastkey = ritem.key;
+            count--;
+        }
+        if (rheapGetCount(rh) != count)
+            nerrors++;
+    }
+
+        /* Adding a key below the last key removed is an error */
+    if (lastkey > 0) {
+        fprintf(stderr, "Expect an error here:\n");
+        ritem.key = lastkey - 1;
+        if (rheapAdd(rh, &ritem) == 0)
+            nerrors++;
+    }
+
+        /* Empty both heaps */
+    while (rheapRemove(rh, &ritem) == 0) {
+        dheapRemove(dh, &ditem);
+        if ((l_float32)ritem.key != ditem.key)
+            nerrors++;
+    }
+    if (dheapGetCount(dh) != 0)
+        nerrors++;
+    if (nerrors > 0)
+        fprintf(stderr, "Radix: %d errors\n", nerrors);
+
+    dheapDestroy(&dh);
+    rheapDestroy(&rh);
+    return nerrors;
+}
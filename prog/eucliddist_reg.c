@@ -0,0 +1,141 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * eucliddist_reg.c
+ *
+ *   Tests pixEuclideanDistance() against a brute force search for
+ *   the nearest bg pixel, for both boundary conditions.
+ *
+ *   It also tests an image that is near the size limit with
+ *   L_BOUNDARY_FG, where a column without bg pixels has a large
+ *   distance and the squared distances overflow 32 bits.
+ */
+
+#include "allheaders.h"
+
+static PIX *BruteForceDistance(PIX *pixs, l_int32 boundcond);
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, w, h, same, maxdiff;
+l_uint32      val;
+BOX          *box;
+PIX          *pix1, *pixs, *pixd, *pixt;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+        /* Small images: compare with the brute force result */
+    pix1 = pixRead("rabi.png");
+    for (i = 0; i < 3; i++) {
+        box = boxCreate(400 + 100 * i, 300 + 200 * i, 120, 80);
+        pixs = pixClipRectangle(pix1, box, NULL);
+        pixd = pixEuclideanDistance(pixs, L_BOUNDARY_BG);
+        pixt = BruteForceDistance(pixs, L_BOUNDARY_BG);
+        regTestComparePix(rp, pixd, pixt);  /* 0, 2, 4 */
+        pixDestroy(&pixd);
+        pixDestroy(&pixt);
+        pixd = pixEuclideanDistance(pixs, L_BOUNDARY_FG);
+        pixt = BruteForceDistance(pixs, L_BOUNDARY_FG);
+        regTestComparePix(rp, pixd, pixt);  /* 1, 3, 5 */
+        pixDestroy(&pixd);
+        pixDestroy(&pixt);
+        pixDestroy(&pixs);
+        boxDestroy(&box);
+    }
+    pixDestroy(&pix1);
+
+        /* A wide image with a single bg pixel at the UL corner.
+         * Every other column has no bg pixel, so the distance is
+         * simply x^2 + y^2. */
+    w = 45900;
+    h = 100;
+    pixs = pixCreate(w, h, 1);
+    pixSetAll(pixs);
+    pixSetPixel(pixs, 0, 0, 0);
+    pixd = pixEuclideanDistance(pixs, L_BOUNDARY_FG);
+    maxdiff = 0;
+    for (i = 0; i < w; i += 17) {
+        pixGetPixel(pixd, i, h - 1, &val);
+        maxdiff = L_MAX(maxdiff,
+                        L_ABS((l_int32)val - (i * i + (h - 1) * (h - 1))));
+    }
+    regTestCompareValues(rp, 0, maxdiff, 0);  /* 6 */
+    pixGetPixel(pixd, w - 1, h - 1, &val);
+    regTestCompareValues(rp, (w - 1) * (w - 1) + (h - 1) * (h - 1),
+                         val, 0);  /* 7 */
+    pixDestroy(&pixs);
+    pixDestroy(&pixd);
+
+    return regTestCleanup(rp);
+}
+
+
+    /* For each pixel, finds the squared distance to the nearest
+     * bg pixel by looking at all of them.  With L_BOUNDARY_BG,
+     * the pixels just outside the image are also bg. */
+static PIX *
+BruteForceDistance(PIX     *pixs,
+                   l_int32  boundcond)
+{
+l_int32   i, j, k, w, h, n, x, y, dist, mindist;
+l_uint32  val;
+PIX      *pixd;
+PTA      *pta;
+
+    pixGetDimensions(pixs, &w, &h, NULL);
+    pixd = pixCreate(w, h, 32);
+    pixInvert(pixs, pixs);
+    pta = ptaGetPixelsFromPix(pixs, NULL);
+    pixInvert(pixs, pixs);
+    n = ptaGetCount(pta);
+    for (i = 0; i < h; i++) {
+        for (j = 0; j < w; j++) {
+            pixGetPixel(pixs, j, i, &val);
+            if (val == 0)
+                continue;
+            mindist = 0x7fffffff;
+            if (boundcond == L_BOUNDARY_BG) {
+                mindist = L_MIN(mindist, (j + 1) * (j + 1));
+                mindist = L_MIN(mindist, (w - j) * (w - j));
+                mindist = L_MIN(mindist, (i + 1) * (i + 1));
+                mindist = L_MIN(mindist, (h - i) * (h - i));
+            }
+            for (k = 0; k < n; k++) {
+                ptaGetIPt(pta, k, &x, &y);
+                dist = (x - j) * (x - j) + (y - i) * (y - i);
+                mindist = L_MIN(mindist, dist);
+            }
+            pixSetPixel(pixd, j, i, mindist);
+        }
+    }
+
+    ptaDestroy(&pta);
+    return pixd;
+}
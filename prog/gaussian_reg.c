@@ -0,0 +1,192 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * gaussian_reg.c
+ *
+ *   Tests the recursive gaussian filter, pixConvolveGaussian():
+ *     (1) against convolution with a sampled gaussian kernel, in the
+ *         interior and near each of the four edges
+ *     (2) at the edges, against the same filter on an image with a
+ *         wide replicated border, which it should match closely
+ *     (3) on rgb, against filtering each component separately
+ */
+
+#include "allheaders.h"
+
+static PIX *AddReplicatedBorder(PIX *pixs, l_int32 npix);
+static l_int32 MaxDiffInRegions(PIX *pix1, PIX *pix2, l_int32 size,
+                                l_int32 *pmaxin, l_int32 *pmaxedge);
+
+static const l_int32    nsigmas = 3;
+static const l_float32  sigmas[] = {2.0, 3.0, 8.0};
+static const l_int32    maxdiff[] = {12, 9, 8};
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, j, half, max1, max2, size;
+BOX          *box;
+L_KERNEL     *kelx, *kely;
+PIX          *pixs, *pixt, *pixr, *pixg, *pixb, *pix1, *pix2, *pix3;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+        /* Compare with the kernel convolution.  The kernel is applied
+         * to a copy with a wide replicated border, so that both have
+         * the same boundary condition. */
+    pixs = pixRead("test8.jpg");
+    for (i = 0; i < nsigmas; i++) {
+        half = (l_int32)(4.0 * sigmas[i] + 1.0);
+        makeGaussianKernelSep(half, half, sigmas[i], 1.0, &kelx, &kely);
+        pixt = AddReplicatedBorder(pixs, half);
+        pix1 = pixConvolveSep(pixt, kelx, kely, 8, 1);
+        pix2 = pixRemoveBorder(pix1, half);
+        pix3 = pixConvolveGaussian(pixs, sigmas[i]);
+        size = (l_int32)(2.0 * sigmas[i] + 0.5);
+        MaxDiffInRegions(pix2, pix3, size, &max1, &max2);
+        fprintf(stderr, "sigma = %4.1f: max diff interior = %d, edge = %d\n",
+                sigmas[i], max1, max2);
+        regTestCompareValues(rp, 0, max1, maxdiff[i]);  /* 0 + 2 * i */
+        regTestCompareValues(rp, 0, max2, maxdiff[i]);  /* 1 + 2 * i */
+        kernelDestroy(&kelx);
+        kernelDestroy(&kely);
+        pixDestroy(&pixt);
+        pixDestroy(&pix1);
+        pixDestroy(&pix2);
+        pixDestroy(&pix3);
+    }
+    pixDestroy(&pixs);
+
+        /* Bright bands along each edge, and a few points.  With exact
+         * boundary conditions, filtering with a border that is wide
+         * enough for the filter to decay gives the same result. */
+    pixs = pixCreate(100, 80, 8);
+    pixSetAll(pixs);
+    box = boxCreate(5, 5, 90, 70);
+    pixClearInRect(pixs, box);
+    boxDestroy(&box);
+    for (i = 0; i < 10; i++)
+        pixSetPixel(pixs, 10 + 8 * i, 7 + 6 * i, 255);
+    for (i = 0; i < 2; i++) {
+        pixt = AddReplicatedBorder(pixs, 400);
+        pix1 = pixConvolveGaussian(pixt, 5.0 * (i + 1));
+        pix2 = pixRemoveBorder(pix1, 400);
+        pix3 = pixConvolveGaussian(pixs, 5.0 * (i + 1));
+        MaxDiffInRegions(pix2, pix3, 10, &max1, &max2);
+        fprintf(stderr, "sigma = %4.1f: max diff from padded = %d, %d\n",
+                5.0 * (i + 1), max1, max2);
+        regTestCompareValues(rp, 0, L_MAX(max1, max2), 1);  /* 6, 7 */
+        pixDestroy(&pixt);
+        pixDestroy(&pix1);
+        pixDestroy(&pix2);
+        pixDestroy(&pix3);
+    }
+    pixDestroy(&pixs);
+
+        /* Each component of rgb is filtered independently */
+    pixs = pixRead("test24.jpg");
+    pix1 = pixConvolveGaussian(pixs, 4.0);
+    for (i = 0; i < 3; i++) {
+        j = (i == 0) ? COLOR_RED : ((i == 1) ? COLOR_GREEN : COLOR_BLUE);
+        pixt = pixGetRGBComponent(pixs, j);
+        pix2 = pixConvolveGaussian(pixt, 4.0);
+        pix3 = pixGetRGBComponent(pix1, j);
+        regTestComparePix(rp, pix2, pix3);  /* 8, 9, 10 */
+        pixDestroy(&pixt);
+        pixDestroy(&pix2);
+        pixDestroy(&pix3);
+    }
+    pixDestroy(&pix1);
+    pixDestroy(&pixs);
+
+    return regTestCleanup(rp);
+}
+
+
+    /* Adds a border that replicates the boundary pixels */
+static PIX *
+AddReplicatedBorder(PIX     *pixs,
+                    l_int32  npix)
+{
+l_int32  i, w, h;
+PIX     *pixd;
+
+    pixGetDimensions(pixs, &w, &h, NULL);
+    pixd = pixAddBorder(pixs, npix, 0);
+    for (i = 0; i < npix; i++) {
+        pixRasterop(pixd, i, npix, 1, h, PIX_SRC, pixd, npix, npix);
+        pixRasterop(pixd, npix + w + i, npix, 1, h, PIX_SRC,
+                    pixd, npix + w - 1, npix);
+    }
+    for (i = 0; i < npix; i++) {
+        pixRasterop(pixd, 0, i, w + 2 * npix, 1, PIX_SRC, pixd, 0, npix);
+        pixRasterop(pixd, 0, npix + h + i, w + 2 * npix, 1, PIX_SRC,
+                    pixd, 0, npix + h - 1);
+    }
+    return pixd;
+}
+
+
+    /* Finds the max difference in the interior, and in the four
+     * strips of width @size along the edges */
+static l_int32
+MaxDiffInRegions(PIX      *pix1,
+                 PIX      *pix2,
+                 l_int32   size,
+                 l_int32  *pmaxin,
+                 l_int32  *pmaxedge)
+{
+l_int32   i, w, h;
+l_uint32  val;
+BOX      *box;
+PIX      *pixd;
+
+    pixGetDimensions(pix1, &w, &h, NULL);
+    pixd = pixAbsDifference(pix1, pix2);
+    box = boxCreate(size, size, w - 2 * size, h - 2 * size);
+    pixGetMaxValueInRect(pixd, box, &val, NULL, NULL);
+    *pmaxin = val;
+    boxDestroy(&box);
+    *pmaxedge = 0;
+    for (i = 0; i < 4; i++) {
+        if (i == 0)
+            box = boxCreate(0, 0, size, h);
+        else if (i == 1)
+            box = boxCreate(w - size, 0, size, h);
+        else if (i == 2)
+            box = boxCreate(0, 0, w, size);
+        else
+            box = boxCreate(0, h - size, w, size);
+        pixGetMaxValueInRect(pixd, box, &val, NULL, NULL);
+        *pmaxedge = L_MAX(*pmaxedge, val);
+        boxDestroy(&box);
+    }
+    pixDestroy(&pixd);
+    return 0;
+}
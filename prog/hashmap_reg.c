@@ -0,0 +1,235 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * hashmap_reg.c
+ *
+ *   Tests the hash map (L_HashMap) against direct counting:
+ *     (1) Integer keys with structure in the high and low bits: the
+ *         count of each key, the values stored in the items after
+ *         the map has been grown, and the lookup of absent keys.
+ *     (2) String keys: sarrayRemoveDupsByHash() keeps the first
+ *         occurrence of each string, in order.
+ *     (3) pixCountRGBColors() and pixNumColors() on rgb images.
+ */
+
+#include <string.h>
+#include "allheaders.h"
+
+static l_uint64 MakeKey(l_int32 index);
+static l_int32 TestIntKeys(l_int32 nkeys, l_int32 nlookups);
+static l_int32 TestStringKeys(l_int32 nstrings, l_int32 nlookups);
+static l_int32 CountColors(PIX *pixs, l_int32 factor);
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       ncolors1, ncolors2;
+PIX          *pixs, *pixq, *pixt;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+    srand(17);
+    regTestCompareValues(rp, 0, TestIntKeys(5000, 20000), 0);  /* 0 */
+    regTestCompareValues(rp, 0, TestStringKeys(3000, 10000), 0);  /* 1 */
+
+        /* Count rgb colors, with and without subsampling */
+    pixs = pixRead("fish24.jpg");
+    pixCountRGBColors(pixs, 1, &ncolors1);
+    regTestCompareValues(rp, CountColors(pixs, 1), ncolors1, 0);  /* 2 */
+    pixCountRGBColors(pixs, 3, &ncolors1);
+    regTestCompareValues(rp, CountColors(pixs, 3), ncolors1, 0);  /* 3 */
+
+        /* pixNumColors() gives up above 256 colors */
+    pixNumColors(pixs, 1, &ncolors1);
+    regTestCompareValues(rp, 0, ncolors1, 0);  /* 4 */
+    pixq = pixOctreeColorQuant(pixs, 200, 0);
+    pixt = pixConvertTo32(pixq);
+    pixNumColors(pixt, 1, &ncolors1);
+    pixCountRGBColors(pixt, 1, &ncolors2);
+    regTestCompareValues(rp, CountColors(pixt, 1), ncolors1, 0);  /* 5 */
+    regTestCompareValues(rp, ncolors1, ncolors2, 0);  /* 6 */
+    pixDestroy(&pixs);
+    pixDestroy(&pixq);
+    pixDestroy(&pixt);
+
+    return regTestCleanup(rp);
+}
+
+
+    /* Different keys that are equal in the low 32 bits, or that are
+     * multiples of a large power of 2, would all collide without
+     * the mixing of the key bits. */
+static l_uint64
+MakeKey(l_int32  index)
+{
+    if (index % 2 == 0)
+        return (l_uint64)index << 32;
+    else
+        return ((l_uint64)index << 12) | 0xfff;
+}
+
+
+    /* Returns the number of errors found */
+static l_int32
+TestIntKeys(l_int32  nkeys,
+            l_int32  nlookups)
+{
+l_int32      i, index, nerrors, nfound;
+l_int32     *counts;
+L_HASHITEM  *item;
+L_HASHMAP   *hmap;
+
+    hmap = l_hmapCreate(0, L_HMAP_INT_KEY);
+    counts = (l_int32 *)CALLOC(nkeys, sizeof(l_int32));
+    nerrors = 0;
+    for (i = 0; i < nlookups; i++) {
+        index = rand() % nkeys;
+        counts[index]++;
+        item = l_hmapLookup(hmap, MakeKey(index), L_HMAP_CREATE);
+        if (item->count == 1)
+            item->val = index;
+    }
+
+    nfound = 0;
+    for (i = 0; i < nkeys; i++) {
+        item = l_hmapLookup(hmap, MakeKey(i), L_HMAP_CHECK);
+        if (counts[i] == 0) {
+            if (item != NULL)
+                nerrors++;
+            continue;
+        }
+        nfound++;
+        if (!item || item->count != counts[i] || item->val != i ||
+            item->ptr != NULL)
+            nerrors++;
+    }
+    if (l_hmapGetCount(hmap) != nfound)
+        nerrors++;
+    if (nerrors > 0)
+        fprintf(stderr, "Int keys: %d errors\n", nerrors);
+
+    FREE(counts);
+    l_hmapDestroy(&hmap);
+    return nerrors;
+}
+
+
+    /* Returns the number of errors found */
+static l_int32
+TestStringKeys(l_int32  nstrings,
+               l_int32  nlookups)
+{
+char         buf[32];
+char        *str;
+l_int32      i, index, nerrors, n;
+l_int32     *counts;
+L_HASHITEM  *item;
+L_HASHMAP   *hmap;
+SARRAY      *sa, *sa1, *sa2;
+
+        /* Make an sarray with repeated strings, and the unique
+         * strings in order of first occurrence */
+    sa = sarrayCreate(nlookups);
+    sa1 = sarrayCreate(nstrings);
+    counts = (l_int32 *)CALLOC(nstrings, sizeof(l_int32));
+    for (i = 0; i < nlookups; i++) {
+        index = rand() % nstrings;
+        sprintf(buf, "string-%d", index);
+        sarrayAddString(sa, buf, L_COPY);
+        if (counts[index]++ == 0)
+            sarrayAddString(sa1, buf, L_COPY);
+    }
+
+    nerrors = 0;
+    sa2 = sarrayRemoveDupsByHash(sa);
+    n = sarrayGetCount(sa1);
+    if (sarrayGetCount(sa2) != n)
+        nerrors++;
+    for (i = 0; i < n && nerrors == 0; i++) {
+        str = sarrayGetString(sa2, i, L_NOCOPY);
+        if (strcmp(str, sarrayGetString(sa1, i, L_NOCOPY)))
+            nerrors++;
+    }
+
+        /* Check the counts */
+    hmap = l_hmapCreate(0, L_HMAP_STRING_KEY);
+    n = sarrayGetCount(sa);
+    for (i = 0; i < n; i++)
+        l_hmapLookupString(hmap, sarrayGetString(sa, i, L_NOCOPY),
+                           L_HMAP_CREATE);
+    for (i = 0; i < nstrings; i++) {
+        sprintf(buf, "string-%d", i);
+        item = l_hmapLookupString(hmap, buf, L_HMAP_CHECK);
+        if ((counts[i] == 0 && item != NULL) ||
+            (counts[i] > 0 && (!item || item->count != counts[i] ||
+                               strcmp(item->str, buf))))
+            nerrors++;
+    }
+    if (l_hmapGetCount(hmap) != sarrayGetCount(sa1))
+        nerrors++;
+    if (nerrors > 0)
+        fprintf(stderr, "String keys: %d errors\n", nerrors);
+
+    FREE(counts);
+    l_hmapDestroy(&hmap);
+    sarrayDestroy(&sa);
+    sarrayDestroy(&sa1);
+    sarrayDestroy(&sa2);
+    return nerrors;
+}
+
+
+    /* Counts the rgb colors with a flag for each of the 2^24 colors */
+static l_int32
+CountColors(PIX     *pixs,
+            l_int32  factor)
+{
+l_int32    i, j, w, h, wpl, ncolors;
+l_uint8   *flags;
+l_uint32   rgb;
+l_uint32  *data, *line;
+
+    pixGetDimensions(pixs, &w, &h, NULL);
+    data = pixGetData(pixs);
+    wpl = pixGetWpl(pixs);
+    flags = (l_uint8 *)CALLOC(1 << 24, sizeof(l_uint8));
+    ncolors = 0;
+    for (i = 0; i < h; i += factor) {
+        line = data + i * wpl;
+        for (j = 0; j < w; j += factor) {
+            rgb = line[j] >> 8;
+            if (!flags[rgb]) {
+                flags[rgb] = 1;
+                ncolors++;
+            }
+        }
+    }
+    FREE(flags);
+    return ncolors;
+}
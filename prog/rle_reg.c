@@ -0,0 +1,183 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * rle_reg.c
+ *
+ *   Tests the run-length encoded binary image functions in rle.c,
+ *   by comparing each with the pix function that it replaces:
+ *       rleCreateFromPix(), pixCreateFromRle()   (round trip)
+ *       rleCountPixels()                         pixCountPixels()
+ *       rleInvert()                              pixInvert()
+ *       rleLogicalOp()                           pixOr(), pixAnd(),
+ *                                                pixSubtract(), pixXor()
+ *       rleDilateBrick(), etc.                   pixDilateBrick(), etc.
+ *       rleConnComp()                            pixCountConnComp()
+ */
+
+#include "allheaders.h"
+
+static void TestBrick(L_REGPARAMS *rp, PIX *pixs, L_RLE *rles,
+                      l_int32 hsize, l_int32 vsize);
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, count1, count2;
+BOX          *box;
+L_CCSTATS    *stats;
+L_RLE        *rle1, *rle2, *rle3;
+PIX          *pix1, *pix2, *pix3, *pix4, *pixs;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+    pix1 = pixRead("rabi.png");
+    box = boxCreate(200, 300, 1000, 600);
+    pixs = pixClipRectangle(pix1, box, NULL);
+    boxDestroy(&box);
+    pixDestroy(&pix1);
+
+        /* Round trip and pixel count */
+    rle1 = rleCreateFromPix(pixs);
+    pix1 = pixCreateFromRle(rle1);
+    regTestComparePix(rp, pixs, pix1);  /* 0 */
+    pixDestroy(&pix1);
+    pixCountPixels(pixs, &count1, NULL);
+    rleCountPixels(rle1, &count2);
+    regTestCompareValues(rp, count1, count2, 0);  /* 1 */
+
+        /* Invert */
+    rle2 = rleInvert(rle1);
+    pix1 = pixCreateFromRle(rle2);
+    pix2 = pixInvert(NULL, pixs);
+    regTestComparePix(rp, pix1, pix2);  /* 2 */
+    pixDestroy(&pix1);
+    pixDestroy(&pix2);
+    rleDestroy(&rle2);
+
+        /* Logical ops with a translated copy */
+    pix2 = pixTranslate(NULL, pixs, 7, 3, L_BRING_IN_WHITE);
+    rle2 = rleCreateFromPix(pix2);
+    for (i = 0; i < 4; i++) {
+        if (i == 0) {
+            rle3 = rleLogicalOp(rle1, rle2, L_UNION);
+            pix3 = pixOr(NULL, pixs, pix2);
+        }
+        else if (i == 1) {
+            rle3 = rleLogicalOp(rle1, rle2, L_INTERSECTION);
+            pix3 = pixAnd(NULL, pixs, pix2);
+        }
+        else if (i == 2) {
+            rle3 = rleLogicalOp(rle1, rle2, L_SUBTRACTION);
+            pix3 = pixSubtract(NULL, pixs, pix2);
+        }
+        else {
+            rle3 = rleLogicalOp(rle1, rle2, L_EXCLUSIVE_OR);
+            pix3 = pixXor(NULL, pixs, pix2);
+        }
+        pix4 = pixCreateFromRle(rle3);
+        regTestComparePix(rp, pix3, pix4);  /* 3 - 6 */
+        pixDestroy(&pix3);
+        pixDestroy(&pix4);
+        rleDestroy(&rle3);
+    }
+    pixDestroy(&pix2);
+    rleDestroy(&rle2);
+
+        /* Brick morphology, with both boundary conditions */
+    for (i = 0; i < 2; i++) {
+        if (i == 0)
+            resetMorphBoundaryCondition(ASYMMETRIC_MORPH_BC);
+        else
+            resetMorphBoundaryCondition(SYMMETRIC_MORPH_BC);
+        TestBrick(rp, pixs, rle1, 1, 1);  /* 7 - 10, 39 - 42 */
+        TestBrick(rp, pixs, rle1, 5, 1);  /* 11 - 14, 43 - 46 */
+        TestBrick(rp, pixs, rle1, 1, 6);  /* 15 - 18, 47 - 50 */
+        TestBrick(rp, pixs, rle1, 4, 4);  /* 19 - 22, 51 - 54 */
+        TestBrick(rp, pixs, rle1, 9, 2);  /* 23 - 26, 55 - 58 */
+        TestBrick(rp, pixs, rle1, 2, 11);  /* 27 - 30, 59 - 62 */
+        TestBrick(rp, pixs, rle1, 25, 25);  /* 31 - 34, 63 - 66 */
+        TestBrick(rp, pixs, rle1, 40, 3);  /* 35 - 38, 67 - 70 */
+    }
+    resetMorphBoundaryCondition(ASYMMETRIC_MORPH_BC);
+
+        /* Connected components */
+    for (i = 0; i < 2; i++) {
+        pixCountConnComp(pixs, 4 + 4 * i, &count1);
+        stats = rleConnComp(rle1, 4 + 4 * i, NULL, NULL, &rle2);
+        regTestCompareValues(rp, count1, ccstatsGetCount(stats), 0);
+                                                   /* 71, 73 */
+        pix1 = pixCreateFromRle(rle2);
+        regTestComparePix(rp, pixs, pix1);  /* 72, 74 */
+        pixDestroy(&pix1);
+        rleDestroy(&rle2);
+        ccstatsDestroy(&stats);
+    }
+
+    rleDestroy(&rle1);
+    pixDestroy(&pixs);
+    return regTestCleanup(rp);
+}
+
+
+static void
+TestBrick(L_REGPARAMS  *rp,
+          PIX          *pixs,
+          L_RLE        *rles,
+          l_int32       hsize,
+          l_int32       vsize)
+{
+l_int32  i;
+L_RLE   *rled;
+PIX     *pix1, *pix2;
+
+    for (i = 0; i < 4; i++) {
+        if (i == 0) {
+            rled = rleDilateBrick(rles, hsize, vsize);
+            pix1 = pixDilateBrick(NULL, pixs, hsize, vsize);
+        }
+        else if (i == 1) {
+            rled = rleErodeBrick(rles, hsize, vsize);
+            pix1 = pixErodeBrick(NULL, pixs, hsize, vsize);
+        }
+        else if (i == 2) {
+            rled = rleOpenBrick(rles, hsize, vsize);
+            pix1 = pixOpenBrick(NULL, pixs, hsize, vsize);
+        }
+        else {
+            rled = rleCloseBrick(rles, hsize, vsize);
+            pix1 = pixCloseBrick(NULL, pixs, hsize, vsize);
+        }
+        pix2 = pixCreateFromRle(rled);
+        regTestComparePix(rp, pix1, pix2);
+        pixDestroy(&pix1);
+        pixDestroy(&pix2);
+        rleDestroy(&rled);
+    }
+    return;
+}
@@ -0,0 +1,165 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * skewproj_reg.c
+ *
+ *     Tests pixFindSkewProjected() and pixFindSkewProjectedScores()
+ *     against the shear-based pixFindSkewSweepAndSearch() and
+ *     pixFindDifferentialSquareSum().
+ *
+ *     An image with a known set of rotations is deskewed by both
+ *     methods, which must agree with each other and track the
+ *     applied rotation.  The early exit for images with no
+ *     foreground pixels is also checked.
+ */
+
+#include "allheaders.h"
+
+#define   SWEEP_RANGE           5.     /* degrees */
+#define   SWEEP_DELTA           1.     /* degrees */
+#define   SWEEP_REDUCTION       4      /* 1, 2, 4 or 8 */
+#define   SEARCH_REDUCTION      2      /* 1, 2, 4 or 8 */
+#define   SEARCH_MIN_DELTA      0.01   /* degrees */
+
+static const l_int32  NROT = 7;
+static const l_float32  rotations[] = {-3.0, -1.3, -0.4, 0.0, 0.7,
+                                       2.1, 3.6};  /* degrees */
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, w, h, ret1, ret2, n, imax1, imax2;
+l_float32     deg2rad, angle0, angle1, angle2, conf1, conf2;
+l_float32     score, sum, max1, max2;
+NUMA         *naangles, *nascores;
+PIX          *pixs, *pixr, *pixt;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+    deg2rad = 3.1415926535 / 180.;
+    pixs = pixRead("rabi.png");
+    pixGetDimensions(pixs, &w, &h, NULL);
+
+        /* The unrotated image has some skew of its own; the
+         * applied rotations are measured relative to it. */
+    pixFindSkewSweepAndSearch(pixs, &angle0, &conf1, SWEEP_REDUCTION,
+                              SEARCH_REDUCTION, SWEEP_RANGE, SWEEP_DELTA,
+                              SEARCH_MIN_DELTA);
+
+        /* Sweep known rotations; the two methods must agree to
+         * within a few search steps, and both must find the rotation */
+    for (i = 0; i < NROT; i++) {
+        pixr = pixRotate(pixs, deg2rad * rotations[i], L_ROTATE_SAMPLING,
+                         L_BRING_IN_WHITE, w, h);
+        ret1 = pixFindSkewProjected(pixr, &angle1, &conf1, SWEEP_REDUCTION,
+                                    SEARCH_REDUCTION, SWEEP_RANGE,
+                                    SWEEP_DELTA, SEARCH_MIN_DELTA);
+        ret2 = pixFindSkewSweepAndSearch(pixr, &angle2, &conf2,
+                                         SWEEP_REDUCTION, SEARCH_REDUCTION,
+                                         SWEEP_RANGE, SWEEP_DELTA,
+                                         SEARCH_MIN_DELTA);
+        if (rp->display)
+            fprintf(stderr, "rot = %5.2f: projected: angle = %7.3f,"
+                    " conf = %6.2f; sheared: angle = %7.3f, conf = %6.2f\n",
+                    rotations[i], angle1, conf1, angle2, conf2);
+        regTestCompareValues(rp, 0, ret1, 0.0);  /* 0 + 5 * i */
+        regTestCompareValues(rp, 0, ret2, 0.0);  /* 1 + 5 * i */
+        regTestCompareValues(rp, angle2, angle1, 0.05);  /* 2 + 5 * i */
+        regTestCompareValues(rp, angle0 - rotations[i], angle1, 0.15);
+                                                          /* 3 + 5 * i */
+        regTestCompareValues(rp, conf2, conf1, 0.1 * conf2);  /* 4 + 5 * i */
+        pixDestroy(&pixr);
+    }
+
+        /* The projected scores must approximate the differential
+         * square sums of the sheared image, and peak at the same angle */
+    pixt = pixReduceRankBinaryCascade(pixs, 1, 0, 0, 0);
+    naangles = numaMakeSequence(-3.0, 0.3, 21);
+    nascores = pixFindSkewProjectedScores(pixt, naangles);
+    n = numaGetCount(nascores);
+    regTestCompareValues(rp, 21, n, 0.0);  /* 35 */
+    max1 = max2 = 0.0;
+    imax1 = imax2 = 0;
+    for (i = 0; i < n; i++) {
+        pixr = pixVShear(NULL, pixt, 0, deg2rad * (-3.0 + 0.3 * i),
+                         L_BRING_IN_WHITE);
+        pixFindDifferentialSquareSum(pixr, &sum);
+        numaGetFValue(nascores, i, &score);
+        regTestCompareValues(rp, sum, score, 0.15 * sum);  /* 36 - 56 */
+        if (score > max1) {
+            max1 = score;
+            imax1 = i;
+        }
+        if (sum > max2) {
+            max2 = sum;
+            imax2 = i;
+        }
+        pixDestroy(&pixr);
+    }
+    regTestCompareValues(rp, imax2, imax1, 0.0);  /* 57 */
+    regTestCompareValues(rp, max2, max1, 0.01 * max2);  /* 58 */
+    numaDestroy(&nascores);
+    pixDestroy(&pixt);
+    pixDestroy(&pixs);
+
+        /* A blank image takes the early exit; a tiny one that cannot
+         * be reduced is rejected, as it is by the shear method */
+    pixs = pixCreate(300, 200, 1);
+    angle1 = conf1 = 1.0;
+    ret1 = pixFindSkewProjected(pixs, &angle1, &conf1, SWEEP_REDUCTION,
+                                SEARCH_REDUCTION, SWEEP_RANGE, SWEEP_DELTA,
+                                SEARCH_MIN_DELTA);
+    regTestCompareValues(rp, 1, ret1, 0.0);  /* 59 */
+    regTestCompareValues(rp, 0.0, angle1, 0.0);  /* 60 */
+    regTestCompareValues(rp, 0.0, conf1, 0.0);  /* 61 */
+    nascores = pixFindSkewProjectedScores(pixs, naangles);
+    numaGetMax(nascores, &max1, NULL);
+    regTestCompareValues(rp, 0.0, max1, 0.0);  /* 62 */
+    numaDestroy(&nascores);
+    pixDestroy(&pixs);
+
+    pixs = pixCreate(3, 2, 1);
+    pixSetPixel(pixs, 1, 1, 1);
+    angle1 = conf1 = 1.0;
+    ret1 = pixFindSkewProjected(pixs, &angle1, &conf1, SWEEP_REDUCTION,
+                                SEARCH_REDUCTION, SWEEP_RANGE, SWEEP_DELTA,
+                                SEARCH_MIN_DELTA);
+    ret2 = pixFindSkewSweepAndSearch(pixs, &angle2, &conf2,
+                                     SWEEP_REDUCTION, SEARCH_REDUCTION,
+                                     SWEEP_RANGE, SWEEP_DELTA,
+                                     SEARCH_MIN_DELTA);
+    regTestCompareValues(rp, 1, ret1, 0.0);  /* 63 */
+    regTestCompareValues(rp, 0.0, angle1, 0.0);  /* 64 */
+    regTestCompareValues(rp, 0.0, conf1, 0.0);  /* 65 */
+    regTestCompareValues(rp, ret2, ret1, 0.0);  /* 66 */
+    pixDestroy(&pixs);
+
+    numaDestroy(&naangles);
+    return regTestCleanup(rp);
+}
@@ -0,0 +1,209 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * whiteblocks_reg.c
+ *
+ *   Tests boxaGetWhiteblocksGeneral() and boxaGetWhiteblocks():
+ *     (1) A synthetic page with two columns, where the tallest
+ *         whitespace box is the gutter between them.
+ *     (2) For the components of a page image, the whitespace boxes
+ *         are within the region, intersect none of the components,
+ *         are sorted, and overlap the larger ones by no more than
+ *         @maxoverlap.
+ *     (3) The results are the same with and without the use of the
+ *         grid cells of the box index to find the intersecting boxes,
+ *         and with and without a (long) time limit.
+ */
+
+#include "allheaders.h"
+
+static l_int32 CheckWhiteblocks(BOXA *boxas, BOX *box, BOXA *boxaw,
+                                l_int32 sortflag, l_float32 maxoverlap);
+static l_int32 SameBoxa(BOXA *boxa1, BOXA *boxa2);
+static l_int32 GetSortValue(BOX *box, l_int32 sortflag);
+
+    /* On a text page, the whitespace boxes that are largest in
+     * width or area are only found after very many pops */
+static const l_int32  nsorts = 2;
+static const l_int32  sortflags[] = {L_SORT_BY_HEIGHT,
+                                     L_SORT_BY_MAX_DIMENSION};
+
+
+main(int    argc,
+     char **argv)
+{
+l_int32       i, x, y, w, h;
+BOX          *box, *boxr;
+BOXA         *boxa, *boxa1, *boxa2, *boxa3, *boxa4;
+PIX          *pixs, *pixc;
+L_REGPARAMS  *rp;
+
+    if (regTestSetup(argc, argv, &rp))
+        return 1;
+
+        /* Two columns of "text lines" in a 1000 x 1000 region;
+         * the gutter is at x = 400 ... 499 */
+    boxa = boxaCreate(0);
+    for (i = 0; i < 50; i++) {
+        boxaAddBox(boxa, boxCreate(0, 20 * i, 400, 12), L_INSERT);
+        boxaAddBox(boxa, boxCreate(500, 20 * i + 6, 500, 12), L_INSERT);
+    }
+    boxr = boxCreate(0, 0, 1000, 1000);
+    boxa1 = boxaGetWhiteblocksGeneral(boxa, boxr, L_SORT_BY_HEIGHT, 1,
+                                      0.0, 200, 0.0, 0, 0.0);
+    box = boxaGetBox(boxa1, 0, L_CLONE);
+    boxGetGeometry(box, &x, &y, &w, &h);
+    regTestCompareValues(rp, 400, x, 0);  /* 0 */
+    regTestCompareValues(rp, 0, y, 0);  /* 1 */
+    regTestCompareValues(rp, 100, w, 0);  /* 2 */
+    regTestCompareValues(rp, 1000, h, 0);  /* 3 */
+    boxDestroy(&box);
+    boxDestroy(&boxr);
+    boxaDestroy(&boxa);
+    boxaDestroy(&boxa1);
+
+        /* Components of part of a page */
+    pixs = pixRead("rabi.png");
+    box = boxCreate(200, 300, 1500, 1500);
+    pixc = pixClipRectangle(pixs, box, NULL);
+    boxa = pixConnComp(pixc, NULL, 8);
+    boxr = boxCreate(0, 0, 1500, 1500);
+    boxDestroy(&box);
+    fprintf(stderr, "Number of components: %d\n", boxaGetCount(boxa));
+
+        /* With an empty box added, the box index is not used */
+    boxa2 = boxaCopy(boxa, L_COPY);
+    boxaAddBox(boxa2, boxCreate(0, 0, 0, 0), L_INSERT);
+
+    for (i = 0; i < nsorts; i++) {
+        boxa1 = boxaGetWhiteblocksGeneral(boxa, boxr, sortflags[i], 40,
+                                          0.2, 200, 0.2, 5000, 0.0);
+        regTestCompareValues(rp, 0, CheckWhiteblocks(boxa, boxr, boxa1,
+                             sortflags[i], 0.2), 0);  /* 4 + 4 * i */
+        boxa3 = boxaGetWhiteblocksGeneral(boxa2, boxr, sortflags[i], 40,
+                                          0.2, 200, 0.2, 5000, 0.0);
+        regTestCompareValues(rp, 0, SameBoxa(boxa1, boxa3), 0);
+                                                      /* 5 + 4 * i */
+        boxa4 = boxaGetWhiteblocksGeneral(boxa, boxr, sortflags[i], 40,
+                                          0.2, 200, 0.2, 5000, 1000.0);
+        regTestCompareValues(rp, 0, SameBoxa(boxa1, boxa4), 0);
+                                                      /* 6 + 4 * i */
+        boxaDestroy(&boxa4);
+        boxa4 = boxaGetWhiteblocks(boxa, boxr, sortflags[i], 40,
+                                   0.2, 200, 0.2, 5000);
+        regTestCompareValues(rp, 0, SameBoxa(boxa1, boxa4), 0);
+                                                      /* 7 + 4 * i */
+        boxaDestroy(&boxa1);
+        boxaDestroy(&boxa3);
+        boxaDestroy(&boxa4);
+    }
+
+    boxaDestroy(&boxa);
+    boxaDestroy(&boxa2);
+    boxDestroy(&boxr);
+    pixDestroy(&pixs);
+    pixDestroy(&pixc);
+    return regTestCleanup(rp);
+}
+
+
+    /* Returns the number of errors found */
+static l_int32
+CheckWhiteblocks(BOXA      *boxas,
+                 BOX       *box,
+                 BOXA      *boxaw,
+                 l_int32    sortflag,
+                 l_float32  maxoverlap)
+{
+l_int32    i, j, n, contained, nerrors;
+l_float32  fract;
+BOX       *box1, *box2;
+BOXA      *boxat;
+
+    n = boxaGetCount(boxaw);
+    nerrors = (n == 0) ? 1 : 0;
+    for (i = 0; i < n; i++) {
+        box1 = boxaGetBox(boxaw, i, L_CLONE);
+        boxContains(box, box1, &contained);
+        if (!contained)
+            nerrors++;
+        boxat = boxaIntersectsBox(boxas, box1);
+        if (boxaGetCount(boxat) > 0)
+            nerrors++;
+        boxaDestroy(&boxat);
+        for (j = 0; j < i; j++) {
+            box2 = boxaGetBox(boxaw, j, L_CLONE);
+            if (GetSortValue(box2, sortflag) < GetSortValue(box1, sortflag))
+                nerrors++;
+            boxOverlapFraction(box2, box1, &fract);
+            if (fract > maxoverlap)
+                nerrors++;
+            boxDestroy(&box2);
+        }
+        boxDestroy(&box1);
+    }
+    if (nerrors > 0)
+        fprintf(stderr, "Sortflag %d: %d errors\n", sortflag, nerrors);
+    return nerrors;
+}
+
+
+    /* Returns 0 if the boxa are the same, in the same order */
+static l_int32
+SameBoxa(BOXA  *boxa1,
+         BOXA  *boxa2)
+{
+l_int32  i, n, same;
+BOX     *box1, *box2;
+
+    n = boxaGetCount(boxa1);
+    if (n != boxaGetCount(boxa2))
+        return 1;
+    for (i = 0; i < n; i++) {
+        box1 = boxaGetBox(boxa1, i, L_CLONE);
+        box2 = boxaGetBox(boxa2, i, L_CLONE);
+        boxEqual(box1, box2, &same);
+        boxDestroy(&box1);
+        boxDestroy(&box2);
+        if (!same)
+            return 1;
+    }
+    return 0;
+}
+
+
+static l_int32
+GetSortValue(BOX     *box,
+             l_int32  sortflag)
+{
+l_int32  w, h;
+
+    boxGetGeometry(box, NULL, NULL, &w, &h);
+    if (sortflag == L_SORT_BY_HEIGHT)
+        return h;
+    else  /* L_SORT_BY_MAX_DIMENSION */
+        return L_MAX(w, h);
+}
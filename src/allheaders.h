@@ -159,6 +159,7 @@ LEPT_DLL extern PIX * pixOtsuThreshOnBackgroundNorm ( PIX *pixs, PIX *pixim, l_i
 LEPT_DLL extern PIX * pixMaskedThreshOnBackgroundNorm ( PIX *pixs, PIX *pixim, l_int32 sx, l_int32 sy, l_int32 thresh, l_int32 mincount, l_int32 smoothx, l_int32 smoothy, l_float32 scorefract, l_int32 *pthresh );
 LEPT_DLL extern l_int32 pixSauvolaBinarizeTiled ( PIX *pixs, l_int32 whsize, l_float32 factor, l_int32 nx, l_int32 ny, PIX **ppixth, PIX **ppixd );
 LEPT_DLL extern l_int32 pixSauvolaBinarize ( PIX *pixs, l_int32 whsize, l_float32 factor, l_int32 addborder, PIX **ppixm, PIX **ppixsd, PIX **ppixth, PIX **ppixd );
+LEPT_DLL extern l_int32 pixSauvolaBinarizeAccum ( PIX *pixs, L_ACCUM *acc, l_int32 whsize, l_float32 factor, PIX **ppixm, PIX **ppixsd, PIX **ppixth, PIX **ppixd );
 LEPT_DLL extern PIX * pixSauvolaGetThreshold ( PIX *pixm, PIX *pixms, l_float32 factor, PIX **ppixsd );
 LEPT_DLL extern PIX * pixApplyLocalThreshold ( PIX *pixs, PIX *pixth, l_int32 redfactor );
 LEPT_DLL extern PIX * pixExpandBinaryReplicate ( PIX *pixs, l_int32 factor );
@@ -170,8 +171,8 @@ LEPT_DLL extern l_uint32 * makeExpandTab8x ( void );
 LEPT_DLL extern PIX * pixReduceBinary2 ( PIX *pixs, l_uint8 *intab );
 LEPT_DLL extern PIX * pixReduceRankBinaryCascade ( PIX *pixs, l_int32 level1, l_int32 level2, l_int32 level3, l_int32 level4 );
 LEPT_DLL extern PIX * pixReduceRankBinary2 ( PIX *pixs, l_int32 level, l_uint8 *intab );
-LEPT_DLL extern void reduceBinary2Low ( l_uint32 *datad, l_int32 wpld, l_uint32 *datas, l_int32 hs, l_int32 wpls, l_uint8 *tab );
-LEPT_DLL extern void reduceRankBinary2Low ( l_uint32 *datad, l_int32 wpld, l_uint32 *datas, l_int32 hs, l_int32 wpls, l_uint8 *tab, l_int32 level );
+LEPT_DLL extern void reduceBinary2Low ( l_uint32 *datad, l_int32 wpld, l_uint32 *datas, l_int32 hs, l_int32 wpls );
+LEPT_DLL extern void reduceRankBinary2Low ( l_uint32 *datad, l_int32 wpld, l_uint32 *datas, l_int32 hs, l_int32 wpls, l_int32 level );
 LEPT_DLL extern l_uint8 * makeSubsampleTab2x ( void );
 LEPT_DLL extern PIX * pixBlend ( PIX *pixs1, PIX *pixs2, l_int32 x, l_int32 y, l_float32 fract );
 LEPT_DLL extern PIX * pixBlendMask ( PIX *pixd, PIX *pixs1, PIX *pixs2, l_int32 x, l_int32 y, l_float32 fract, l_int32 type );
@@ -319,6 +320,18 @@ LEPT_DLL extern l_int32 boxaGetExtent ( BOXA *boxa, l_int32 *pw, l_int32 *ph, BO
 LEPT_DLL extern l_int32 boxaGetCoverage ( BOXA *boxa, l_int32 wc, l_int32 hc, l_int32 exactflag, l_float32 *pfract );
 LEPT_DLL extern l_int32 boxaSizeRange ( BOXA *boxa, l_int32 *pminw, l_int32 *pminh, l_int32 *pmaxw, l_int32 *pmaxh );
 LEPT_DLL extern l_int32 boxaLocationRange ( BOXA *boxa, l_int32 *pminx, l_int32 *pminy, l_int32 *pmaxx, l_int32 *pmaxy );
+LEPT_DLL extern L_BOXINDEX * boxindexCreate ( BOXA *boxa, l_int32 cellsize );
+LEPT_DLL extern void boxindexDestroy ( L_BOXINDEX **pbi );
+LEPT_DLL extern l_int32 boxindexGetCount ( L_BOXINDEX *bi );
+LEPT_DLL extern NUMA * boxindexIntersectsBox ( L_BOXINDEX *bi, BOX *box );
+LEPT_DLL extern NUMA * boxindexContainedInBox ( L_BOXINDEX *bi, BOX *box );
+LEPT_DLL extern NUMA * boxindexGetNearest ( L_BOXINDEX *bi, l_float32 x, l_float32 y, l_int32 k, NUMA **pnadist );
+LEPT_DLL extern L_BUCKETQ * bqueueCreate ( l_int32 nbuckets, l_int32 direction, l_int32 nalloc );
+LEPT_DLL extern void bqueueDestroy ( L_BUCKETQ **pbq );
+LEPT_DLL extern l_int32 bqueueAdd ( L_BUCKETQ *bq, l_int32 priority, l_int32 x, l_int32 y, l_int32 data );
+LEPT_DLL extern l_int32 bqueueRemove ( L_BUCKETQ *bq, l_int32 *ppriority, l_int32 *px, l_int32 *py, l_int32 *pdata );
+LEPT_DLL extern l_int32 bqueueGetCount ( L_BUCKETQ *bq );
+LEPT_DLL extern l_int32 bqueuePrint ( FILE *fp, L_BUCKETQ *bq );
 LEPT_DLL extern L_BYTEA * l_byteaCreate ( size_t nbytes );
 LEPT_DLL extern L_BYTEA * l_byteaInitFromMem ( l_uint8 *data, size_t size );
 LEPT_DLL extern L_BYTEA * l_byteaInitFromFile ( const char *fname );
@@ -385,6 +398,7 @@ LEPT_DLL extern l_int32 pixColorFraction ( PIX *pixs, l_int32 darkthresh, l_int3
 LEPT_DLL extern l_int32 pixNumSignificantGrayColors ( PIX *pixs, l_int32 darkthresh, l_int32 lightthresh, l_float32 minfract, l_int32 factor, l_int32 *pncolors );
 LEPT_DLL extern l_int32 pixColorsForQuantization ( PIX *pixs, l_int32 thresh, l_int32 *pncolors, l_int32 *piscolor, l_int32 debug );
 LEPT_DLL extern l_int32 pixNumColors ( PIX *pixs, l_int32 factor, l_int32 *pncolors );
+LEPT_DLL extern l_int32 pixCountRGBColors ( PIX *pixs, l_int32 factor, l_int32 *pncolors );
 LEPT_DLL extern l_int32 pixColorGray ( PIX *pixs, BOX *box, l_int32 type, l_int32 thresh, l_int32 rval, l_int32 gval, l_int32 bval );
 LEPT_DLL extern PIX * pixSnapColor ( PIX *pixd, PIX *pixs, l_uint32 srcval, l_uint32 dstval, l_int32 diff );
 LEPT_DLL extern PIX * pixSnapColorCmap ( PIX *pixd, PIX *pixs, l_uint32 srcval, l_uint32 dstval, l_int32 diff );
@@ -420,6 +434,9 @@ LEPT_DLL extern l_int32 pixcmapGetNearestIndex ( PIXCMAP *cmap, l_int32 rval, l_
 LEPT_DLL extern l_int32 pixcmapGetNearestGrayIndex ( PIXCMAP *cmap, l_int32 val, l_int32 *pindex );
 LEPT_DLL extern l_int32 pixcmapGetComponentRange ( PIXCMAP *cmap, l_int32 color, l_int32 *pminval, l_int32 *pmaxval );
 LEPT_DLL extern l_int32 pixcmapGetExtremeValue ( PIXCMAP *cmap, l_int32 type, l_int32 *prval, l_int32 *pgval, l_int32 *pbval );
+LEPT_DLL extern L_CMAPNEAR * cmapnearCreate ( PIXCMAP *cmap, l_int32 level, l_int32 metric );
+LEPT_DLL extern void cmapnearDestroy ( L_CMAPNEAR **pcn );
+LEPT_DLL extern l_int32 cmapnearGetIndex ( L_CMAPNEAR *cn, l_int32 rval, l_int32 gval, l_int32 bval, l_int32 *pindex );
 LEPT_DLL extern PIXCMAP * pixcmapGrayToColor ( l_uint32 color );
 LEPT_DLL extern PIXCMAP * pixcmapColorToGray ( PIXCMAP *cmaps, l_float32 rwt, l_float32 gwt, l_float32 bwt );
 LEPT_DLL extern PIXCMAP * pixcmapReadStream ( FILE *fp );
@@ -526,6 +543,11 @@ LEPT_DLL extern PIX * pixWindowedMean ( PIX *pixs, l_int32 wc, l_int32 hc, l_int
 LEPT_DLL extern PIX * pixWindowedMeanSquare ( PIX *pixs, l_int32 wc, l_int32 hc, l_int32 hasborder );
 LEPT_DLL extern l_int32 pixWindowedVariance ( PIX *pixm, PIX *pixms, FPIX **pfpixv, FPIX **pfpixrv );
 LEPT_DLL extern DPIX * pixMeanSquareAccum ( PIX *pixs );
+LEPT_DLL extern L_ACCUM * accumCreate ( PIX *pixs );
+LEPT_DLL extern void accumDestroy ( L_ACCUM **pacc );
+LEPT_DLL extern PIX * accumWindowedMean ( L_ACCUM *acc, l_int32 wc, l_int32 hc, l_int32 mirror );
+LEPT_DLL extern PIX * accumWindowedMeanSquare ( L_ACCUM *acc, l_int32 wc, l_int32 hc, l_int32 mirror );
+LEPT_DLL extern l_int32 accumWindowedStats ( L_ACCUM *acc, l_int32 wc, l_int32 hc, l_int32 mirror, PIX **ppixm, PIX **ppixms, FPIX **pfpixv, FPIX **pfpixrv );
 LEPT_DLL extern PIX * pixBlockrank ( PIX *pixs, PIX *pixacc, l_int32 wc, l_int32 hc, l_float32 rank );
 LEPT_DLL extern PIX * pixBlocksum ( PIX *pixs, PIX *pixacc, l_int32 wc, l_int32 hc );
 LEPT_DLL extern PIX * pixCensusTransform ( PIX *pixs, l_int32 halfsize, PIX *pixacc );
@@ -535,15 +557,26 @@ LEPT_DLL extern PIX * pixConvolveRGB ( PIX *pixs, L_KERNEL *kel );
 LEPT_DLL extern PIX * pixConvolveRGBSep ( PIX *pixs, L_KERNEL *kelx, L_KERNEL *kely );
 LEPT_DLL extern FPIX * fpixConvolve ( FPIX *fpixs, L_KERNEL *kel, l_int32 normflag );
 LEPT_DLL extern FPIX * fpixConvolveSep ( FPIX *fpixs, L_KERNEL *kelx, L_KERNEL *kely, l_int32 normflag );
+LEPT_DLL extern PIX * pixConvolveGaussian ( PIX *pixs, l_float32 sigma );
+LEPT_DLL extern FPIX * fpixConvolveGaussian ( FPIX *fpixs, l_float32 sigma );
 LEPT_DLL extern void l_setConvolveSampling ( l_int32 xfact, l_int32 yfact );
 LEPT_DLL extern void blockconvLow ( l_uint32 *data, l_int32 w, l_int32 h, l_int32 wpl, l_uint32 *dataa, l_int32 wpla, l_int32 wc, l_int32 hc );
 LEPT_DLL extern void blockconvAccumLow ( l_uint32 *datad, l_int32 w, l_int32 h, l_int32 wpld, l_uint32 *datas, l_int32 d, l_int32 wpls );
 LEPT_DLL extern void blocksumLow ( l_uint32 *datad, l_int32 w, l_int32 h, l_int32 wpl, l_uint32 *dataa, l_int32 wpla, l_int32 wc, l_int32 hc );
 LEPT_DLL extern l_float32 pixCorrelationScore ( PIX *pix1, PIX *pix2, l_int32 area1, l_int32 area2, l_float32 delx, l_float32 dely, l_int32 maxdiffw, l_int32 maxdiffh, l_int32 *tab );
 LEPT_DLL extern l_int32 pixCorrelationScoreThresholded ( PIX *pix1, PIX *pix2, l_int32 area1, l_int32 area2, l_float32 delx, l_float32 dely, l_int32 maxdiffw, l_int32 maxdiffh, l_int32 *tab, l_int32 *downcount, l_float32 score_threshold );
+LEPT_DLL extern NUMA * pixCorrelationScoreMulti ( PIX *pix1, l_int32 area1, l_float32 x1, l_float32 y1, PIXA *pixa2, NUMA *naarea2, PTA *pta2, NUMA *naindex, l_int32 maxdiffw, l_int32 maxdiffh, l_int32 *tab8 );
 LEPT_DLL extern l_float32 pixCorrelationScoreSimple ( PIX *pix1, PIX *pix2, l_int32 area1, l_int32 area2, l_float32 delx, l_float32 dely, l_int32 maxdiffw, l_int32 maxdiffh, l_int32 *tab );
 LEPT_DLL extern l_float32 pixCorrelationScoreShifted ( PIX *pix1, PIX *pix2, l_int32 area1, l_int32 area2, l_int32 delx, l_int32 dely, l_int32 *tab );
 LEPT_DLL extern l_int32 pixBestCorrelation ( PIX *pix1, PIX *pix2, l_int32 area1, l_int32 area2, l_int32 etransx, l_int32 etransy, l_int32 maxshift, l_int32 *tab8, l_int32 *pdelx, l_int32 *pdely, l_float32 *pscore, l_int32 debugflag );
+LEPT_DLL extern l_int32 correlCountLow ( l_uint32 *row1, l_int32 wpl1, l_uint32 *row2, l_int32 wpl2, l_int32 nrows, l_int32 nwords1, l_int32 nwords2, l_int32 shift, l_uint32 lastmask, l_int32 threshold, l_int32 *downcount, l_int32 untouchable, l_int32 *tab );
+LEPT_DLL extern l_int32 correlCountPopcntLow ( l_uint32 *row1, l_int32 wpl1, l_uint32 *row2, l_int32 wpl2, l_int32 nrows, l_int32 nwords1, l_int32 nwords2, l_int32 shift, l_uint32 lastmask, l_int32 threshold, l_int32 *downcount, l_int32 untouchable, l_int32 *tab );
+LEPT_DLL extern l_int32 l_cpuGetFeatures ( void );
+LEPT_DLL extern l_int32 l_cpuGetBestTier ( void );
+LEPT_DLL extern l_int32 l_cpuGetTier ( void );
+LEPT_DLL extern l_int32 l_cpuSetTier ( l_int32 tier );
+LEPT_DLL extern const char * l_cpuGetTierName ( l_int32 tier );
+LEPT_DLL extern L_CPU_DISPATCH * l_cpuGetDispatch ( void );
 LEPT_DLL extern L_DEWARP * dewarpCreate ( PIX *pixs, l_int32 pageno );
 LEPT_DLL extern L_DEWARP * dewarpCreateReference ( l_int32 pageno, l_int32 refpage );
 LEPT_DLL extern void dewarpDestroy ( L_DEWARP **pdew );
@@ -653,6 +686,8 @@ LEPT_DLL extern NUMA * numaEqualizeTRC ( PIX *pix, l_float32 fract, l_int32 fact
 LEPT_DLL extern l_int32 pixTRCMap ( PIX *pixs, PIX *pixm, NUMA *na );
 LEPT_DLL extern PIX * pixUnsharpMasking ( PIX *pixs, l_int32 halfwidth, l_float32 fract );
 LEPT_DLL extern PIX * pixUnsharpMaskingGray ( PIX *pixs, l_int32 halfwidth, l_float32 fract );
+LEPT_DLL extern PIX * pixUnsharpMaskingGauss ( PIX *pixs, l_float32 sigma, l_float32 fract );
+LEPT_DLL extern PIX * pixUnsharpMaskingGrayGauss ( PIX *pixs, l_float32 sigma, l_float32 fract );
 LEPT_DLL extern PIX * pixUnsharpMaskingFast ( PIX *pixs, l_int32 halfwidth, l_float32 fract, l_int32 direction );
 LEPT_DLL extern PIX * pixUnsharpMaskingGrayFast ( PIX *pixs, l_int32 halfwidth, l_float32 fract, l_int32 direction );
 LEPT_DLL extern PIX * pixUnsharpMaskingGray1D ( PIX *pixs, l_int32 halfwidth, l_float32 fract, l_int32 direction );
@@ -869,6 +904,11 @@ LEPT_DLL extern void ditherTo2bppLineLow ( l_uint32 *lined, l_int32 w, l_uint32
 LEPT_DLL extern l_int32 make8To2DitherTables ( l_int32 **ptabval, l_int32 **ptab38, l_int32 **ptab14, l_int32 cliptoblack, l_int32 cliptowhite );
 LEPT_DLL extern void thresholdTo2bppLow ( l_uint32 *datad, l_int32 h, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_int32 *tab );
 LEPT_DLL extern void thresholdTo4bppLow ( l_uint32 *datad, l_int32 h, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_int32 *tab );
+LEPT_DLL extern L_HASHMAP * l_hmapCreate ( l_int32 ninit, l_int32 keytype );
+LEPT_DLL extern void l_hmapDestroy ( L_HASHMAP **phmap );
+LEPT_DLL extern L_HASHITEM * l_hmapLookup ( L_HASHMAP *hmap, l_uint64 key, l_int32 op );
+LEPT_DLL extern L_HASHITEM * l_hmapLookupString ( L_HASHMAP *hmap, const char *str, l_int32 op );
+LEPT_DLL extern l_int32 l_hmapGetCount ( L_HASHMAP *hmap );
 LEPT_DLL extern L_HEAP * lheapCreate ( l_int32 nalloc, l_int32 direction );
 LEPT_DLL extern void lheapDestroy ( L_HEAP **plh, l_int32 freeflag );
 LEPT_DLL extern l_int32 lheapAdd ( L_HEAP *lh, void *item );
@@ -880,6 +920,21 @@ LEPT_DLL extern l_int32 lheapSwapDown ( L_HEAP *lh );
 LEPT_DLL extern l_int32 lheapSort ( L_HEAP *lh );
 LEPT_DLL extern l_int32 lheapSortStrictOrder ( L_HEAP *lh );
 LEPT_DLL extern l_int32 lheapPrint ( FILE *fp, L_HEAP *lh );
+LEPT_DLL extern L_DHEAP * dheapCreate ( l_int32 itemsize, l_int32 nalloc, l_int32 direction );
+LEPT_DLL extern void dheapDestroy ( L_DHEAP **pdh );
+LEPT_DLL extern l_int32 dheapAdd ( L_DHEAP *dh, void *item );
+LEPT_DLL extern l_int32 dheapExtendArray ( L_DHEAP *dh );
+LEPT_DLL extern l_int32 dheapRemove ( L_DHEAP *dh, void *item );
+LEPT_DLL extern l_int32 dheapGetCount ( L_DHEAP *dh );
+LEPT_DLL extern l_int32 dheapSwapUp ( L_DHEAP *dh, l_int32 index );
+LEPT_DLL extern l_int32 dheapSwapDown ( L_DHEAP *dh, l_int32 index );
+LEPT_DLL extern l_int32 dheapSort ( L_DHEAP *dh );
+LEPT_DLL extern l_int32 dheapSortStrictOrder ( L_DHEAP *dh );
+LEPT_DLL extern L_RHEAP * rheapCreate ( l_int32 itemsize );
+LEPT_DLL extern void rheapDestroy ( L_RHEAP **prh );
+LEPT_DLL extern l_int32 rheapAdd ( L_RHEAP *rh, void *item );
+LEPT_DLL extern l_int32 rheapRemove ( L_RHEAP *rh, void *item );
+LEPT_DLL extern l_int32 rheapGetCount ( L_RHEAP *rh );
 LEPT_DLL extern JBCLASSER * jbRankHausInit ( l_int32 components, l_int32 maxwidth, l_int32 maxheight, l_int32 size, l_float32 rank );
 LEPT_DLL extern JBCLASSER * jbCorrelationInit ( l_int32 components, l_int32 maxwidth, l_int32 maxheight, l_float32 thresh, l_float32 weightfactor );
 LEPT_DLL extern JBCLASSER * jbCorrelationInitWithoutComponents ( l_int32 components, l_int32 maxwidth, l_int32 maxheight, l_float32 thresh, l_float32 weightfactor );
@@ -1113,6 +1168,7 @@ LEPT_DLL extern NUMA * numaSort ( NUMA *naout, NUMA *nain, l_int32 sortorder );
 LEPT_DLL extern NUMA * numaBinSort ( NUMA *nas, l_int32 sortorder );
 LEPT_DLL extern NUMA * numaGetSortIndex ( NUMA *na, l_int32 sortorder );
 LEPT_DLL extern NUMA * numaGetBinSortIndex ( NUMA *nas, l_int32 sortorder );
+LEPT_DLL extern NUMA * numaGetRadixSortIndex ( NUMA *nas, l_int32 sortorder );
 LEPT_DLL extern NUMA * numaSortByIndex ( NUMA *nas, NUMA *naindex );
 LEPT_DLL extern l_int32 numaIsSorted ( NUMA *nas, l_int32 sortorder, l_int32 *psorted );
 LEPT_DLL extern l_int32 numaSortPair ( NUMA *nax, NUMA *nay, l_int32 sortorder, NUMA **pnasx, NUMA **pnasy );
@@ -1168,6 +1224,7 @@ LEPT_DLL extern l_int32 pixSetSelectMaskedCmap ( PIX *pixs, PIX *pixm, l_int32 x
 LEPT_DLL extern l_int32 pixSetMaskedCmap ( PIX *pixs, PIX *pixm, l_int32 x, l_int32 y, l_int32 rval, l_int32 gval, l_int32 bval );
 LEPT_DLL extern char * parseForProtos ( const char *filein, const char *prestring );
 LEPT_DLL extern BOXA * boxaGetWhiteblocks ( BOXA *boxas, BOX *box, l_int32 sortflag, l_int32 maxboxes, l_float32 maxoverlap, l_int32 maxperim, l_float32 fract, l_int32 maxpops );
+LEPT_DLL extern BOXA * boxaGetWhiteblocksGeneral ( BOXA *boxas, BOX *box, l_int32 sortflag, l_int32 maxboxes, l_float32 maxoverlap, l_int32 maxperim, l_float32 fract, l_int32 maxpops, l_float32 maxtime );
 LEPT_DLL extern BOXA * boxaPruneSortedOnOverlap ( BOXA *boxas, l_float32 maxoverlap );
 LEPT_DLL extern l_int32 convertFilesToPdf ( const char *dirname, const char *substr, l_int32 res, l_float32 scalefactor, l_int32 type, l_int32 quality, const char *title, const char *fileout );
 LEPT_DLL extern l_int32 saConvertFilesToPdf ( SARRAY *sa, l_int32 res, l_float32 scalefactor, l_int32 type, l_int32 quality, const char *title, const char *fileout );
@@ -1572,6 +1629,13 @@ LEPT_DLL extern PIX * pixConvertForPSWrap ( PIX *pixs );
 LEPT_DLL extern PIX * pixConvertToSubpixelRGB ( PIX *pixs, l_float32 scalex, l_float32 scaley, l_int32 order );
 LEPT_DLL extern PIX * pixConvertGrayToSubpixelRGB ( PIX *pixs, l_float32 scalex, l_float32 scaley, l_int32 order );
 LEPT_DLL extern PIX * pixConvertColorToSubpixelRGB ( PIX *pixs, l_float32 scalex, l_float32 scaley, l_int32 order );
+LEPT_DLL extern PIX * pixConnCompLabel ( PIX *pixs, l_int32 connectivity, L_CCFILTER filter, void *data, L_CCSTATS **pstats );
+LEPT_DLL extern PIX * pixConnCompSelect ( PIX *pixs, l_int32 connectivity, L_CCFILTER filter, void *data, L_CCSTATS **pstats );
+LEPT_DLL extern L_CCSTATS * ccstatsCreate ( l_int32 n );
+LEPT_DLL extern L_CCSTATS * ccstatsCreateFromRle ( L_RLE *rle, l_int32 connectivity, L_CCFILTER filter, void *data, l_int32 **plabels );
+LEPT_DLL extern void ccstatsDestroy ( L_CCSTATS **pstats );
+LEPT_DLL extern l_int32 ccstatsGetCount ( L_CCSTATS *stats );
+LEPT_DLL extern BOXA * ccstatsGetBoxa ( L_CCSTATS *stats );
 LEPT_DLL extern PIXTILING * pixTilingCreate ( PIX *pixs, l_int32 nx, l_int32 ny, l_int32 w, l_int32 h, l_int32 xoverlap, l_int32 yoverlap );
 LEPT_DLL extern void pixTilingDestroy ( PIXTILING **ppt );
 LEPT_DLL extern l_int32 pixTilingGetCount ( PIXTILING *pt, l_int32 *pnx, l_int32 *pny );
@@ -1801,6 +1865,21 @@ LEPT_DLL extern l_int32 regTestCompareSimilarPix ( L_REGPARAMS *rp, PIX *pix1, P
 LEPT_DLL extern l_int32 regTestCheckFile ( L_REGPARAMS *rp, const char *localname );
 LEPT_DLL extern l_int32 regTestCompareFiles ( L_REGPARAMS *rp, l_int32 index1, l_int32 index2 );
 LEPT_DLL extern l_int32 regTestWritePixAndCheck ( L_REGPARAMS *rp, PIX *pix, l_int32 format );
+LEPT_DLL extern L_RLE * rleCreate ( l_int32 w, l_int32 h, l_int32 nalloc );
+LEPT_DLL extern void rleDestroy ( L_RLE **prle );
+LEPT_DLL extern L_RLE * rleCopy ( L_RLE *rles );
+LEPT_DLL extern l_int32 rleGetDimensions ( L_RLE *rle, l_int32 *pw, l_int32 *ph );
+LEPT_DLL extern l_int32 rleGetCount ( L_RLE *rle );
+LEPT_DLL extern L_RLE * rleCreateFromPix ( PIX *pixs );
+LEPT_DLL extern PIX * pixCreateFromRle ( L_RLE *rle );
+LEPT_DLL extern l_int32 rleCountPixels ( L_RLE *rle, l_int32 *pcount );
+LEPT_DLL extern L_RLE * rleInvert ( L_RLE *rles );
+LEPT_DLL extern L_RLE * rleLogicalOp ( L_RLE *rle1, L_RLE *rle2, l_int32 op );
+LEPT_DLL extern L_RLE * rleDilateBrick ( L_RLE *rles, l_int32 hsize, l_int32 vsize );
+LEPT_DLL extern L_RLE * rleErodeBrick ( L_RLE *rles, l_int32 hsize, l_int32 vsize );
+LEPT_DLL extern L_RLE * rleOpenBrick ( L_RLE *rles, l_int32 hsize, l_int32 vsize );
+LEPT_DLL extern L_RLE * rleCloseBrick ( L_RLE *rles, l_int32 hsize, l_int32 vsize );
+LEPT_DLL extern L_CCSTATS * rleConnComp ( L_RLE *rles, l_int32 connectivity, L_CCFILTER filter, void *data, L_RLE **prled );
 LEPT_DLL extern l_int32 pixRasterop ( PIX *pixd, l_int32 dx, l_int32 dy, l_int32 dw, l_int32 dh, l_int32 op, PIX *pixs, l_int32 sx, l_int32 sy );
 LEPT_DLL extern l_int32 pixRasteropVip ( PIX *pixd, l_int32 bx, l_int32 bw, l_int32 vshift, l_int32 incolor );
 LEPT_DLL extern l_int32 pixRasteropHip ( PIX *pixd, l_int32 by, l_int32 bh, l_int32 hshift, l_int32 incolor );
@@ -1836,7 +1915,7 @@ LEPT_DLL extern PIX * pixRotate90 ( PIX *pixs, l_int32 direction );
 LEPT_DLL extern PIX * pixFlipLR ( PIX *pixd, PIX *pixs );
 LEPT_DLL extern PIX * pixFlipTB ( PIX *pixd, PIX *pixs );
 LEPT_DLL extern void rotate90Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 d, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_int32 direction );
-LEPT_DLL extern void flipLRLow ( l_uint32 *data, l_int32 w, l_int32 h, l_int32 d, l_int32 wpl, l_uint8 *tab, l_uint32 *buffer );
+LEPT_DLL extern void flipLRLow ( l_uint32 *data, l_int32 w, l_int32 h, l_int32 d, l_int32 wpl );
 LEPT_DLL extern void flipTBLow ( l_uint32 *data, l_int32 h, l_int32 wpl, l_uint32 *buffer );
 LEPT_DLL extern l_uint8 * makeReverseByteTab1 ( void );
 LEPT_DLL extern l_uint8 * makeReverseByteTab2 ( void );
@@ -1879,6 +1958,7 @@ LEPT_DLL extern l_int32 sarraySplitString ( SARRAY *sa, const char *str, const c
 LEPT_DLL extern SARRAY * sarraySelectBySubstring ( SARRAY *sain, const char *substr );
 LEPT_DLL extern SARRAY * sarraySelectByRange ( SARRAY *sain, l_int32 first, l_int32 last );
 LEPT_DLL extern l_int32 sarrayParseRange ( SARRAY *sa, l_int32 start, l_int32 *pactualstart, l_int32 *pend, l_int32 *pnewstart, const char *substr, l_int32 loc );
+LEPT_DLL extern SARRAY * sarrayRemoveDupsByHash ( SARRAY *sain );
 LEPT_DLL extern SARRAY * sarraySort ( SARRAY *saout, SARRAY *sain, l_int32 sortorder );
 LEPT_DLL extern l_int32 stringCompareLexical ( const char *str1, const char *str2 );
 LEPT_DLL extern SARRAY * sarrayRead ( const char *filename );
@@ -1946,20 +2026,20 @@ LEPT_DLL extern void scaleColorAreaMapLow ( l_uint32 *datad, l_int32 wd, l_int32
 LEPT_DLL extern void scaleGrayAreaMapLow ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 ws, l_int32 hs, l_int32 wpls );
 LEPT_DLL extern void scaleAreaMapLow2 ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 d, l_int32 wpls );
 LEPT_DLL extern l_int32 scaleBinaryLow ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 ws, l_int32 hs, l_int32 wpls );
-LEPT_DLL extern void scaleToGray2Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_uint32 *sumtab, l_uint8 *valtab );
+LEPT_DLL extern void scaleToGray2Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_uint8 *valtab );
 LEPT_DLL extern l_uint32 * makeSumTabSG2 ( void );
 LEPT_DLL extern l_uint8 * makeValTabSG2 ( void );
 LEPT_DLL extern void scaleToGray3Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_uint32 *sumtab, l_uint8 *valtab );
 LEPT_DLL extern l_uint32 * makeSumTabSG3 ( void );
 LEPT_DLL extern l_uint8 * makeValTabSG3 ( void );
-LEPT_DLL extern void scaleToGray4Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_uint32 *sumtab, l_uint8 *valtab );
+LEPT_DLL extern void scaleToGray4Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_uint8 *valtab );
 LEPT_DLL extern l_uint32 * makeSumTabSG4 ( void );
 LEPT_DLL extern l_uint8 * makeValTabSG4 ( void );
 LEPT_DLL extern void scaleToGray6Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_int32 *tab8, l_uint8 *valtab );
 LEPT_DLL extern l_uint8 * makeValTabSG6 ( void );
-LEPT_DLL extern void scaleToGray8Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_int32 *tab8, l_uint8 *valtab );
+LEPT_DLL extern void scaleToGray8Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_uint8 *valtab );
 LEPT_DLL extern l_uint8 * makeValTabSG8 ( void );
-LEPT_DLL extern void scaleToGray16Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_int32 *tab8 );
+LEPT_DLL extern void scaleToGray16Low ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas, l_int32 wpls );
 LEPT_DLL extern l_int32 scaleMipmapLow ( l_uint32 *datad, l_int32 wd, l_int32 hd, l_int32 wpld, l_uint32 *datas1, l_int32 wpls1, l_uint32 *datas2, l_int32 wpls2, l_float32 red );
 LEPT_DLL extern PIX * pixSeedfillBinary ( PIX *pixd, PIX *pixs, PIX *pixm, l_int32 connectivity );
 LEPT_DLL extern PIX * pixSeedfillBinaryRestricted ( PIX *pixd, PIX *pixs, PIX *pixm, l_int32 connectivity, l_int32 xmax, l_int32 ymax );
@@ -1974,6 +2054,8 @@ LEPT_DLL extern l_int32 pixSeedfillGraySimple ( PIX *pixs, PIX *pixm, l_int32 co
 LEPT_DLL extern l_int32 pixSeedfillGrayInvSimple ( PIX *pixs, PIX *pixm, l_int32 connectivity );
 LEPT_DLL extern PIX * pixSeedfillGrayBasin ( PIX *pixb, PIX *pixm, l_int32 delta, l_int32 connectivity );
 LEPT_DLL extern PIX * pixDistanceFunction ( PIX *pixs, l_int32 connectivity, l_int32 outdepth, l_int32 boundcond );
+LEPT_DLL extern PIX * pixEuclideanDistance ( PIX *pixs, l_int32 boundcond );
+LEPT_DLL extern FPIX * pixEuclideanDistanceFPix ( PIX *pixs, l_int32 boundcond );
 LEPT_DLL extern PIX * pixSeedspread ( PIX *pixs, l_int32 connectivity );
 LEPT_DLL extern l_int32 pixLocalExtrema ( PIX *pixs, l_int32 maxmin, l_int32 minmax, PIX **ppixmin, PIX **ppixmax );
 LEPT_DLL extern l_int32 pixSelectedLocalExtrema ( PIX *pixs, l_int32 mindist, PIX **ppixmin, PIX **ppixmax );
@@ -1986,6 +2068,7 @@ LEPT_DLL extern void seedfillGrayInvLow ( l_uint32 *datas, l_int32 w, l_int32 h,
 LEPT_DLL extern void seedfillGrayLowSimple ( l_uint32 *datas, l_int32 w, l_int32 h, l_int32 wpls, l_uint32 *datam, l_int32 wplm, l_int32 connectivity );
 LEPT_DLL extern void seedfillGrayInvLowSimple ( l_uint32 *datas, l_int32 w, l_int32 h, l_int32 wpls, l_uint32 *datam, l_int32 wplm, l_int32 connectivity );
 LEPT_DLL extern void distanceFunctionLow ( l_uint32 *datad, l_int32 w, l_int32 h, l_int32 d, l_int32 wpld, l_int32 connectivity );
+LEPT_DLL extern void euclideanDistanceLow ( l_uint32 *datad, l_int32 w, l_int32 h, l_int32 wpld, l_uint32 *datas, l_int32 wpls, l_int32 boundcond, l_int32 *g, l_int32 *s, l_int32 *t );
 LEPT_DLL extern void seedspreadLow ( l_uint32 *datad, l_int32 w, l_int32 h, l_int32 wpld, l_uint32 *datat, l_int32 wplt, l_int32 connectivity );
 LEPT_DLL extern SELA * selaCreate ( l_int32 n );
 LEPT_DLL extern void selaDestroy ( SELA **psela );
@@ -2062,6 +2145,8 @@ LEPT_DLL extern l_int32 pixFindSkewSweep ( PIX *pixs, l_float32 *pangle, l_int32
 LEPT_DLL extern l_int32 pixFindSkewSweepAndSearch ( PIX *pixs, l_float32 *pangle, l_float32 *pconf, l_int32 redsweep, l_int32 redsearch, l_float32 sweeprange, l_float32 sweepdelta, l_float32 minbsdelta );
 LEPT_DLL extern l_int32 pixFindSkewSweepAndSearchScore ( PIX *pixs, l_float32 *pangle, l_float32 *pconf, l_float32 *pendscore, l_int32 redsweep, l_int32 redsearch, l_float32 sweepcenter, l_float32 sweeprange, l_float32 sweepdelta, l_float32 minbsdelta );
 LEPT_DLL extern l_int32 pixFindSkewSweepAndSearchScorePivot ( PIX *pixs, l_float32 *pangle, l_float32 *pconf, l_float32 *pendscore, l_int32 redsweep, l_int32 redsearch, l_float32 sweepcenter, l_float32 sweeprange, l_float32 sweepdelta, l_float32 minbsdelta, l_int32 pivot );
+LEPT_DLL extern l_int32 pixFindSkewProjected ( PIX *pixs, l_float32 *pangle, l_float32 *pconf, l_int32 redsweep, l_int32 redsearch, l_float32 sweeprange, l_float32 sweepdelta, l_float32 minbsdelta );
+LEPT_DLL extern NUMA * pixFindSkewProjectedScores ( PIX *pixs, NUMA *naangles );
 LEPT_DLL extern l_int32 pixFindSkewOrthogonalRange ( PIX *pixs, l_float32 *pangle, l_float32 *pconf, l_int32 redsweep, l_int32 redsearch, l_float32 sweeprange, l_float32 sweepdelta, l_float32 minbsdelta, l_float32 confprior );
 LEPT_DLL extern l_int32 pixFindDifferentialSquareSum ( PIX *pixs, l_float32 *psum );
 LEPT_DLL extern l_int32 pixFindNormalizedSquareSum ( PIX *pixs, l_float32 *phratio, l_float32 *pvratio, l_float32 *pfract );
@@ -39,9 +39,12 @@
 #include "arrayaccess.h"
 #include "bbuffer.h"
 #include "bmf.h"
+#include "boxindex.h"
+#include "bucketq.h"
 #include "ccbord.h"
 #include "dewarp.h"
 #include "gplot.h"
+#include "hashmap.h"
 #include "heap.h"
 #include "imageio.h"
 #include "jbclass.h"
@@ -47,6 +47,7 @@
  *      Sauvola local thresholding
  *          l_int32    pixSauvolaBinarizeTiled()
  *          l_int32    pixSauvolaBinarize()
+ *          l_int32    pixSauvolaBinarizeAccum()
  *          PIX       *pixSauvolaGetThreshold()
  *          PIX       *pixApplyLocalThreshold();
  *
@@ -566,6 +567,9 @@ PIXTILING  *pt;
  *          and the larger the variance, the closer to the median
  *          it should be chosen.  Typical values for k are between
  *          0.2 and 0.5.
+ *      (6) To binarize the same image with several window sizes,
+ *          use pixSauvolaBinarizeAccum(), which reuses the
+ *          accumulators for all of them.
  */
 l_int32
 pixSauvolaBinarize(PIX       *pixs,
@@ -642,6 +646,98 @@ PIX     *pixg, *pixsc, *pixm, *pixms, *pixth, *pixd;
 }
 
 
+/*!
+ *  pixSauvolaBinarizeAccum()
+ *
+ *      Input:  pixs (8 bpp grayscale; not colormapped)
+ *              acc (<optional> accumulators made from pixs; can be null)
+ *              whsize (window half-width for measuring local statistics)
+ *              factor (factor for reducing threshold due to variance; >= 0)
+ *              &pixm (<optional return> local mean values)
+ *              &pixsd (<optional return> local standard deviation values)
+ *              &pixth (<optional return> threshold values)
+ *              &pixd (<optional return> thresholded image)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) This gives the same results as pixSauvolaBinarize() with
+ *          @addborder = 1.  The local statistics are found from
+ *          accumulators made on pixs itself, treating the border
+ *          as mirrored, so they do not depend on @whsize.
+ *      (2) To binarize an image at several window sizes, make @acc
+ *          once with accumCreate(pixs) and pass it to each call.
+ *          Then each extra window size costs only the lookups.
+ *          If @acc is null, it is made and destroyed here.
+ *      (3) See pixSauvolaBinarize() for the threshold formula.
+ */
+l_int32
+pixSauvolaBinarizeAccum(PIX       *pixs,
+                        L_ACCUM   *acc,
+                        l_int32    whsize,
+                        l_float32  factor,
+                        PIX      **ppixm,
+                        PIX      **ppixsd,
+                        PIX      **ppixth,
+                        PIX      **ppixd)
+{
+l_int32   w, h;
+L_ACCUM  *accd;
+PIX      *pixm, *pixms, *pixth, *pixd;
+
+    PROCNAME("pixSauvolaBinarizeAccum");
+
+    if (!ppixm && !ppixsd && !ppixth && !ppixd)
+        return ERROR_INT("no outputs", procName, 1);
+    if (ppixm) *ppixm = NULL;
+    if (ppixsd) *ppixsd = NULL;
+    if (ppixth) *ppixth = NULL;
+    if (ppixd) *ppixd = NULL;
+    if (!pixs || pixGetDepth(pixs) != 8)
+        return ERROR_INT("pixs undefined or not 8 bpp", procName, 1);
+    if (pixGetColormap(pixs))
+        return ERROR_INT("pixs is cmapped", procName, 1);
+    pixGetDimensions(pixs, &w, &h, NULL);
+    if (whsize < 2)
+        return ERROR_INT("whsize must be >= 2", procName, 1);
+    if (w < 2 * whsize + 3 || h < 2 * whsize + 3)
+        return ERROR_INT("whsize too large for image", procName, 1);
+    if (factor < 0.0)
+        return ERROR_INT("factor must be >= 0", procName, 1);
+    if (acc && (acc->w != w || acc->h != h))
+        return ERROR_INT("acc and pixs sizes differ", procName, 1);
+
+    if (acc)
+        accd = acc;
+    else if ((accd = accumCreate(pixs)) == NULL)
+        return ERROR_INT("accd not made", procName, 1);
+
+        /* The standard deviation is made along with the threshold */
+    pixm = pixms = pixth = pixd = NULL;
+    accumWindowedStats(accd, whsize, whsize, 1, &pixm,
+                       (ppixsd || ppixth || ppixd) ? &pixms : NULL,
+                       NULL, NULL);
+    if (ppixsd || ppixth || ppixd)
+        pixth = pixSauvolaGetThreshold(pixm, pixms, factor, ppixsd);
+    if (ppixd)
+        pixd = pixApplyLocalThreshold(pixs, pixth, 1);
+
+    if (ppixm)
+        *ppixm = pixm;
+    else
+        pixDestroy(&pixm);
+    pixDestroy(&pixms);
+    if (ppixth)
+        *ppixth = pixth;
+    else
+        pixDestroy(&pixth);
+    if (ppixd)
+        *ppixd = pixd;
+    if (!acc)
+        accumDestroy(&accd);
+    return 0;
+}
+
+
 /*!
  *  pixSauvolaGetThreshold()
  *
@@ -86,6 +86,10 @@ PIX       *pixd;
         lines = datas + i * wpls;
         lined = datad + factor * i * wpld;
         for (j = 0; j < w; j++) {
+            if ((j & 31) == 0 && lines[j >> 5] == 0) {  /* skip empty word */
+                j += 31;
+                continue;
+            }
             if (GET_DATA_BIT(lines, j)) {
                 start = factor * j;
                 for (k = 0; k < factor; k++)
@@ -41,8 +41,9 @@
 #include "allheaders.h"
 
 
-static  l_uint32 expandtab16[] = {
-            0x00000000, 0x0000ffff, 0xffff0000, 0xffffffff};
+static l_uint32 expandWord2x(l_uint32 word);
+static l_uint32 expandWord4x(l_uint32 word);
+static l_uint32 expandWord8x(l_uint32 word);
 
 
 /*-------------------------------------------------------------------*
@@ -50,6 +51,17 @@ static  l_uint32 expandtab16[] = {
  *-------------------------------------------------------------------*/
 /*!
  *  expandBinaryPower2Low()
+ *
+ *  Notes:
+ *      (1) Each src word is expanded into @factor full dest words.
+ *          The bits are spread out in parallel within the word by
+ *          a short sequence of shifts and masks, rather than by
+ *          table lookup on bytes; see expandWord2x(), etc.
+ *      (2) Only the first src line of each set of @factor dest lines
+ *          is expanded; the rest are copied.
+ *      (3) Bits in the padding of the last dest word are derived
+ *          from the padding of the src, just as with the other
+ *          low-level binary ops.
  */
 l_int32
 expandBinaryPower2Low(l_uint32  *datad,
@@ -62,86 +74,110 @@ expandBinaryPower2Low(l_uint32  *datad,
                       l_int32    wpls,
                       l_int32    factor)
 {
-l_int32    i, j, k, sdibits, sqbits, sbytes;
-l_uint8    sval;
-l_uint16  *tab2;
-l_uint32  *tab4, *tab8;
+l_int32    i, j, k, nwd;
+l_uint32   sword;
 l_uint32  *lines, *lined;
 
     PROCNAME("expandBinaryPower2Low");
 
-    switch (factor)
-    {
-    case 2:
-        if ((tab2 = makeExpandTab2x()) == NULL)
-            return ERROR_INT("tab2 not made", procName, 1);
-        sbytes = (ws + 7) / 8;
-        for (i = 0; i < hs; i++) {
-            lines = datas + i * wpls;
-            lined = datad + 2 * i * wpld;
-            for (j = 0; j < sbytes; j++) {
-                sval = GET_DATA_BYTE(lines, j);
-                SET_DATA_TWO_BYTES(lined, j, tab2[sval]);
+    if (factor != 2 && factor != 4 && factor != 8 && factor != 16)
+        return ERROR_INT("expansion factor not in {2,4,8,16}", procName, 1);
+
+    nwd = (wd + 31) / 32;  /* number of dest words to be written */
+    for (i = 0; i < hs; i++) {
+        lines = datas + i * wpls;
+        lined = datad + factor * i * wpld;
+        switch (factor)
+        {
+        case 2:
+            for (j = 0; j < nwd; j += 2) {
+                sword = lines[j / 2];
+                lined[j] = expandWord2x(sword >> 16);
+                if (j + 1 < nwd)
+                    lined[j + 1] = expandWord2x(sword & 0xffff);
             }
-            memcpy((char *)(lined + wpld), (char *)lined, 4 * wpld);
-        }
-        FREE(tab2);
-        break;
-    case 4:
-        if ((tab4 = makeExpandTab4x()) == NULL)
-            return ERROR_INT("tab4 not made", procName, 1);
-        sbytes = (ws + 7) / 8;
-        for (i = 0; i < hs; i++) {
-            lines = datas + i * wpls;
-            lined = datad + 4 * i * wpld;
-            for (j = 0; j < sbytes; j++) {
-                sval = GET_DATA_BYTE(lines, j);
-                lined[j] = tab4[sval];
+            break;
+        case 4:
+            for (j = 0; j < nwd; j++) {
+                sword = lines[j / 4] >> (24 - 8 * (j & 3));
+                lined[j] = expandWord4x(sword & 0xff);
             }
-            for (k = 1; k < 4; k++)
-                memcpy((char *)(lined + k * wpld), (char *)lined, 4 * wpld);
-        }
-        FREE(tab4);
-        break;
-    case 8:
-        if ((tab8 = makeExpandTab8x()) == NULL)
-            return ERROR_INT("tab8 not made", procName, 1);
-        sqbits = (ws + 3) / 4;
-        for (i = 0; i < hs; i++) {
-            lines = datas + i * wpls;
-            lined = datad + 8 * i * wpld;
-            for (j = 0; j < sqbits; j++) {
-                sval = GET_DATA_QBIT(lines, j);
-                if (sval > 15)
-                    L_WARNING_INT("sval = %d; should be < 16", procName, sval);
-                lined[j] = tab8[sval];
+            break;
+        case 8:
+            for (j = 0; j < nwd; j++) {
+                sword = lines[j / 8] >> (28 - 4 * (j & 7));
+                lined[j] = expandWord8x(sword & 0xf);
             }
-            for (k = 1; k < 8; k++)
-                memcpy((char *)(lined + k * wpld), (char *)lined, 4 * wpld);
-        }
-        FREE(tab8);
-        break;
-    case 16:
-        sdibits = (ws + 1) / 2;
-        for (i = 0; i < hs; i++) {
-            lines = datas + i * wpls;
-            lined = datad + 16 * i * wpld;
-            for (j = 0; j < sdibits; j++) {
-                sval = GET_DATA_DIBIT(lines, j);
-                lined[j] = expandtab16[sval];
+            break;
+        case 16:
+            for (j = 0; j < nwd; j++) {
+                sword = lines[j / 16] >> (30 - 2 * (j & 15));
+                lined[j] = ((sword >> 1) & 1) * 0xffff0000 |
+                           (sword & 1) * 0x0000ffff;
             }
-            for (k = 1; k < 16; k++)
-                memcpy((char *)(lined + k * wpld), (char *)lined, 4 * wpld);
+            break;
         }
-        break;
-    default:
-        return ERROR_INT("expansion factor not in {2,4,8,16}", procName, 1);
+        for (k = 1; k < factor; k++)
+            memcpy((char *)(lined + k * wpld), (char *)lined, 4 * wpld);
     }
 
     return 0;
 }
 
 
+/*!
+ *  expandWord2x()
+ *
+ *      Input:  word (16 src bits, in the lower half)
+ *      Return: the 32 bits with each src bit replicated twice
+ *
+ *  Notes:
+ *      (1) The bits are first moved apart, by halving the distance
+ *          between them at each step, to the odd bit positions;
+ *          they are then doubled by a shift and OR.
+ */
+static l_uint32
+expandWord2x(l_uint32  word)
+{
+    word = (word | (word << 8)) & 0x00ff00ff;
+    word = (word | (word << 4)) & 0x0f0f0f0f;
+    word = (word | (word << 2)) & 0x33333333;
+    word = (word | (word << 1)) & 0x55555555;
+    return word | (word << 1);
+}
+
+
+/*!
+ *  expandWord4x()
+ *
+ *      Input:  word (8 src bits, in the lowest byte)
+ *      Return: the 32 bits with each src bit replicated 4 times
+ */
+static l_uint32
+expandWord4x(l_uint32  word)
+{
+    word = (word | (word << 12)) & 0x000f000f;
+    word = (word | (word << 6)) & 0x03030303;
+    word = (word | (word << 3)) & 0x11111111;
+    return word * 0xf;
+}
+
+
+/*!
+ *  expandWord8x()
+ *
+ *      Input:  word (4 src bits, in the lowest nibble)
+ *      Return: the 32 bits with each src bit replicated 8 times
+ */
+static l_uint32
+expandWord8x(l_uint32  word)
+{
+    word = (word | (word << 14)) & 0x00030003;
+    word = (word | (word << 7)) & 0x01010101;
+    return word * 0xff;
+}
+
+
 
 /*-------------------------------------------------------------------*
  *             Expansion tables for 2x, 4x and 8x expansion          *
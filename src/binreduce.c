@@ -48,15 +48,19 @@
  *  pixReduceBinary2()
  *
  *      Input:  pixs
- *              tab (<optional>; if null, a table is made here
- *                   and destroyed before exit)
+ *              intab (<optional>; not used; can be null)
  *      Return: pixd (2x subsampled), or null on error
+ *
+ *  Notes:
+ *      (1) The subsampling is done a word at a time with shifts and
+ *          masks, so the byte permutation table that was formerly
+ *          required is no longer used.  The argument is retained
+ *          for compatibility.
  */
 PIX *
 pixReduceBinary2(PIX      *pixs,
                  l_uint8  *intab)
 {
-l_uint8   *tab;
 l_int32    ws, hs, wpls, wpld;
 l_uint32  *datas, *datad;
 PIX       *pixd;
@@ -69,13 +73,6 @@ PIX       *pixd;
     if (pixGetDepth(pixs) != 1)
         return (PIX *)ERROR_PTR("pixs not binary", procName, NULL);
 
-    if (intab) /* use input table */
-        tab = intab;
-    else {
-        if ((tab = makeSubsampleTab2x()) == NULL)
-            return (PIX *)ERROR_PTR("tab not made", procName, NULL);
-    }
-
     ws = pixGetWidth(pixs);
     hs = pixGetHeight(pixs);
     if (hs <= 1)
@@ -90,11 +87,7 @@ PIX       *pixd;
     wpld = pixGetWpl(pixd);
     datad = pixGetData(pixd);
 
-    reduceBinary2Low(datad, wpld, datas, hs, wpls, tab);
-
-    if (intab == NULL)
-        FREE(tab);
-
+    reduceBinary2Low(datad, wpld, datas, hs, wpls);
     return pixd;
 }
 
@@ -120,8 +113,7 @@ pixReduceRankBinaryCascade(PIX     *pixs,
                            l_int32  level3,
                            l_int32  level4)
 {
-PIX      *pix1, *pix2, *pix3, *pix4;
-l_uint8  *tab;
+PIX  *pix1, *pix2, *pix3, *pix4;
 
     PROCNAME("pixReduceRankBinaryCascade");
 
@@ -137,32 +129,22 @@ l_uint8  *tab;
         return pixCopy(NULL, pixs);
     }
 
-    if ((tab = makeSubsampleTab2x()) == NULL)
-        return (PIX *)ERROR_PTR("tab not made", procName, NULL);
-
-    pix1 = pixReduceRankBinary2(pixs, level1, tab);
-    if (level2 <= 0) {
-        FREE(tab);
+    pix1 = pixReduceRankBinary2(pixs, level1, NULL);
+    if (level2 <= 0)
         return pix1;
-    }
 
-    pix2 = pixReduceRankBinary2(pix1, level2, tab);
+    pix2 = pixReduceRankBinary2(pix1, level2, NULL);
     pixDestroy(&pix1);
-    if (level3 <= 0) {
-        FREE(tab);
+    if (level3 <= 0)
         return pix2;
-    }
 
-    pix3 = pixReduceRankBinary2(pix2, level3, tab);
+    pix3 = pixReduceRankBinary2(pix2, level3, NULL);
     pixDestroy(&pix2);
-    if (level4 <= 0) {
-        FREE(tab);
+    if (level4 <= 0)
         return pix3;
-    }
 
-    pix4 = pixReduceRankBinary2(pix3, level4, tab);
+    pix4 = pixReduceRankBinary2(pix3, level4, NULL);
     pixDestroy(&pix3);
-    FREE(tab);
     return pix4;
 }
 
@@ -172,8 +154,7 @@ l_uint8  *tab;
  *
  *      Input:  pixs (1 bpp)
  *              level (rank threshold: 1, 2, 3, 4)
- *              intab (<optional>; if null, a table is made here
- *                     and destroyed before exit)
+ *              intab (<optional>; not used; can be null)
  *      Return: pixd (1 bpp, 2x rank threshold reduced), or null on error
  *
  *  Notes:
@@ -181,13 +162,13 @@ l_uint8  *tab;
  *      (2) The rank threshold specifies the minimum number of ON
  *          pixels in each 2x2 region of pixs that are required to
  *          set the corresponding pixel ON in pixd.
+ *      (3) As with pixReduceBinary2(), @intab is no longer used.
  */
 PIX *
 pixReduceRankBinary2(PIX      *pixs,
                      l_int32   level,
                      l_uint8  *intab)
 {
-l_uint8   *tab;
 l_int32    ws, hs, wpls, wpld;
 l_uint32  *datas, *datad;
 PIX       *pixd;
@@ -203,13 +184,6 @@ PIX       *pixd;
         return (PIX *)ERROR_PTR("level must be in set {1,2,3,4}",
             procName, NULL);
 
-    if (intab) /* use input table */
-        tab = intab;
-    else {
-        if ((tab = makeSubsampleTab2x()) == NULL)
-            return (PIX *)ERROR_PTR("tab not made", procName, NULL);
-    }
-
     ws = pixGetWidth(pixs);
     hs = pixGetHeight(pixs);
     if (hs <= 1)
@@ -224,10 +198,6 @@ PIX       *pixd;
     wpld = pixGetWpl(pixd);
     datad = pixGetData(pixd);
 
-    reduceRankBinary2Low(datad, wpld, datas, hs, wpls, tab, level);
-
-    if (!intab)
-        FREE(tab);
-
+    reduceRankBinary2Low(datad, wpld, datas, hs, wpls, level);
     return pixd;
 }
@@ -34,46 +34,35 @@
  *          Low-level threshold reduction
  *                  void       reduceRankBinary2Low()
  *                  l_uint8   *makeSubsampleTab2x()
- *
- *
  */
 
 #include <string.h>
 #include "allheaders.h"
 
 
+static l_uint32 subsampleWord2x(l_uint32 word);
+
+
 /*-------------------------------------------------------------------*
  *                   Low-level subsampled reduction                  *
  *-------------------------------------------------------------------*/
 /*!
  *  reduceBinary2Low()
  *
- *  After folding, the data is in bytes 0 and 2 of the word,
- *  and the bits in each byte are in the following order
- *  (with 0 being the leftmost originating pair and 7 being
- *  the rightmost originating pair):
- *
- *      0 4 1 5 2 6 3 7
- *
- *  These need to be permuted to
- *
- *      0 1 2 3 4 5 6 7
- *
- *  which is done with an 8-bit table generated by
- *  makeSubsampleTab2x().
- *
+ *  Each pair of src words is reduced to one dest word.  The pixels
+ *  in the even positions (0, 2, ... 30) of each src word are gathered
+ *  into a contiguous 16 bit field by subsampleWord2x(), which does
+ *  with shifts and masks what the makeSubsampleTab2x() table does
+ *  for one byte at a time.
  */
 void
 reduceBinary2Low(l_uint32  *datad,
                  l_int32    wpld,
                  l_uint32  *datas,
                  l_int32    hs,
-                 l_int32    wpls,
-                 l_uint8   *tab)
+                 l_int32    wpls)
 {
 l_int32    i, id, j, wplsi;
-l_uint8    byte0, byte1;
-l_uint16   shortd;
 l_uint32   word;
 l_uint32  *lines, *lined;
 
@@ -83,14 +72,11 @@ l_uint32  *lines, *lined;
     for (i = 0, id = 0; i < hs - 1; i += 2, id++) {
         lines = datas + i * wpls;
         lined = datad + id * wpld;
-        for (j = 0; j < wplsi; j++) {
-            word = *(lines + j);
-            word = word & 0xaaaaaaaa;  /* mask */
-            word = word | (word << 7);  /* fold; data in bytes 0 & 2 */
-            byte0 = word >> 24;
-            byte1 = (word >> 8) & 0xff;
-            shortd = (tab[byte0] << 8) | tab[byte1];
-            SET_DATA_TWO_BYTES(lined, j, shortd);
+        for (j = 0; j < wplsi; j += 2) {
+            word = subsampleWord2x(lines[j]) << 16;
+            if (j + 1 < wplsi)
+                word |= subsampleWord2x(lines[j + 1]);
+            lined[j / 2] = word;
         }
     }
 
@@ -116,120 +102,83 @@ reduceRankBinary2Low(l_uint32  *datad,
                      l_uint32  *datas,
                      l_int32    hs,
                      l_int32    wpls,
-                     l_uint8   *tab,
                      l_int32    level)
 {
-l_int32    i, id, j, wplsi;
-l_uint8    byte0, byte1;
-l_uint16   shortd;
-l_uint32   word1, word2, word3, word4;
+l_int32    i, id, j, k, wplsi;
+l_uint32   word1, word2, word3, word4, wordd;
 l_uint32  *lines, *lined;
 
         /* e.g., if ws = 65: wd = 32, wpls = 3, wpld = 1 --> trouble */
     wplsi = L_MIN(wpls, 2 * wpld);  /* iterate over this number of words */
 
-    switch (level)
-    {
-
-    case 1:
-        for (i = 0, id = 0; i < hs - 1; i += 2, id++) {
-            lines = datas + i * wpls;
-            lined = datad + id * wpld;
-            for (j = 0; j < wplsi; j++) {
-                word1 = *(lines + j);
-                word2 = *(lines + wpls + j);
-
-                    /* OR/OR */
-                word2 = word1 | word2;
-                word2 = word2 | (word2 << 1);
-
-                word2 = word2 & 0xaaaaaaaa;  /* mask */
-                word1 = word2 | (word2 << 7);  /* fold; data in bytes 0 & 2 */
-                byte0 = word1 >> 24;
-                byte1 = (word1 >> 8) & 0xff;
-                shortd = (tab[byte0] << 8) | tab[byte1];
-                SET_DATA_TWO_BYTES(lined, j, shortd);
-            }
-        }
-        break;
-
-    case 2:
-        for (i = 0, id = 0; i < hs - 1; i += 2, id++) {
-            lines = datas + i * wpls;
-            lined = datad + id * wpld;
-            for (j = 0; j < wplsi; j++) {
-                word1 = *(lines + j);
-                word2 = *(lines + wpls + j);
-
-                    /* (AND/OR) OR (OR/AND) */
-                word3 = word1 & word2;
-                word3 = word3 | (word3 << 1);
-                word4 = word1 | word2;
-                word4 = word4 & (word4 << 1);
-                word2 = word3 | word4;
-
-                word2 = word2 & 0xaaaaaaaa;  /* mask */
-                word1 = word2 | (word2 << 7);  /* fold; data in bytes 0 & 2 */
-                byte0 = word1 >> 24;
-                byte1 = (word1 >> 8) & 0xff;
-                shortd = (tab[byte0] << 8) | tab[byte1];
-                SET_DATA_TWO_BYTES(lined, j, shortd);
-            }
-        }
-        break;
-
-    case 3:
-        for (i = 0, id = 0; i < hs - 1; i += 2, id++) {
-            lines = datas + i * wpls;
-            lined = datad + id * wpld;
-            for (j = 0; j < wplsi; j++) {
-                word1 = *(lines + j);
-                word2 = *(lines + wpls + j);
-
-                    /* (AND/OR) AND (OR/AND) */
-                word3 = word1 & word2;
-                word3 = word3 | (word3 << 1);
-                word4 = word1 | word2;
-                word4 = word4 & (word4 << 1);
-                word2 = word3 & word4;
-
-                word2 = word2 & 0xaaaaaaaa;  /* mask */
-                word1 = word2 | (word2 << 7);  /* fold; data in bytes 0 & 2 */
-                byte0 = word1 >> 24;
-                byte1 = (word1 >> 8) & 0xff;
-                shortd = (tab[byte0] << 8) | tab[byte1];
-                SET_DATA_TWO_BYTES(lined, j, shortd);
-            }
-        }
-        break;
-
-    case 4:
-        for (i = 0, id = 0; i < hs - 1; i += 2, id++) {
-            lines = datas + i * wpls;
-            lined = datad + id * wpld;
-            for (j = 0; j < wplsi; j++) {
-                word1 = *(lines + j);
-                word2 = *(lines + wpls + j);
-
-                    /* AND/AND */
-                word2 = word1 & word2;
-                word2 = word2 & (word2 << 1);
-
-                word2 = word2 & 0xaaaaaaaa;  /* mask */
-                word1 = word2 | (word2 << 7);  /* fold; data in bytes 0 & 2 */
-                byte0 = word1 >> 24;
-                byte1 = (word1 >> 8) & 0xff;
-                shortd = (tab[byte0] << 8) | tab[byte1];
-                SET_DATA_TWO_BYTES(lined, j, shortd);
+    for (i = 0, id = 0; i < hs - 1; i += 2, id++) {
+        lines = datas + i * wpls;
+        lined = datad + id * wpld;
+        for (j = 0; j < wplsi; j += 2) {
+            wordd = 0;
+            for (k = j; k < j + 2 && k < wplsi; k++) {
+                word1 = lines[k];
+                word2 = lines[wpls + k];
+                switch (level)
+                {
+                case 1:  /* OR/OR */
+                    word2 = word1 | word2;
+                    word2 = word2 | (word2 << 1);
+                    break;
+                case 2:  /* (AND/OR) OR (OR/AND) */
+                    word3 = word1 & word2;
+                    word3 = word3 | (word3 << 1);
+                    word4 = word1 | word2;
+                    word4 = word4 & (word4 << 1);
+                    word2 = word3 | word4;
+                    break;
+                case 3:  /* (AND/OR) AND (OR/AND) */
+                    word3 = word1 & word2;
+                    word3 = word3 | (word3 << 1);
+                    word4 = word1 | word2;
+                    word4 = word4 & (word4 << 1);
+                    word2 = word3 & word4;
+                    break;
+                case 4:  /* AND/AND */
+                    word2 = word1 & word2;
+                    word2 = word2 & (word2 << 1);
+                    break;
+                }
+                wordd |= subsampleWord2x(word2) << (16 * (j + 1 - k));
             }
+            lined[j / 2] = wordd;
         }
-        break;
     }
 
     return;
 }
 
 
+/*!
+ *  subsampleWord2x()
+ *
+ *      Input:  word (32 pixels)
+ *      Return: the 16 pixels in the even positions, right-justified
+ *
+ *  Notes:
+ *      (1) Pixel 0 is the MSB.  The even-numbered pixels are shifted
+ *          right by 1 to occupy the even bit positions, and then
+ *          packed pairwise in 4 steps, doubling the size of the packed
+ *          fields at each step.  This is a portable version of a
+ *          parallel bit extract with mask 0xaaaaaaaa.
+ */
+static l_uint32
+subsampleWord2x(l_uint32  word)
+{
+    word = (word >> 1) & 0x55555555;
+    word = (word | (word >> 1)) & 0x33333333;
+    word = (word | (word >> 2)) & 0x0f0f0f0f;
+    word = (word | (word >> 4)) & 0x00ff00ff;
+    word = (word | (word >> 8)) & 0x0000ffff;
+    return word;
+}
+
+
 /*!
  *  makeSubsampleTab2x()
  *
@@ -34,6 +34,8 @@
  *           BOXA     *boxaIntersectsBox()
  *           BOXA     *boxaClipToBox()
  *           BOXA     *boxaCombineOverlaps()
+ *           static l_int32  boxaFindSet()
+ *           static void     boxaJoinSets()
  *           BOX      *boxOverlapRegion()
  *           BOX      *boxBoundingRegion()
  *           l_int32   boxOverlapFraction()
@@ -55,6 +57,9 @@
 
 #include "allheaders.h"
 
+static l_int32 boxaFindSet(l_int32 *parent, l_int32 i);
+static void boxaJoinSets(l_int32 *parent, l_int32 i, l_int32 j);
+
 
 /*---------------------------------------------------------------------*
  *                             Box geometry                            *
@@ -135,6 +140,8 @@ l_int32  left1, left2, top1, top2, right1, right2, bot1, bot2;
  *
  *  Notes:
  *      (1) All boxes in boxa that are entirely outside box are removed.
+ *      (2) This scans all the boxes.  To make many such queries on
+ *          the same boxa, use boxindexContainedInBox().
  */
 BOXA *
 boxaContainedInBox(BOXA  *boxas,
@@ -177,6 +184,8 @@ BOXA    *boxad;
  *  Notes:
  *      (1) All boxes in boxa that intersect with box (i.e., are completely
  *          or partially contained in box) are retained.
+ *      (2) This scans all the boxes.  To make many such queries on
+ *          the same boxa, use boxindexIntersectsBox().
  */
 BOXA *
 boxaIntersectsBox(BOXA  *boxas,
@@ -264,71 +273,174 @@ BOXA    *boxad;
  *          the 4-connected components gives the wrong result, because
  *          two non-overlapping rectangles, when rendered, can still
  *          be 4-connected, and hence they will be joined.
- *      (3) A bad case is to have n boxes, none of which overlap.
- *          Then you have one iteration with O(n^2) compares.  This
- *          is still faster than painting each rectangle and finding
- *          the connected components, even for thousands of rectangles.
+ *      (3) Each iteration is a sweep over the boxes in order of their
+ *          left side, keeping an active list of the boxes whose right
+ *          side has not yet been passed.  Each box is tested only
+ *          against the active boxes, and boxes that intersect are
+ *          joined with union-find.  Each group is then replaced by
+ *          its bounding box, and this is repeated until no boxes are
+ *          joined, because the bounding boxes can themselves overlap.
+ *      (4) The boxes in @boxad are in the order of the first box of
+ *          each group in @boxas.
+ *      (5) For boxes on a page, the active list is short, and each
+ *          iteration is close to O(n logn).  The bad case for the
+ *          older method, n boxes none of which overlap, which took
+ *          O(n^2) compares, is now a single fast iteration.
  */
 BOXA *
 boxaCombineOverlaps(BOXA  *boxas)
 {
-l_int32  i, j, n1, n2, inter, interfound, niters;
-BOX     *box1, *box2, *box3;
-BOXA    *boxat1, *boxat2;
+l_int32   i, j, k, m, n, ngroups, nactive, root, x, y, w, h;
+l_int32  *left, *top, *right, *bot, *parent, *active, *group;
+NUMA     *na, *naindex;
+BOXA     *boxad;
 
     PROCNAME("boxaCombineOverlaps");
 
     if (!boxas)
         return (BOXA *)ERROR_PTR("boxas not defined", procName, NULL);
 
-    boxat1 = boxaCopy(boxas, L_COPY);
-    n1 = boxaGetCount(boxat1);
-    niters = 0;
-/*    fprintf(stderr, "%d iters: %d boxes\n", niters, n1); */
-    while (1) {  /* loop until no change from previous iteration */
-        niters++;
-        boxat2 = boxaCreate(n1);
-        for (i = 0; i < n1; i++) {
-            box1 = boxaGetBox(boxat1, i, L_COPY);
-            if (i == 0) {
-                boxaAddBox(boxat2, box1, L_INSERT);
-                continue;
+    if ((n = boxaGetCount(boxas)) < 2)
+        return boxaCopy(boxas, L_COPY);
+    left = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    top = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    right = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    bot = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    parent = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    active = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    group = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    if (!left || !top || !right || !bot || !parent || !active || !group) {
+        FREE(left);
+        FREE(top);
+        FREE(right);
+        FREE(bot);
+        FREE(parent);
+        FREE(active);
+        FREE(group);
+        return (BOXA *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+    for (i = 0; i < n; i++) {
+        boxaGetBoxGeometry(boxas, i, &x, &y, &w, &h);
+        left[i] = x;
+        top[i] = y;
+        right[i] = x + w - 1;
+        bot[i] = y + h - 1;
+    }
+
+    while (1) {  /* loop until no boxes are joined */
+            /* Sweep in order of the left side */
+        na = numaCreate(n);
+        for (i = 0; i < n; i++) {
+            numaAddNumber(na, left[i]);
+            parent[i] = i;
+        }
+        naindex = numaGetSortIndex(na, L_SORT_INCREASING);
+        nactive = 0;
+        for (m = 0; m < n; m++) {
+            numaGetIValue(naindex, m, &i);
+                /* Drop active boxes that are entirely to the left,
+                 * and join the others if they overlap box i */
+            for (j = 0, k = 0; j < nactive; j++) {
+                if (right[active[j]] < left[i]) continue;
+                active[k++] = active[j];
+                if (bot[active[j]] >= top[i] && bot[i] >= top[active[j]] &&
+                    right[i] >= left[active[j]])
+                    boxaJoinSets(parent, active[j], i);
             }
-            n2 = boxaGetCount(boxat2);
-                /* Now test box1 against all boxes already put in boxat2.
-                 * If it is found to intersect with an existing box,
-                 * replace that box by the union of the two boxes,
-                 * and break to the outer loop.  If no overlap is
-                 * found, add box1 to boxat2. */
-            interfound = FALSE;
-            for (j = 0; j < n2; j++) {
-                box2 = boxaGetBox(boxat2, j, L_CLONE);
-                boxIntersects(box1, box2, &inter);
-                if (inter == 1) {
-                    box3 = boxBoundingRegion(box1, box2);
-                    boxaReplaceBox(boxat2, j, box3);
-                    boxDestroy(&box1);
-                    boxDestroy(&box2);
-                    interfound = TRUE;
-                    break;
-                }
-                boxDestroy(&box2);
+            nactive = k;
+            active[nactive++] = i;
+        }
+        numaDestroy(&na);
+        numaDestroy(&naindex);
+
+            /* Each root is the lowest index in its set, so it comes
+             * before all other members.  Make the bounding box of
+             * each set in place, at the position of its group number. */
+        ngroups = 0;
+        for (i = 0; i < n; i++) {
+            root = boxaFindSet(parent, i);
+            if (root == i) {
+                group[i] = ngroups;
+                left[ngroups] = left[i];
+                top[ngroups] = top[i];
+                right[ngroups] = right[i];
+                bot[ngroups] = bot[i];
+                ngroups++;
+            } else {
+                k = group[root];
+                left[k] = L_MIN(left[k], left[i]);
+                top[k] = L_MIN(top[k], top[i]);
+                right[k] = L_MAX(right[k], right[i]);
+                bot[k] = L_MAX(bot[k], bot[i]);
             }
-            if (interfound == FALSE)
-                boxaAddBox(boxat2, box1, L_INSERT);
         }
-        n2 = boxaGetCount(boxat2);
-/*        fprintf(stderr, "%d iters: %d boxes\n", niters, n2); */
-        if (n2 == n1)  /* we're done */
+        if (ngroups == n)  /* we're done */
             break;
-        else {
-            n1 = n2;
-            boxaDestroy(&boxat1);
-            boxat1 = boxat2;
-        }
+        n = ngroups;
+    }
+
+    boxad = boxaCreate(n);
+    for (i = 0; i < n; i++) {
+        boxaAddBox(boxad, boxCreate(left[i], top[i], right[i] - left[i] + 1,
+                                    bot[i] - top[i] + 1), L_INSERT);
+    }
+
+    FREE(left);
+    FREE(top);
+    FREE(right);
+    FREE(bot);
+    FREE(parent);
+    FREE(active);
+    FREE(group);
+    return boxad;
+}
+
+
+/*!
+ *  boxaFindSet()
+ *
+ *      Input:  parent (array of union-find links)
+ *              i (element)
+ *      Return: root (of the set containing i)
+ *
+ *  Notes:
+ *      (1) Uses path halving.
+ */
+static l_int32
+boxaFindSet(l_int32  *parent,
+            l_int32   i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
     }
-    boxaDestroy(&boxat1);
-    return boxat2;
+    return i;
+}
+
+
+/*!
+ *  boxaJoinSets()
+ *
+ *      Input:  parent (array of union-find links)
+ *              i, j (elements)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) The root of the joined set is the lower of the two roots,
+ *          so the root of every set is its lowest element.
+ */
+static void
+boxaJoinSets(l_int32  *parent,
+             l_int32   i,
+             l_int32   j)
+{
+    i = boxaFindSet(parent, i);
+    j = boxaFindSet(parent, j);
+    if (i < j)
+        parent[j] = i;
+    else if (j < i)
+        parent[i] = j;
+    return;
 }
 
 
@@ -484,6 +596,9 @@ l_int32  bx, by, bw, bh;
  *
  *  Notes:
  *      (1) Uses euclidean distance between centroid and point.
+ *      (2) This scans all the boxes.  To make many such queries on
+ *          the same boxa, or to find the k nearest boxes, use
+ *          boxindexGetNearest().
  */
 BOX *
 boxaGetNearestToPt(BOXA    *boxa,
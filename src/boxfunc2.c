@@ -61,11 +61,6 @@
 #include <math.h>
 #include "allheaders.h"
 
-    /* For more than this number of c.c. in a binarized image of
-     * semi-perimeter (w + h) about 5000 or less, the O(n) binsort
-     * is faster than the O(nlogn) shellsort.  */
-static const l_int32   MIN_COMPS_FOR_BIN_SORT = 500;
-
 
 /*---------------------------------------------------------------------*
  *      Boxa/Box transform (shift, scale) and orthogonal rotation      *
@@ -535,6 +530,11 @@ l_int32  bx, by, bw, bh, xdist, ydist;
  *              &naindex (<optional return> index of sorted order into
  *                        original array)
  *      Return: boxad (sorted version of boxas), or null on error
+ *
+ *  Notes:
+ *      (1) For more than a few hundred boxes, the sort index is found
+ *          with an O(n) radix sort that is stable; boxes with equal
+ *          values stay in their input order.
  */
 BOXA *
 boxaSort(BOXA    *boxas,
@@ -562,13 +562,7 @@ NUMA      *na, *naindex;
     if (sortorder != L_SORT_INCREASING && sortorder != L_SORT_DECREASING)
         return (BOXA *)ERROR_PTR("invalid sort order", procName, NULL);
 
-        /* Use O(n) binsort if possible */
     n = boxaGetCount(boxas);
-    if (n > MIN_COMPS_FOR_BIN_SORT &&
-        ((sorttype == L_SORT_BY_X) || (sorttype == L_SORT_BY_Y) ||
-         (sorttype == L_SORT_BY_WIDTH) || (sorttype == L_SORT_BY_HEIGHT) ||
-         (sorttype == L_SORT_BY_PERIMETER)))
-        return boxaBinSort(boxas, sorttype, sortorder, pnaindex);
 
         /* Build up numa of specific data */
     if ((na = numaCreate(n)) == NULL)
@@ -643,9 +637,9 @@ NUMA      *na, *naindex;
  *  Notes:
  *      (1) For a large number of boxes (say, greater than 1000), this
  *          O(n) binsort is much faster than the O(nlogn) shellsort.
- *          For 5000 components, this is over 20x faster than boxaSort().
- *      (2) Consequently, boxaSort() calls this function if it will
- *          likely go much faster.
+ *      (2) The values must be non-negative integers.  boxaSort() is
+ *          equally fast for large boxa, because it uses a radix sort;
+ *          see numaGetRadixSortIndex().
  */
 BOXA *
 boxaBinSort(BOXA    *boxas,
@@ -0,0 +1,572 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ - 
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+/*
+ *   boxindex.c
+ *
+ *      Create/Destroy L_BoxIndex
+ *          L_BOXINDEX  *boxindexCreate()
+ *          void         boxindexDestroy()
+ *
+ *      Accessors
+ *          l_int32      boxindexGetCount()
+ *
+ *      Queries
+ *          NUMA        *boxindexIntersectsBox()
+ *          NUMA        *boxindexContainedInBox()
+ *          NUMA        *boxindexGetNearest()
+ *          static l_int32  boxindexGetCellRange()
+ *          static l_int32  boxindexNextStamp()
+ *
+ *    The boxindex is a uniform grid over the boxes of a boxa.  It is
+ *    useful when many queries are made on the same set of boxes, as
+ *    in layout analysis, where each query with boxaIntersectsBox()
+ *    or boxaGetNearestToPt() would scan the entire boxa.  Making the
+ *    index is O(n), and a query only looks at the boxes in the cells
+ *    that it touches.
+ *
+ *    The cell size is chosen by default to be the larger of the mean
+ *    box dimension and the size for which there is about one box per
+ *    cell.  Then each box is in a few cells, and the lists are short,
+ *    unless the boxes are very unequal in size or strongly clustered.
+ *
+ *    The queries return a numa of the indices of the boxes in the
+ *    original boxa.  Intersection and containment results are in
+ *    increasing order of the index, which is the order in which
+ *    boxaIntersectsBox() and boxaContainedInBox() return the boxes.
+ *    Nearest neighbor results are in increasing order of distance,
+ *    with ties going to the lower index, as in boxaGetNearestToPt().
+ *
+ *    Boxes with w < 1 or h < 1 are never returned by the intersection
+ *    and containment queries, but they are found by boxindexGetNearest().
+ */
+
+#include <string.h>
+#include <math.h>
+#include "allheaders.h"
+
+    /* Upper limit on the number of cells in the grid */
+static const l_float64  MAX_BOXINDEX_CELLS = 100000000.;
+
+static l_int32 boxindexGetCellRange(L_BOXINDEX *bi, l_int32 left,
+                                    l_int32 top, l_int32 right, l_int32 bot,
+                                    l_int32 *px0, l_int32 *py0,
+                                    l_int32 *px1, l_int32 *py1);
+static l_int32 boxindexNextStamp(L_BOXINDEX *bi);
+
+
+/*--------------------------------------------------------------------------*
+ *                        L_BoxIndex create/destroy                         *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  boxindexCreate()
+ *
+ *      Input:  boxa
+ *              cellsize (width and height of grid cells; use 0 for default)
+ *      Return: boxindex, or null on error
+ *
+ *  Notes:
+ *      (1) The geometry of each box is copied, so the boxa can be
+ *          destroyed after the index is made.
+ *      (2) The default cell size is usually best.  Use a larger
+ *          @cellsize if most queries are for large regions, and a
+ *          smaller one if most queries are for small regions.
+ */
+L_BOXINDEX *
+boxindexCreate(BOXA    *boxa,
+               l_int32  cellsize)
+{
+l_int32      i, n, x, y, w, h, nx, ny, ncells, nitems, sumdim, nvalid;
+l_int32      ix, iy, x0, y0, x1, y1, xmin, ymin, xmax, ymax, cell;
+l_int32     *pos;
+l_float64    size;
+L_BOXINDEX  *bi;
+
+    PROCNAME("boxindexCreate");
+
+    if (!boxa)
+        return (L_BOXINDEX *)ERROR_PTR("boxa not defined", procName, NULL);
+    if (cellsize < 0)
+        return (L_BOXINDEX *)ERROR_PTR("cellsize < 0", procName, NULL);
+
+    if ((bi = (L_BOXINDEX *)CALLOC(1, sizeof(L_BOXINDEX))) == NULL)
+        return (L_BOXINDEX *)ERROR_PTR("bi not made", procName, NULL);
+    n = boxaGetCount(boxa);
+    bi->n = n;
+    bi->left = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32));
+    bi->top = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32));
+    bi->right = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32));
+    bi->bot = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32));
+    bi->cx = (l_float32 *)CALLOC(L_MAX(n, 1), sizeof(l_float32));
+    bi->cy = (l_float32 *)CALLOC(L_MAX(n, 1), sizeof(l_float32));
+    bi->mark = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32));
+    if (!bi->left || !bi->top || !bi->right || !bi->bot ||
+        !bi->cx || !bi->cy || !bi->mark) {
+        boxindexDestroy(&bi);
+        return (L_BOXINDEX *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+
+        /* Copy the geometry and find the extent of all boxes */
+    xmin = ymin = 0x7fffffff;
+    xmax = ymax = -0x7fffffff;
+    sumdim = nvalid = 0;
+    for (i = 0; i < n; i++) {
+        boxaGetBoxGeometry(boxa, i, &x, &y, &w, &h);
+        bi->left[i] = x;
+        bi->top[i] = y;
+        bi->right[i] = x + w - 1;
+        bi->bot[i] = y + h - 1;
+        bi->cx[i] = (l_float32)(x + 0.5 * w);
+        bi->cy[i] = (l_float32)(y + 0.5 * h);
+        xmin = L_MIN(xmin, x);
+        ymin = L_MIN(ymin, y);
+        xmax = L_MAX(xmax, L_MAX(x, x + w - 1));
+        ymax = L_MAX(ymax, L_MAX(y, y + h - 1));
+        if (w > 0 && h > 0) {
+            sumdim += L_MAX(w, h);
+            nvalid++;
+        }
+    }
+    if (n == 0)
+        xmin = ymin = xmax = ymax = 0;
+
+        /* Choose the cell size and make the grid */
+    if (cellsize == 0) {
+        size = sqrt((l_float64)(xmax - xmin + 1) * (ymax - ymin + 1) /
+                    L_MAX(n, 1));
+        if (nvalid > 0)
+            size = L_MAX(size, (l_float64)sumdim / nvalid);
+        cellsize = L_MAX(1, (l_int32)(size + 0.5));
+    }
+    nx = (xmax - xmin) / cellsize + 1;
+    ny = (ymax - ymin) / cellsize + 1;
+    if ((l_float64)nx * ny > MAX_BOXINDEX_CELLS) {
+        boxindexDestroy(&bi);
+        return (L_BOXINDEX *)ERROR_PTR("too many cells", procName, NULL);
+    }
+    ncells = nx * ny;
+    bi->xorg = xmin;
+    bi->yorg = ymin;
+    bi->cellsize = cellsize;
+    bi->nx = nx;
+    bi->ny = ny;
+    bi->start = (l_int32 *)CALLOC(ncells + 1, sizeof(l_int32));
+    bi->cstart = (l_int32 *)CALLOC(ncells + 1, sizeof(l_int32));
+    pos = (l_int32 *)CALLOC(ncells + 1, sizeof(l_int32));
+    if (!bi->start || !bi->cstart || !pos) {
+        FREE(pos);
+        boxindexDestroy(&bi);
+        return (L_BOXINDEX *)ERROR_PTR("cell arrays not made", procName, NULL);
+    }
+
+        /* Count the boxes in each cell, and the centroids in each cell.
+         * The counts are accumulated into start[cell + 1], so that after
+         * the prefix sum, start[cell] is the offset of the cell list. */
+    for (i = 0; i < n; i++) {
+        if (bi->right[i] >= bi->left[i] && bi->bot[i] >= bi->top[i]) {
+            boxindexGetCellRange(bi, bi->left[i], bi->top[i], bi->right[i],
+                                 bi->bot[i], &x0, &y0, &x1, &y1);
+            for (iy = y0; iy <= y1; iy++) {
+                for (ix = x0; ix <= x1; ix++)
+                    bi->start[iy * nx + ix + 1]++;
+            }
+        }
+        ix = L_MIN(nx - 1, (l_int32)((bi->cx[i] - xmin) / cellsize));
+        iy = L_MIN(ny - 1, (l_int32)((bi->cy[i] - ymin) / cellsize));
+        bi->cstart[iy * nx + ix + 1]++;
+    }
+    for (cell = 0; cell < ncells; cell++) {
+        bi->start[cell + 1] += bi->start[cell];
+        bi->cstart[cell + 1] += bi->cstart[cell];
+    }
+    nitems = bi->start[ncells];
+    bi->items = (l_int32 *)CALLOC(L_MAX(nitems, 1), sizeof(l_int32));
+    bi->citems = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32));
+    if (!bi->items || !bi->citems) {
+        FREE(pos);
+        boxindexDestroy(&bi);
+        return (L_BOXINDEX *)ERROR_PTR("item arrays not made", procName, NULL);
+    }
+
+        /* Fill the lists; the boxes in each list are in increasing order */
+    memcpy(pos, bi->start, (ncells + 1) * sizeof(l_int32));
+    for (i = 0; i < n; i++) {
+        if (bi->right[i] < bi->left[i] || bi->bot[i] < bi->top[i])
+            continue;
+        boxindexGetCellRange(bi, bi->left[i], bi->top[i], bi->right[i],
+                             bi->bot[i], &x0, &y0, &x1, &y1);
+        for (iy = y0; iy <= y1; iy++) {
+            for (ix = x0; ix <= x1; ix++)
+                bi->items[pos[iy * nx + ix]++] = i;
+        }
+    }
+    memcpy(pos, bi->cstart, (ncells + 1) * sizeof(l_int32));
+    for (i = 0; i < n; i++) {
+        ix = L_MIN(nx - 1, (l_int32)((bi->cx[i] - xmin) / cellsize));
+        iy = L_MIN(ny - 1, (l_int32)((bi->cy[i] - ymin) / cellsize));
+        bi->citems[pos[iy * nx + ix]++] = i;
+    }
+
+    FREE(pos);
+    return bi;
+}
+
+
+/*!
+ *  boxindexDestroy()
+ *
+ *      Input:  &boxindex  (<to be nulled>)
+ *      Return: void
+ */
+void
+boxindexDestroy(L_BOXINDEX  **pbi)
+{
+L_BOXINDEX  *bi;
+
+    PROCNAME("boxindexDestroy");
+
+    if (pbi == NULL) {
+        L_WARNING("ptr address is NULL", procName);
+        return;
+    }
+    if ((bi = *pbi) == NULL)
+        return;
+
+    FREE(bi->left);
+    FREE(bi->top);
+    FREE(bi->right);
+    FREE(bi->bot);
+    FREE(bi->cx);
+    FREE(bi->cy);
+    FREE(bi->start);
+    FREE(bi->items);
+    FREE(bi->cstart);
+    FREE(bi->citems);
+    FREE(bi->mark);
+    FREE(bi);
+    *pbi = NULL;
+    return;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                                Accessors                                 *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  boxindexGetCount()
+ *
+ *      Input:  boxindex
+ *      Return: count (number of boxes in the index), or 0 on error
+ */
+l_int32
+boxindexGetCount(L_BOXINDEX  *bi)
+{
+    PROCNAME("boxindexGetCount");
+
+    if (!bi)
+        return ERROR_INT("bi not defined", procName, 0);
+    return bi->n;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                                 Queries                                  *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  boxindexIntersectsBox()
+ *
+ *      Input:  boxindex
+ *              box (for intersecting)
+ *      Return: na (indices of the boxes that intersect @box, in
+ *                  increasing order), or null on error
+ *
+ *  Notes:
+ *      (1) This finds the same boxes as boxaIntersectsBox(), for any
+ *          @box with w > 0 and h > 0.
+ */
+NUMA *
+boxindexIntersectsBox(L_BOXINDEX  *bi,
+                      BOX         *box)
+{
+l_int32  i, k, ix, iy, x0, y0, x1, y1, stamp, cell;
+l_int32  left, top, right, bot;
+NUMA    *na;
+
+    PROCNAME("boxindexIntersectsBox");
+
+    if (!bi)
+        return (NUMA *)ERROR_PTR("bi not defined", procName, NULL);
+    if (!box)
+        return (NUMA *)ERROR_PTR("box not defined", procName, NULL);
+
+    na = numaCreate(0);
+    boxGetGeometry(box, &left, &top, &right, &bot);
+    right += left - 1;
+    bot += top - 1;
+    if (boxindexGetCellRange(bi, left, top, right, bot, &x0, &y0, &x1, &y1))
+        return na;  /* no overlap with the grid */
+
+    stamp = boxindexNextStamp(bi);
+    for (iy = y0; iy <= y1; iy++) {
+        for (ix = x0; ix <= x1; ix++) {
+            cell = iy * bi->nx + ix;
+            for (k = bi->start[cell]; k < bi->start[cell + 1]; k++) {
+                i = bi->items[k];
+                if (bi->mark[i] == stamp) continue;
+                bi->mark[i] = stamp;
+                if (bi->bot[i] >= top && bot >= bi->top[i] &&
+                    right >= bi->left[i] && bi->right[i] >= left)
+                    numaAddNumber(na, i);
+            }
+        }
+    }
+
+    numaSort(na, na, L_SORT_INCREASING);
+    return na;
+}
+
+
+/*!
+ *  boxindexContainedInBox()
+ *
+ *      Input:  boxindex
+ *              box (for containment)
+ *      Return: na (indices of the boxes that are entirely contained
+ *                  in @box, in increasing order), or null on error
+ *
+ *  Notes:
+ *      (1) This finds the same boxes as boxaContainedInBox(), for any
+ *          @box with w > 0 and h > 0, except that boxes with w < 1
+ *          or h < 1 are not returned.
+ */
+NUMA *
+boxindexContainedInBox(L_BOXINDEX  *bi,
+                       BOX         *box)
+{
+l_int32  i, k, ix, iy, x0, y0, x1, y1, stamp, cell;
+l_int32  left, top, right, bot;
+NUMA    *na;
+
+    PROCNAME("boxindexContainedInBox");
+
+    if (!bi)
+        return (NUMA *)ERROR_PTR("bi not defined", procName, NULL);
+    if (!box)
+        return (NUMA *)ERROR_PTR("box not defined", procName, NULL);
+
+    na = numaCreate(0);
+    boxGetGeometry(box, &left, &top, &right, &bot);
+    right += left - 1;
+    bot += top - 1;
+    if (boxindexGetCellRange(bi, left, top, right, bot, &x0, &y0, &x1, &y1))
+        return na;  /* no overlap with the grid */
+
+    stamp = boxindexNextStamp(bi);
+    for (iy = y0; iy <= y1; iy++) {
+        for (ix = x0; ix <= x1; ix++) {
+            cell = iy * bi->nx + ix;
+            for (k = bi->start[cell]; k < bi->start[cell + 1]; k++) {
+                i = bi->items[k];
+                if (bi->mark[i] == stamp) continue;
+                bi->mark[i] = stamp;
+                if (bi->left[i] >= left && bi->top[i] >= top &&
+                    bi->right[i] <= right && bi->bot[i] <= bot)
+                    numaAddNumber(na, i);
+            }
+        }
+    }
+
+    numaSort(na, na, L_SORT_INCREASING);
+    return na;
+}
+
+
+/*!
+ *  boxindexGetNearest()
+ *
+ *      Input:  boxindex
+ *              x, y (point)
+ *              k (number of boxes to find)
+ *              &nadist (<optional return> squared distances from the
+ *                       point to the centroids of the boxes found)
+ *      Return: na (indices of the @k boxes with centroids closest to
+ *                  the point, in increasing order of distance),
+ *                  or null on error
+ *
+ *  Notes:
+ *      (1) If @k is larger than the number of boxes, all boxes are
+ *          returned.  The first box is the one that is returned by
+ *          boxaGetNearestToPt().
+ *      (2) The cells are visited in square rings of increasing size
+ *          around the cell holding the point.  After ring r, every
+ *          box that has not been seen is at least r * cellsize from
+ *          the point, so the search stops as soon as the k-th best
+ *          distance is smaller than that.
+ */
+NUMA *
+boxindexGetNearest(L_BOXINDEX  *bi,
+                   l_float32    x,
+                   l_float32    y,
+                   l_int32      k,
+                   NUMA       **pnadist)
+{
+l_int32     i, j, m, r, rmax, ix, iy, ix0, iy0, cell, nfound, step;
+l_int32    *bestindex;
+l_float32   delx, dely, dist, bound;
+l_float32  *bestdist;
+NUMA       *na;
+
+    PROCNAME("boxindexGetNearest");
+
+    if (pnadist) *pnadist = NULL;
+    if (!bi)
+        return (NUMA *)ERROR_PTR("bi not defined", procName, NULL);
+    if (k < 1)
+        return (NUMA *)ERROR_PTR("k < 1", procName, NULL);
+    if (bi->n == 0)
+        return (NUMA *)ERROR_PTR("no boxes", procName, NULL);
+    k = L_MIN(k, bi->n);
+
+    bestindex = (l_int32 *)CALLOC(k, sizeof(l_int32));
+    bestdist = (l_float32 *)CALLOC(k, sizeof(l_float32));
+    if (!bestindex || !bestdist) {
+        FREE(bestindex);
+        FREE(bestdist);
+        return (NUMA *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+
+        /* Cell holding the point, clipped to the grid */
+    ix0 = (l_int32)floor((x - bi->xorg) / bi->cellsize);
+    iy0 = (l_int32)floor((y - bi->yorg) / bi->cellsize);
+    ix0 = L_MAX(0, L_MIN(bi->nx - 1, ix0));
+    iy0 = L_MAX(0, L_MIN(bi->ny - 1, iy0));
+    rmax = L_MAX(L_MAX(ix0, bi->nx - 1 - ix0), L_MAX(iy0, bi->ny - 1 - iy0));
+
+    nfound = 0;
+    for (r = 0; r <= rmax; r++) {
+        for (iy = iy0 - r; iy <= iy0 + r; iy++) {
+            if (iy < 0 || iy >= bi->ny) continue;
+                /* Visit the full row at the top and bottom of the ring,
+                 * and only the two end cells of the other rows */
+            step = (iy == iy0 - r || iy == iy0 + r) ? 1 : L_MAX(1, 2 * r);
+            for (ix = ix0 - r; ix <= ix0 + r; ix += step) {
+                if (ix < 0 || ix >= bi->nx) continue;
+                cell = iy * bi->nx + ix;
+                for (m = bi->cstart[cell]; m < bi->cstart[cell + 1]; m++) {
+                    i = bi->citems[m];
+                    delx = bi->cx[i] - x;
+                    dely = bi->cy[i] - y;
+                    dist = delx * delx + dely * dely;
+                    if (nfound == k &&
+                        (dist > bestdist[k - 1] ||
+                         (dist == bestdist[k - 1] && i > bestindex[k - 1])))
+                        continue;
+                        /* Insert in order of (dist, index) */
+                    j = (nfound < k) ? nfound++ : k - 1;
+                    for ( ; j > 0; j--) {
+                        if (bestdist[j - 1] < dist ||
+                            (bestdist[j - 1] == dist && bestindex[j - 1] < i))
+                            break;
+                        bestdist[j] = bestdist[j - 1];
+                        bestindex[j] = bestindex[j - 1];
+                    }
+                    bestdist[j] = dist;
+                    bestindex[j] = i;
+                }
+            }
+        }
+        bound = (l_float32)r * bi->cellsize;
+        if (nfound == k && bestdist[k - 1] < bound * bound)
+            break;
+    }
+
+    na = numaCreate(k);
+    if (pnadist) *pnadist = numaCreate(k);
+    for (j = 0; j < nfound; j++) {
+        numaAddNumber(na, bestindex[j]);
+        if (pnadist) numaAddNumber(*pnadist, bestdist[j]);
+    }
+
+    FREE(bestindex);
+    FREE(bestdist);
+    return na;
+}
+
+
+/*!
+ *  boxindexGetCellRange()
+ *
+ *      Input:  boxindex
+ *              left, top, right, bot (region, including all four sides)
+ *              &x0, &y0, &x1, &y1 (<return> range of cells, inclusive,
+ *                                  that the region overlaps)
+ *      Return: 0 if the region overlaps the grid, 1 if it doesn't
+ */
+static l_int32
+boxindexGetCellRange(L_BOXINDEX  *bi,
+                     l_int32      left,
+                     l_int32      top,
+                     l_int32      right,
+                     l_int32      bot,
+                     l_int32     *px0,
+                     l_int32     *py0,
+                     l_int32     *px1,
+                     l_int32     *py1)
+{
+l_int32  xend, yend;
+
+    xend = bi->xorg + bi->nx * bi->cellsize - 1;
+    yend = bi->yorg + bi->ny * bi->cellsize - 1;
+    if (right < left || bot < top || right < bi->xorg || bot < bi->yorg ||
+        left > xend || top > yend)
+        return 1;
+    left = L_MAX(left, bi->xorg);
+    top = L_MAX(top, bi->yorg);
+    right = L_MIN(right, xend);
+    bot = L_MIN(bot, yend);
+    *px0 = (left - bi->xorg) / bi->cellsize;
+    *py0 = (top - bi->yorg) / bi->cellsize;
+    *px1 = (right - bi->xorg) / bi->cellsize;
+    *py1 = (bot - bi->yorg) / bi->cellsize;
+    return 0;
+}
+
+
+/*!
+ *  boxindexNextStamp()
+ *
+ *      Input:  boxindex
+ *      Return: stamp (new value for marking the boxes seen in a query)
+ */
+static l_int32
+boxindexNextStamp(L_BOXINDEX  *bi)
+{
+    if (bi->stamp == 0x7fffffff) {  /* start over */
+        memset(bi->mark, 0, L_MAX(bi->n, 1) * sizeof(l_int32));
+        bi->stamp = 0;
+    }
+    return ++bi->stamp;
+}
@@ -0,0 +1,80 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ - 
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+#ifndef  LEPTONICA_BOXINDEX_H
+#define  LEPTONICA_BOXINDEX_H
+
+/*
+ *  boxindex.h
+ *
+ *      Uniform grid spatial index over the boxes in a boxa.
+ *
+ *      The L_BoxIndex is made once from a boxa, and then answers
+ *      many queries for the boxes that intersect, or are contained
+ *      in, a given box, and for the k boxes whose centroids are
+ *      nearest to a given point.  The geometry of the boxes is
+ *      copied when the index is made, so later changes to the boxa
+ *      are not seen by the index.
+ *
+ *      The plane covered by the boxes is divided into square cells.
+ *      Each cell has a list of the boxes that overlap it, and a list
+ *      of the boxes whose centroid lies in it.  The lists are stored
+ *      contiguously: the boxes for cell i are in
+ *          items[start[i]] ... items[start[i + 1] - 1]
+ *      and likewise for centroids with cstart[] and citems[].
+ *
+ *      Because a box can be in several cells, each query marks the
+ *      boxes it has already seen with a stamp that is changed for
+ *      every query, so no clearing is needed between queries.
+ *
+ *      For further implementation details, see boxindex.c.
+ */
+
+struct L_BoxIndex
+{
+    l_int32          n;          /* number of boxes in the index           */
+    l_int32          xorg;       /* UL corner of the grid                  */
+    l_int32          yorg;
+    l_int32          cellsize;   /* width and height of each cell          */
+    l_int32          nx;         /* number of cells in each row            */
+    l_int32          ny;         /* number of cells in each column         */
+    l_int32         *left;       /* box coords: left, top, right and       */
+    l_int32         *top;        /* bottom are all included in the box;    */
+    l_int32         *right;      /* right < left for an empty box          */
+    l_int32         *bot;
+    l_float32       *cx;         /* box centroids                          */
+    l_float32       *cy;
+    l_int32         *start;      /* offsets into items; nx * ny + 1        */
+    l_int32         *items;      /* box indices, listed by cell            */
+    l_int32         *cstart;     /* offsets into citems; nx * ny + 1       */
+    l_int32         *citems;     /* box indices, listed by centroid cell   */
+    l_int32         *mark;       /* stamp of last query that saw each box  */
+    l_int32          stamp;      /* stamp of the current query             */
+};
+typedef struct L_BoxIndex L_BOXINDEX;
+
+
+#endif  /* LEPTONICA_BOXINDEX_H */
@@ -0,0 +1,369 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ - 
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+/*
+ *   bucketq.c
+ *
+ *      Create/Destroy L_BucketQ
+ *          L_BUCKETQ  *bqueueCreate()
+ *          void        bqueueDestroy()
+ *
+ *      Operations to add/remove to/from a L_BucketQ
+ *          l_int32     bqueueAdd()
+ *          l_int32     bqueueRemove()
+ *          static l_int32  bqueueExtendPool()
+ *
+ *      Accessors
+ *          l_int32     bqueueGetCount()
+ *
+ *      Debug output
+ *          l_int32     bqueuePrint()
+ *
+ *    The bqueue is a priority queue for items with integer priorities
+ *    in a small range, such as the pixel values of an 8 bpp image.
+ *    It has a fifo for each priority value (the "buckets"), and
+ *    items are removed from the first nonempty bucket, in either
+ *    increasing or decreasing order of priority.  This is the
+ *    hierarchical queue that is used for watershed flooding and for
+ *    gray reconstruction.  Compared with the L_Heap, adding and
+ *    removing are O(1) instead of O(log n), items with equal priority
+ *    come out in the order they went in, and the items are held
+ *    by value, so that no allocation is required per item.
+ *
+ *    Internally, the buckets are always indexed so that the lowest
+ *    internal bucket is removed first; for L_SORT_DECREASING,
+ *    priority p is held in bucket (nbuckets - 1 - p).  The index
+ *    @current is a lower bound on the first nonempty bucket.  It
+ *    only decreases when an item is added to a lower bucket, so
+ *    for the typical monotone use (flooding) the total cost of
+ *    scanning the buckets is O(nbuckets).
+ */
+
+#include "allheaders.h"
+
+static const l_int32  INITIAL_POOL_SIZE = 1024;  /* n'importe quoi */
+
+static l_int32 bqueueExtendPool(L_BUCKETQ *bq);
+
+
+/*--------------------------------------------------------------------------*
+ *                        L_BucketQ create/destroy                          *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  bqueueCreate()
+ *
+ *      Input:  nbuckets (number of priority values; priorities are
+ *                        in [0 ... nbuckets - 1])
+ *              direction (L_SORT_INCREASING, L_SORT_DECREASING)
+ *              nalloc (initial size of item pool; use 0 for default)
+ *      Return: bqueue, or null on error
+ *
+ *  Notes:
+ *      (1) With L_SORT_INCREASING, items with the lowest priority
+ *          are removed first.
+ *      (2) The pool grows by doubling as required.  If the maximum
+ *          number of items in the queue is known (e.g., the number
+ *          of pixels in an image), use it for @nalloc.
+ */
+L_BUCKETQ *
+bqueueCreate(l_int32  nbuckets,
+             l_int32  direction,
+             l_int32  nalloc)
+{
+l_int32     i;
+L_BUCKETQ  *bq;
+
+    PROCNAME("bqueueCreate");
+
+    if (nbuckets < 1)
+        return (L_BUCKETQ *)ERROR_PTR("nbuckets < 1", procName, NULL);
+    if (direction != L_SORT_INCREASING && direction != L_SORT_DECREASING)
+        return (L_BUCKETQ *)ERROR_PTR("invalid direction", procName, NULL);
+    if (nalloc <= 0)
+        nalloc = INITIAL_POOL_SIZE;
+
+    if ((bq = (L_BUCKETQ *)CALLOC(1, sizeof(L_BUCKETQ))) == NULL)
+        return (L_BUCKETQ *)ERROR_PTR("bq not made", procName, NULL);
+    bq->head = (l_int32 *)CALLOC(nbuckets, sizeof(l_int32));
+    bq->tail = (l_int32 *)CALLOC(nbuckets, sizeof(l_int32));
+    bq->items = (L_BUCKETQ_ITEM *)CALLOC(nalloc, sizeof(L_BUCKETQ_ITEM));
+    if (!bq->head || !bq->tail || !bq->items) {
+        bqueueDestroy(&bq);
+        return (L_BUCKETQ *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+    for (i = 0; i < nbuckets; i++)
+        bq->head[i] = bq->tail[i] = -1;
+    bq->nbuckets = nbuckets;
+    bq->direction = direction;
+    bq->current = nbuckets;
+    bq->nalloc = nalloc;
+    bq->freelist = -1;
+    return bq;
+}
+
+
+/*!
+ *  bqueueDestroy()
+ *
+ *      Input:  &bqueue  (<to be nulled>)
+ *      Return: void
+ */
+void
+bqueueDestroy(L_BUCKETQ  **pbq)
+{
+L_BUCKETQ  *bq;
+
+    PROCNAME("bqueueDestroy");
+
+    if (pbq == NULL) {
+        L_WARNING("ptr address is NULL", procName);
+        return;
+    }
+    if ((bq = *pbq) == NULL)
+        return;
+
+    if (bq->head) FREE(bq->head);
+    if (bq->tail) FREE(bq->tail);
+    if (bq->items) FREE(bq->items);
+    FREE(bq);
+    *pbq = NULL;
+    return;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                            L_BucketQ operations                          *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  bqueueAdd()
+ *
+ *      Input:  bqueue
+ *              priority (in [0 ... nbuckets - 1])
+ *              x, y (pixel location, or any two integers)
+ *              data (any integer; e.g., a label)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) The item is added to the tail of the fifo for @priority.
+ *          An item is taken from the free list if possible; otherwise
+ *          from the unused part of the pool, which is doubled in size
+ *          when it has all been used.
+ */
+l_int32
+bqueueAdd(L_BUCKETQ  *bq,
+          l_int32     priority,
+          l_int32     x,
+          l_int32     y,
+          l_int32     data)
+{
+l_int32          index, ib;
+L_BUCKETQ_ITEM  *item;
+
+    PROCNAME("bqueueAdd");
+
+    if (!bq)
+        return ERROR_INT("bq not defined", procName, 1);
+    if (priority < 0 || priority >= bq->nbuckets)
+        return ERROR_INT("invalid priority", procName, 1);
+
+    if (bq->freelist >= 0) {
+        index = bq->freelist;
+        bq->freelist = bq->items[index].next;
+    }
+    else {
+        if (bq->nused >= bq->nalloc) {
+            if (bqueueExtendPool(bq))
+                return ERROR_INT("pool not extended", procName, 1);
+        }
+        index = bq->nused++;
+    }
+
+    item = bq->items + index;
+    item->x = x;
+    item->y = y;
+    item->data = data;
+    item->next = -1;
+
+    if (bq->direction == L_SORT_INCREASING)
+        ib = priority;
+    else
+        ib = bq->nbuckets - 1 - priority;
+    if (bq->head[ib] < 0)
+        bq->head[ib] = index;
+    else
+        bq->items[bq->tail[ib]].next = index;
+    bq->tail[ib] = index;
+    if (ib < bq->current)
+        bq->current = ib;
+    bq->nelem++;
+    return 0;
+}
+
+
+/*!
+ *  bqueueRemove()
+ *
+ *      Input:  bqueue
+ *              &priority (<optional return> priority of the item)
+ *              &x, &y (<optional return> pixel location)
+ *              &data (<optional return> user data)
+ *      Return: 0 if OK, 1 if the queue is empty or on error
+ *
+ *  Notes:
+ *      (1) This removes the item at the head of the first nonempty
+ *          bucket, and puts it on the free list for reuse.
+ */
+l_int32
+bqueueRemove(L_BUCKETQ  *bq,
+             l_int32    *ppriority,
+             l_int32    *px,
+             l_int32    *py,
+             l_int32    *pdata)
+{
+l_int32          index, ib;
+L_BUCKETQ_ITEM  *item;
+
+    PROCNAME("bqueueRemove");
+
+    if (!bq)
+        return ERROR_INT("bq not defined", procName, 1);
+    if (bq->nelem == 0)
+        return 1;
+
+    ib = bq->current;
+    while (bq->head[ib] < 0)  /* can't go off the end because nelem > 0 */
+        ib++;
+    bq->current = ib;
+
+    index = bq->head[ib];
+    item = bq->items + index;
+    bq->head[ib] = item->next;
+    if (item->next < 0)
+        bq->tail[ib] = -1;
+    if (ppriority) {
+        if (bq->direction == L_SORT_INCREASING)
+            *ppriority = ib;
+        else
+            *ppriority = bq->nbuckets - 1 - ib;
+    }
+    if (px) *px = item->x;
+    if (py) *py = item->y;
+    if (pdata) *pdata = item->data;
+
+    item->next = bq->freelist;
+    bq->freelist = index;
+    bq->nelem--;
+    return 0;
+}
+
+
+/*!
+ *  bqueueExtendPool()
+ *
+ *      Input:  bqueue
+ *      Return: 0 if OK, 1 on error
+ */
+static l_int32
+bqueueExtendPool(L_BUCKETQ  *bq)
+{
+    PROCNAME("bqueueExtendPool");
+
+    if (!bq)
+        return ERROR_INT("bq not defined", procName, 1);
+
+    if ((bq->items = (L_BUCKETQ_ITEM *)reallocNew((void **)&bq->items,
+                                sizeof(L_BUCKETQ_ITEM) * bq->nalloc,
+                                2 * sizeof(L_BUCKETQ_ITEM) * bq->nalloc))
+            == NULL)
+        return ERROR_INT("new item pool not returned", procName, 1);
+
+    bq->nalloc = 2 * bq->nalloc;
+    return 0;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                                  Accessors                               *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  bqueueGetCount()
+ *
+ *      Input:  bqueue
+ *      Return: count, or 0 on error
+ */
+l_int32
+bqueueGetCount(L_BUCKETQ  *bq)
+{
+    PROCNAME("bqueueGetCount");
+
+    if (!bq)
+        return ERROR_INT("bq not defined", procName, 0);
+
+    return bq->nelem;
+}
+
+
+/*---------------------------------------------------------------------*
+ *                            Debug output                             *
+ *---------------------------------------------------------------------*/
+/*!
+ *  bqueuePrint()
+ *
+ *      Input:  stream
+ *              bqueue
+ *      Return: 0 if OK; 1 on error
+ *
+ *  Notes:
+ *      (1) Prints the number of items in each nonempty bucket.
+ */
+l_int32
+bqueuePrint(FILE       *fp,
+            L_BUCKETQ  *bq)
+{
+l_int32  i, n, index;
+
+    PROCNAME("bqueuePrint");
+
+    if (!fp)
+        return ERROR_INT("stream not defined", procName, 1);
+    if (!bq)
+        return ERROR_INT("bq not defined", procName, 1);
+
+    fprintf(fp, "\n L_BucketQ: nbuckets = %d, nelem = %d, nalloc = %d\n",
+            bq->nbuckets, bq->nelem, bq->nalloc);
+    for (i = 0; i < bq->nbuckets; i++) {
+        n = 0;
+        for (index = bq->head[i]; index >= 0; index = bq->items[index].next)
+            n++;
+        if (n > 0) {
+            fprintf(fp, "priority %d: %d items\n",
+                    (bq->direction == L_SORT_INCREASING) ?
+                    i : bq->nbuckets - 1 - i, n);
+        }
+    }
+
+    return 0;
+}
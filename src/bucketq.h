@@ -0,0 +1,79 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ - 
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+#ifndef  LEPTONICA_BUCKETQ_H
+#define  LEPTONICA_BUCKETQ_H
+
+/*
+ *  bucketq.h
+ *
+ *      Bucket (hierarchical) priority queue for integer priorities.
+ *
+ *      The L_BucketQ holds small fixed-size items, each consisting of
+ *      a pixel location (x, y) and an integer of user data, in one
+ *      of @nbuckets fifo queues indexed by an integer priority in
+ *      [0 ... nbuckets - 1].  Items are removed from the lowest
+ *      (or highest) nonempty bucket, and in fifo order within
+ *      a bucket.  Adding and removing items are both O(1), apart
+ *      from the scan over empty buckets.
+ *
+ *      The items are stored in a single pool array, and are linked
+ *      through the @next field into a list for each bucket.  Items
+ *      that are removed go onto a free list and are reused, so after
+ *      the pool has grown to the largest number of items that are
+ *      simultaneously in the queue, no further allocation is done.
+ *
+ *      For further implementation details, see bucketq.c.
+ */
+
+struct L_BucketQItem
+{
+    l_int32          x;          /* pixel location                         */
+    l_int32          y;
+    l_int32          data;       /* user data; e.g., a label               */
+    l_int32          next;       /* index of next item in the bucket, or   */
+                                 /* in the free list; -1 at the end        */
+};
+typedef struct L_BucketQItem L_BUCKETQ_ITEM;
+
+struct L_BucketQ
+{
+    l_int32          nbuckets;   /* number of priority values              */
+    l_int32          direction;  /* L_SORT_INCREASING or L_SORT_DECREASING */
+    l_int32          current;    /* lowest internal bucket that may be     */
+                                 /* nonempty                               */
+    l_int32          nelem;      /* number of items in the queue           */
+    l_int32          nalloc;     /* size of allocated item pool            */
+    l_int32          nused;      /* number of pool items ever handed out   */
+    l_int32          freelist;   /* first item in the free list; -1 if none */
+    l_int32         *head;       /* first item in each bucket; -1 if empty */
+    l_int32         *tail;       /* last item in each bucket               */
+    L_BUCKETQ_ITEM  *items;      /* item pool                              */
+};
+typedef struct L_BucketQ L_BUCKETQ;
+
+
+#endif  /* LEPTONICA_BUCKETQ_H */
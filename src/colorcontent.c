@@ -53,6 +53,7 @@
  *
  *      Finds the number of unique colors in an image
  *         l_int32    pixNumColors()
+ *         l_int32    pixCountRGBColors()
  *
  *  Color is tricky.  If we consider gray (r = g = b) to have no color
  *  content, how should we define the color content in each component
@@ -909,19 +910,20 @@ PIXCMAP   *cmap;
  *      (3) For d = 2, 4 or 8 bpp grayscale, this returns the number
  *          of colors found in the image in 'ncolors'.
  *      (4) For d = 32 bpp (rgb), if the number of colors is
- *          greater than 256, this returns 0 in 'ncolors'.
+ *          greater than 256, this returns 0 in 'ncolors'.  The colors
+ *          are counted exactly with a hash map; to count more than 256
+ *          colors, use pixCountRGBColors().
  */
 l_int32
 pixNumColors(PIX      *pixs,
              l_int32   factor,
              l_int32  *pncolors)
 {
-l_int32    w, h, d, i, j, wpl, hashsize, sum, count;
-l_int32    rval, gval, bval, val;
-l_int32   *inta;
-l_uint32   pixel;
-l_uint32  *data, *line;
-PIXCMAP   *cmap;
+l_int32     w, h, d, i, j, wpl, sum, count, val;
+l_int32    *inta;
+l_uint32   *data, *line;
+L_HASHMAP  *hmap;
+PIXCMAP    *cmap;
 
     PROCNAME("pixNumColors");
 
@@ -967,26 +969,72 @@ PIXCMAP   *cmap;
     }
 
         /* 32 bpp rgb; quit if we get above 256 colors */
-    hashsize = 5507;  /* big and prime; collisions are not likely */
-    inta = (l_int32 *)CALLOC(hashsize, sizeof(l_int32));
+    if ((hmap = l_hmapCreate(257, L_HMAP_INT_KEY)) == NULL)
+        return ERROR_INT("hmap not made", procName, 1);
     for (i = 0; i < h; i += factor) {
         line = data + i * wpl;
         for (j = 0; j < w; j += factor) {
-            pixel = line[j];
-            extractRGBValues(pixel, &rval, &gval, &bval);
-            val = (137 * rval + 269 * gval + 353 * bval) % hashsize;
-            if (inta[val] == 0) {
-                inta[val] = 1;
-                sum++;
-                if (sum > 256) {
-                    FREE(inta);
-                    return 0;
-                }
+            l_hmapLookup(hmap, line[j] >> 8, L_HMAP_CREATE);  /* rgb */
+            if (l_hmapGetCount(hmap) > 256) {
+                l_hmapDestroy(&hmap);
+                return 0;
             }
         }
     }
 
-    *pncolors = sum;
-    FREE(inta);
+    *pncolors = l_hmapGetCount(hmap);
+    l_hmapDestroy(&hmap);
+    return 0;
+}
+
+
+/*!
+ *  pixCountRGBColors()
+ *      Input:  pixs (32 bpp rgb)
+ *              factor (subsampling factor; integer)
+ *              &ncolors (<return> the number of different rgb colors)
+ *      Return: 0 if OK, 1 on error.
+ *
+ *  Notes:
+ *      (1) Unlike pixNumColors(), this has no limit on the number of
+ *          colors, and it returns the exact number found in the
+ *          sampled pixels.  The alpha byte is ignored.
+ *      (2) The colors are held in a hash map that grows with the
+ *          number of colors, so the time is linear in the number
+ *          of sampled pixels.
+ */
+l_int32
+pixCountRGBColors(PIX      *pixs,
+                  l_int32   factor,
+                  l_int32  *pncolors)
+{
+l_int32     w, h, d, i, j, wpl;
+l_uint32   *data, *line;
+L_HASHMAP  *hmap;
+
+    PROCNAME("pixCountRGBColors");
+
+    if (!pncolors)
+        return ERROR_INT("&ncolors not defined", procName, 1);
+    *pncolors = 0;
+    if (!pixs)
+        return ERROR_INT("pixs not defined", procName, 1);
+    pixGetDimensions(pixs, &w, &h, &d);
+    if (d != 32)
+        return ERROR_INT("pixs not 32 bpp", procName, 1);
+    if (factor < 1) factor = 1;
+
+    if ((hmap = l_hmapCreate(0, L_HMAP_INT_KEY)) == NULL)
+        return ERROR_INT("hmap not made", procName, 1);
+    data = pixGetData(pixs);
+    wpl = pixGetWpl(pixs);
+    for (i = 0; i < h; i += factor) {
+        line = data + i * wpl;
+        for (j = 0; j < w; j += factor)  /* drop the alpha byte */
+            l_hmapLookup(hmap, line[j] >> 8, L_HMAP_CREATE);
+    }
+
+    *pncolors = l_hmapGetCount(hmap);
+    l_hmapDestroy(&hmap);
     return 0;
 }
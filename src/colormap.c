@@ -58,6 +58,11 @@
  *           l_int32     pixcmapGetComponentRange()
  *           l_int32     pixcmapGetExtremeValue()
  *
+ *      Accelerated nearest color search
+ *           L_CMAPNEAR *cmapnearCreate()
+ *           void        cmapnearDestroy()
+ *           l_int32     cmapnearGetIndex()
+ *
  *      Colormap conversion
  *           PIXCMAP    *pixcmapGrayToColor()
  *           PIXCMAP    *pixcmapColorToGray()
@@ -916,6 +921,9 @@ NUMA    *na, *nasort;
  *          index of the color closest to the target color.
  *      (2) Nearest color is that which is the least sum-of-squares distance
  *          from the target color.
+ *      (3) This does a linear scan over the colormap.  For many queries
+ *          on the same colormap, make a L_CMAPNEAR with cmapnearCreate()
+ *          and use cmapnearGetIndex(), which gives the same result.
  */
 l_int32
 pixcmapGetNearestIndex(PIXCMAP  *cmap,
@@ -1124,6 +1132,244 @@ l_int32  i, n, rval, gval, bval, extrval, extgval, extbval;
 }
 
 
+/*-------------------------------------------------------------*
+ *              Accelerated nearest color search               *
+ *-------------------------------------------------------------*/
+/*!
+ *  cmapnearCreate()
+ *
+ *      Input:  cmap
+ *              level (octcube level of the cell grid, in {1 ... 5};
+ *                     use 0 for the default, which is 4)
+ *              metric (L_MANHATTAN_DISTANCE, L_EUCLIDEAN_DISTANCE)
+ *      Return: cmapnear, or null on error
+ *
+ *  Notes:
+ *      (1) This is used when many nearest color queries are made
+ *          on the same colormap.  Color space is divided into
+ *          2^(3 * level) cubical cells.  For each cell, we find the
+ *          smallest, over all colors, of the largest distance from
+ *          the color to any point in the cell.  The only colors that
+ *          can be nearest to a point in the cell are those whose
+ *          smallest distance to the cell does not exceed this value;
+ *          all others are strictly farther away from every point
+ *          in the cell than at least one color.  These candidates
+ *          are stored, in increasing index order, for each cell.
+ *      (2) A query then scans only the candidates for the cell
+ *          containing the color.  The result is identical to a
+ *          linear scan over the colormap, including breaking ties
+ *          in favor of the lowest index, so it can be substituted
+ *          for pixcmapGetNearestIndex() (with L_EUCLIDEAN_DISTANCE).
+ *      (3) For a well-distributed colormap the number of candidates
+ *          in a cell is small and nearly independent of the colormap
+ *          size.  The setup cost is proportional to the product of
+ *          the number of cells and the number of colors.
+ *      (4) The colors are copied, so this must be rebuilt if the
+ *          colormap is changed.
+ */
+L_CMAPNEAR *
+cmapnearCreate(PIXCMAP  *cmap,
+               l_int32   level,
+               l_int32   metric)
+{
+l_int32      i, k, rc, gc, bc, ncolors, ncells, csize, ncands, nalloc;
+l_int32      lo[3], hi[3], cval[3], mind, maxd, minmaxd, dmin, dmax, m;
+l_int32     *mindist, *cands;
+L_CMAPNEAR  *cn;
+
+    PROCNAME("cmapnearCreate");
+
+    if (!cmap)
+        return (L_CMAPNEAR *)ERROR_PTR("cmap not defined", procName, NULL);
+    if (level == 0)
+        level = 4;
+    if (level < 1 || level > 5)
+        return (L_CMAPNEAR *)ERROR_PTR("level not in {1...5}",
+                                       procName, NULL);
+    if (metric != L_MANHATTAN_DISTANCE && metric != L_EUCLIDEAN_DISTANCE)
+        return (L_CMAPNEAR *)ERROR_PTR("invalid metric", procName, NULL);
+    if ((ncolors = pixcmapGetCount(cmap)) == 0)
+        return (L_CMAPNEAR *)ERROR_PTR("no colors in cmap", procName, NULL);
+
+    if ((cn = (L_CMAPNEAR *)CALLOC(1, sizeof(L_CMAPNEAR))) == NULL)
+        return (L_CMAPNEAR *)ERROR_PTR("cn not made", procName, NULL);
+    cn->metric = metric;
+    cn->level = level;
+    cn->ncolors = ncolors;
+    pixcmapToArrays(cmap, &cn->rmap, &cn->gmap, &cn->bmap);
+    ncells = 1 << (3 * level);
+    csize = 256 >> level;
+    nalloc = 2 * ncells;
+    mindist = (l_int32 *)CALLOC(ncolors, sizeof(l_int32));
+    cn->cellstart = (l_int32 *)CALLOC(ncells + 1, sizeof(l_int32));
+    cn->cands = (l_int32 *)CALLOC(nalloc, sizeof(l_int32));
+    if (!cn->rmap || !mindist || !cn->cellstart || !cn->cands) {
+        FREE(mindist);
+        cmapnearDestroy(&cn);
+        return (L_CMAPNEAR *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+
+    ncands = 0;
+    for (i = 0; i < ncells; i++) {
+        rc = i >> (2 * level);
+        gc = (i >> level) & ((1 << level) - 1);
+        bc = i & ((1 << level) - 1);
+        lo[0] = rc * csize;
+        lo[1] = gc * csize;
+        lo[2] = bc * csize;
+        for (m = 0; m < 3; m++)
+            hi[m] = lo[m] + csize - 1;
+
+            /* Get the smallest and largest distance from each color
+             * to the cell, and the smallest of the largest distances */
+        minmaxd = 0x7fffffff;
+        for (k = 0; k < ncolors; k++) {
+            cval[0] = cn->rmap[k];
+            cval[1] = cn->gmap[k];
+            cval[2] = cn->bmap[k];
+            mind = maxd = 0;
+            for (m = 0; m < 3; m++) {
+                if (cval[m] < lo[m])
+                    dmin = lo[m] - cval[m];
+                else if (cval[m] > hi[m])
+                    dmin = cval[m] - hi[m];
+                else
+                    dmin = 0;
+                dmax = L_MAX(L_ABS(cval[m] - lo[m]), L_ABS(cval[m] - hi[m]));
+                if (metric == L_MANHATTAN_DISTANCE) {
+                    mind += dmin;
+                    maxd += dmax;
+                }
+                else {  /* L_EUCLIDEAN_DISTANCE */
+                    mind += dmin * dmin;
+                    maxd += dmax * dmax;
+                }
+            }
+            mindist[k] = mind;
+            if (maxd < minmaxd)
+                minmaxd = maxd;
+        }
+
+            /* Save the candidates */
+        cn->cellstart[i] = ncands;
+        for (k = 0; k < ncolors; k++) {
+            if (mindist[k] > minmaxd)
+                continue;
+            if (ncands >= nalloc) {
+                cands = (l_int32 *)reallocNew((void **)&cn->cands,
+                                              sizeof(l_int32) * nalloc,
+                                              2 * sizeof(l_int32) * nalloc);
+                if (!cands) {
+                    FREE(mindist);
+                    cmapnearDestroy(&cn);
+                    return (L_CMAPNEAR *)ERROR_PTR("cands not extended",
+                                                   procName, NULL);
+                }
+                cn->cands = cands;
+                nalloc *= 2;
+            }
+            cn->cands[ncands++] = k;
+        }
+    }
+    cn->cellstart[ncells] = ncands;
+
+    FREE(mindist);
+    return cn;
+}
+
+
+/*!
+ *  cmapnearDestroy()
+ *
+ *      Input:  &cn (<to be nulled>)
+ *      Return: void
+ */
+void
+cmapnearDestroy(L_CMAPNEAR  **pcn)
+{
+L_CMAPNEAR  *cn;
+
+    PROCNAME("cmapnearDestroy");
+
+    if (pcn == NULL) {
+        L_WARNING("ptr address is null!", procName);
+        return;
+    }
+    if ((cn = *pcn) == NULL)
+        return;
+
+    if (cn->rmap) FREE(cn->rmap);
+    if (cn->gmap) FREE(cn->gmap);
+    if (cn->bmap) FREE(cn->bmap);
+    if (cn->cellstart) FREE(cn->cellstart);
+    if (cn->cands) FREE(cn->cands);
+    FREE(cn);
+    *pcn = NULL;
+    return;
+}
+
+
+/*!
+ *  cmapnearGetIndex()
+ *
+ *      Input:  cn
+ *              rval, gval, bval (color to search for; each number
+ *                                is in range [0, ... 255])
+ *              &index (<return> the index of the nearest color)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) Returns the lowest index of the colors at the least
+ *          distance from the target color, using the metric
+ *          with which @cn was made.
+ */
+l_int32
+cmapnearGetIndex(L_CMAPNEAR  *cn,
+                 l_int32      rval,
+                 l_int32      gval,
+                 l_int32      bval,
+                 l_int32     *pindex)
+{
+l_int32   i, k, shift, cell, dr, dg, db, dist, mindist;
+l_int32  *cands;
+
+    PROCNAME("cmapnearGetIndex");
+
+    if (!pindex)
+        return ERROR_INT("&index not defined", procName, 1);
+    *pindex = UNDEF;
+    if (!cn)
+        return ERROR_INT("cn not defined", procName, 1);
+    if (rval < 0 || rval > 255 || gval < 0 || gval > 255 ||
+        bval < 0 || bval > 255)
+        return ERROR_INT("color component not in [0 ... 255]", procName, 1);
+
+    shift = 8 - cn->level;
+    cell = ((rval >> shift) << (2 * cn->level)) |
+           ((gval >> shift) << cn->level) | (bval >> shift);
+    cands = cn->cands;
+    mindist = 0x7fffffff;
+    for (i = cn->cellstart[cell]; i < cn->cellstart[cell + 1]; i++) {
+        k = cands[i];
+        dr = rval - cn->rmap[k];
+        dg = gval - cn->gmap[k];
+        db = bval - cn->bmap[k];
+        if (cn->metric == L_MANHATTAN_DISTANCE)
+            dist = L_ABS(dr) + L_ABS(dg) + L_ABS(db);
+        else  /* L_EUCLIDEAN_DISTANCE */
+            dist = dr * dr + dg * dg + db * db;
+        if (dist < mindist) {
+            *pindex = k;
+            if (dist == 0)
+                break;
+            mindist = dist;
+        }
+    }
+
+    return 0;
+}
+
+
 /*-------------------------------------------------------------*
  *                       Colormap conversion                   *
  *-------------------------------------------------------------*/
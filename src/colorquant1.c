@@ -3762,15 +3762,24 @@ NUMA       *na;
  *          level = 5 is slightly better.  When this function is used
  *          for color segmentation, there are typically a small number
  *          of colors and the number of levels can be small (e.g., level = 3).
+ *      (6) For level 5 and 6, the nearest color for each octcube center
+ *          is found with a L_CMAPNEAR accelerator, which scans only the
+ *          few colors that can be nearest within a region of color
+ *          space.  It is built at level 3, because its setup time is
+ *          proportional to the number of its cells times the number
+ *          of colors.  For smaller levels, a linear scan over the
+ *          colormap is faster than building the accelerator.  Either
+ *          way, the table is the same.
  */
 l_int32 *
 pixcmapToOctcubeLUT(PIXCMAP  *cmap,
                     l_int32   level,
                     l_int32   metric)
 {
-l_int32    i, k, size, ncolors, mindist, dist, mincolor, index;
-l_int32    rval, gval, bval;  /* color at center of the octcube */
-l_int32   *rmap, *gmap, *bmap, *tab;
+l_int32      i, k, size, ncolors, mindist, dist, mincolor, index;
+l_int32      rval, gval, bval;  /* color at center of the octcube */
+l_int32     *rmap, *gmap, *bmap, *tab;
+L_CMAPNEAR  *cn;
 
     PROCNAME("pixcmapToOctcubeLUT");
 
@@ -3786,30 +3795,45 @@ l_int32   *rmap, *gmap, *bmap, *tab;
     if ((tab = (l_int32 *)CALLOC(size, sizeof(l_int32))) == NULL)
         return (l_int32 *)ERROR_PTR("tab not allocated", procName, NULL);
 
-    ncolors = pixcmapGetCount(cmap);
-    pixcmapToArrays(cmap, &rmap, &gmap, &bmap);
-
-        /* Assign based on the closest octcube center to the cmap color */
-    for (i = 0; i < size; i++) {
-        getRGBFromOctcube(i, level, &rval, &gval, &bval);
-        mindist = 1000000;
-        mincolor = 0;  /* irrelevant init */
-        for (k = 0; k < ncolors; k++) {
-            if (metric == L_MANHATTAN_DISTANCE) {
-                dist = L_ABS(rval - rmap[k]) + L_ABS(gval - gmap[k]) +
-                       L_ABS(bval - bmap[k]);
-            }
-            else {  /* L_EUCLIDEAN_DISTANCE */
-                dist = (rval - rmap[k]) * (rval - rmap[k]) +
-                       (gval - gmap[k]) * (gval - gmap[k]) +
-                       (bval - bmap[k]) * (bval - bmap[k]);
-            }
-            if (dist < mindist) {
-                mindist = dist;
-                mincolor = k;
+        /* Assign based on the closest cmap color to the octcube center */
+    if (level >= 5) {
+        if ((cn = cmapnearCreate(cmap, 3, metric)) == NULL) {
+            FREE(tab);
+            return (l_int32 *)ERROR_PTR("cn not made", procName, NULL);
+        }
+        for (i = 0; i < size; i++) {
+            getRGBFromOctcube(i, level, &rval, &gval, &bval);
+            cmapnearGetIndex(cn, rval, gval, bval, &tab[i]);
+        }
+        cmapnearDestroy(&cn);
+    }
+    else {
+        ncolors = pixcmapGetCount(cmap);
+        pixcmapToArrays(cmap, &rmap, &gmap, &bmap);
+        for (i = 0; i < size; i++) {
+            getRGBFromOctcube(i, level, &rval, &gval, &bval);
+            mindist = 1000000;
+            mincolor = 0;  /* irrelevant init */
+            for (k = 0; k < ncolors; k++) {
+                if (metric == L_MANHATTAN_DISTANCE) {
+                    dist = L_ABS(rval - rmap[k]) + L_ABS(gval - gmap[k]) +
+                           L_ABS(bval - bmap[k]);
+                }
+                else {  /* L_EUCLIDEAN_DISTANCE */
+                    dist = (rval - rmap[k]) * (rval - rmap[k]) +
+                           (gval - gmap[k]) * (gval - gmap[k]) +
+                           (bval - bmap[k]) * (bval - bmap[k]);
+                }
+                if (dist < mindist) {
+                    mindist = dist;
+                    mincolor = k;
+                }
             }
+            tab[i] = mincolor;
         }
-        tab[i] = mincolor;
+        FREE(rmap);
+        FREE(gmap);
+        FREE(bmap);
     }
 
         /* Reset black and white if available in the colormap.
@@ -3826,9 +3850,6 @@ l_int32   *rmap, *gmap, *bmap, *tab;
         tab[(1 << (3 * level)) - 1] = index;
     }
 
-    FREE(rmap);
-    FREE(gmap);
-    FREE(bmap);
     return tab;
 }
 
@@ -61,6 +61,18 @@
     /* Small enough to consider equal to 0.0, for plot output */
 static const l_float32  TINY = 0.00001;
 
+static l_int32 pixTestDiffZeroLow(PIX *pix1, PIX *pix2, l_int32 comptype,
+                                  l_int32 *psame);
+static void pixGetDiffHistoLow(PIX *pix1, PIX *pix2, l_int32 factor,
+                               l_int32 *hist1, l_int32 *hist2,
+                               l_int32 *hist3, l_int32 *histmax,
+                               l_int32 *pnpix);
+static void diffHistoGetStats(l_int32 *hist, l_int32 maxval, l_int32 npix,
+                              l_int32 comptype, l_int32 *psame,
+                              l_float32 *pdiff, l_float32 *prmsdiff);
+static NUMA *diffHistoToNuma(l_int32 *hist, l_int32 maxval,
+                             l_int32 comptype);
+
 
 /*------------------------------------------------------------------*
  *                        Test for pix equality                     *
@@ -93,6 +105,8 @@ static const l_float32  TINY = 0.00001;
  *          of the RGBA pixel)
  *      (6) For images without colormaps that are not 32 bpp, all bits
  *          in the image part of the data array must be identical.
+ *      (7) The raster lines are compared with memcmp(), and the
+ *          function returns at the first line that differs.
  */
 l_int32
 pixEqual(PIX      *pix1,
@@ -212,6 +226,8 @@ PIXCMAP   *cmap1, *cmap2;
         for (i = 0; i < h1; i++) {
             line1 = data1 + wpl1 * i;
             line2 = data2 + wpl2 * i;
+            if (!memcmp(line1, line2, 4 * wpl1))  /* fast check on all bits */
+                continue;
             for (j = 0; j < wpl1; j++) {
                 if ((*line1 ^ *line2) & 0xffffff00) {
                     pixDestroy(&pixt1);
@@ -231,15 +247,13 @@ PIXCMAP   *cmap1, *cmap2;
         for (i = 0; i < h1; i++) {
             line1 = data1 + wpl1 * i;
             line2 = data2 + wpl2 * i;
-            for (j = 0; j < fullwords; j++) {
-                if (*line1 ^ *line2) {
-                    pixDestroy(&pixt1);
-                    pixDestroy(&pixt2);
-                    return 0;
-                }
-                line1++;
-                line2++;
+            if (memcmp(line1, line2, 4 * fullwords)) {
+                pixDestroy(&pixt1);
+                pixDestroy(&pixt2);
+                return 0;
             }
+            line1 += fullwords;
+            line2 += fullwords;
             if (endbits) {
                 if ((*line1 ^ *line2) & endmask) {
                     pixDestroy(&pixt1);
@@ -346,12 +360,10 @@ PIXCMAP   *cmap1, *cmap2;
         for (i = 0; i < h; i++) {
             line1 = data1 + wpl1 * i;
             line2 = data2 + wpl2 * i;
-            for (j = 0; j < fullwords; j++) {
-                if (*line1 ^ *line2)
-                    return 0;
-                line1++;
-                line2++;
-            }
+            if (memcmp(line1, line2, 4 * fullwords))
+                return 0;
+            line1 += fullwords;
+            line2 += fullwords;
             if (endbits) {
                 if ((*line1 ^ *line2) & endmask)
                     return 0;
@@ -635,6 +647,11 @@ PIX      *pixt;
  *      (9) The RMS difference is optionally returned in the
  *          parameter 'rmsdiff'.  For RGB, we return the average of
  *          the RMS differences for each of the components.
+ *      (10) All statistics are computed in a single pass over the two
+ *          images, from a histogram of the signed pixel difference.
+ *          A difference image is only made if @pixdiff is requested.
+ *          If only @same is requested, the test stops at the first
+ *          pixel that differs.
  */
 l_int32
 pixCompareGrayOrRGB(PIX        *pix1,
@@ -713,10 +730,11 @@ pixCompareGray(PIX        *pix1,
                l_float32  *prmsdiff,
                PIX       **ppixdiff)
 {
-l_int32  d1, d2, first, last;
-GPLOT   *gplot;
-NUMA    *na, *nac;
-PIX     *pixt;
+l_int32   d1, d2, maxval, npix, first, last;
+l_int32  *hist;
+GPLOT    *gplot;
+NUMA     *na, *nac;
+PIX      *pixt;
 
     PROCNAME("pixCompareGray");
 
@@ -739,19 +757,20 @@ PIX     *pixt;
     if (plottype > NUM_GPLOT_OUTPUTS)
         return ERROR_INT("invalid plottype", procName, 1);
 
-    if (comptype == L_COMPARE_SUBTRACT)
-        pixt = pixSubtractGray(NULL, pix1, pix2);
-    else  /* comptype == L_COMPARE_ABS_DIFF) */
-        pixt = pixAbsDifference(pix1, pix2);
-
-    if (psame)
-        pixZero(pixt, psame);
+        /* If only equality is requested, quit at the first difference */
+    if (psame && !pdiff && !prmsdiff && !plottype && !ppixdiff)
+        return pixTestDiffZeroLow(pix1, pix2, comptype, psame);
 
-    if (pdiff)
-        pixGetAverageMasked(pixt, NULL, 0, 0, 1, L_MEAN_ABSVAL, pdiff);
+        /* Otherwise, everything is derived from a single histogram
+         * of the signed pixel difference, made in one pass */
+    maxval = (d1 == 8) ? 0xff : 0xffff;
+    if ((hist = (l_int32 *)CALLOC(2 * maxval + 1, sizeof(l_int32))) == NULL)
+        return ERROR_INT("hist not made", procName, 1);
+    pixGetDiffHistoLow(pix1, pix2, 1, hist, NULL, NULL, NULL, &npix);
+    diffHistoGetStats(hist, maxval, npix, comptype, psame, pdiff, prmsdiff);
 
     if (plottype) {
-        na = pixGetGrayHistogram(pixt, 1);
+        na = diffHistoToNuma(hist, maxval, comptype);
         numaGetNonzeroRange(na, TINY, &first, &last);
         nac = numaClipToInterval(na, 0, last);
         gplot = gplotCreate("/tmp/grayroot", plottype,
@@ -764,18 +783,15 @@ PIX     *pixt;
         numaDestroy(&nac);
     }
 
-    if (ppixdiff)
-        *ppixdiff = pixCopy(NULL, pixt);
-
-    if (prmsdiff) {
-        if (comptype == L_COMPARE_SUBTRACT) {  /* wrong type for rms diff */
-            pixDestroy(&pixt);
+    if (ppixdiff) {
+        if (comptype == L_COMPARE_SUBTRACT)
+            pixt = pixSubtractGray(NULL, pix1, pix2);
+        else  /* comptype == L_COMPARE_ABS_DIFF) */
             pixt = pixAbsDifference(pix1, pix2);
-        }
-        pixGetAverageMasked(pixt, NULL, 0, 0, 1, L_ROOT_MEAN_SQUARE, prmsdiff);
+        *ppixdiff = pixt;
     }
 
-    pixDestroy(&pixt);
+    FREE(hist);
     return 0;
 }
 
@@ -806,14 +822,18 @@ pixCompareRGB(PIX        *pix1,
               l_float32  *prmsdiff,
               PIX       **ppixdiff)
 {
-l_int32    rsame, gsame, bsame, first, rlast, glast, blast, last;
-l_float32  rdiff, gdiff, bdiff;
+l_int32    i, npix, rsame, gsame, bsame, first, rlast, glast, blast, last;
+l_int32   *hist[3];
+l_float32  rdiff, gdiff, bdiff, rrms, grms, brms;
 GPLOT     *gplot;
 NUMA      *nar, *nag, *nab, *narc, *nagc, *nabc;
 PIX       *pixr1, *pixr2, *pixg1, *pixg2, *pixb1, *pixb2, *pixr, *pixg, *pixb;
 
     PROCNAME("pixCompareRGB");
 
+    if (psame) *psame = 0;
+    if (pdiff) *pdiff = 0.0;
+    if (prmsdiff) *prmsdiff = 0.0;
     if (ppixdiff) *ppixdiff = NULL;
     if (!pix1 || pixGetDepth(pix1) != 32)
         return ERROR_INT("pix1 not defined or not 32 bpp", procName, 1);
@@ -824,44 +844,34 @@ PIX       *pixr1, *pixr2, *pixg1, *pixg2, *pixb1, *pixb2, *pixr, *pixg, *pixb;
     if (plottype > NUM_GPLOT_OUTPUTS)
         return ERROR_INT("invalid plottype", procName, 1);
 
-    pixr1 = pixGetRGBComponent(pix1, COLOR_RED);
-    pixr2 = pixGetRGBComponent(pix2, COLOR_RED);
-    pixg1 = pixGetRGBComponent(pix1, COLOR_GREEN);
-    pixg2 = pixGetRGBComponent(pix2, COLOR_GREEN);
-    pixb1 = pixGetRGBComponent(pix1, COLOR_BLUE);
-    pixb2 = pixGetRGBComponent(pix2, COLOR_BLUE);
-    if (comptype == L_COMPARE_SUBTRACT) {
-        pixr = pixSubtractGray(NULL, pixr1, pixr2);
-        pixg = pixSubtractGray(NULL, pixg1, pixg2);
-        pixb = pixSubtractGray(NULL, pixb1, pixb2);
-    }
-    else  { /* comptype == L_COMPARE_ABS_DIFF) */
-        pixr = pixAbsDifference(pixr1, pixr2);
-        pixg = pixAbsDifference(pixg1, pixg2);
-        pixb = pixAbsDifference(pixb1, pixb2);
-    }
+        /* If only equality is requested, quit at the first difference */
+    if (psame && !pdiff && !prmsdiff && !plottype && !ppixdiff)
+        return pixTestDiffZeroLow(pix1, pix2, comptype, psame);
 
-    if (psame) {
-        pixZero(pixr, &rsame);
-        pixZero(pixg, &gsame);
-        pixZero(pixb, &bsame);
-        if (!rsame || !gsame || !bsame)
-            *psame = 0;
-        else
-            *psame = 1;
+        /* One pass makes the signed difference histogram
+         * for each of the three components */
+    for (i = 0; i < 3; i++) {
+        if ((hist[i] = (l_int32 *)CALLOC(511, sizeof(l_int32))) == NULL) {
+            while (--i >= 0)
+                FREE(hist[i]);
+            return ERROR_INT("hist not made", procName, 1);
+        }
     }
-
-    if (pdiff) {
-        pixGetAverageMasked(pixr, NULL, 0, 0, 1, L_MEAN_ABSVAL, &rdiff);
-        pixGetAverageMasked(pixg, NULL, 0, 0, 1, L_MEAN_ABSVAL, &gdiff);
-        pixGetAverageMasked(pixb, NULL, 0, 0, 1, L_MEAN_ABSVAL, &bdiff);
+    pixGetDiffHistoLow(pix1, pix2, 1, hist[0], hist[1], hist[2], NULL, &npix);
+    diffHistoGetStats(hist[0], 0xff, npix, comptype, &rsame, &rdiff, &rrms);
+    diffHistoGetStats(hist[1], 0xff, npix, comptype, &gsame, &gdiff, &grms);
+    diffHistoGetStats(hist[2], 0xff, npix, comptype, &bsame, &bdiff, &brms);
+    if (psame)
+        *psame = (rsame && gsame && bsame) ? 1 : 0;
+    if (pdiff)
         *pdiff = (rdiff + gdiff + bdiff) / 3.0;
-    }
+    if (prmsdiff)
+        *prmsdiff = (rrms + grms + brms) / 3.0;
 
     if (plottype) {
-        nar = pixGetGrayHistogram(pixr, 1);
-        nag = pixGetGrayHistogram(pixg, 1);
-        nab = pixGetGrayHistogram(pixb, 1);
+        nar = diffHistoToNuma(hist[0], 0xff, comptype);
+        nag = diffHistoToNuma(hist[1], 0xff, comptype);
+        nab = diffHistoToNuma(hist[2], 0xff, comptype);
         numaGetNonzeroRange(nar, TINY, &first, &rlast);
         numaGetNonzeroRange(nag, TINY, &first, &glast);
         numaGetNonzeroRange(nab, TINY, &first, &blast);
@@ -885,34 +895,39 @@ PIX       *pixr1, *pixr2, *pixg1, *pixg2, *pixb1, *pixb2, *pixr, *pixg, *pixb;
         numaDestroy(&nagc);
         numaDestroy(&nabc);
     }
-
-    if (ppixdiff)
-        *ppixdiff = pixCreateRGBImage(pixr, pixg, pixb);
-
-    if (prmsdiff) {
+    for (i = 0; i < 3; i++)
+        FREE(hist[i]);
+
+        /* The difference image is only made if requested */
+    if (ppixdiff) {
+        pixr1 = pixGetRGBComponent(pix1, COLOR_RED);
+        pixr2 = pixGetRGBComponent(pix2, COLOR_RED);
+        pixg1 = pixGetRGBComponent(pix1, COLOR_GREEN);
+        pixg2 = pixGetRGBComponent(pix2, COLOR_GREEN);
+        pixb1 = pixGetRGBComponent(pix1, COLOR_BLUE);
+        pixb2 = pixGetRGBComponent(pix2, COLOR_BLUE);
         if (comptype == L_COMPARE_SUBTRACT) {
-            pixDestroy(&pixr);
-            pixDestroy(&pixg);
-            pixDestroy(&pixb);
+            pixr = pixSubtractGray(NULL, pixr1, pixr2);
+            pixg = pixSubtractGray(NULL, pixg1, pixg2);
+            pixb = pixSubtractGray(NULL, pixb1, pixb2);
+        }
+        else  { /* comptype == L_COMPARE_ABS_DIFF) */
             pixr = pixAbsDifference(pixr1, pixr2);
             pixg = pixAbsDifference(pixg1, pixg2);
             pixb = pixAbsDifference(pixb1, pixb2);
         }
-        pixGetAverageMasked(pixr, NULL, 0, 0, 1, L_ROOT_MEAN_SQUARE, &rdiff);
-        pixGetAverageMasked(pixg, NULL, 0, 0, 1, L_ROOT_MEAN_SQUARE, &gdiff);
-        pixGetAverageMasked(pixb, NULL, 0, 0, 1, L_ROOT_MEAN_SQUARE, &bdiff);
-        *prmsdiff = (rdiff + gdiff + bdiff) / 3.0;
+        *ppixdiff = pixCreateRGBImage(pixr, pixg, pixb);
+        pixDestroy(&pixr1);
+        pixDestroy(&pixr2);
+        pixDestroy(&pixg1);
+        pixDestroy(&pixg2);
+        pixDestroy(&pixb1);
+        pixDestroy(&pixb2);
+        pixDestroy(&pixr);
+        pixDestroy(&pixg);
+        pixDestroy(&pixb);
     }
 
-    pixDestroy(&pixr1);
-    pixDestroy(&pixr2);
-    pixDestroy(&pixg1);
-    pixDestroy(&pixg2);
-    pixDestroy(&pixb1);
-    pixDestroy(&pixb2);
-    pixDestroy(&pixr);
-    pixDestroy(&pixg);
-    pixDestroy(&pixb);
     return 0;
 }
 
@@ -1282,20 +1297,18 @@ NUMA       *nah, *nan, *nac;
  *          is either gray or RGB depending on the colormap.
  *      (3) If RGB, the maximum difference between pixel components is
  *          saved in the histogram.
+ *      (4) The histogram is accumulated directly from the two images,
+ *          without making an intermediate difference image.
  */
 NUMA *
 pixGetDifferenceHistogram(PIX     *pix1,
                           PIX     *pix2,
                           l_int32  factor)
 {
-l_int32     w1, h1, d1, w2, h2, d2, w, h, wpl1, wpl2;
-l_int32     i, j, val, val1, val2;
-l_int32     rval1, rval2, gval1, gval2, bval1, bval2;
-l_int32     rdiff, gdiff, bdiff, maxdiff;
-l_uint32   *data1, *data2, *line1, *line2;
-l_float32  *array;
-NUMA       *na;
-PIX        *pixt1, *pixt2;
+l_int32   w1, h1, d1, w2, h2, d2, i, npix;
+l_int32  *hist, *shist;
+NUMA     *na;
+PIX      *pixt1, *pixt2;
 
     PROCNAME("pixGetDifferenceHistogram");
 
@@ -1324,44 +1337,35 @@ PIX        *pixt1, *pixt2;
     }
     if (factor < 1) factor = 1;
 
-    na = numaCreate(256);
-    numaSetCount(na, 256);  /* all initialized to 0.0 */
-    array = numaGetFArray(na, L_NOCOPY);
-    w = L_MIN(w1, w2);
-    h = L_MIN(h1, h2);
-    data1 = pixGetData(pixt1);
-    data2 = pixGetData(pixt2);
-    wpl1 = pixGetWpl(pixt1);
-    wpl2 = pixGetWpl(pixt2);
+    if ((hist = (l_int32 *)CALLOC(256, sizeof(l_int32))) == NULL) {
+        pixDestroy(&pixt1);
+        pixDestroy(&pixt2);
+        return (NUMA *)ERROR_PTR("hist not made", procName, NULL);
+    }
     if (d1 == 8) {
-        for (i = 0; i < h; i += factor) {
-            line1 = data1 + i * wpl1;
-            line2 = data2 + i * wpl2;
-            for (j = 0; j < w; j += factor) {
-                val1 = GET_DATA_BYTE(line1, j);
-                val2 = GET_DATA_BYTE(line2, j);
-                val = L_ABS(val1 - val2);
-                array[val]++;
-            }
+        if ((shist = (l_int32 *)CALLOC(511, sizeof(l_int32))) == NULL) {
+            FREE(hist);
+            pixDestroy(&pixt1);
+            pixDestroy(&pixt2);
+            return (NUMA *)ERROR_PTR("shist not made", procName, NULL);
         }
+        pixGetDiffHistoLow(pixt1, pixt2, factor, shist, NULL, NULL, NULL,
+                           &npix);
+        hist[0] = shist[255];
+        for (i = 1; i < 256; i++)
+            hist[i] = shist[255 + i] + shist[255 - i];
+        FREE(shist);
     }
     else {  /* d1 == 32 */
-        for (i = 0; i < h; i += factor) {
-            line1 = data1 + i * wpl1;
-            line2 = data2 + i * wpl2;
-            for (j = 0; j < w; j += factor) {
-                extractRGBValues(line1[j], &rval1, &gval1, &bval1);
-                extractRGBValues(line2[j], &rval2, &gval2, &bval2);
-                rdiff = L_ABS(rval1 - rval2);
-                gdiff = L_ABS(gval1 - gval2);
-                bdiff = L_ABS(bval1 - bval2);
-                maxdiff = L_MAX(rdiff, gdiff);
-                maxdiff = L_MAX(maxdiff, bdiff);
-                array[maxdiff]++;
-            }
-        }
+        pixGetDiffHistoLow(pixt1, pixt2, factor, NULL, NULL, NULL, hist,
+                           &npix);
     }
 
+    na = numaCreate(256);
+    for (i = 0; i < 256; i++)
+        numaAddNumber(na, hist[i]);
+
+    FREE(hist);
     pixDestroy(&pixt1);
     pixDestroy(&pixt2);
     return na;
@@ -1385,6 +1389,9 @@ PIX        *pixt1, *pixt2;
  *                 = 4.3429 * ln((255/MSE)^2)
  *                 = -4.3429 * ln((MSE/255)^2)
  *          where MSE is the mean squared error.
+ *      (2) The MSE is computed in a single pass from a histogram of
+ *          the pixel differences, and is normalized by the number of
+ *          sampled pixels, so the result is nearly independent of @factor.
  */
 l_int32
 pixGetPSNR(PIX        *pix1,
@@ -1392,9 +1399,9 @@ pixGetPSNR(PIX        *pix1,
            l_int32     factor,
            l_float32  *ppsnr)
 {
-l_int32    i, j, w, h, d, wpl1, wpl2, v1, v2, r1, g1, b1, r2, g2, b2;
-l_uint32  *data1, *data2, *line1, *line2;
-l_float32  mse;  /* mean squared error */
+l_int32    i, j, w, h, d, nhist, npix;
+l_int32   *hist[3];
+l_float64  sum, mse;  /* mean squared error */
 
     PROCNAME("pixGetPSNR");
 
@@ -1415,36 +1422,28 @@ l_float32  mse;  /* mean squared error */
     if (factor < 1)
         return ERROR_INT("invalid sampling factor", procName, 1);
 
-    data1 = pixGetData(pix1);
-    data2 = pixGetData(pix2);
-    wpl1 = pixGetWpl(pix1);
-    wpl2 = pixGetWpl(pix2);
-    mse = 0.0;
-    if (d == 8) {
-        for (i = 0; i < h; i += factor) {
-            line1 = data1 + i * wpl1;
-            line2 = data2 + i * wpl2;
-            for (j = 0; j < w; j += factor) {
-                v1 = GET_DATA_BYTE(line1, j);
-                v2 = GET_DATA_BYTE(line2, j);
-                mse += (v1 - v2) * (v1 - v2);
-            }
+    nhist = (d == 8) ? 1 : 3;
+    for (i = 0; i < nhist; i++) {
+        if ((hist[i] = (l_int32 *)CALLOC(511, sizeof(l_int32))) == NULL) {
+            while (--i >= 0)
+                FREE(hist[i]);
+            return ERROR_INT("hist not made", procName, 1);
         }
     }
-    else {  /* d == 32 */
-        for (i = 0; i < h; i += factor) {
-            line1 = data1 + i * wpl1;
-            line2 = data2 + i * wpl2;
-            for (j = 0; j < w; j += factor) {
-                extractRGBValues(line1[j], &r1, &g1, &b1);
-                extractRGBValues(line2[j], &r2, &g2, &b2);
-                mse += ((r1 - r2) * (r1 - r2) +
-                        (g1 - g2) * (g1 - g2) +
-                        (b1 - b2) * (b1 - b2)) / 3.0;
-            }
-        }
+    if (d == 8)
+        pixGetDiffHistoLow(pix1, pix2, factor, hist[0], NULL, NULL, NULL,
+                           &npix);
+    else  /* d == 32 */
+        pixGetDiffHistoLow(pix1, pix2, factor, hist[0], hist[1], hist[2],
+                           NULL, &npix);
+
+    sum = 0.0;
+    for (i = 0; i < nhist; i++) {
+        for (j = -255; j <= 255; j++)
+            sum += (l_float64)j * j * hist[i][255 + j];
+        FREE(hist[i]);
     }
-    mse = mse / (w * h);
+    mse = sum / ((l_float64)nhist * npix);
 
     *ppsnr = -4.3429448 * log(mse / (255 * 255));
     return 0;
@@ -1491,7 +1490,6 @@ pixCompareWithTranslation(PIX        *pix1,
                           l_float32  *pscore,
                           l_int32     debugflag)
 {
-l_uint8   *subtab;
 l_int32    i, level, area1, area2, delx, dely;
 l_int32    etransx, etransy, maxshift, dbint;
 l_int32   *stab, *ctab;
@@ -1513,7 +1511,6 @@ PIXA      *pixa1, *pixa2, *pixadb;
         return ERROR_INT("pix2 not defined", procName, 1);
 
         /* Make tables */
-    subtab = makeSubsampleTab2x();
     stab = makePixelSumTab8();
     ctab = makePixelCentroidTab8();
 
@@ -1530,8 +1527,8 @@ PIXA      *pixa1, *pixa2, *pixadb;
     pixaAddPix(pixa1, pixb1, L_INSERT);
     pixaAddPix(pixa2, pixb2, L_INSERT);
     for (i = 0; i < 3; i++) {
-        pixt1 = pixReduceRankBinary2(pixb1, 2, subtab);
-        pixt2 = pixReduceRankBinary2(pixb2, 2, subtab);
+        pixt1 = pixReduceRankBinary2(pixb1, 2, NULL);
+        pixt2 = pixReduceRankBinary2(pixb2, 2, NULL);
         pixaAddPix(pixa1, pixt1, L_INSERT);
         pixaAddPix(pixa2, pixt2, L_INSERT);
         pixb1 = pixt1;
@@ -1589,8 +1586,312 @@ PIXA      *pixa1, *pixa2, *pixadb;
     *pscore = score;
     pixaDestroy(&pixa1);
     pixaDestroy(&pixa2);
-    FREE(subtab);
     FREE(stab);
     FREE(ctab);
     return 0;
 }
+
+
+/*------------------------------------------------------------------*
+ *              Static helpers for the difference statistics         *
+ *------------------------------------------------------------------*/
+/*!
+ *  pixTestDiffZeroLow()
+ *
+ *      Input:  pix1, pix2 (8, 16 or 32 bpp; same depth; no colormap)
+ *              comptype (L_COMPARE_SUBTRACT, L_COMPARE_ABS_DIFF)
+ *              &same (<return> 1 if the difference image would be 0)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) This gives the same result as making the difference image
+ *          with pixSubtractGray() or pixAbsDifference(), and testing
+ *          it with pixZero(), but it makes no image and exits at
+ *          the first pixel that gives a nonzero difference.
+ *      (2) With L_COMPARE_SUBTRACT, the difference is zero if every
+ *          pixel (or component, for RGB) in pix1 is not larger than
+ *          the corresponding one in pix2.
+ *      (3) As with the other functions, the comparison is made over
+ *          the overlap of the two images, aligned at the UL corner.
+ *          For RGB, the alpha byte is ignored.
+ */
+static l_int32
+pixTestDiffZeroLow(PIX      *pix1,
+                   PIX      *pix2,
+                   l_int32   comptype,
+                   l_int32  *psame)
+{
+l_int32    w, h, w2, h2, d, wpl1, wpl2, i, j, k;
+l_int32    linebits, fullwords, endbits, bpw, shift;
+l_uint32   word1, word2, mask, endmask, v1, v2;
+l_uint32  *data1, *data2, *line1, *line2;
+
+    *psame = 0;
+    pixGetDimensions(pix1, &w, &h, &d);
+    pixGetDimensions(pix2, &w2, &h2, NULL);
+    w = L_MIN(w, w2);
+    h = L_MIN(h, h2);
+    data1 = pixGetData(pix1);
+    data2 = pixGetData(pix2);
+    wpl1 = pixGetWpl(pix1);
+    wpl2 = pixGetWpl(pix2);
+    linebits = d * w;
+    fullwords = linebits / 32;
+    endbits = linebits & 31;
+    endmask = (endbits) ? 0xffffffff << (32 - endbits) : 0;
+    mask = (d == 32) ? 0xffffff00 : 0xffffffff;
+
+        /* For 32 bpp the "pixel" is one 8 bit component */
+    bpw = (d == 16) ? 16 : 8;
+    for (i = 0; i < h; i++) {
+        line1 = data1 + i * wpl1;
+        line2 = data2 + i * wpl2;
+        for (j = 0; j <= fullwords; j++) {
+            if (j == fullwords && !endbits)
+                break;
+            word1 = line1[j] & mask;
+            word2 = line2[j] & mask;
+            if (j == fullwords) {
+                word1 &= endmask;
+                word2 &= endmask;
+            }
+            if (word1 == word2)
+                continue;
+            if (comptype == L_COMPARE_ABS_DIFF)
+                return 0;
+            for (k = 0; k < 32 / bpw; k++) {  /* L_COMPARE_SUBTRACT */
+                shift = 32 - bpw * (k + 1);
+                v1 = (word1 >> shift) & ((1 << bpw) - 1);
+                v2 = (word2 >> shift) & ((1 << bpw) - 1);
+                if (v1 > v2)
+                    return 0;
+            }
+        }
+    }
+
+    *psame = 1;
+    return 0;
+}
+
+
+/*!
+ *  pixGetDiffHistoLow()
+ *
+ *      Input:  pix1, pix2 (8, 16 or 32 bpp; same depth; no colormap)
+ *              factor (subsampling factor; >= 1)
+ *              hist1 (<optional> histogram of the signed difference for
+ *                     gray, or for the red component)
+ *              hist2, hist3 (<optional> same for green and blue)
+ *              histmax (<optional> for RGB, histogram of the maximum
+ *                       absolute component difference; 256 bins)
+ *              &npix (<return> number of sampled pixels)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) The signed difference pix1 - pix2 is histogrammed into
+ *          2 * maxval + 1 bins, where maxval is 255 for 8 bpp and 32 bpp,
+ *          and 65535 for 16 bpp.  Bin (maxval + diff) holds the count
+ *          for diff.  All arrays must be allocated and zeroed by
+ *          the caller.
+ *      (2) The images are traversed once, a word at a time.  Because
+ *          the images being compared are usually nearly identical,
+ *          words that are the same are counted in a single operation
+ *          without unpacking the pixels.
+ */
+static void
+pixGetDiffHistoLow(PIX      *pix1,
+                   PIX      *pix2,
+                   l_int32   factor,
+                   l_int32  *hist1,
+                   l_int32  *hist2,
+                   l_int32  *hist3,
+                   l_int32  *histmax,
+                   l_int32  *pnpix)
+{
+l_int32    w, h, w2, h2, d, wpl1, wpl2, i, j, k, nw, npix;
+l_int32    v1, v2, rdiff, gdiff, bdiff, maxdiff;
+l_uint32   word1, word2;
+l_uint32  *data1, *data2, *line1, *line2;
+
+    pixGetDimensions(pix1, &w, &h, &d);
+    pixGetDimensions(pix2, &w2, &h2, NULL);
+    w = L_MIN(w, w2);
+    h = L_MIN(h, h2);
+    data1 = pixGetData(pix1);
+    data2 = pixGetData(pix2);
+    wpl1 = pixGetWpl(pix1);
+    wpl2 = pixGetWpl(pix2);
+    npix = 0;
+
+    if (d == 8) {
+        nw = (factor == 1) ? w / 4 : 0;
+        for (i = 0; i < h; i += factor) {
+            line1 = data1 + i * wpl1;
+            line2 = data2 + i * wpl2;
+            for (k = 0; k < nw; k++) {
+                word1 = line1[k];
+                word2 = line2[k];
+                if (word1 == word2) {
+                    hist1[255] += 4;
+                    continue;
+                }
+                hist1[255 + (word1 >> 24) - (word2 >> 24)]++;
+                hist1[255 + ((word1 >> 16) & 0xff) - ((word2 >> 16) & 0xff)]++;
+                hist1[255 + ((word1 >> 8) & 0xff) - ((word2 >> 8) & 0xff)]++;
+                hist1[255 + (word1 & 0xff) - (word2 & 0xff)]++;
+            }
+            for (j = 4 * nw; j < w; j += factor) {
+                v1 = GET_DATA_BYTE(line1, j);
+                v2 = GET_DATA_BYTE(line2, j);
+                hist1[255 + v1 - v2]++;
+            }
+            npix += (w - 1) / factor + 1;
+        }
+    }
+    else if (d == 16) {
+        nw = (factor == 1) ? w / 2 : 0;
+        for (i = 0; i < h; i += factor) {
+            line1 = data1 + i * wpl1;
+            line2 = data2 + i * wpl2;
+            for (k = 0; k < nw; k++) {
+                word1 = line1[k];
+                word2 = line2[k];
+                if (word1 == word2) {
+                    hist1[0xffff] += 2;
+                    continue;
+                }
+                hist1[0xffff + (word1 >> 16) - (word2 >> 16)]++;
+                hist1[0xffff + (word1 & 0xffff) - (word2 & 0xffff)]++;
+            }
+            for (j = 2 * nw; j < w; j += factor) {
+                v1 = GET_DATA_TWO_BYTES(line1, j);
+                v2 = GET_DATA_TWO_BYTES(line2, j);
+                hist1[0xffff + v1 - v2]++;
+            }
+            npix += (w - 1) / factor + 1;
+        }
+    }
+    else {  /* d == 32 */
+        for (i = 0; i < h; i += factor) {
+            line1 = data1 + i * wpl1;
+            line2 = data2 + i * wpl2;
+            for (j = 0; j < w; j += factor) {
+                word1 = line1[j];
+                word2 = line2[j];
+                if (((word1 ^ word2) & 0xffffff00) == 0) {
+                    if (hist1) hist1[255]++;
+                    if (hist2) hist2[255]++;
+                    if (hist3) hist3[255]++;
+                    if (histmax) histmax[0]++;
+                    continue;
+                }
+                rdiff = (l_int32)(word1 >> L_RED_SHIFT & 0xff) -
+                        (l_int32)(word2 >> L_RED_SHIFT & 0xff);
+                gdiff = (l_int32)(word1 >> L_GREEN_SHIFT & 0xff) -
+                        (l_int32)(word2 >> L_GREEN_SHIFT & 0xff);
+                bdiff = (l_int32)(word1 >> L_BLUE_SHIFT & 0xff) -
+                        (l_int32)(word2 >> L_BLUE_SHIFT & 0xff);
+                if (hist1) hist1[255 + rdiff]++;
+                if (hist2) hist2[255 + gdiff]++;
+                if (hist3) hist3[255 + bdiff]++;
+                if (histmax) {
+                    maxdiff = L_MAX(L_ABS(rdiff), L_ABS(gdiff));
+                    maxdiff = L_MAX(maxdiff, L_ABS(bdiff));
+                    histmax[maxdiff]++;
+                }
+            }
+            npix += (w - 1) / factor + 1;
+        }
+    }
+
+    *pnpix = npix;
+    return;
+}
+
+
+/*!
+ *  diffHistoGetStats()
+ *
+ *      Input:  hist (histogram of signed difference; 2 * maxval + 1 bins)
+ *              maxval (255 or 65535)
+ *              npix (number of pixels in the histogram)
+ *              comptype (L_COMPARE_SUBTRACT, L_COMPARE_ABS_DIFF)
+ *              &same (<optional return> 1 if the difference is all 0)
+ *              &diff (<optional return> average difference)
+ *              &rmsdiff (<optional return> rms of the absolute difference)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) With L_COMPARE_SUBTRACT, negative differences are clipped
+ *          to 0 for @same and @diff.  As in pixCompareGray(), the rms
+ *          difference always uses the absolute difference.
+ */
+static void
+diffHistoGetStats(l_int32    *hist,
+                  l_int32     maxval,
+                  l_int32     npix,
+                  l_int32     comptype,
+                  l_int32    *psame,
+                  l_float32  *pdiff,
+                  l_float32  *prmsdiff)
+{
+l_int32    j, count, val, nonzero;
+l_float64  sum, sumsq;
+
+    sum = sumsq = 0.0;
+    nonzero = FALSE;
+    for (j = -maxval; j <= maxval; j++) {
+        if ((count = hist[maxval + j]) == 0)
+            continue;
+        if (comptype == L_COMPARE_SUBTRACT)
+            val = L_MAX(j, 0);
+        else  /* comptype == L_COMPARE_ABS_DIFF */
+            val = L_ABS(j);
+        if (val > 0) nonzero = TRUE;
+        sum += (l_float64)val * count;
+        sumsq += (l_float64)j * j * count;
+    }
+
+    if (psame) *psame = (nonzero) ? 0 : 1;
+    if (pdiff) *pdiff = (npix > 0) ? sum / npix : 0.0;
+    if (prmsdiff) *prmsdiff = (npix > 0) ? sqrt(sumsq / npix) : 0.0;
+    return;
+}
+
+
+/*!
+ *  diffHistoToNuma()
+ *
+ *      Input:  hist (histogram of signed difference; 2 * maxval + 1 bins)
+ *              maxval (255 or 65535)
+ *              comptype (L_COMPARE_SUBTRACT, L_COMPARE_ABS_DIFF)
+ *      Return: na (histogram of the difference image values), or null
+ *              on error
+ *
+ *  Notes:
+ *      (1) This is the histogram that pixGetGrayHistogram() would give
+ *          for the difference image.
+ */
+static NUMA *
+diffHistoToNuma(l_int32  *hist,
+                l_int32   maxval,
+                l_int32   comptype)
+{
+l_int32     j;
+l_float32  *array;
+NUMA       *na;
+
+    PROCNAME("diffHistoToNuma");
+
+    if ((na = numaCreate(maxval + 1)) == NULL)
+        return (NUMA *)ERROR_PTR("na not made", procName, NULL);
+    numaSetCount(na, maxval + 1);  /* all initialized to 0.0 */
+    array = numaGetFArray(na, L_NOCOPY);
+    for (j = -maxval; j <= maxval; j++) {
+        if (comptype == L_COMPARE_SUBTRACT)
+            array[L_MAX(j, 0)] += hist[maxval + j];
+        else  /* comptype == L_COMPARE_ABS_DIFF */
+            array[L_ABS(j)] += hist[maxval + j];
+    }
+    return na;
+}
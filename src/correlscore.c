@@ -34,17 +34,27 @@
  *         l_float32   pixCorrelationScore()
  *         l_int32     pixCorrelationScoreThresholded()
  *
+ *     Correlation of one pix with a set of templates
+ *         NUMA       *pixCorrelationScoreMulti()
+ *
  *     Simple 2 pix correlators
  *         l_float32   pixCorrelationScoreSimple()
  *         l_float32   pixCorrelationScoreShifted()
  *
  *     Shift to find the best correlation
  *         l_int32     pixBestCorrelation()
+ *
+ *     Static helper
+ *         static l_int32  correlationCount()
  */
 
 #include <math.h>
 #include "allheaders.h"
 
+static l_int32 correlationCount(PIX *pix1, PIX *pix2, l_int32 idelx,
+                                l_int32 idely, l_int32 threshold,
+                                l_int32 *downcount, l_int32 *tab);
+
 
 /* -------------------------------------------------------------------- *
  *           Optimized 2 pix correlators (for jbig2 clustering)         *
@@ -109,7 +119,9 @@
  *  However, here it is done in a streaming fashion, counting as it goes,
  *  and touching memory exactly once, giving a 3-4x speedup over the
  *  simple implementation.  This very fast correlation matcher was
- *  contributed by William Rucklidge.
+ *  contributed by William Rucklidge.  The inner loop, which ANDs
+ *  the aligned words and counts the bits, is correlCountLow(), called
+ *  through the cpu dispatch table.
  */
 l_float32
 pixCorrelationScore(PIX       *pix1,
@@ -123,10 +135,6 @@ pixCorrelationScore(PIX       *pix1,
                     l_int32   *tab)
 {
 l_int32    wi, hi, wt, ht, delw, delh, idelx, idely, count;
-l_int32    wpl1, wpl2, lorow, hirow, locol, hicol;
-l_int32    x, y, pix1lskip, pix2lskip, rowwords1, rowwords2;
-l_uint32   word1, word2, andw;
-l_uint32  *row1, *row2;
 l_float32  score;
 
     PROCNAME("pixCorrelationScore");
@@ -160,189 +168,8 @@ l_float32  score;
     else
         idely = (l_int32)(dely - 0.5);
 
-    count = 0;
-    wpl1 = pixGetWpl(pix1);
-    wpl2 = pixGetWpl(pix2);
-    rowwords2 = wpl2;
-
-        /* What rows of pix1 need to be considered?  Only those underlying the
-         * shifted pix2. */
-    lorow = L_MAX(idely, 0);
-    hirow = L_MIN(ht + idely, hi);
-
-        /* Get the pointer to the first row of each image that will be
-         * considered. */
-    row1 = pixGetData(pix1) + wpl1 * lorow;
-    row2 = pixGetData(pix2) + wpl2 * (lorow - idely);
-
-        /* Similarly, figure out which columns of pix1 will be considered. */
-    locol = L_MAX(idelx, 0);
-    hicol = L_MIN(wt + idelx, wi);
-
-    if (idelx >= 32) {
-            /* pix2 is shifted far enough to the right that pix1's first
-             * word(s) won't contribute to the count.  Increment its
-             * pointer to point to the first word that will contribute,
-             * and adjust other values accordingly. */
-        pix1lskip = idelx >> 5;  /* # of words to skip on left */
-        row1 += pix1lskip;
-        locol -= pix1lskip << 5;
-        hicol -= pix1lskip << 5;
-        idelx &= 31;
-    } else if (idelx <= -32) {
-            /* pix2 is shifted far enough to the left that its first word(s)
-             * won't contribute to the count.  Increment its pointer
-             * to point to the first word that will contribute,
-             * and adjust other values accordingly. */
-        pix2lskip = -((idelx + 31) >> 5);  /* # of words to skip on left */
-        row2 += pix2lskip;
-        rowwords2 -= pix2lskip;
-        idelx += pix2lskip << 5;
-    }
-
-    if ((locol >= hicol) || (lorow >= hirow)) {  /* there is no overlap */
-        count = 0;
-    } else {
-            /* How many words of each row of pix1 need to be considered? */
-        rowwords1 = (hicol + 31) >> 5;
-
-        if (idelx == 0) {
-                /* There's no lateral offset; simple case. */
-            for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                for (x = 0; x < rowwords1; x++) {
-                    andw = row1[x] & row2[x];
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-                }
-            }
-        } else if (idelx > 0) {
-                /* pix2 is shifted to the right.  word 0 of pix1 is touched by
-                 * word 0 of pix2; word 1 of pix1 is touched by word 0 and word
-                 * 1 of pix2, and so on up to the last word of pix1 (word N),
-                 * which is touched by words N-1 and N of pix1... if there is a
-                 * word N.  Handle the two cases (pix2 has N-1 words and pix2
-                 * has at least N words) separately.
-                 *
-                 * Note: we know that pix2 has at least N-1 words (i.e.,
-                 * rowwords2 >= rowwords1 - 1) by the following logic.
-                 * We can pretend that idelx <= 31 because the >= 32 logic
-                 * above adjusted everything appropriately.  Then
-                 * hicol <= wt + idelx <= wt + 31, so
-                 * hicol + 31 <= wt + 62
-                 * rowwords1 = (hicol + 31) >> 5 <= (wt + 62) >> 5
-                 * rowwords2 == (wt + 31) >> 5, so
-                 * rowwords1 <= rowwords2 + 1 */
-            if (rowwords2 < rowwords1) {
-                for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                        /* Do the first iteration so the loop can be
-                         * branch-free. */
-                    word1 = row1[0];
-                    word2 = row2[0] >> idelx;
-                    andw = word1 & word2;
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-
-                    for (x = 1; x < rowwords2; x++) {
-                        word1 = row1[x];
-                        word2 = (row2[x] >> idelx) |
-                            (row2[x - 1] << (32 - idelx));
-                        andw = word1 & word2;
-                        count += tab[andw & 0xff] +
-                            tab[(andw >> 8) & 0xff] +
-                            tab[(andw >> 16) & 0xff] +
-                            tab[andw >> 24];
-                    }
-
-                        /* Now the last iteration - we know that this is safe
-                         * (i.e.  rowwords1 >= 2) because rowwords1 > rowwords2
-                         * > 0 (if it was 0, we'd have taken the "count = 0"
-                         * fast-path out of here). */
-                    word1 = row1[x];
-                    word2 = row2[x - 1] << (32 - idelx);
-                    andw = word1 & word2;
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-                }
-            } else {
-                for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                        /* Do the first iteration so the loop can be
-                         * branch-free.  This section is the same as above
-                         * except for the different limit on the loop, since
-                         * the last iteration is the same as all the other
-                         * iterations (beyond the first). */
-                    word1 = row1[0];
-                    word2 = row2[0] >> idelx;
-                    andw = word1 & word2;
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-
-                    for (x = 1; x < rowwords1; x++) {
-                        word1 = row1[x];
-                        word2 = (row2[x] >> idelx) |
-                            (row2[x - 1] << (32 - idelx));
-                        andw = word1 & word2;
-                        count += tab[andw & 0xff] +
-                            tab[(andw >> 8) & 0xff] +
-                            tab[(andw >> 16) & 0xff] +
-                            tab[andw >> 24];
-                    }
-                }
-            }
-        } else {
-                /* pix2 is shifted to the left.  word 0 of pix1 is touched by
-                 * word 0 and word 1 of pix2, and so on up to the last word of
-                 * pix1 (word N), which is touched by words N and N+1 of
-                 * pix2... if there is a word N+1.  Handle the two cases (pix2
-                 * has N words and pix2 has at least N+1 words) separately. */
-            if (rowwords1 < rowwords2) {
-                    /* pix2 has at least N+1 words, so every iteration through
-                     * the loop can be the same. */
-                for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                    for (x = 0; x < rowwords1; x++) {
-                        word1 = row1[x];
-                        word2 = row2[x] << -idelx;
-                        word2 |= row2[x + 1] >> (32 + idelx);
-                        andw = word1 & word2;
-                        count += tab[andw & 0xff] +
-                            tab[(andw >> 8) & 0xff] +
-                            tab[(andw >> 16) & 0xff] +
-                            tab[andw >> 24];
-                    }
-                }
-            } else {
-                    /* pix2 has only N words, so the last iteration is broken
-                     * out. */
-                for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                    for (x = 0; x < rowwords1 - 1; x++) {
-                        word1 = row1[x];
-                        word2 = row2[x] << -idelx;
-                        word2 |= row2[x + 1] >> (32 + idelx);
-                        andw = word1 & word2;
-                        count += tab[andw & 0xff] +
-                            tab[(andw >> 8) & 0xff] +
-                            tab[(andw >> 16) & 0xff] +
-                            tab[andw >> 24];
-                    }
-
-                    word1 = row1[x];
-                    word2 = row2[x] << -idelx;
-                    andw = word1 & word2;
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-                }
-            }
-        }
-    }
+    count = correlationCount(pix1, pix2, idelx, idely, 0, NULL, tab);
+    count = L_MAX(0, count);
 
     score = (l_float32)count * (l_float32)count /
              ((l_float32)area1 * (l_float32)area2);
@@ -401,6 +228,11 @@ l_float32  score;
  *  score, not the first template with a score satisfying the matching
  *  constraint.  However, this is not particularly effective.
  *
+ *  The count is checked after each row.  The function returns as soon
+ *  as it reaches the count needed for the threshold, or when the count
+ *  plus the number of ON pixels remaining in the overlapped rows of pix1
+ *  (from downcount) cannot reach it.
+ *
  *  This very fast correlation matcher was contributed by William Rucklidge.
  */
 l_int32
@@ -417,11 +249,6 @@ pixCorrelationScoreThresholded(PIX       *pix1,
                                l_float32  score_threshold)
 {
 l_int32    wi, hi, wt, ht, delw, delh, idelx, idely, count;
-l_int32    wpl1, wpl2, lorow, hirow, locol, hicol, untouchable;
-l_int32    x, y, pix1lskip, pix2lskip, rowwords1, rowwords2;
-l_uint32   word1, word2, andw;
-l_uint32  *row1, *row2;
-l_float32  score;
 l_int32    threshold;
 
     PROCNAME("pixCorrelationScoreThresholded");
@@ -432,6 +259,8 @@ l_int32    threshold;
         return ERROR_INT("pix2 not 1 bpp", procName, 0);
     if (!tab)
         return ERROR_INT("tab not defined", procName, 0);
+    if (!downcount)
+        return ERROR_INT("downcount not defined", procName, 0);
     if (area1 <= 0 || area2 <= 0)
         return ERROR_INT("areas must be > 0", procName, 0);
 
@@ -459,230 +288,135 @@ l_int32    threshold;
          * count * count / (area1 * area2) >= score_threshold */
     threshold = (l_int32)ceil(sqrt(score_threshold * area1 * area2));
 
-    count = 0;
-    wpl1 = pixGetWpl(pix1);
-    wpl2 = pixGetWpl(pix2);
-    rowwords2 = wpl2;
+    count = correlationCount(pix1, pix2, idelx, idely, threshold, downcount,
+                             tab);
+    if (count < 0)  /* no overlap */
+        return FALSE;
+    return (count >= threshold) ? TRUE : FALSE;
+}
 
-        /* What rows of pix1 need to be considered?  Only those underlying the
-         * shifted pix2. */
-    lorow = L_MAX(idely, 0);
-    hirow = L_MIN(ht + idely, hi);
 
-        /* Get the pointer to the first row of each image that will be
-         * considered. */
-    row1 = pixGetData(pix1) + wpl1 * lorow;
-    row2 = pixGetData(pix2) + wpl2 * (lorow - idely);
-    if (hirow <= hi) {
-            /* Some rows of pix1 will never contribute to count */
-        untouchable = downcount[hirow - 1];
-    }
+/* -------------------------------------------------------------------- *
+ *            Correlation of one pix with a set of templates            *
+ * -------------------------------------------------------------------- */
+/*!
+ *  pixCorrelationScoreMulti()
+ *
+ *      Input:  pix1   (test pix, 1 bpp)
+ *              area1  (number of on pixels in pix1)
+ *              x1, y1 (centroid of pix1)
+ *              pixa2  (exemplar pix, 1 bpp)
+ *              naarea2 (number of on pixels in each pix of pixa2)
+ *              pta2   (centroid of each pix of pixa2)
+ *              naindex (<optional> indices in pixa2 of the exemplars
+ *                       to be scored; use null to score all of them)
+ *              maxdiffw (max width difference of pix1 and pix2)
+ *              maxdiffh (max height difference of pix1 and pix2)
+ *              tab8   (<optional> sum tab for byte; can be NULL)
+ *      Return: nascore (correlation score with each exemplar), or null
+ *              on error
+ *
+ *  Notes:
+ *      (1) This gives the same scores as calling pixCorrelationScore()
+ *          for each exemplar, with the centroid difference
+ *          (x1 - x2, y1 - y2).  Exemplars that differ in size by more
+ *          than (maxdiffw, maxdiffh) get a score of 0.0.
+ *      (2) If naindex is defined, the output has one score for each
+ *          index, in the same order.
+ *      (3) The input is checked once, and exemplars that fail the size
+ *          test are rejected before their pix is accessed, so this is
+ *          faster than separate calls when most exemplars are rejected.
+ */
+NUMA *
+pixCorrelationScoreMulti(PIX        *pix1,
+                         l_int32     area1,
+                         l_float32   x1,
+                         l_float32   y1,
+                         PIXA       *pixa2,
+                         NUMA       *naarea2,
+                         PTA        *pta2,
+                         NUMA       *naindex,
+                         l_int32     maxdiffw,
+                         l_int32     maxdiffh,
+                         l_int32    *tab8)
+{
+l_int32    i, index, n, n2, wi, hi, wt, ht, area2, idelx, idely, count;
+l_int32   *tab;
+l_float32  x2, y2, delx, dely, score;
+NUMA      *nascore;
+PIX       *pix2;
 
-        /* Similarly, figure out which columns of pix1 will be considered. */
-    locol = L_MAX(idelx, 0);
-    hicol = L_MIN(wt + idelx, wi);
+    PROCNAME("pixCorrelationScoreMulti");
 
-    if (idelx >= 32) {
-            /* pix2 is shifted far enough to the right that pix1's first
-             * word(s) won't contribute to the count.  Increment its
-             * pointer to point to the first word that will contribute,
-             * and adjust other values accordingly. */
-        pix1lskip = idelx >> 5;  /* # of words to skip on left */
-        row1 += pix1lskip;
-        locol -= pix1lskip << 5;
-        hicol -= pix1lskip << 5;
-        idelx &= 31;
-    } else if (idelx <= -32) {
-            /* pix2 is shifted far enough to the left that its first word(s)
-             * won't contribute to the count.  Increment its pointer
-             * to point to the first word that will contribute,
-             * and adjust other values accordingly. */
-        pix2lskip = -((idelx + 31) >> 5);  /* # of words to skip on left */
-        row2 += pix2lskip;
-        rowwords2 -= pix2lskip;
-        idelx += pix2lskip << 5;
-    }
+    if (!pix1 || pixGetDepth(pix1) != 1)
+        return (NUMA *)ERROR_PTR("pix1 not 1 bpp", procName, NULL);
+    if (area1 <= 0)
+        return (NUMA *)ERROR_PTR("area1 must be > 0", procName, NULL);
+    if (!pixa2 || !naarea2 || !pta2)
+        return (NUMA *)ERROR_PTR("pixa2, naarea2, pta2 not all defined",
+                                 procName, NULL);
+    n2 = pixaGetCount(pixa2);
+    if (numaGetCount(naarea2) != n2 || ptaGetCount(pta2) != n2)
+        return (NUMA *)ERROR_PTR("pixa2, naarea2, pta2 sizes differ",
+                                 procName, NULL);
+
+    n = (naindex) ? numaGetCount(naindex) : n2;
+    if ((nascore = numaCreate(n)) == NULL)
+        return (NUMA *)ERROR_PTR("nascore not made", procName, NULL);
+    tab = (tab8) ? tab8 : makePixelSumTab8();
+    pixGetDimensions(pix1, &wi, &hi, NULL);
+    for (i = 0; i < n; i++) {
+        index = i;
+        if (naindex)
+            numaGetIValue(naindex, i, &index);
+        if (index < 0 || index >= n2) {
+            L_WARNING("invalid index", procName);
+            numaAddNumber(nascore, 0.0);
+            continue;
+        }
 
-    if ((locol >= hicol) || (lorow >= hirow)) {  /* there is no overlap */
-        count = 0;
-    } else {
-            /* How many words of each row of pix1 need to be considered? */
-        rowwords1 = (hicol + 31) >> 5;
-
-        if (idelx == 0) {
-                /* There's no lateral offset; simple case. */
-            for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                for (x = 0; x < rowwords1; x++) {
-                    andw = row1[x] & row2[x];
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-                }
-
-                    /* If the count is over the threshold, no need to
-                     * calculate any futher.  Likewise, return early if the
-                     * count plus the maximum count attainable from further
-                     * rows is below the threshold. */
-                if (count >= threshold) return TRUE;
-                if (count + downcount[y] - untouchable < threshold) {
-                    return FALSE;
-                }
-            }
-        } else if (idelx > 0) {
-                /* pix2 is shifted to the right.  word 0 of pix1 is touched by
-                 * word 0 of pix2; word 1 of pix1 is touched by word 0 and word
-                 * 1 of pix2, and so on up to the last word of pix1 (word N),
-                 * which is touched by words N-1 and N of pix1... if there is a
-                 * word N.  Handle the two cases (pix2 has N-1 words and pix2
-                 * has at least N words) separately.
-                 *
-                 * Note: we know that pix2 has at least N-1 words (i.e.,
-                 * rowwords2 >= rowwords1 - 1) by the following logic.
-                 * We can pretend that idelx <= 31 because the >= 32 logic
-                 * above adjusted everything appropriately.  Then
-                 * hicol <= wt + idelx <= wt + 31, so
-                 * hicol + 31 <= wt + 62
-                 * rowwords1 = (hicol + 31) >> 5 <= (wt + 62) >> 5
-                 * rowwords2 == (wt + 31) >> 5, so
-                 * rowwords1 <= rowwords2 + 1 */
-            if (rowwords2 < rowwords1) {
-                for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                        /* Do the first iteration so the loop can be
-                         * branch-free. */
-                    word1 = row1[0];
-                    word2 = row2[0] >> idelx;
-                    andw = word1 & word2;
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-
-                    for (x = 1; x < rowwords2; x++) {
-                        word1 = row1[x];
-                        word2 = (row2[x] >> idelx) |
-                            (row2[x - 1] << (32 - idelx));
-                        andw = word1 & word2;
-                        count += tab[andw & 0xff] +
-                            tab[(andw >> 8) & 0xff] +
-                            tab[(andw >> 16) & 0xff] +
-                            tab[andw >> 24];
-                    }
-
-                        /* Now the last iteration - we know that this is safe
-                         * (i.e.  rowwords1 >= 2) because rowwords1 > rowwords2
-                         * > 0 (if it was 0, we'd have taken the "count = 0"
-                         * fast-path out of here). */
-                    word1 = row1[x];
-                    word2 = row2[x - 1] << (32 - idelx);
-                    andw = word1 & word2;
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-
-                    if (count >= threshold) return TRUE;
-                    if (count + downcount[y] - untouchable < threshold) {
-                        return FALSE;
-                    }
-                }
-            } else {
-                for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                        /* Do the first iteration so the loop can be
-                         * branch-free.  This section is the same as above
-                         * except for the different limit on the loop, since
-                         * the last iteration is the same as all the other
-                         * iterations (beyond the first). */
-                    word1 = row1[0];
-                    word2 = row2[0] >> idelx;
-                    andw = word1 & word2;
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-
-                    for (x = 1; x < rowwords1; x++) {
-                        word1 = row1[x];
-                        word2 = (row2[x] >> idelx) |
-                            (row2[x - 1] << (32 - idelx));
-                        andw = word1 & word2;
-                        count += tab[andw & 0xff] +
-                            tab[(andw >> 8) & 0xff] +
-                            tab[(andw >> 16) & 0xff] +
-                            tab[andw >> 24];
-                    }
-
-                    if (count >= threshold) return TRUE;
-                    if (count + downcount[y] - untouchable < threshold) {
-                        return FALSE;
-                    }
-                }
-            }
+            /* Eliminate based on size difference */
+        pixaGetPixDimensions(pixa2, index, &wt, &ht, NULL);
+        if (L_ABS(wi - wt) > maxdiffw || L_ABS(hi - ht) > maxdiffh) {
+            numaAddNumber(nascore, 0.0);
+            continue;
+        }
+        numaGetIValue(naarea2, index, &area2);
+        if (area2 <= 0) {
+            numaAddNumber(nascore, 0.0);
+            continue;
+        }
+
+            /* Round difference to nearest integer */
+        ptaGetPt(pta2, index, &x2, &y2);
+        delx = x1 - x2;
+        dely = y1 - y2;
+        if (delx >= 0)
+            idelx = (l_int32)(delx + 0.5);
+        else
+            idelx = (l_int32)(delx - 0.5);
+        if (dely >= 0)
+            idely = (l_int32)(dely + 0.5);
+        else
+            idely = (l_int32)(dely - 0.5);
+
+        pix2 = pixaGetPix(pixa2, index, L_CLONE);
+        if (pixGetDepth(pix2) != 1) {
+            L_WARNING("pix2 not 1 bpp", procName);
+            count = 0;
         } else {
-                /* pix2 is shifted to the left.  word 0 of pix1 is touched by
-                 * word 0 and word 1 of pix2, and so on up to the last word of
-                 * pix1 (word N), which is touched by words N and N+1 of
-                 * pix2... if there is a word N+1.  Handle the two cases (pix2
-                 * has N words and pix2 has at least N+1 words) separately. */
-            if (rowwords1 < rowwords2) {
-                    /* pix2 has at least N+1 words, so every iteration through
-                     * the loop can be the same. */
-                for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                    for (x = 0; x < rowwords1; x++) {
-                        word1 = row1[x];
-                        word2 = row2[x] << -idelx;
-                        word2 |= row2[x + 1] >> (32 + idelx);
-                        andw = word1 & word2;
-                        count += tab[andw & 0xff] +
-                            tab[(andw >> 8) & 0xff] +
-                            tab[(andw >> 16) & 0xff] +
-                            tab[andw >> 24];
-                    }
-
-                    if (count >= threshold) return TRUE;
-                    if (count + downcount[y] - untouchable < threshold) {
-                        return FALSE;
-                    }
-                }
-            } else {
-                    /* pix2 has only N words, so the last iteration is broken
-                     * out. */
-                for (y = lorow; y < hirow; y++, row1 += wpl1, row2 += wpl2) {
-                    for (x = 0; x < rowwords1 - 1; x++) {
-                        word1 = row1[x];
-                        word2 = row2[x] << -idelx;
-                        word2 |= row2[x + 1] >> (32 + idelx);
-                        andw = word1 & word2;
-                        count += tab[andw & 0xff] +
-                            tab[(andw >> 8) & 0xff] +
-                            tab[(andw >> 16) & 0xff] +
-                            tab[andw >> 24];
-                    }
-
-                    word1 = row1[x];
-                    word2 = row2[x] << -idelx;
-                    andw = word1 & word2;
-                    count += tab[andw & 0xff] +
-                        tab[(andw >> 8) & 0xff] +
-                        tab[(andw >> 16) & 0xff] +
-                        tab[andw >> 24];
-
-                    if (count >= threshold) return TRUE;
-                    if (count + downcount[y] - untouchable < threshold) {
-                        return FALSE;
-                    }
-                }
-            }
+            count = correlationCount(pix1, pix2, idelx, idely, 0, NULL,
+                                     tab);
+            count = L_MAX(0, count);
         }
+        pixDestroy(&pix2);
+        score = (l_float32)count * (l_float32)count /
+                 ((l_float32)area1 * (l_float32)area2);
+        numaAddNumber(nascore, score);
     }
 
-    score = (l_float32)count * (l_float32)count /
-             ((l_float32)area1 * (l_float32)area2);
-    if (score >= score_threshold) {
-        fprintf(stderr, "count %d < threshold %d but score %g >= score_threshold %g\n",
-                count, threshold, score, score_threshold);
-    }
-    return FALSE;
+    if (!tab8) FREE(tab);
+    return nascore;
 }
 
 
@@ -790,8 +524,10 @@ PIX       *pixt;
  *      (1) This finds the correlation between two 1 bpp images,
  *          when pix2 is shifted by (delx, dely) with respect
  *          to each other.
- *      (2) This is implemented by starting with a copy of pix1 and
- *          ANDing its pixels with those of a shifted pix2.
+ *      (2) This counts the ON pixels in the AND of pix1 and the shifted
+ *          pix2 in a single pass over the overlapping words, without
+ *          making a temporary pix.  The result is the same as ANDing
+ *          a shifted copy of pix2 with pix1.
  *      (3) Get the pixel counts for area1 and area2 using piCountPixels().
  *      (4) A good estimate for a shift that would maximize the correlation
  *          is to align the centroids (cx1, cy1; cx2, cy2), giving the
@@ -813,11 +549,10 @@ pixCorrelationScoreShifted(PIX      *pix1,
                            l_int32   dely,
                            l_int32  *tab)
 {
-l_int32    w1, h1, w2, h2, count;
+l_int32    count;
 l_float32  score;
-PIX       *pixt;
 
-    PROCNAME("pixCorrelationScoreSimple");
+    PROCNAME("pixCorrelationScoreShifted");
 
     if (!pix1 || pixGetDepth(pix1) != 1)
         return (l_float32)ERROR_FLOAT("pix1 not 1 bpp", procName, 0.0);
@@ -828,20 +563,8 @@ PIX       *pixt;
     if (!area1 || !area2)
         return (l_float32)ERROR_FLOAT("areas must be > 0", procName, 0.0);
 
-    pixGetDimensions(pix1, &w1, &h1, NULL);
-    pixGetDimensions(pix2, &w2, &h2, NULL);
-
-        /*  To insure that pixels are ON only within the
-         *  intersection of pix1 and the shifted pix2:
-         *  (1) Start with pixt cleared and equal in size to pix1.
-         *  (2) Blit the shifted pix2 onto pixt.  Then all ON pixels
-         *      are within the intersection of pix1 and the shifted pix2.
-         *  (3) AND pix1 with pixt. */
-    pixt = pixCreateTemplate(pix1);
-    pixRasterop(pixt, delx, dely, w2, h2, PIX_SRC, pix2, 0, 0);
-    pixRasterop(pixt, 0, 0, w1, h1, PIX_SRC & PIX_DST, pix1, 0, 0);
-    pixCountPixels(pixt, &count, tab);
-    pixDestroy(&pixt);
+    count = correlationCount(pix1, pix2, delx, dely, 0, NULL, tab);
+    count = L_MAX(0, count);
 
     score = (l_float32)count * (l_float32)count /
              ((l_float32)area1 * (l_float32)area2);
@@ -966,3 +689,102 @@ PIX       *pixt1, *pixt2;
     if (!tab8) FREE(tab);
     return 0;
 }
+
+
+/* -------------------------------------------------------------------- *
+ *                             Static helper                            *
+ * -------------------------------------------------------------------- */
+/*!
+ *  correlationCount()
+ *
+ *      Input:  pix1   (1 bpp)
+ *              pix2   (1 bpp)
+ *              idelx  (x translation of pix2 relative to pix1)
+ *              idely  (y translation of pix2 relative to pix1)
+ *              threshold (count at which to stop; ignored if downcount
+ *                         is null)
+ *              downcount (<optional> count of 1 pixels below each row
+ *                         of pix1; use null to count all rows)
+ *              tab    (sum tab for byte)
+ *      Return: count of ON pixels in the AND of pix1 and the translated
+ *              pix2, within pix1; or -1 if they do not overlap
+ *
+ *  Notes:
+ *      (1) This finds the rows and words of each image that overlap,
+ *          and calls the low-level function to AND and count them.
+ *      (2) If downcount is defined, the count may stop early; it is
+ *          then only useful for comparison with the threshold.
+ */
+static l_int32
+correlationCount(PIX      *pix1,
+                 PIX      *pix2,
+                 l_int32   idelx,
+                 l_int32   idely,
+                 l_int32   threshold,
+                 l_int32  *downcount,
+                 l_int32  *tab)
+{
+l_int32          wi, hi, wt, ht, wpl1, wpl2, lorow, hirow, locol, hicol;
+l_int32          pix1lskip, pix2lskip, rowwords1, rowwords2, untouchable;
+l_uint32         lastmask;
+l_uint32        *row1, *row2;
+L_CPU_DISPATCH  *dispatch;
+
+    pixGetDimensions(pix1, &wi, &hi, NULL);
+    pixGetDimensions(pix2, &wt, &ht, NULL);
+    wpl1 = pixGetWpl(pix1);
+    wpl2 = pixGetWpl(pix2);
+    rowwords2 = wpl2;
+
+        /* What rows of pix1 need to be considered?  Only those underlying
+         * the shifted pix2. */
+    lorow = L_MAX(idely, 0);
+    hirow = L_MIN(ht + idely, hi);
+
+        /* Similarly, figure out which columns of pix1 will be considered. */
+    locol = L_MAX(idelx, 0);
+    hicol = L_MIN(wt + idelx, wi);
+    if ((locol >= hicol) || (lorow >= hirow))  /* there is no overlap */
+        return -1;
+
+        /* Get the pointer to the first row of each image that will be
+         * considered. */
+    row1 = pixGetData(pix1) + wpl1 * lorow;
+    row2 = pixGetData(pix2) + wpl2 * (lorow - idely);
+
+    if (idelx >= 32) {
+            /* pix2 is shifted far enough to the right that pix1's first
+             * word(s) won't contribute to the count.  Increment its
+             * pointer to point to the first word that will contribute,
+             * and adjust other values accordingly. */
+        pix1lskip = idelx >> 5;  /* # of words to skip on left */
+        row1 += pix1lskip;
+        hicol -= pix1lskip << 5;
+        idelx &= 31;
+    } else if (idelx <= -32) {
+            /* pix2 is shifted far enough to the left that its first word(s)
+             * won't contribute to the count.  Increment its pointer
+             * to point to the first word that will contribute,
+             * and adjust other values accordingly. */
+        pix2lskip = -((idelx + 31) >> 5);  /* # of words to skip on left */
+        row2 += pix2lskip;
+        rowwords2 -= pix2lskip;
+        idelx += pix2lskip << 5;
+    }
+
+        /* How many words of each row of pix1 need to be considered?
+         * Pixels of pix1 to the right of column hicol are masked out
+         * of the last word. */
+    rowwords1 = (hicol + 31) >> 5;
+    lastmask = (hicol & 31) ? 0xffffffff << (32 - (hicol & 31)) : 0xffffffff;
+
+        /* Some rows of pix1 will never contribute to count */
+    untouchable = (downcount) ? downcount[hirow - 1] : 0;
+
+    dispatch = l_cpuGetDispatch();
+    return dispatch->correlCountLow(row1, wpl1, row2, wpl2, hirow - lorow,
+                                    rowwords1, rowwords2, idelx, lastmask,
+                                    threshold,
+                                    (downcount) ? downcount + lorow : NULL,
+                                    untouchable, tab);
+}
@@ -0,0 +1,319 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+
+/*
+ *  correlscorelow.c
+ *
+ *      Count of ON pixels in the AND of two 1 bpp images
+ *            l_int32    correlCountLow()
+ *            l_int32    correlCountPopcntLow()
+ *
+ *      Static helpers
+ *            static l_int32  correlCountRows()
+ *            static l_int32  correlCountRowsPopcnt()
+ */
+
+#include "allheaders.h"
+
+    /* The popcount instruction can be used on x86 with gcc or clang */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define  L_CORREL_POPCNT   1
+#endif
+
+#if defined(L_CORREL_POPCNT)
+static __inline__ l_int32 correlCountRows(l_uint32 *row1, l_int32 wpl1,
+                                          l_uint32 *row2, l_int32 wpl2,
+                                          l_int32 nrows, l_int32 nwords1,
+                                          l_int32 nwords2, l_int32 shift,
+                                          l_uint32 lastmask, l_int32 threshold,
+                                          l_int32 *downcount,
+                                          l_int32 untouchable, l_int32 *tab,
+                                          l_int32 usepopcnt)
+                                          __attribute__((always_inline));
+static l_int32 correlCountRowsPopcnt(l_uint32 *row1, l_int32 wpl1,
+                                     l_uint32 *row2, l_int32 wpl2,
+                                     l_int32 nrows, l_int32 nwords1,
+                                     l_int32 nwords2, l_int32 shift,
+                                     l_uint32 lastmask, l_int32 threshold,
+                                     l_int32 *downcount, l_int32 untouchable,
+                                     l_int32 *tab)
+                                     __attribute__((target("popcnt")));
+#define  COUNT_BITS(w)  ((usepopcnt) ? __builtin_popcount(w) : \
+                         tab[(w) & 0xff] + tab[((w) >> 8) & 0xff] + \
+                         tab[((w) >> 16) & 0xff] + tab[(w) >> 24])
+#else
+static l_int32 correlCountRows(l_uint32 *row1, l_int32 wpl1, l_uint32 *row2,
+                               l_int32 wpl2, l_int32 nrows, l_int32 nwords1,
+                               l_int32 nwords2, l_int32 shift,
+                               l_uint32 lastmask, l_int32 threshold,
+                               l_int32 *downcount, l_int32 untouchable,
+                               l_int32 *tab, l_int32 usepopcnt);
+#define  COUNT_BITS(w)  (tab[(w) & 0xff] + tab[((w) >> 8) & 0xff] + \
+                         tab[((w) >> 16) & 0xff] + tab[(w) >> 24])
+#endif  /* L_CORREL_POPCNT */
+
+
+/*------------------------------------------------------------------*
+ *        Count of ON pixels in the AND of two 1 bpp images         *
+ *------------------------------------------------------------------*/
+/*!
+ *  correlCountLow()
+ *
+ *      Input:  row1 (first word of the first row of pix1 to be used)
+ *              wpl1 (words/line of pix1)
+ *              row2 (first word of the corresponding row of pix2)
+ *              wpl2 (words/line of pix2)
+ *              nrows (number of rows to be used)
+ *              nwords1 (number of words of each row of pix1 to be used)
+ *              nwords2 (number of words in each row of pix2, from row2;
+ *                       nwords2 >= nwords1 - 1, and nwords2 >= nwords1
+ *                       if shift <= 0)
+ *              shift (shift of pix2 to the right, in pixels, with
+ *                     respect to pix1; -31 <= shift <= 31)
+ *              lastmask (mask for the last word of each row of pix1;
+ *                        0 bits are not counted)
+ *              threshold (count at which to stop; ignored if downcount
+ *                         is null)
+ *              downcount (<optional> number of ON pixels in pix1 below
+ *                         each row; use null to count all rows)
+ *              untouchable (number of ON pixels in pix1 below the last
+ *                           row to be used; ignored if downcount is null)
+ *              tab (sum tab for byte)
+ *      Return: count (of ON pixels in the AND, up to the row where it
+ *                     was stopped)
+ *
+ *  Notes:
+ *      (1) For a shift to the right, word x of pix1 is compared with
+ *          the shifted bits of words x - 1 and x of pix2; for a shift
+ *          to the left, with words x and x + 1.  The word of pix2 that
+ *          is used twice is carried over to the next iteration, so
+ *          each word of both images is read once.  Words beyond the
+ *          row of pix2 are taken to be 0.
+ *      (2) If downcount is defined, the count is checked after each row,
+ *          and returned as soon as it reaches the threshold, or when
+ *          the count plus the number of ON pixels in pix1 that remain
+ *          to be compared is less than the threshold.  The downcount
+ *          array is indexed from @row1, so the caller must offset it
+ *          by the first row used.
+ *      (3) This is the generic implementation that is called through
+ *          the dispatch table; see cpu.c.
+ */
+l_int32
+correlCountLow(l_uint32  *row1,
+               l_int32    wpl1,
+               l_uint32  *row2,
+               l_int32    wpl2,
+               l_int32    nrows,
+               l_int32    nwords1,
+               l_int32    nwords2,
+               l_int32    shift,
+               l_uint32   lastmask,
+               l_int32    threshold,
+               l_int32   *downcount,
+               l_int32    untouchable,
+               l_int32   *tab)
+{
+    return correlCountRows(row1, wpl1, row2, wpl2, nrows, nwords1, nwords2,
+                           shift, lastmask, threshold, downcount,
+                           untouchable, tab, FALSE);
+}
+
+
+/*!
+ *  correlCountPopcntLow()
+ *
+ *      Input:  same as correlCountLow()
+ *      Return: count
+ *
+ *  Notes:
+ *      (1) This gives the same result as correlCountLow(), using the
+ *          popcount instruction instead of the table.  It must only
+ *          be called on a cpu that has the instruction; it is used
+ *          for the avx2 and avx512 tiers in the dispatch table.
+ *      (2) Where the instruction is not available to the compiler,
+ *          this is the same as correlCountLow().
+ */
+l_int32
+correlCountPopcntLow(l_uint32  *row1,
+                     l_int32    wpl1,
+                     l_uint32  *row2,
+                     l_int32    wpl2,
+                     l_int32    nrows,
+                     l_int32    nwords1,
+                     l_int32    nwords2,
+                     l_int32    shift,
+                     l_uint32   lastmask,
+                     l_int32    threshold,
+                     l_int32   *downcount,
+                     l_int32    untouchable,
+                     l_int32   *tab)
+{
+#if defined(L_CORREL_POPCNT)
+    return correlCountRowsPopcnt(row1, wpl1, row2, wpl2, nrows, nwords1,
+                                 nwords2, shift, lastmask, threshold,
+                                 downcount, untouchable, tab);
+#else
+    return correlCountRows(row1, wpl1, row2, wpl2, nrows, nwords1, nwords2,
+                           shift, lastmask, threshold, downcount,
+                           untouchable, tab, FALSE);
+#endif  /* L_CORREL_POPCNT */
+}
+
+
+/*------------------------------------------------------------------*
+ *                          Static helpers                          *
+ *------------------------------------------------------------------*/
+#if defined(L_CORREL_POPCNT)
+/*!
+ *  correlCountRowsPopcnt()
+ *
+ *      Input:  same as correlCountLow()
+ *      Return: count
+ *
+ *  Notes:
+ *      (1) correlCountRows() is inlined here, so that it is compiled
+ *          with the popcount instruction.
+ */
+static l_int32
+correlCountRowsPopcnt(l_uint32  *row1,
+                      l_int32    wpl1,
+                      l_uint32  *row2,
+                      l_int32    wpl2,
+                      l_int32    nrows,
+                      l_int32    nwords1,
+                      l_int32    nwords2,
+                      l_int32    shift,
+                      l_uint32   lastmask,
+                      l_int32    threshold,
+                      l_int32   *downcount,
+                      l_int32    untouchable,
+                      l_int32   *tab)
+{
+    return correlCountRows(row1, wpl1, row2, wpl2, nrows, nwords1, nwords2,
+                           shift, lastmask, threshold, downcount,
+                           untouchable, tab, TRUE);
+}
+#endif  /* L_CORREL_POPCNT */
+
+
+/*!
+ *  correlCountRows()
+ *
+ *      Input:  row1, wpl1, row2, wpl2, nrows, nwords1, nwords2, shift,
+ *              lastmask, threshold, downcount, untouchable, tab
+ *                  (see correlCountLow())
+ *              usepopcnt (1 to use the popcount instruction; 0 to use tab)
+ *      Return: count
+ *
+ *  Notes:
+ *      (1) Rows of a single word, which are typical for characters
+ *          scanned at 300 ppi, are handled separately.
+ */
+static l_int32
+correlCountRows(l_uint32  *row1,
+                l_int32    wpl1,
+                l_uint32  *row2,
+                l_int32    wpl2,
+                l_int32    nrows,
+                l_int32    nwords1,
+                l_int32    nwords2,
+                l_int32    shift,
+                l_uint32   lastmask,
+                l_int32    threshold,
+                l_int32   *downcount,
+                l_int32    untouchable,
+                l_int32   *tab,
+                l_int32    usepopcnt)
+{
+l_int32   i, x, count, lshift, rshift;
+l_uint32  andw, prev, cur, next;
+
+    count = 0;
+    lshift = (shift > 0) ? 32 - shift : -shift;
+    rshift = (shift > 0) ? shift : 32 + shift;
+
+    if (nwords1 == 1) {
+        if (shift > 0 && nwords2 == 0)
+            return 0;
+        for (i = 0; i < nrows; i++, row1 += wpl1, row2 += wpl2) {
+            if (shift == 0)
+                andw = row2[0];
+            else if (shift > 0)
+                andw = row2[0] >> rshift;
+            else if (nwords2 > 1)
+                andw = (row2[0] << lshift) | (row2[1] >> rshift);
+            else
+                andw = row2[0] << lshift;
+            andw &= row1[0] & lastmask;
+            count += COUNT_BITS(andw);
+            if (downcount && (count >= threshold ||
+                count + downcount[i] - untouchable < threshold))
+                break;
+        }
+        return count;
+    }
+
+    for (i = 0; i < nrows; i++, row1 += wpl1, row2 += wpl2) {
+        if (shift == 0) {
+            for (x = 0; x < nwords1 - 1; x++) {
+                andw = row1[x] & row2[x];
+                count += COUNT_BITS(andw);
+            }
+            andw = row1[x] & row2[x] & lastmask;
+            count += COUNT_BITS(andw);
+        } else if (shift > 0) {  /* pix2 is shifted to the right */
+            prev = 0;
+            for (x = 0; x < nwords1 - 1; x++) {
+                cur = row2[x];
+                andw = row1[x] & ((cur >> rshift) | (prev << lshift));
+                count += COUNT_BITS(andw);
+                prev = cur;
+            }
+            cur = (nwords1 <= nwords2) ? row2[x] : 0;
+            andw = row1[x] & lastmask & ((cur >> rshift) | (prev << lshift));
+            count += COUNT_BITS(andw);
+        } else {  /* pix2 is shifted to the left */
+            cur = row2[0];
+            for (x = 0; x < nwords1 - 1; x++) {
+                next = row2[x + 1];
+                andw = row1[x] & ((cur << lshift) | (next >> rshift));
+                count += COUNT_BITS(andw);
+                cur = next;
+            }
+            next = (nwords1 < nwords2) ? row2[nwords1] : 0;
+            andw = row1[x] & lastmask & ((cur << lshift) | (next >> rshift));
+            count += COUNT_BITS(andw);
+        }
+
+        if (downcount && (count >= threshold ||
+            count + downcount[i] - untouchable < threshold))
+            break;
+    }
+
+    return count;
+}
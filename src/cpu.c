@@ -0,0 +1,384 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+/*
+ *  cpu.c
+ *
+ *      CPU feature detection
+ *           l_int32           l_cpuGetFeatures()
+ *           l_int32           l_cpuGetBestTier()
+ *
+ *      Dispatch tier control
+ *           l_int32           l_cpuGetTier()
+ *           l_int32           l_cpuSetTier()
+ *           const char       *l_cpuGetTierName()
+ *
+ *      Dispatch table
+ *           L_CPU_DISPATCH   *l_cpuGetDispatch()
+ *
+ *      Static helpers
+ *           static l_int32    cpuDetectFeatures()
+ *           static void       cpuFillDispatch()
+ *
+ *  The cpu is queried once, on the first call to any function here.
+ *  The dispatch table holds pointers to the low-level functions
+ *  for rasterop, scaling, grayscale morphology, arithmetic,
+ *  conversion and binary correlation.  The high-level functions
+ *  call through the table:
+ *
+ *       L_CPU_DISPATCH  *dispatch = l_cpuGetDispatch();
+ *       dispatch->rasteropLow(...);
+ *
+ *  so that a single binary can use the best implementation for
+ *  the machine it is running on.  For testing, any tier that the
+ *  cpu supports can be forced with l_cpuSetTier(); to go back
+ *  to the default, call l_cpuSetTier(l_cpuGetBestTier()).
+ *
+ *  Each tier starts with the generic (portable C) implementations,
+ *  which are the reference.  Where an implementation specialized for
+ *  a tier exists, cpuFillDispatch() substitutes it, and it must give
+ *  identical results.  At present the only specialized function is
+ *  correlCountPopcntLow(), for the avx2 and avx512 tiers; otherwise
+ *  all tiers use the generic functions, which are written to be
+ *  word-parallel and friendly to compiler vectorization.
+ *
+ *  Detection on x86 uses the cpuid instruction (and xgetbv, to verify
+ *  that the OS saves the wide vector registers), with gcc, clang or
+ *  MSVC.  NEON is reported on ARM when the compiler targets it.
+ *  On other platforms, or with other compilers, no features are
+ *  reported and only the generic tier is available.
+ *
+ *  Note: detection and table initialization are not protected by a
+ *  lock.  They are idempotent, so a race on first use is benign,
+ *  but l_cpuSetTier() should not be called while other threads
+ *  are running leptonica functions.
+ */
+
+#include <string.h>
+#include "allheaders.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define  L_CPU_X86_GCC   1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define  L_CPU_X86_MSVC  1
+#endif
+
+static l_int32 cpuDetectFeatures(void);
+static void cpuFillDispatch(L_CPU_DISPATCH *dispatch, l_int32 tier);
+
+static const char  *CpuTierNames[] = {"generic", "sse4.1", "avx2",
+                                      "avx512", "neon"};
+
+    /* Cpu state; features is -1 until detection has been done */
+static l_int32         CpuFeatures = -1;
+static l_int32         CpuBestTier = L_CPU_TIER_GENERIC;
+static L_CPU_DISPATCH  CpuDispatch;
+static l_int32         CpuDispatchReady = 0;
+
+
+/*------------------------------------------------------------------*
+ *                       CPU feature detection                      *
+ *------------------------------------------------------------------*/
+/*!
+ *  l_cpuGetFeatures()
+ *
+ *      Return: features (bitwise 'or' of L_CPU_SSE2, L_CPU_SSE41, etc.)
+ *
+ *  Notes:
+ *      (1) The cpu is only queried on the first call.
+ */
+l_int32
+l_cpuGetFeatures(void)
+{
+    if (CpuFeatures < 0) {
+        CpuFeatures = cpuDetectFeatures();
+        if (CpuFeatures & L_CPU_AVX512)
+            CpuBestTier = L_CPU_TIER_AVX512;
+        else if (CpuFeatures & L_CPU_AVX2)
+            CpuBestTier = L_CPU_TIER_AVX2;
+        else if (CpuFeatures & L_CPU_SSE41)
+            CpuBestTier = L_CPU_TIER_SSE41;
+        else if (CpuFeatures & L_CPU_NEON)
+            CpuBestTier = L_CPU_TIER_NEON;
+        else
+            CpuBestTier = L_CPU_TIER_GENERIC;
+    }
+    return CpuFeatures;
+}
+
+
+/*!
+ *  l_cpuGetBestTier()
+ *
+ *      Return: tier (the best dispatch tier supported by the cpu)
+ */
+l_int32
+l_cpuGetBestTier(void)
+{
+    l_cpuGetFeatures();
+    return CpuBestTier;
+}
+
+
+/*------------------------------------------------------------------*
+ *                       Dispatch tier control                      *
+ *------------------------------------------------------------------*/
+/*!
+ *  l_cpuGetTier()
+ *
+ *      Return: tier (currently used by the dispatch table)
+ */
+l_int32
+l_cpuGetTier(void)
+{
+    return l_cpuGetDispatch()->tier;
+}
+
+
+/*!
+ *  l_cpuSetTier()
+ *
+ *      Input:  tier (L_CPU_TIER_GENERIC, L_CPU_TIER_SSE41, ...)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) This forces the dispatch table to use the implementations
+ *          of the given tier.  It is intended for testing and timing
+ *          different implementations on the same machine.
+ *      (2) It is an error to request a tier that the cpu does not
+ *          support; in that case the table is not changed.
+ *          L_CPU_TIER_GENERIC is always supported.
+ */
+l_int32
+l_cpuSetTier(l_int32  tier)
+{
+l_int32  features, required;
+
+    PROCNAME("l_cpuSetTier");
+
+    features = l_cpuGetFeatures();
+    switch (tier)
+    {
+    case L_CPU_TIER_GENERIC:
+        required = 0;
+        break;
+    case L_CPU_TIER_SSE41:
+        required = L_CPU_SSE41;
+        break;
+    case L_CPU_TIER_AVX2:
+        required = L_CPU_AVX2;
+        break;
+    case L_CPU_TIER_AVX512:
+        required = L_CPU_AVX512;
+        break;
+    case L_CPU_TIER_NEON:
+        required = L_CPU_NEON;
+        break;
+    default:
+        return ERROR_INT("invalid tier", procName, 1);
+    }
+    if ((features & required) != required)
+        return ERROR_INT("tier not supported by this cpu", procName, 1);
+
+    cpuFillDispatch(&CpuDispatch, tier);
+    CpuDispatchReady = 1;
+    return 0;
+}
+
+
+/*!
+ *  l_cpuGetTierName()
+ *
+ *      Input:  tier
+ *      Return: name (of the tier; not owned by caller), or null on error
+ */
+const char *
+l_cpuGetTierName(l_int32  tier)
+{
+    PROCNAME("l_cpuGetTierName");
+
+    if (tier < L_CPU_TIER_GENERIC || tier > L_CPU_TIER_NEON)
+        return (const char *)ERROR_PTR("invalid tier", procName, NULL);
+    return CpuTierNames[tier];
+}
+
+
+/*------------------------------------------------------------------*
+ *                          Dispatch table                          *
+ *------------------------------------------------------------------*/
+/*!
+ *  l_cpuGetDispatch()
+ *
+ *      Return: dispatch table (not owned by caller)
+ *
+ *  Notes:
+ *      (1) On the first call, the table is filled for the best tier
+ *          supported by the cpu.  This never fails.
+ */
+L_CPU_DISPATCH *
+l_cpuGetDispatch(void)
+{
+    if (!CpuDispatchReady) {
+        cpuFillDispatch(&CpuDispatch, l_cpuGetBestTier());
+        CpuDispatchReady = 1;
+    }
+    return &CpuDispatch;
+}
+
+
+/*------------------------------------------------------------------*
+ *                          Static helpers                          *
+ *------------------------------------------------------------------*/
+/*!
+ *  cpuDetectFeatures()
+ *
+ *      Return: features
+ *
+ *  Notes:
+ *      (1) AVX2 and AVX-512 are only reported if the OS has enabled
+ *          saving of the ymm (and zmm) registers, as given by XCR0.
+ */
+static l_int32
+cpuDetectFeatures(void)
+{
+l_int32   features;
+#if defined(L_CPU_X86_GCC) || defined(L_CPU_X86_MSVC)
+l_uint32  maxleaf, eax, ebx, ecx, edx, xcr0;
+#endif
+#if defined(L_CPU_X86_MSVC)
+int       regs[4];
+#endif
+
+    features = 0;
+
+#if defined(L_CPU_X86_GCC) || defined(L_CPU_X86_MSVC)
+#if defined(L_CPU_X86_GCC)
+    maxleaf = __get_cpuid_max(0, NULL);
+    if (maxleaf < 1)
+        return 0;
+    __cpuid_count(1, 0, eax, ebx, ecx, edx);
+#else  /* L_CPU_X86_MSVC */
+    __cpuid(regs, 0);
+    maxleaf = regs[0];
+    if (maxleaf < 1)
+        return 0;
+    __cpuidex(regs, 1, 0);
+    eax = regs[0];
+    ebx = regs[1];
+    ecx = regs[2];
+    edx = regs[3];
+#endif  /* L_CPU_X86_GCC */
+
+    if (edx & (1 << 26))
+        features |= L_CPU_SSE2;
+    if (ecx & (1 << 19))
+        features |= L_CPU_SSE41;
+
+        /* The wide registers require both cpu support for AVX and
+         * the OS to be saving their state (osxsave and XCR0) */
+    xcr0 = 0;
+    if ((ecx & (1 << 27)) && (ecx & (1 << 28))) {
+#if defined(L_CPU_X86_GCC)
+        __asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+        xcr0 = eax;
+#else
+        xcr0 = (l_uint32)_xgetbv(0);
+#endif
+    }
+    if (maxleaf >= 7 && (xcr0 & 0x6) == 0x6) {
+#if defined(L_CPU_X86_GCC)
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+#else
+        __cpuidex(regs, 7, 0);
+        ebx = regs[1];
+#endif
+        if (ebx & (1 << 5))
+            features |= L_CPU_AVX2;
+        if ((ebx & (1 << 16)) && (xcr0 & 0xe6) == 0xe6)
+            features |= L_CPU_AVX512;
+    }
+#endif  /* x86 */
+
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    features |= L_CPU_NEON;
+#endif  /* ARM */
+
+    return features;
+}
+
+
+/*!
+ *  cpuFillDispatch()
+ *
+ *      Input:  dispatch (table to be filled)
+ *              tier (which must be supported by the cpu)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) All entries are first set to the generic implementations.
+ *          An implementation for a specific tier replaces the generic
+ *          one in the switch below; tiers without any specialized
+ *          functions fall through to the generic ones.
+ */
+static void
+cpuFillDispatch(L_CPU_DISPATCH  *dispatch,
+                l_int32          tier)
+{
+    memset(dispatch, 0, sizeof(L_CPU_DISPATCH));
+    dispatch->tier = tier;
+    dispatch->rasteropUniLow = rasteropUniLow;
+    dispatch->rasteropLow = rasteropLow;
+    dispatch->scaleGrayLILow = scaleGrayLILow;
+    dispatch->scaleColorLILow = scaleColorLILow;
+    dispatch->scaleGrayAreaMapLow = scaleGrayAreaMapLow;
+    dispatch->scaleColorAreaMapLow = scaleColorAreaMapLow;
+    dispatch->dilateGrayLow = dilateGrayLow;
+    dispatch->erodeGrayLow = erodeGrayLow;
+    dispatch->addConstantGrayLow = addConstantGrayLow;
+    dispatch->multConstantGrayLow = multConstantGrayLow;
+    dispatch->addGrayLow = addGrayLow;
+    dispatch->thresholdToBinaryLow = thresholdToBinaryLow;
+    dispatch->correlCountLow = correlCountLow;
+
+    switch (tier)
+    {
+    case L_CPU_TIER_AVX512:
+    case L_CPU_TIER_AVX2:
+            /* Every cpu with avx2 has the popcount instruction */
+        dispatch->correlCountLow = correlCountPopcntLow;
+        break;
+    case L_CPU_TIER_SSE41:
+    case L_CPU_TIER_NEON:
+    case L_CPU_TIER_GENERIC:
+    default:
+        break;
+    }
+
+    return;
+}
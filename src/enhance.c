@@ -48,6 +48,8 @@
  *      Unsharp-masking
  *           PIX     *pixUnsharpMasking()
  *           PIX     *pixUnsharpMaskingGray()
+ *           PIX     *pixUnsharpMaskingGauss()
+ *           PIX     *pixUnsharpMaskingGrayGauss()
  *           PIX     *pixUnsharpMaskingFast()
  *           PIX     *pixUnsharpMaskingGrayFast()
  *           PIX     *pixUnsharpMaskingGray1D()
@@ -870,6 +872,8 @@ l_uint32  *data, *datam, *line, *linem;
  *      (2) The fract parameter is typically taken in the
  *          range:  0.2 < fract < 0.7
  *      (3) Returns a clone if no sharpening is requested.
+ *      (4) For smoothing with a gaussian instead of a block filter,
+ *          use pixUnsharpMaskingGauss().
  */
 PIX *
 pixUnsharpMasking(PIX       *pixs,
@@ -995,6 +999,119 @@ PIXACC  *pixacc;
 }
 
 
+/*!
+ *  pixUnsharpMaskingGauss()
+ *
+ *      Input:  pixs (all depths except 1 bpp; with or without colormaps)
+ *              sigma  (standard deviation of the gaussian smoothing)
+ *              fract  (fraction of edge added back into image)
+ *      Return: pixd, or null on error
+ *
+ *  Notes:
+ *      (1) This is the same as pixUnsharpMasking(), except that the
+ *          low frequency part is found with a gaussian of standard
+ *          deviation @sigma, rather than with a block filter.
+ *          The time is independent of @sigma; see pixConvolveGaussian().
+ *      (2) Returns a clone if no sharpening is requested.
+ */
+PIX *
+pixUnsharpMaskingGauss(PIX       *pixs,
+                       l_float32  sigma,
+                       l_float32  fract)
+{
+l_int32  d;
+PIX     *pixt, *pixd, *pixr, *pixrs, *pixg, *pixgs, *pixb, *pixbs;
+
+    PROCNAME("pixUnsharpMaskingGauss");
+
+    if (!pixs || (pixGetDepth(pixs) == 1))
+        return (PIX *)ERROR_PTR("pixs not defined or 1 bpp", procName, NULL);
+    if (fract <= 0.0 || sigma <= 0.0) {
+        L_WARNING("no sharpening requested; clone returned", procName);
+        return pixClone(pixs);
+    }
+    if (sigma < 0.5)
+        return (PIX *)ERROR_PTR("sigma < 0.5", procName, NULL);
+
+        /* Remove colormap; clone if possible; result is either 8 or 32 bpp */
+    if ((pixt = pixConvertTo8Or32(pixs, 0, 1)) == NULL)
+        return (PIX *)ERROR_PTR("pixt not made", procName, NULL);
+
+        /* Sharpen */
+    d = pixGetDepth(pixt);
+    if (d == 8)
+        pixd = pixUnsharpMaskingGrayGauss(pixt, sigma, fract);
+    else {  /* d == 32 */
+        pixr = pixGetRGBComponent(pixt, COLOR_RED);
+        pixrs = pixUnsharpMaskingGrayGauss(pixr, sigma, fract);
+        pixDestroy(&pixr);
+        pixg = pixGetRGBComponent(pixt, COLOR_GREEN);
+        pixgs = pixUnsharpMaskingGrayGauss(pixg, sigma, fract);
+        pixDestroy(&pixg);
+        pixb = pixGetRGBComponent(pixt, COLOR_BLUE);
+        pixbs = pixUnsharpMaskingGrayGauss(pixb, sigma, fract);
+        pixDestroy(&pixb);
+        pixd = pixCreateRGBImage(pixrs, pixgs, pixbs);
+        pixDestroy(&pixrs);
+        pixDestroy(&pixgs);
+        pixDestroy(&pixbs);
+    }
+
+    pixDestroy(&pixt);
+    return pixd;
+}
+
+
+/*!
+ *  pixUnsharpMaskingGrayGauss()
+ *
+ *      Input:  pixs (8 bpp; no colormap)
+ *              sigma  (standard deviation of the gaussian smoothing)
+ *              fract  (fraction of edge added back into image)
+ *      Return: pixd, or null on error
+ *
+ *  Notes:
+ *      (1) See pixUnsharpMaskingGauss().
+ *      (2) Returns a clone if no sharpening is requested.
+ */
+PIX *
+pixUnsharpMaskingGrayGauss(PIX       *pixs,
+                           l_float32  sigma,
+                           l_float32  fract)
+{
+l_int32  w, h, d;
+PIX     *pixc, *pixd;
+PIXACC  *pixacc;
+
+    PROCNAME("pixUnsharpMaskingGrayGauss");
+
+    if (!pixs)
+        return (PIX *)ERROR_PTR("pixs not defined", procName, NULL);
+    pixGetDimensions(pixs, &w, &h, &d);
+    if (d != 8 || pixGetColormap(pixs) != NULL)
+        return (PIX *)ERROR_PTR("pixs not 8 bpp or has cmap", procName, NULL);
+    if (fract <= 0.0 || sigma <= 0.0) {
+        L_WARNING("no sharpening requested; clone returned", procName);
+        return pixClone(pixs);
+    }
+
+    if ((pixc = pixConvolveGaussian(pixs, sigma)) == NULL)
+        return (PIX *)ERROR_PTR("pixc not made", procName, NULL);
+
+        /* pixd = pixs + fract * (pixs - pixc); see pixUnsharpMaskingGray() */
+    pixacc = pixaccCreate(w, h, 1);
+    pixaccAdd(pixacc, pixs);
+    pixaccSubtract(pixacc, pixc);
+    pixaccMultConst(pixacc, fract);
+    pixaccAdd(pixacc, pixs);
+    pixd = pixaccFinal(pixacc, 8);
+    pixaccDestroy(&pixacc);
+
+    pixDestroy(&pixc);
+    return pixd;
+}
+
+
 /*!
  *  pixUnsharpMaskingFast()
  *
@@ -151,6 +151,8 @@ typedef short                   l_int16;
 typedef unsigned short          l_uint16;
 typedef int                     l_int32;
 typedef unsigned int            l_uint32;
+typedef long long               l_int64;
+typedef unsigned long long      l_uint64;
 typedef float                   l_float32;
 typedef double                  l_float64;
 
@@ -214,6 +216,75 @@ enum {
 };
 
 
+/*------------------------------------------------------------------------*
+ *                 CPU features and low-level dispatch                    *
+ *                                                                        *
+ *  The features are detected once at run time; see cpu.c.  The tier     *
+ *  selects the implementation of each low-level function that is        *
+ *  called through the dispatch table.  It defaults to the best tier     *
+ *  supported by the cpu, and can be forced with l_cpuSetTier().         *
+ *------------------------------------------------------------------------*/
+enum {
+    L_CPU_SSE2 = 1,                 /* x86 SSE2                          */
+    L_CPU_SSE41 = 2,                /* x86 SSE4.1                        */
+    L_CPU_AVX2 = 4,                 /* x86 AVX2, with OS support         */
+    L_CPU_AVX512 = 8,               /* x86 AVX-512F, with OS support     */
+    L_CPU_NEON = 16                 /* ARM NEON                          */
+};
+
+enum {
+    L_CPU_TIER_GENERIC = 0,         /* portable C                        */
+    L_CPU_TIER_SSE41 = 1,           /* requires L_CPU_SSE41              */
+    L_CPU_TIER_AVX2 = 2,            /* requires L_CPU_AVX2               */
+    L_CPU_TIER_AVX512 = 3,          /* requires L_CPU_AVX512             */
+    L_CPU_TIER_NEON = 4             /* requires L_CPU_NEON               */
+};
+
+struct L_CpuDispatch
+{
+    l_int32    tier;                /* tier of these implementations     */
+        /* rasterop */
+    void     (*rasteropUniLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                               l_int32, l_int32, l_int32, l_int32,
+                               l_int32, l_int32);
+    void     (*rasteropLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                            l_int32, l_int32, l_int32, l_int32, l_int32,
+                            l_int32, l_uint32 *, l_int32, l_int32,
+                            l_int32, l_int32, l_int32);
+        /* scaling */
+    void     (*scaleGrayLILow)(l_uint32 *, l_int32, l_int32, l_int32,
+                               l_uint32 *, l_int32, l_int32, l_int32);
+    void     (*scaleColorLILow)(l_uint32 *, l_int32, l_int32, l_int32,
+                                l_uint32 *, l_int32, l_int32, l_int32);
+    void     (*scaleGrayAreaMapLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                                    l_uint32 *, l_int32, l_int32, l_int32);
+    void     (*scaleColorAreaMapLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                                     l_uint32 *, l_int32, l_int32, l_int32);
+        /* grayscale morphology */
+    void     (*dilateGrayLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                              l_uint32 *, l_int32, l_int32, l_int32,
+                              l_uint8 *, l_uint8 *);
+    void     (*erodeGrayLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                             l_uint32 *, l_int32, l_int32, l_int32,
+                             l_uint8 *, l_uint8 *);
+        /* arithmetic */
+    void     (*addConstantGrayLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                                   l_int32, l_int32);
+    void     (*multConstantGrayLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                                    l_int32, l_float32);
+    void     (*addGrayLow)(l_uint32 *, l_int32, l_int32, l_int32, l_int32,
+                           l_uint32 *, l_int32);
+        /* conversion */
+    void     (*thresholdToBinaryLow)(l_uint32 *, l_int32, l_int32, l_int32,
+                                     l_uint32 *, l_int32, l_int32, l_int32);
+        /* binary correlation */
+    l_int32  (*correlCountLow)(l_uint32 *, l_int32, l_uint32 *, l_int32,
+                               l_int32, l_int32, l_int32, l_int32, l_uint32,
+                               l_int32, l_int32 *, l_int32, l_int32 *);
+};
+typedef struct L_CpuDispatch  L_CPU_DISPATCH;
+
+
 /*------------------------------------------------------------------------*
  *                      Standard memory allocation                        *
  *
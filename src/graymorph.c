@@ -83,11 +83,12 @@ pixErodeGray(PIX     *pixs,
              l_int32  hsize,
              l_int32  vsize)
 {
-l_uint8   *buffer, *minarray;
-l_int32    w, h, wplb, wplt;
-l_int32    leftpix, rightpix, toppix, bottompix, maxsize;
-l_uint32  *datab, *datat;
-PIX       *pixb, *pixt, *pixd;
+l_uint8         *buffer, *minarray;
+l_int32          w, h, wplb, wplt;
+l_int32          leftpix, rightpix, toppix, bottompix, maxsize;
+l_uint32        *datab, *datat;
+PIX             *pixb, *pixt, *pixd;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixErodeGray");
 
@@ -146,19 +147,20 @@ PIX       *pixb, *pixt, *pixd;
     if ((minarray = (l_uint8 *)CALLOC(2 * maxsize, sizeof(l_uint8))) == NULL)
         return (PIX *)ERROR_PTR("minarray not made", procName, NULL);
 
+    dispatch = l_cpuGetDispatch();
     if (vsize == 1)
-        erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                     buffer, minarray);
+        dispatch->erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                               buffer, minarray);
     else if (hsize == 1)
-        erodeGrayLow(datat, w, h, wplt, datab, wplb, vsize, L_VERT,
-                     buffer, minarray);
+        dispatch->erodeGrayLow(datat, w, h, wplt, datab, wplb, vsize, L_VERT,
+                               buffer, minarray);
     else {
-        erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                     buffer, minarray);
+        dispatch->erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                               buffer, minarray);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_SET);
-        erodeGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
-                     buffer, minarray);
+        dispatch->erodeGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
+                               buffer, minarray);
         pixDestroy(&pixt);
         pixt = pixClone(pixb);
     }
@@ -192,11 +194,12 @@ pixDilateGray(PIX     *pixs,
               l_int32  hsize,
               l_int32  vsize)
 {
-l_uint8   *buffer, *maxarray;
-l_int32    w, h, wplb, wplt;
-l_int32    leftpix, rightpix, toppix, bottompix, maxsize;
-l_uint32  *datab, *datat;
-PIX       *pixb, *pixt, *pixd;
+l_uint8         *buffer, *maxarray;
+l_int32          w, h, wplb, wplt;
+l_int32          leftpix, rightpix, toppix, bottompix, maxsize;
+l_uint32        *datab, *datat;
+PIX             *pixb, *pixt, *pixd;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixDilateGray");
 
@@ -255,19 +258,20 @@ PIX       *pixb, *pixt, *pixd;
     if ((maxarray = (l_uint8 *)CALLOC(2 * maxsize, sizeof(l_uint8))) == NULL)
         return (PIX *)ERROR_PTR("buffer not made", procName, NULL);
 
+    dispatch = l_cpuGetDispatch();
     if (vsize == 1)
-        dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                      buffer, maxarray);
+        dispatch->dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                                buffer, maxarray);
     else if (hsize == 1)
-        dilateGrayLow(datat, w, h, wplt, datab, wplb, vsize, L_VERT,
-                      buffer, maxarray);
+        dispatch->dilateGrayLow(datat, w, h, wplt, datab, wplb, vsize, L_VERT,
+                                buffer, maxarray);
     else {
-        dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                      buffer, maxarray);
+        dispatch->dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                                buffer, maxarray);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_CLR);
-        dilateGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
-                      buffer, maxarray);
+        dispatch->dilateGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
+                                buffer, maxarray);
         pixDestroy(&pixt);
         pixt = pixClone(pixb);
     }
@@ -301,12 +305,13 @@ pixOpenGray(PIX     *pixs,
             l_int32  hsize,
             l_int32  vsize)
 {
-l_uint8   *buffer;
-l_uint8   *array;  /* used to find either min or max in interval */
-l_int32    w, h, wplb, wplt;
-l_int32    leftpix, rightpix, toppix, bottompix, maxsize;
-l_uint32  *datab, *datat;
-PIX       *pixb, *pixt, *pixd;
+l_uint8         *buffer;
+l_uint8         *array;  /* used to find either min or max in interval */
+l_int32          w, h, wplb, wplt;
+l_int32          leftpix, rightpix, toppix, bottompix, maxsize;
+l_uint32        *datab, *datat;
+PIX             *pixb, *pixt, *pixd;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixOpenGray");
 
@@ -365,37 +370,38 @@ PIX       *pixb, *pixt, *pixd;
     if ((array = (l_uint8 *)CALLOC(2 * maxsize, sizeof(l_uint8))) == NULL)
         return (PIX *)ERROR_PTR("array not made", procName, NULL);
 
+    dispatch = l_cpuGetDispatch();
     if (vsize == 1) {
-        erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                     buffer, array);
+        dispatch->erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                               buffer, array);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_CLR);
-        dilateGrayLow(datab, w, h, wplb, datat, wplt, hsize, L_HORIZ,
-                      buffer, array);
+        dispatch->dilateGrayLow(datab, w, h, wplb, datat, wplt, hsize, L_HORIZ,
+                                buffer, array);
     }
     else if (hsize == 1) {
-        erodeGrayLow(datat, w, h, wplt, datab, wplb, vsize, L_VERT,
-                     buffer, array);
+        dispatch->erodeGrayLow(datat, w, h, wplt, datab, wplb, vsize, L_VERT,
+                               buffer, array);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_CLR);
-        dilateGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
-                      buffer, array);
+        dispatch->dilateGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
+                                buffer, array);
     }
     else {
-        erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                     buffer, array);
+        dispatch->erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                               buffer, array);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_SET);
-        erodeGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
-                     buffer, array);
+        dispatch->erodeGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
+                               buffer, array);
         pixSetOrClearBorder(pixb, leftpix, rightpix, toppix, bottompix,
                             PIX_CLR);
-        dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                      buffer, array);
+        dispatch->dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                                buffer, array);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_CLR);
-        dilateGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
-                      buffer, array);
+        dispatch->dilateGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
+                                buffer, array);
     }
 
     if ((pixd = pixRemoveBorderGeneral(pixb,
@@ -427,12 +433,13 @@ pixCloseGray(PIX     *pixs,
              l_int32  hsize,
              l_int32  vsize)
 {
-l_uint8   *buffer;
-l_uint8   *array;  /* used to find either min or max in interval */
-l_int32    w, h, wplb, wplt;
-l_int32    leftpix, rightpix, toppix, bottompix, maxsize;
-l_uint32  *datab, *datat;
-PIX       *pixb, *pixt, *pixd;
+l_uint8         *buffer;
+l_uint8         *array;  /* used to find either min or max in interval */
+l_int32          w, h, wplb, wplt;
+l_int32          leftpix, rightpix, toppix, bottompix, maxsize;
+l_uint32        *datab, *datat;
+PIX             *pixb, *pixt, *pixd;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixCloseGray");
 
@@ -491,37 +498,38 @@ PIX       *pixb, *pixt, *pixd;
     if ((array = (l_uint8 *)CALLOC(2 * maxsize, sizeof(l_uint8))) == NULL)
         return (PIX *)ERROR_PTR("array not made", procName, NULL);
 
+    dispatch = l_cpuGetDispatch();
     if (vsize == 1) {
-        dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                     buffer, array);
+        dispatch->dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                                buffer, array);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_SET);
-        erodeGrayLow(datab, w, h, wplb, datat, wplt, hsize, L_HORIZ,
-                      buffer, array);
+        dispatch->erodeGrayLow(datab, w, h, wplb, datat, wplt, hsize, L_HORIZ,
+                               buffer, array);
     }
     else if (hsize == 1) {
-        dilateGrayLow(datat, w, h, wplt, datab, wplb, vsize, L_VERT,
-                     buffer, array);
+        dispatch->dilateGrayLow(datat, w, h, wplt, datab, wplb, vsize, L_VERT,
+                                buffer, array);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_SET);
-        erodeGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
-                      buffer, array);
+        dispatch->erodeGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
+                               buffer, array);
     }
     else {
-        dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                      buffer, array);
+        dispatch->dilateGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                                buffer, array);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_CLR);
-        dilateGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
-                      buffer, array);
+        dispatch->dilateGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
+                                buffer, array);
         pixSetOrClearBorder(pixb, leftpix, rightpix, toppix, bottompix,
                             PIX_SET);
-        erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
-                     buffer, array);
+        dispatch->erodeGrayLow(datat, w, h, wplt, datab, wplb, hsize, L_HORIZ,
+                               buffer, array);
         pixSetOrClearBorder(pixt, leftpix, rightpix, toppix, bottompix,
                             PIX_SET);
-        erodeGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
-                     buffer, array);
+        dispatch->erodeGrayLow(datab, w, h, wplb, datat, wplt, vsize, L_VERT,
+                               buffer, array);
     }
 
     if ((pixd = pixRemoveBorderGeneral(pixb,
@@ -226,9 +226,10 @@ PIX *
 pixThresholdToBinary(PIX     *pixs,
                      l_int32  thresh)
 {
-l_int32    d, w, h, wplt, wpld;
-l_uint32  *datat, *datad;
-PIX       *pixt, *pixd;
+l_int32          d, w, h, wplt, wpld;
+l_uint32        *datat, *datad;
+PIX             *pixt, *pixd;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixThresholdToBinary");
 
@@ -260,7 +261,8 @@ PIX       *pixt, *pixd;
         thresh *= 16;
     }
 
-    thresholdToBinaryLow(datad, w, h, wpld, datat, d, wplt, thresh);
+    dispatch = l_cpuGetDispatch();
+    dispatch->thresholdToBinaryLow(datad, w, h, wpld, datat, d, wplt, thresh);
     pixDestroy(&pixt);
     return pixd;
 }
@@ -0,0 +1,399 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ - 
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+/*
+ *   hashmap.c
+ *
+ *      Create/Destroy L_HashMap
+ *          L_HASHMAP   *l_hmapCreate()
+ *          void         l_hmapDestroy()
+ *
+ *      Lookup
+ *          L_HASHITEM  *l_hmapLookup()
+ *          L_HASHITEM  *l_hmapLookupString()
+ *          static L_HASHITEM  *l_hmapFindSlot()
+ *
+ *      Accessors
+ *          l_int32      l_hmapGetCount()
+ *
+ *      Helpers
+ *          static l_int32   l_hmapRehash()
+ *          static l_uint64  l_hmapHashInt()
+ *          static l_uint64  l_hmapHashString()
+ *
+ *    The L_HashMap is a general hash table for integer and string
+ *    keys; see hashmap.h.  Unlike the NumaHash, which has a fixed
+ *    number of buckets chosen by the caller, it grows with the number
+ *    of keys, and keys that collide are kept distinct.
+ *
+ *    The integer keys are scrambled by a mixing function before being
+ *    reduced to a slot index, so that keys with structure, such as
+ *    rgb pixels or packed (w, h) pairs, are spread over all slots.
+ *
+ *    To find all the items in the map, scan the slots in @items,
+ *    from 0 to @nalloc - 1, and take those for which @used is 1.
+ */
+
+#include <string.h>
+#include "allheaders.h"
+
+static const l_int32  MIN_HASHMAP_SIZE = 16;  /* n'importe quoi */
+
+static L_HASHITEM *l_hmapFindSlot(L_HASHMAP *hmap, l_uint64 key,
+                                  const char *str);
+static l_int32 l_hmapRehash(L_HASHMAP *hmap, l_int32 nalloc);
+static l_uint64 l_hmapHashInt(l_uint64 key);
+static l_uint64 l_hmapHashString(const char *str);
+
+
+/*--------------------------------------------------------------------------*
+ *                        L_HashMap create/destroy                          *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  l_hmapCreate()
+ *
+ *      Input:  ninit (expected number of keys; use 0 for default)
+ *              keytype (L_HMAP_INT_KEY, L_HMAP_STRING_KEY)
+ *      Return: hmap, or null on error
+ *
+ *  Notes:
+ *      (1) The map grows as required.  If the number of keys is
+ *          known, giving it as @ninit avoids rehashing.
+ */
+L_HASHMAP *
+l_hmapCreate(l_int32  ninit,
+             l_int32  keytype)
+{
+l_int32     nalloc;
+L_HASHMAP  *hmap;
+
+    PROCNAME("l_hmapCreate");
+
+    if (keytype != L_HMAP_INT_KEY && keytype != L_HMAP_STRING_KEY)
+        return (L_HASHMAP *)ERROR_PTR("invalid keytype", procName, NULL);
+
+        /* Make the array at least twice the expected number of keys */
+    nalloc = MIN_HASHMAP_SIZE;
+    while (nalloc < 2 * ninit && nalloc < (1 << 29))
+        nalloc *= 2;
+
+    if ((hmap = (L_HASHMAP *)CALLOC(1, sizeof(L_HASHMAP))) == NULL)
+        return (L_HASHMAP *)ERROR_PTR("hmap not made", procName, NULL);
+    if ((hmap->items = (L_HASHITEM *)CALLOC(nalloc, sizeof(L_HASHITEM)))
+            == NULL) {
+        FREE(hmap);
+        return (L_HASHMAP *)ERROR_PTR("items not made", procName, NULL);
+    }
+    hmap->keytype = keytype;
+    hmap->nalloc = nalloc;
+    hmap->n = 0;
+    return hmap;
+}
+
+
+/*!
+ *  l_hmapDestroy()
+ *
+ *      Input:  &hmap  (<to be nulled>)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) The copies of the string keys are freed.  Anything owned
+ *          by the ptrs in the items must be freed by the caller
+ *          before calling this.
+ */
+void
+l_hmapDestroy(L_HASHMAP  **phmap)
+{
+l_int32     i;
+L_HASHMAP  *hmap;
+
+    PROCNAME("l_hmapDestroy");
+
+    if (phmap == NULL) {
+        L_WARNING("ptr address is NULL", procName);
+        return;
+    }
+    if ((hmap = *phmap) == NULL)
+        return;
+
+    for (i = 0; i < hmap->nalloc; i++) {
+        if (hmap->items[i].str)
+            FREE(hmap->items[i].str);
+    }
+    FREE(hmap->items);
+    FREE(hmap);
+    *phmap = NULL;
+    return;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                                  Lookup                                  *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  l_hmapLookup()
+ *
+ *      Input:  hmap (with integer keys)
+ *              key
+ *              op (L_HMAP_CHECK, L_HMAP_CREATE)
+ *      Return: item, or null if not found with L_HMAP_CHECK, or on error
+ *
+ *  Notes:
+ *      (1) With L_HMAP_CREATE, a new item has count 1, val 0 and a
+ *          null ptr, and the count of an existing item is incremented.
+ *      (2) The returned ptr is invalidated by a later lookup with
+ *          L_HMAP_CREATE.
+ */
+L_HASHITEM *
+l_hmapLookup(L_HASHMAP  *hmap,
+             l_uint64    key,
+             l_int32     op)
+{
+L_HASHITEM  *item;
+
+    PROCNAME("l_hmapLookup");
+
+    if (!hmap)
+        return (L_HASHITEM *)ERROR_PTR("hmap not defined", procName, NULL);
+    if (hmap->keytype != L_HMAP_INT_KEY)
+        return (L_HASHITEM *)ERROR_PTR("keys not integer", procName, NULL);
+    if (op != L_HMAP_CHECK && op != L_HMAP_CREATE)
+        return (L_HASHITEM *)ERROR_PTR("invalid op", procName, NULL);
+
+    item = l_hmapFindSlot(hmap, key, NULL);
+    if (item->used) {
+        if (op == L_HMAP_CREATE)
+            item->count++;
+        return item;
+    }
+    if (op == L_HMAP_CHECK)
+        return NULL;
+
+        /* Make sure there will be at least half the slots empty */
+    if (2 * (hmap->n + 1) > hmap->nalloc) {
+        if (l_hmapRehash(hmap, 2 * hmap->nalloc))
+            return (L_HASHITEM *)ERROR_PTR("hmap not grown", procName, NULL);
+        item = l_hmapFindSlot(hmap, key, NULL);
+    }
+    item->key = key;
+    item->used = 1;
+    item->count = 1;
+    hmap->n++;
+    return item;
+}
+
+
+/*!
+ *  l_hmapLookupString()
+ *
+ *      Input:  hmap (with string keys)
+ *              str (key)
+ *              op (L_HMAP_CHECK, L_HMAP_CREATE)
+ *      Return: item, or null if not found with L_HMAP_CHECK, or on error
+ *
+ *  Notes:
+ *      (1) A copy of @str is stored in a new item.
+ *      (2) See notes in l_hmapLookup().
+ */
+L_HASHITEM *
+l_hmapLookupString(L_HASHMAP   *hmap,
+                   const char  *str,
+                   l_int32      op)
+{
+l_uint64     key;
+L_HASHITEM  *item;
+
+    PROCNAME("l_hmapLookupString");
+
+    if (!hmap)
+        return (L_HASHITEM *)ERROR_PTR("hmap not defined", procName, NULL);
+    if (hmap->keytype != L_HMAP_STRING_KEY)
+        return (L_HASHITEM *)ERROR_PTR("keys not strings", procName, NULL);
+    if (!str)
+        return (L_HASHITEM *)ERROR_PTR("str not defined", procName, NULL);
+    if (op != L_HMAP_CHECK && op != L_HMAP_CREATE)
+        return (L_HASHITEM *)ERROR_PTR("invalid op", procName, NULL);
+
+    key = l_hmapHashString(str);
+    item = l_hmapFindSlot(hmap, key, str);
+    if (item->used) {
+        if (op == L_HMAP_CREATE)
+            item->count++;
+        return item;
+    }
+    if (op == L_HMAP_CHECK)
+        return NULL;
+
+    if (2 * (hmap->n + 1) > hmap->nalloc) {
+        if (l_hmapRehash(hmap, 2 * hmap->nalloc))
+            return (L_HASHITEM *)ERROR_PTR("hmap not grown", procName, NULL);
+        item = l_hmapFindSlot(hmap, key, str);
+    }
+    if ((item->str = stringNew(str)) == NULL)
+        return (L_HASHITEM *)ERROR_PTR("str not copied", procName, NULL);
+    item->key = key;
+    item->used = 1;
+    item->count = 1;
+    hmap->n++;
+    return item;
+}
+
+
+/*!
+ *  l_hmapFindSlot()
+ *
+ *      Input:  hmap
+ *              key (integer key, or hash of @str)
+ *              str (string key; null for integer keys)
+ *      Return: the slot holding the key, or the empty slot
+ *              where it would be put
+ *
+ *  Notes:
+ *      (1) There is always an empty slot, so the probe terminates.
+ */
+static L_HASHITEM *
+l_hmapFindSlot(L_HASHMAP   *hmap,
+               l_uint64     key,
+               const char  *str)
+{
+l_uint32     mask, index;
+L_HASHITEM  *item;
+
+    mask = hmap->nalloc - 1;
+    index = (l_uint32)l_hmapHashInt(key) & mask;
+    while (1) {
+        item = hmap->items + index;
+        if (!item->used)
+            return item;
+        if (item->key == key && (!str || !strcmp(item->str, str)))
+            return item;
+        index = (index + 1) & mask;
+    }
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                                 Accessors                                *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  l_hmapGetCount()
+ *
+ *      Input:  hmap
+ *      Return: number of keys, or 0 on error
+ */
+l_int32
+l_hmapGetCount(L_HASHMAP  *hmap)
+{
+    PROCNAME("l_hmapGetCount");
+
+    if (!hmap)
+        return ERROR_INT("hmap not defined", procName, 0);
+    return hmap->n;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                                  Helpers                                 *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  l_hmapRehash()
+ *
+ *      Input:  hmap
+ *              nalloc (new number of slots; a power of 2)
+ *      Return: 0 if OK, 1 on error
+ */
+static l_int32
+l_hmapRehash(L_HASHMAP  *hmap,
+             l_int32     nalloc)
+{
+l_int32      i, nold;
+l_uint32     mask, index;
+L_HASHITEM  *itemsold, *item;
+
+    PROCNAME("l_hmapRehash");
+
+    if ((item = (L_HASHITEM *)CALLOC(nalloc, sizeof(L_HASHITEM))) == NULL)
+        return ERROR_INT("new items not made", procName, 1);
+    itemsold = hmap->items;
+    nold = hmap->nalloc;
+    hmap->items = item;
+    hmap->nalloc = nalloc;
+    mask = nalloc - 1;
+    for (i = 0; i < nold; i++) {
+        if (!itemsold[i].used)
+            continue;
+            /* The keys are distinct, so put it in the first empty slot */
+        index = (l_uint32)l_hmapHashInt(itemsold[i].key) & mask;
+        while (hmap->items[index].used)
+            index = (index + 1) & mask;
+        hmap->items[index] = itemsold[i];
+    }
+    FREE(itemsold);
+    return 0;
+}
+
+
+/*!
+ *  l_hmapHashInt()
+ *
+ *      Input:  key
+ *      Return: scrambled key
+ *
+ *  Notes:
+ *      (1) This is the finalizer of MurmurHash3, which is a bijection
+ *          in which each input bit affects every output bit.
+ */
+static l_uint64
+l_hmapHashInt(l_uint64  key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+
+/*!
+ *  l_hmapHashString()
+ *
+ *      Input:  str
+ *      Return: 64 bit FNV-1a hash of the string
+ */
+static l_uint64
+l_hmapHashString(const char  *str)
+{
+l_uint64  hash;
+
+    hash = 0xcbf29ce484222325ULL;
+    while (*str) {
+        hash ^= (l_uint8)(*str++);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
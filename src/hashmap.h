@@ -0,0 +1,90 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ - 
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+#ifndef  LEPTONICA_HASHMAP_H
+#define  LEPTONICA_HASHMAP_H
+
+/*
+ *  hashmap.h
+ *
+ *      Expandable hash map with open addressing
+ *
+ *      The L_HashMap maps keys to items.  The keys are either unsigned
+ *      integers of up to 64 bits, or strings.  Each item holds an
+ *      integer value and a ptr, so the map can be used, for example,
+ *      from a 32 bit color to a count, from a 64 bit size key to an
+ *      array, or from a string to an index.
+ *
+ *      The items are stored by value in an array whose size is a power
+ *      of 2, and collisions are resolved by linear probing.  The array
+ *      is doubled whenever it becomes more than half full, so a lookup
+ *      takes constant expected time, however many keys are stored.
+ *      For string keys, a 64 bit hash of the string is stored with
+ *      a copy of the string, and the strings are compared only when
+ *      the hashes are equal.  Items cannot be removed.
+ *
+ *      An item is found with l_hmapLookup() or l_hmapLookupString().
+ *      With L_HMAP_CREATE, the item is made if the key is not in the
+ *      map, and the count of the item is the number of such lookups
+ *      of its key.  Because the array can be reallocated when a key
+ *      is added, a ptr to an item is only valid until the next lookup
+ *      with L_HMAP_CREATE.
+ */
+
+    /* Type of key */
+enum {
+    L_HMAP_INT_KEY = 1,        /* unsigned integer, up to 64 bits        */
+    L_HMAP_STRING_KEY = 2      /* null-terminated string                 */
+};
+
+    /* Operation for lookup */
+enum {
+    L_HMAP_CHECK = 1,          /* return the item only if it exists      */
+    L_HMAP_CREATE = 2          /* make the item if it doesn't exist      */
+};
+
+struct L_HashItem
+{
+    l_uint64         key;      /* integer key, or hash of string key     */
+    char            *str;      /* copy of string key; NULL for int key   */
+    l_int32          used;     /* 1 if the slot holds an item; else 0    */
+    l_int32          count;    /* number of L_HMAP_CREATE lookups of key */
+    l_int32          val;      /* integer value; initialized to 0        */
+    void            *ptr;      /* ptr value; initialized to NULL         */
+};
+typedef struct L_HashItem  L_HASHITEM;
+
+struct L_HashMap
+{
+    l_int32          keytype;  /* L_HMAP_INT_KEY or L_HMAP_STRING_KEY    */
+    l_int32          nalloc;   /* number of slots; a power of 2          */
+    l_int32          n;        /* number of items stored                 */
+    L_HASHITEM      *items;    /* array of slots                         */
+};
+typedef struct L_HashMap  L_HASHMAP;
+
+
+#endif  /* LEPTONICA_HASHMAP_H */
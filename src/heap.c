@@ -48,6 +48,30 @@
  *      Debug output
  *          l_int32    lheapPrint()
  *
+ *      Create/Destroy L_DHeap
+ *          L_DHEAP   *dheapCreate()
+ *          void       dheapDestroy()
+ *
+ *      Operations to add/remove to/from the 4-ary heap
+ *          l_int32    dheapAdd()
+ *          l_int32    dheapExtendArray()
+ *          l_int32    dheapRemove()
+ *          l_int32    dheapGetCount()
+ *
+ *      4-ary heap operations
+ *          l_int32    dheapSwapUp()
+ *          l_int32    dheapSwapDown()
+ *          l_int32    dheapSort()
+ *          l_int32    dheapSortStrictOrder()
+ *
+ *      Radix heap
+ *          L_RHEAP   *rheapCreate()
+ *          void       rheapDestroy()
+ *          l_int32    rheapAdd()
+ *          l_int32    rheapRemove()
+ *          l_int32    rheapGetCount()
+ *          static l_int32  rheapGetBucket()
+ *
  *    The L_Heap is useful to implement a priority queue, that is sorted
  *    on a key in each element of the heap.  The heap is an array
  *    of nearly arbitrary structs, with a l_float32 the first field.
@@ -70,6 +94,22 @@
  *    choose (but don't) to pass an application-specific comparison
  *    function into the heap operation functions.
  *    --------------------------  N.B.  ------------------------------
+ *
+ *    The L_Heap is a wrapper on the L_DHeap, which holds fixed-size
+ *    items by value in a heap that is 4-ary by default.  The L_Heap
+ *    stores in it the key, read once when the item is added, together
+ *    with the ptr to the item, so that the heap operations never
+ *    dereference the items.  The key of an item must not be changed
+ *    while it is on the heap.  New code that would allocate a struct
+ *    for each item added to a L_Heap can instead use the L_DHeap
+ *    directly.
+ *
+ *    The L_RHeap is a radix heap, for the special case of integer keys
+ *    where no item is added with a key smaller than that of the last
+ *    item removed.  See heap.h for details.
+ *
+ *    The order in which items with equal keys are removed is not
+ *    specified for any of these heaps.
  */
 
 #include <string.h>
@@ -78,9 +118,18 @@
 static const l_int32  MIN_BUFFER_SIZE = 20;             /* n'importe quoi */
 static const l_int32  INITIAL_BUFFER_ARRAYSIZE = 128;   /* n'importe quoi */
 
-#define SWAP_ITEMS(i, j)       { void *tempitem = lh->array[(i)]; \
-                                 lh->array[(i)] = lh->array[(j)]; \
-                                 lh->array[(j)] = tempitem; }
+    /* Item held in the L_DHeap that implements a L_Heap */
+struct L_HeapPtr
+{
+    l_float32   key;
+    void       *ptr;
+};
+typedef struct L_HeapPtr  L_HEAPPTR;
+
+#define DHEAP_ITEM(dh, i)   ((dh)->array + (size_t)(i) * (dh)->itemsize)
+#define DHEAP_KEY(dh, i)    (*(l_float32 *)DHEAP_ITEM(dh, i))
+
+static l_int32 rheapGetBucket(l_uint32 diff);
 
 
 /*--------------------------------------------------------------------------*
@@ -104,13 +153,13 @@ L_HEAP  *lh;
     if (nalloc < MIN_BUFFER_SIZE)
         nalloc = MIN_BUFFER_SIZE;
 
-        /* Allocate ptr array and initialize counters. */
     if ((lh = (L_HEAP *)CALLOC(1, sizeof(L_HEAP))) == NULL)
         return (L_HEAP *)ERROR_PTR("lh not made", procName, NULL);
-    if ((lh->array = (void **)CALLOC(nalloc, sizeof(void *))) == NULL)
-        return (L_HEAP *)ERROR_PTR("ptr array not made", procName, NULL);
-    lh->nalloc = nalloc;
-    lh->n = 0;
+    if ((lh->dh = dheapCreate(sizeof(L_HEAPPTR), nalloc, direction)) == NULL) {
+        FREE(lh);
+        return (L_HEAP *)ERROR_PTR("dh not made", procName, NULL);
+    }
+    lh->dh->arity = 2;  /* preserve the order of removal for equal keys */
     lh->direction = direction;
     return lh;
 }
@@ -136,8 +185,9 @@ void
 lheapDestroy(L_HEAP  **plh,
              l_int32   freeflag)
 {
-l_int32  i;
-L_HEAP  *lh;
+l_int32   i, n;
+L_HEAP   *lh;
+L_DHEAP  *dh;
 
     PROCNAME("lheapDestroy");
 
@@ -148,18 +198,19 @@ L_HEAP  *lh;
     if ((lh = *plh) == NULL)
         return;
 
-    if (freeflag) {  /* free each struct in the array */
-        for (i = 0; i < lh->n; i++)
-            FREE(lh->array[i]);
+    if ((dh = lh->dh) != NULL) {
+        n = dh->n;
+        if (freeflag) {  /* free each struct in the array */
+            for (i = 0; i < n; i++)
+                FREE(((L_HEAPPTR *)DHEAP_ITEM(dh, i))->ptr);
+        }
+        else if (n > 0)  /* freeflag == FALSE but elements exist on array */
+            L_WARNING_INT("memory leak of %d items in lheap!", procName, n);
+        dheapDestroy(&lh->dh);
     }
-    else if (lh->n > 0)  /* freeflag == FALSE but elements exist on array */
-        L_WARNING_INT("memory leak of %d items in lheap!", procName, lh->n);
 
-    if (lh->array)
-        FREE(lh->array);
     FREE(lh);
     *plh = NULL;
-
     return;
 }
 
@@ -177,6 +228,8 @@ l_int32
 lheapAdd(L_HEAP  *lh,
          void    *item)
 {
+L_HEAPPTR  hp;
+
     PROCNAME("lheapAdd");
 
     if (!lh)
@@ -184,17 +237,10 @@ lheapAdd(L_HEAP  *lh,
     if (!item)
         return ERROR_INT("item not defined", procName, 1);
 
-        /* If necessary, expand the allocated array by a factor of 2 */
-    if (lh->n >= lh->nalloc)
-        lheapExtendArray(lh);
-
-        /* Add the item */
-    lh->array[lh->n] = item;
-    lh->n++;
-
-        /* Restore the heap */
-    lheapSwapUp(lh, lh->n - 1);
-    return 0;
+    hp.key = *(l_float32 *)item;
+    hp.ptr = item;
+    lh->dh->direction = lh->direction;
+    return dheapAdd(lh->dh, &hp);
 }
 
 
@@ -212,13 +258,7 @@ lheapExtendArray(L_HEAP  *lh)
     if (!lh)
         return ERROR_INT("lh not defined", procName, 1);
 
-    if ((lh->array = (void **)reallocNew((void **)&lh->array,
-                                sizeof(void *) * lh->nalloc,
-                                2 * sizeof(void *) * lh->nalloc)) == NULL)
-        return ERROR_INT("new ptr array not returned", procName, 1);
-
-    lh->nalloc = 2 * lh->nalloc;
-    return 0;
+    return dheapExtendArray(lh->dh);
 }
 
 
@@ -232,23 +272,17 @@ lheapExtendArray(L_HEAP  *lh)
 void *
 lheapRemove(L_HEAP  *lh)
 {
-void   *item;
+L_HEAPPTR  hp;
 
     PROCNAME("lheapRemove");
 
     if (!lh)
         return (void *)ERROR_PTR("lh not defined", procName, NULL);
 
-    if (lh->n == 0)
+    lh->dh->direction = lh->direction;
+    if (dheapRemove(lh->dh, &hp))
         return NULL;
-
-    item = lh->array[0];
-    lh->array[0] = lh->array[lh->n - 1];  /* move last to the head */
-    lh->array[lh->n - 1] = NULL;  /* set ptr to null */
-    lh->n--;
-
-    lheapSwapDown(lh);  /* restore the heap */
-    return item;
+    return hp.ptr;
 }
 
 
@@ -266,7 +300,7 @@ lheapGetCount(L_HEAP  *lh)
     if (!lh)
         return ERROR_INT("lh not defined", procName, 0);
 
-    return lh->n;
+    return lh->dh->n;
 }
 
 
@@ -284,54 +318,19 @@ lheapGetCount(L_HEAP  *lh)
  *  Notes:
  *      (1) This is called after a new item is put on the heap, at the
  *          bottom of a complete tree.
- *      (2) To regain the heap order, we let it bubble up,
- *          iteratively swapping with its parent, until it either
- *          reaches the root of the heap or it finds a parent that
- *          is in the correct position already vis-a-vis the child.
+ *      (2) See dheapSwapUp().
  */
 l_int32
 lheapSwapUp(L_HEAP  *lh,
             l_int32  index)
 {
-l_int32    ip;  /* index to heap for parent; 1 larger than array index */
-l_int32    ic;  /* index into heap for child */
-l_float32  valp, valc;
-
-  PROCNAME("lheapSwapUp");
-
-  if (!lh)
-      return ERROR_INT("lh not defined", procName, 1);
-  if (index < 0 || index >= lh->n)
-      return ERROR_INT("invalid index", procName, 1);
-
-  ic = index + 1;  /* index into heap: add 1 to array index */
-  if (lh->direction == L_SORT_INCREASING) {
-      while (1) {
-          if (ic == 1)  /* root of heap */
-              break;
-          ip = ic / 2;
-          valc = *(l_float32 *)(lh->array[ic - 1]);
-          valp = *(l_float32 *)(lh->array[ip - 1]);
-          if (valp <= valc)
-             break;
-          SWAP_ITEMS(ip - 1, ic - 1);
-          ic = ip;
-      }
-  }
-  else {  /* lh->direction == L_SORT_DECREASING */
-      while (1) {
-          if (ic == 1)  /* root of heap */
-              break;
-          ip = ic / 2;
-          valc = *(l_float32 *)(lh->array[ic - 1]);
-          valp = *(l_float32 *)(lh->array[ip - 1]);
-          if (valp >= valc)
-             break;
-          SWAP_ITEMS(ip - 1, ic - 1);
-          ic = ip;
-      }
-  }
-  return 0;
+    PROCNAME("lheapSwapUp");
+
+    if (!lh)
+        return ERROR_INT("lh not defined", procName, 1);
+
+    lh->dh->direction = lh->direction;
+    return dheapSwapUp(lh->dh, index);
 }
 
 
@@ -345,88 +344,20 @@ l_float32  valp, valc;
  *      (1) This is called after an item has been popped off the
  *          root of the heap, and the last item in the heap has
  *          been placed at the root.
- *      (2) To regain the heap order, we let it bubble down,
- *          iteratively swapping with one of its children.  For a
- *          decreasing sort, it swaps with the largest child; for
- *          an increasing sort, the smallest.  This continues until
- *          it either reaches the lowest level in the heap, or the
- *          parent finds that neither child should swap with it
- *          (e.g., for a decreasing heap, the parent is larger
- *          than or equal to both children).
+ *      (2) See dheapSwapDown().
  */
 l_int32
 lheapSwapDown(L_HEAP  *lh)
 {
-l_int32    ip;  /* index to heap for parent; 1 larger than array index */
-l_int32    icr, icl;  /* index into heap for left/right children */
-l_float32  valp, valcl, valcr;
-
-  PROCNAME("lheapSwapDown");
-
-  if (!lh)
-      return ERROR_INT("lh not defined", procName, 1);
-  if (lheapGetCount(lh) < 1)
-      return 0;
-
-  ip = 1;  /* index into top of heap: corresponds to array[0] */
-  if (lh->direction == L_SORT_INCREASING) {
-      while (1) {
-          icl = 2 * ip;
-          if (icl > lh->n)
-             break;
-          valp = *(l_float32 *)(lh->array[ip - 1]);
-          valcl = *(l_float32 *)(lh->array[icl - 1]);
-          icr = icl + 1;
-          if (icr > lh->n) {  /* only a left child; no iters below */
-              if (valp > valcl)
-                  SWAP_ITEMS(ip - 1, icl - 1);
-              break;
-          }
-          else {  /* both children present; swap with the smallest if bigger */
-              valcr = *(l_float32 *)(lh->array[icr - 1]);
-              if (valp <= valcl && valp <= valcr)  /* smaller than both */
-                  break;
-              if (valcl <= valcr) {  /* left smaller; swap */
-                  SWAP_ITEMS(ip - 1, icl - 1);
-                  ip = icl;
-              }
-              else { /* right smaller; swap */
-                  SWAP_ITEMS(ip - 1, icr - 1);
-                  ip = icr;
-              }
-          }
-      }
-  }
-  else {  /* lh->direction == L_SORT_DECREASING */
-      while (1) {
-          icl = 2 * ip;
-          if (icl > lh->n)
-             break;
-          valp = *(l_float32 *)(lh->array[ip - 1]);
-          valcl = *(l_float32 *)(lh->array[icl - 1]);
-          icr = icl + 1;
-          if (icr > lh->n) {  /* only a left child; no iters below */
-              if (valp < valcl)
-                  SWAP_ITEMS(ip - 1, icl - 1);
-              break;
-          }
-          else {  /* both children present; swap with the biggest if smaller */
-              valcr = *(l_float32 *)(lh->array[icr - 1]);
-              if (valp >= valcl && valp >= valcr)  /* bigger than both */
-                  break;
-              if (valcl >= valcr) {  /* left bigger; swap */
-                  SWAP_ITEMS(ip - 1, icl - 1);
-                  ip = icl;
-              }
-              else { /* right bigger; swap */
-                  SWAP_ITEMS(ip - 1, icr - 1);
-                  ip = icr;
-              }
-          }
-      }
-  }
-
-  return 0;
+    PROCNAME("lheapSwapDown");
+
+    if (!lh)
+        return ERROR_INT("lh not defined", procName, 1);
+    if (lheapGetCount(lh) < 1)
+        return 0;
+
+    lh->dh->direction = lh->direction;
+    return dheapSwapDown(lh->dh, 0);
 }
 
 
@@ -439,21 +370,22 @@ l_float32  valp, valcl, valcr;
  *  Notes:
  *      (1) This sorts an array into heap order.  If the heap is already
  *          in heap order for the direction given, this has no effect.
+ *      (2) Use this after changing lh->direction.
  */
 l_int32
 lheapSort(L_HEAP  *lh)
 {
 l_int32  i;
 
-  PROCNAME("lheapSort");
-
-  if (!lh)
-      return ERROR_INT("lh not defined", procName, 1);
+    PROCNAME("lheapSort");
 
-  for (i = 0; i < lh->n; i++)
-      lheapSwapUp(lh, i);
+    if (!lh)
+        return ERROR_INT("lh not defined", procName, 1);
 
-  return 0;
+    lh->dh->direction = lh->direction;
+    for (i = 0; i < lh->dh->n; i++)
+        dheapSwapUp(lh->dh, i);
+    return 0;
 }
 
 
@@ -464,37 +396,19 @@ l_int32  i;
  *      Return: 0 if OK, 1 on error
  *
  *  Notes:
- *      (1) This sorts a heap into strict order.
- *      (2) For each element, starting at the end of the array and
- *          working forward, the element is swapped with the head
- *          element and then allowed to swap down onto a heap of
- *          size reduced by one.  The result is that the heap is
- *          reversed but in strict order.  The array elements are
- *          then reversed to put it in the original order.
+ *      (1) This sorts a heap into strict order.  See
+ *          dheapSortStrictOrder().
  */
 l_int32
 lheapSortStrictOrder(L_HEAP  *lh)
 {
-l_int32  i, index, size;
-
-  PROCNAME("lheapSortStrictOrder");
-
-  if (!lh)
-      return ERROR_INT("lh not defined", procName, 1);
+    PROCNAME("lheapSortStrictOrder");
 
-  size = lh->n;  /* save the actual size */
-  for (i = 0; i < size; i++) {
-      index = size - i;
-      SWAP_ITEMS(0, index - 1);
-      lh->n--;  /* reduce the apparent heap size by 1 */
-      lheapSwapDown(lh);
-  }
-  lh->n = size;  /* restore the size */
-
-  for (i = 0; i < size / 2; i++)  /* reverse */
-      SWAP_ITEMS(i, size - i - 1);
+    if (!lh)
+        return ERROR_INT("lh not defined", procName, 1);
 
-  return 0;
+    lh->dh->direction = lh->direction;
+    return dheapSortStrictOrder(lh->dh);
 }
 
 
@@ -513,7 +427,8 @@ l_int32
 lheapPrint(FILE    *fp,
            L_HEAP  *lh)
 {
-l_int32  i;
+l_int32   i;
+L_DHEAP  *dh;
 
     PROCNAME("lheapPrint");
 
@@ -522,10 +437,630 @@ l_int32  i;
     if (!lh)
         return ERROR_INT("lh not defined", procName, 1);
 
+    dh = lh->dh;
     fprintf(fp, "\n L_Heap: nalloc = %d, n = %d, array = %p\n",
-            lh->nalloc, lh->n, lh->array);
-    for (i = 0; i < lh->n; i++)
-        fprintf(fp,   "keyval[%d] = %f\n", i, *(l_float32 *)lh->array[i]);
+            dh->nalloc, dh->n, dh->array);
+    for (i = 0; i < dh->n; i++)
+        fprintf(fp,   "keyval[%d] = %f\n", i, DHEAP_KEY(dh, i));
+
+    return 0;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                          L_DHeap create/destroy                          *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  dheapCreate()
+ *
+ *      Input:  itemsize (size in bytes of each item; typically the
+ *                        sizeof() a struct whose first field is
+ *                        the l_float32 key)
+ *              nalloc (number of items to alloc; 0 for default)
+ *              direction (L_SORT_INCREASING, L_SORT_DECREASING)
+ *      Return: dheap, or null on error
+ *
+ *  Notes:
+ *      (1) The items are copied into the heap by dheapAdd() and out
+ *          of it by dheapRemove(), so the caller's struct can be
+ *          a local variable.
+ */
+L_DHEAP *
+dheapCreate(l_int32  itemsize,
+            l_int32  nalloc,
+            l_int32  direction)
+{
+L_DHEAP  *dh;
+
+    PROCNAME("dheapCreate");
+
+    if (itemsize < (l_int32)sizeof(l_float32))
+        return (L_DHEAP *)ERROR_PTR("itemsize too small", procName, NULL);
+    if (direction != L_SORT_INCREASING && direction != L_SORT_DECREASING)
+        return (L_DHEAP *)ERROR_PTR("invalid direction", procName, NULL);
+    if (nalloc <= 0)
+        nalloc = INITIAL_BUFFER_ARRAYSIZE;
+    if (nalloc < MIN_BUFFER_SIZE)
+        nalloc = MIN_BUFFER_SIZE;
+
+    if ((dh = (L_DHEAP *)CALLOC(1, sizeof(L_DHEAP))) == NULL)
+        return (L_DHEAP *)ERROR_PTR("dh not made", procName, NULL);
+    dh->array = (l_uint8 *)CALLOC(nalloc, itemsize);
+    dh->temp = (l_uint8 *)CALLOC(1, itemsize);
+    if (!dh->array || !dh->temp) {
+        dheapDestroy(&dh);
+        return (L_DHEAP *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+    dh->itemsize = itemsize;
+    dh->nalloc = nalloc;
+    dh->n = 0;
+    dh->direction = direction;
+    dh->arity = 4;
+    return dh;
+}
+
+
+/*!
+ *  dheapDestroy()
+ *
+ *      Input:  &dheap  (<to be nulled>)
+ *      Return: void
+ */
+void
+dheapDestroy(L_DHEAP  **pdh)
+{
+L_DHEAP  *dh;
+
+    PROCNAME("dheapDestroy");
+
+    if (pdh == NULL) {
+        L_WARNING("ptr address is NULL", procName);
+        return;
+    }
+    if ((dh = *pdh) == NULL)
+        return;
+
+    if (dh->array) FREE(dh->array);
+    if (dh->temp) FREE(dh->temp);
+    FREE(dh);
+    *pdh = NULL;
+    return;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                             L_DHeap accessors                            *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  dheapAdd()
+ *
+ *      Input:  dheap
+ *              item (ptr to the item to be copied into the heap)
+ *      Return: 0 if OK, 1 on error
+ */
+l_int32
+dheapAdd(L_DHEAP  *dh,
+         void     *item)
+{
+    PROCNAME("dheapAdd");
+
+    if (!dh)
+        return ERROR_INT("dh not defined", procName, 1);
+    if (!item)
+        return ERROR_INT("item not defined", procName, 1);
+
+        /* If necessary, expand the allocated array by a factor of 2 */
+    if (dh->n >= dh->nalloc) {
+        if (dheapExtendArray(dh))
+            return ERROR_INT("array not extended", procName, 1);
+    }
+
+        /* Add the item and restore the heap */
+    memcpy(DHEAP_ITEM(dh, dh->n), item, dh->itemsize);
+    dh->n++;
+    dheapSwapUp(dh, dh->n - 1);
+    return 0;
+}
+
+
+/*!
+ *  dheapExtendArray()
+ *
+ *      Input:  dheap
+ *      Return: 0 if OK, 1 on error
+ */
+l_int32
+dheapExtendArray(L_DHEAP  *dh)
+{
+    PROCNAME("dheapExtendArray");
+
+    if (!dh)
+        return ERROR_INT("dh not defined", procName, 1);
+
+    if ((dh->array = (l_uint8 *)reallocNew((void **)&dh->array,
+                                dh->itemsize * dh->nalloc,
+                                2 * dh->itemsize * dh->nalloc)) == NULL)
+        return ERROR_INT("new array not returned", procName, 1);
+
+    dh->nalloc = 2 * dh->nalloc;
+    return 0;
+}
+
+
+/*!
+ *  dheapRemove()
+ *
+ *      Input:  dheap
+ *              item (<return> copy of the item at the root of the heap)
+ *      Return: 0 if OK, 1 if the heap is empty or on error
+ */
+l_int32
+dheapRemove(L_DHEAP  *dh,
+            void     *item)
+{
+    PROCNAME("dheapRemove");
+
+    if (!dh)
+        return ERROR_INT("dh not defined", procName, 1);
+    if (!item)
+        return ERROR_INT("item not defined", procName, 1);
+
+    if (dh->n == 0)
+        return 1;
+
+    memcpy(item, DHEAP_ITEM(dh, 0), dh->itemsize);
+    dh->n--;
+    if (dh->n > 0) {  /* move last to the head and restore the heap */
+        memcpy(DHEAP_ITEM(dh, 0), DHEAP_ITEM(dh, dh->n), dh->itemsize);
+        dheapSwapDown(dh, 0);
+    }
+    return 0;
+}
+
+
+/*!
+ *  dheapGetCount()
+ *
+ *      Input:  dheap
+ *      Return: count, or 0 on error
+ */
+l_int32
+dheapGetCount(L_DHEAP  *dh)
+{
+    PROCNAME("dheapGetCount");
+
+    if (!dh)
+        return ERROR_INT("dh not defined", procName, 0);
+
+    return dh->n;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                           4-ary heap operations                          *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  dheapSwapUp()
+ *
+ *      Input:  dh (dheap)
+ *              index (of array corresponding to node to be swapped up)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) The parent of node i is node (i - 1) / arity.
+ *      (2) To regain the heap order, the item moves up, shifting
+ *          each parent down into its place, until it either reaches
+ *          the root or finds a parent that is in the correct order
+ *          with respect to it.  The item is then copied once into
+ *          the hole.
+ */
+l_int32
+dheapSwapUp(L_DHEAP  *dh,
+            l_int32   index)
+{
+l_int32    ic, ip, itemsize;
+l_float32  valc, valp;
+
+    PROCNAME("dheapSwapUp");
+
+    if (!dh)
+        return ERROR_INT("dh not defined", procName, 1);
+    if (index < 0 || index >= dh->n)
+        return ERROR_INT("invalid index", procName, 1);
+
+    itemsize = dh->itemsize;
+    ic = index;
+    valc = DHEAP_KEY(dh, ic);
+    memcpy(dh->temp, DHEAP_ITEM(dh, ic), itemsize);
+    while (ic > 0) {
+        ip = (ic - 1) / dh->arity;
+        valp = DHEAP_KEY(dh, ip);
+        if (dh->direction == L_SORT_INCREASING) {
+            if (valp <= valc)
+                break;
+        }
+        else {  /* L_SORT_DECREASING */
+            if (valp >= valc)
+                break;
+        }
+        memcpy(DHEAP_ITEM(dh, ic), DHEAP_ITEM(dh, ip), itemsize);
+        ic = ip;
+    }
+    if (ic != index)
+        memcpy(DHEAP_ITEM(dh, ic), dh->temp, itemsize);
+    return 0;
+}
+
+
+/*!
+ *  dheapSwapDown()
+ *
+ *      Input:  dh (dheap)
+ *              index (of array corresponding to node to be swapped down)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) The children of node i are nodes (arity * i + 1) ...
+ *          (arity * i + arity).
+ *      (2) To regain the heap order, the item moves down, shifting
+ *          up the child that should be first (smallest for an
+ *          increasing sort, largest for decreasing), until it either
+ *          reaches the lowest level or finds that no child should
+ *          be above it.  The item is then copied once into the hole.
+ */
+l_int32
+dheapSwapDown(L_DHEAP  *dh,
+              l_int32   index)
+{
+l_int32    ip, ic, icmax, ibest, n, itemsize, arity;
+l_float32  valp, valc, valbest;
+
+    PROCNAME("dheapSwapDown");
+
+    if (!dh)
+        return ERROR_INT("dh not defined", procName, 1);
+    if (index < 0 || index >= dh->n)
+        return ERROR_INT("invalid index", procName, 1);
+
+    n = dh->n;
+    itemsize = dh->itemsize;
+    arity = dh->arity;
+    ip = index;
+    valp = DHEAP_KEY(dh, ip);
+    memcpy(dh->temp, DHEAP_ITEM(dh, ip), itemsize);
+    while (1) {
+        ic = arity * ip + 1;
+        if (ic >= n)
+            break;
+        icmax = L_MIN(ic + arity - 1, n - 1);
+        ibest = ic;
+        valbest = DHEAP_KEY(dh, ic);
+        if (dh->direction == L_SORT_INCREASING) {
+            for (ic = ic + 1; ic <= icmax; ic++) {
+                if ((valc = DHEAP_KEY(dh, ic)) < valbest) {
+                    valbest = valc;
+                    ibest = ic;
+                }
+            }
+            if (valp <= valbest)
+                break;
+        }
+        else {  /* L_SORT_DECREASING */
+            for (ic = ic + 1; ic <= icmax; ic++) {
+                if ((valc = DHEAP_KEY(dh, ic)) > valbest) {
+                    valbest = valc;
+                    ibest = ic;
+                }
+            }
+            if (valp >= valbest)
+                break;
+        }
+        memcpy(DHEAP_ITEM(dh, ip), DHEAP_ITEM(dh, ibest), itemsize);
+        ip = ibest;
+    }
+    if (ip != index)
+        memcpy(DHEAP_ITEM(dh, ip), dh->temp, itemsize);
+    return 0;
+}
 
+
+/*!
+ *  dheapSort()
+ *
+ *      Input:  dh (dheap, with internal array)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) This sorts an array into heap order, by swapping down each
+ *          node that has children, starting from the last one.
+ *          If the heap is already in heap order for the direction
+ *          given, this has no effect.
+ */
+l_int32
+dheapSort(L_DHEAP  *dh)
+{
+l_int32  i;
+
+    PROCNAME("dheapSort");
+
+    if (!dh)
+        return ERROR_INT("dh not defined", procName, 1);
+
+    if (dh->n < 2)
+        return 0;
+    for (i = (dh->n - 2) / dh->arity; i >= 0; i--)
+        dheapSwapDown(dh, i);
     return 0;
 }
+
+
+/*!
+ *  dheapSortStrictOrder()
+ *
+ *      Input:  dh (dheap, with internal array)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) This sorts a heap into strict order.  A strictly ordered
+ *          array is also in heap order.
+ *      (2) For each element, starting at the end of the array and
+ *          working forward, the element is swapped with the head
+ *          element and then allowed to swap down onto a heap of
+ *          size reduced by one.  The result is that the heap is
+ *          reversed but in strict order.  The array elements are
+ *          then reversed to put it in the original order.
+ */
+l_int32
+dheapSortStrictOrder(L_DHEAP  *dh)
+{
+l_int32   i, size, itemsize;
+l_uint8  *item1, *item2;
+
+    PROCNAME("dheapSortStrictOrder");
+
+    if (!dh)
+        return ERROR_INT("dh not defined", procName, 1);
+
+    size = dh->n;  /* save the actual size */
+    itemsize = dh->itemsize;
+    for (i = size - 1; i > 0; i--) {
+        item1 = DHEAP_ITEM(dh, 0);
+        item2 = DHEAP_ITEM(dh, i);
+        memcpy(dh->temp, item1, itemsize);
+        memcpy(item1, item2, itemsize);
+        memcpy(item2, dh->temp, itemsize);
+        dh->n = i;  /* reduce the apparent heap size by 1 */
+        dheapSwapDown(dh, 0);
+    }
+    dh->n = size;  /* restore the size */
+
+    for (i = 0; i < size / 2; i++) {  /* reverse */
+        item1 = DHEAP_ITEM(dh, i);
+        item2 = DHEAP_ITEM(dh, size - i - 1);
+        memcpy(dh->temp, item1, itemsize);
+        memcpy(item1, item2, itemsize);
+        memcpy(item2, dh->temp, itemsize);
+    }
+
+    return 0;
+}
+
+
+/*--------------------------------------------------------------------------*
+ *                                Radix heap                                *
+ *--------------------------------------------------------------------------*/
+/*!
+ *  rheapCreate()
+ *
+ *      Input:  itemsize (size in bytes of each item; typically the
+ *                        sizeof() a struct whose first field is
+ *                        the l_uint32 key)
+ *      Return: rheap, or null on error
+ *
+ *  Notes:
+ *      (1) Items are removed in order of increasing key.  See heap.h
+ *          for the restriction on the keys of items that are added.
+ *      (2) The bucket arrays are allocated as they are needed.
+ */
+L_RHEAP *
+rheapCreate(l_int32  itemsize)
+{
+L_RHEAP  *rh;
+
+    PROCNAME("rheapCreate");
+
+    if (itemsize < (l_int32)sizeof(l_uint32))
+        return (L_RHEAP *)ERROR_PTR("itemsize too small", procName, NULL);
+
+    if ((rh = (L_RHEAP *)CALLOC(1, sizeof(L_RHEAP))) == NULL)
+        return (L_RHEAP *)ERROR_PTR("rh not made", procName, NULL);
+    rh->itemsize = itemsize;
+    return rh;
+}
+
+
+/*!
+ *  rheapDestroy()
+ *
+ *      Input:  &rheap  (<to be nulled>)
+ *      Return: void
+ */
+void
+rheapDestroy(L_RHEAP  **prh)
+{
+l_int32   i;
+L_RHEAP  *rh;
+
+    PROCNAME("rheapDestroy");
+
+    if (prh == NULL) {
+        L_WARNING("ptr address is NULL", procName);
+        return;
+    }
+    if ((rh = *prh) == NULL)
+        return;
+
+    for (i = 0; i < RHEAP_NBUCKETS; i++) {
+        if (rh->bucket[i])
+            FREE(rh->bucket[i]);
+    }
+    FREE(rh);
+    *prh = NULL;
+    return;
+}
+
+
+/*!
+ *  rheapAdd()
+ *
+ *      Input:  rheap
+ *              item (ptr to the item to be copied into the heap)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) It is an error to add an item whose key is less than
+ *          the key of the last item removed.
+ */
+l_int32
+rheapAdd(L_RHEAP  *rh,
+         void     *item)
+{
+l_int32   b, nalloc;
+l_uint32  key;
+
+    PROCNAME("rheapAdd");
+
+    if (!rh)
+        return ERROR_INT("rh not defined", procName, 1);
+    if (!item)
+        return ERROR_INT("item not defined", procName, 1);
+    key = *(l_uint32 *)item;
+    if (key < rh->lastkey)
+        return ERROR_INT("key less than last key removed", procName, 1);
+
+    b = rheapGetBucket(key ^ rh->lastkey);
+    if (rh->nb[b] >= rh->nballoc[b]) {
+        nalloc = L_MAX(MIN_BUFFER_SIZE, 2 * rh->nballoc[b]);
+        if ((rh->bucket[b] = (l_uint8 *)reallocNew((void **)&rh->bucket[b],
+                                  rh->itemsize * rh->nballoc[b],
+                                  rh->itemsize * nalloc)) == NULL)
+            return ERROR_INT("bucket not extended", procName, 1);
+        rh->nballoc[b] = nalloc;
+    }
+    memcpy(rh->bucket[b] + rh->itemsize * rh->nb[b], item, rh->itemsize);
+    rh->nb[b]++;
+    rh->n++;
+    return 0;
+}
+
+
+/*!
+ *  rheapRemove()
+ *
+ *      Input:  rheap
+ *              item (<return> copy of an item with the smallest key)
+ *      Return: 0 if OK, 1 if the heap is empty or on error
+ *
+ *  Notes:
+ *      (1) If bucket 0 is empty, the first nonempty bucket is emptied:
+ *          its smallest key becomes the last key, and each of its
+ *          items is moved to the bucket for the new last key,
+ *          which is lower than the one it came from.
+ */
+l_int32
+rheapRemove(L_RHEAP  *rh,
+            void     *item)
+{
+l_int32    b, i, j, nb, itemsize;
+l_uint32   key, minkey;
+l_uint8   *src;
+
+    PROCNAME("rheapRemove");
+
+    if (!rh)
+        return ERROR_INT("rh not defined", procName, 1);
+    if (!item)
+        return ERROR_INT("item not defined", procName, 1);
+
+    if (rh->n == 0)
+        return 1;
+
+    itemsize = rh->itemsize;
+    if (rh->nb[0] == 0) {
+        for (b = 1; rh->nb[b] == 0; b++)  /* one must be nonempty */
+            ;
+        nb = rh->nb[b];
+        src = rh->bucket[b];
+        minkey = *(l_uint32 *)src;
+        for (i = 1; i < nb; i++) {
+            if ((key = *(l_uint32 *)(src + i * itemsize)) < minkey)
+                minkey = key;
+        }
+        rh->lastkey = minkey;
+        rh->nb[b] = 0;
+        rh->n -= nb;
+        for (i = 0; i < nb; i++) {  /* redistribute; can't fail */
+            rheapAdd(rh, src + i * itemsize);
+        }
+    }
+
+    j = --rh->nb[0];
+    memcpy(item, rh->bucket[0] + j * itemsize, itemsize);
+    rh->n--;
+    return 0;
+}
+
+
+/*!
+ *  rheapGetCount()
+ *
+ *      Input:  rheap
+ *      Return: count, or 0 on error
+ */
+l_int32
+rheapGetCount(L_RHEAP  *rh)
+{
+    PROCNAME("rheapGetCount");
+
+    if (!rh)
+        return ERROR_INT("rh not defined", procName, 0);
+
+    return rh->n;
+}
+
+
+/*!
+ *  rheapGetBucket()
+ *
+ *      Input:  diff (xor of a key with the last key removed)
+ *      Return: bucket index: 0 if @diff is 0; otherwise, 1 + the
+ *              position of the highest bit set in @diff
+ */
+static l_int32
+rheapGetBucket(l_uint32  diff)
+{
+l_int32  b;
+
+    b = 0;
+    if (diff & 0xffff0000) {
+        b += 16;
+        diff >>= 16;
+    }
+    if (diff & 0xff00) {
+        b += 8;
+        diff >>= 8;
+    }
+    if (diff & 0xf0) {
+        b += 4;
+        diff >>= 4;
+    }
+    if (diff & 0xc) {
+        b += 2;
+        diff >>= 2;
+    }
+    if (diff & 0x2) {
+        b += 1;
+        diff >>= 1;
+    }
+    return b + (l_int32)diff;
+}
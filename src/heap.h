@@ -31,16 +31,20 @@
  *  heap.h
  *
  *      Expandable priority queue configured as a heap for arbitrary void* data
+ *      Expandable 4-ary heap of fixed-size items stored by value
+ *      Radix heap of fixed-size items with monotone integer keys
  *
  *      The L_Heap is used to implement a priority queue.  The elements
  *      in the heap are ordered in either increasing or decreasing key value.
  *      The key is a float field 'keyval' that is required to be
  *      contained in the elements of the queue.
  * 
- *      The heap is a simple binary tree with the following constraints:
- *         - the key of each node is >= the keys of the two children
- *         - the tree is complete, meaning that each level (1, 2, 4, ...)
- *           is filled and the last level is filled from left to right
+ *      The heap is a tree with the following constraints:
+ *         - the key of each node is >= the keys of its children
+ *         - the tree is complete, meaning that each level is filled
+ *           and the last level is filled from left to right
+ *      It is implemented as a L_DHeap (see below), with 2 children
+ *      for each node.
  *
  *      The tree structure is implicit in the queue array, with the
  *      array elements numbered as a breadth-first search of the tree
@@ -73,12 +77,72 @@
 
 struct L_Heap
 {
-    l_int32      nalloc;      /* size of allocated ptr array                 */
-    l_int32      n;           /* number of elements stored in the heap       */
-    void       **array;       /* ptr array                                   */
-    l_int32      direction;   /* L_SORT_INCREASING or L_SORT_DECREASING      */
+    l_int32         direction;  /* L_SORT_INCREASING or L_SORT_DECREASING   */
+    struct L_DHeap *dh;         /* heap of (key, ptr) pairs                  */
 };
 typedef struct L_Heap  L_HEAP;
 
 
+/*
+ *      The L_DHeap is a heap with, by default, 4 children for each
+ *      node, where the items are structs of fixed size that are copied
+ *      into and out of a single array.  As with the L_Heap, the key is
+ *      an l_float32 that is REQUIRED to be the first field of the struct.
+ *      Because the items are held by value, no allocation is needed
+ *      for each item, and the keys of the children of a node are
+ *      adjacent in memory.  The 4-ary tree is half as deep as
+ *      the binary tree, which reduces the number of cache misses
+ *      in removing items, at the cost of a few more comparisons.
+ *
+ *      The L_Heap is implemented as a wrapper on a L_DHeap with
+ *      items consisting of the key and the ptr to the user's struct.
+ *      It uses 2 children for each node, so that items with equal keys
+ *      are removed in the same order as before, on which the results
+ *      of some callers (e.g., octcube quantization) depend.
+ */
+struct L_DHeap
+{
+    l_int32      itemsize;    /* size of each item in bytes                  */
+    l_int32      nalloc;      /* number of items allocated                   */
+    l_int32      n;           /* number of items stored in the heap          */
+    l_int32      direction;   /* L_SORT_INCREASING or L_SORT_DECREASING      */
+    l_int32      arity;       /* number of children of each node             */
+    l_uint8     *array;       /* item array                                  */
+    l_uint8     *temp;        /* storage for one item, used in swapping      */
+};
+typedef struct L_DHeap  L_DHEAP;
+
+
+/*
+ *      The L_RHeap is a radix heap: a priority queue for items with
+ *      unsigned integer keys, that can only be used when the key of
+ *      each item added is not less than the key of the last item
+ *      removed.  This "monotone" condition holds, for example, in
+ *      Dijkstra's shortest path algorithm with nonnegative costs.
+ *      Items are fixed-size structs stored by value, with the key an
+ *      l_uint32 that is REQUIRED to be the first field of the struct.
+ *
+ *      Bucket 0 holds items whose key equals the last key removed,
+ *      and bucket b > 0 holds items whose key differs from the
+ *      last key removed first in bit (b - 1).  Removal is from
+ *      bucket 0; when it is empty, the first nonempty bucket is
+ *      redistributed into lower buckets with a new value of the last
+ *      key.  Each item moves down at most 32 times, so the amortized
+ *      cost of a removal is O(log C), where C is the range of keys,
+ *      and adding is O(1).
+ */
+#define  RHEAP_NBUCKETS   33
+
+struct L_RHeap
+{
+    l_int32      itemsize;    /* size of each item in bytes                  */
+    l_int32      n;           /* number of items stored in the heap          */
+    l_uint32     lastkey;     /* key of the last item removed                */
+    l_uint8     *bucket[RHEAP_NBUCKETS];  /* item arrays                     */
+    l_int32      nb[RHEAP_NBUCKETS];      /* number of items in each bucket  */
+    l_int32      nballoc[RHEAP_NBUCKETS]; /* items allocated in each bucket  */
+};
+typedef struct L_RHeap  L_RHEAP;
+
+
 #endif  /* LEPTONICA_HEAP_H */
@@ -86,6 +86,14 @@
  *         static JBFINDCTX *findSimilarSizedTemplatesInit()
  *         static l_int32    findSimilarSizedTemplatesNext()
  *         static void       findSimilarSizedTemplatesDestroy()
+ *         static l_int32    jbAddTemplateBySize()
+ *         static NUMA      *jbGetSignature()
+ *         static l_int32    jbSignatureTest()
+ *         static l_int32    jbBandTest()
+ *         static l_int32    hausCountUncovered()
+ *         static l_int32    hausCountUncoveredTemplate()
+ *         static l_uint32   hausGetWord()
+ *         static l_uint32   hausRangeMask()
  *         static l_int32    finalPositioningForAlignment()
  *
  *     Note: this is NOT an implementation of the JPEG jbig2
@@ -237,6 +245,11 @@ static const l_int32  MAX_COMP_HEIGHT = 120;  /* default max component height */
     /* Max allowed dilation to merge characters into words */
 #define  MAX_ALLOWED_DILATION  14
 
+    /* Size of the bands of rows and columns that are summed in the
+     * projection signature of each template.  This must be 4, so that
+     * the column bands can be summed on the nibbles of each word. */
+#define  JB_SIG_BANDSIZE  4
+
     /* This stores the state of a state machine which fetches
      * similar sized templates */
 struct JbFindTemplatesState
@@ -260,6 +273,23 @@ static JBCLASSER * jbCorrelationInitInternal(l_int32 components,
 static JBFINDCTX * findSimilarSizedTemplatesInit(JBCLASSER *classer, PIX *pixs);
 static l_int32 findSimilarSizedTemplatesNext(JBFINDCTX *context);
 static void findSimilarSizedTemplatesDestroy(JBFINDCTX **pcontext);
+static l_int32 jbAddTemplateBySize(L_HASHMAP *hmap, l_int32 w, l_int32 h,
+                                   l_int32 index);
+static NUMA *jbGetSignature(PIX *pix, l_int32 *tab8);
+static l_int32 jbSignatureTest(NUMA *na1, NUMA *na2, l_float32 delx,
+                               l_float32 dely, l_int32 mincount);
+static l_int32 jbBandTest(l_float32 *band1, l_int32 n1, l_float32 *band2,
+                          l_int32 n2, l_int32 shift, l_float32 total1,
+                          l_int32 mincount);
+static l_int32 hausCountUncovered(PIX *pix1, PIX *pix4, l_int32 idelx,
+                                  l_int32 idely, l_int32 thresh, l_int32 *tab8);
+static l_int32 hausCountUncoveredTemplate(PIX *pix1, PIX *pix2, PIX *pix3,
+                                          PIX *pix4, l_int32 idelx,
+                                          l_int32 idely, l_int32 thresh,
+                                          l_int32 *tab8);
+static l_uint32 hausGetWord(l_uint32 *line, l_int32 wpl, l_int32 w,
+                            l_int32 x);
+static l_uint32 hausRangeMask(l_int32 x, l_int32 xstart, l_int32 xend);
 static l_int32 finalPositioningForAlignment(PIX *pixs, l_int32 x, l_int32 y,
                              l_int32 idelx, l_int32 idely, PIX *pixt,
                              l_int32 *sumtab, l_int32 *pdx, l_int32 *pdy);
@@ -322,7 +352,7 @@ JBCLASSER  *classer;
     classer->maxheight = maxheight;
     classer->sizehaus = size;
     classer->rankhaus = rank;
-    classer->nahash = numaHashCreate(5507, 4);  /* 5507 is prime */
+    classer->hmap = l_hmapCreate(0, L_HMAP_INT_KEY);
     return classer;
 }
 
@@ -416,7 +446,7 @@ JBCLASSER  *classer;
     classer->maxheight = maxheight;
     classer->thresh = thresh;
     classer->weightfactor = weightfactor;
-    classer->nahash = numaHashCreate(5507, 4);  /* 5507 is prime */
+    classer->hmap = l_hmapCreate(0, L_HMAP_INT_KEY);
     classer->keep_pixaa = keep_components;
     return classer;
 }
@@ -588,17 +618,20 @@ jbClassifyRankHaus(JBCLASSER  *classer,
                    BOXA       *boxa,
                    PIXA       *pixas)
 {
-l_int32     n, nt, i, wt, ht, iclass, size, found, testval;
+l_int32     n, nt, i, wt, ht, iclass, size, found, testval, ret;
 l_int32    *sumtab;
-l_int32     npages, area1, area3;
+l_int32     npages, area1, area3, thresh1;
 l_int32    *tab8;
 l_float32   rank, x1, y1, x2, y2;
 BOX        *box;
 NUMA       *naclass, *napage;
 NUMA       *nafg;   /* fg area of all instances */
 NUMA       *nafgt;  /* fg area of all templates */
+NUMA       *nasig;  /* projection signature of instance or template */
+NUMA       *nasigt;  /* projection signature of a dilated template */
+NUMAA      *naasig;  /* projection signatures of dilated templates */
 JBFINDCTX  *findcontext;
-NUMAHASH   *nahash;
+L_HASHMAP  *hmap;
 PIX        *pix, *pix1, *pix2, *pix3, *pix4;
 PIXA       *pixa, *pixa1, *pixa2, *pixat, *pixatd;
 PIXAA      *pixaa;
@@ -681,22 +714,43 @@ SEL        *sel;
          * and the greater the likelihood of putting semantically
          * different objects in the same class.  For simplicity,
          * we do this separately for the case of rank == 1.0 (exact
-         * match within the Hausdorff distance) and rank < 1.0.  */
+         * match within the Hausdorff distance) and rank < 1.0.
+         * Before comparing bitmaps, the projection signatures of
+         * the instance and the dilated template are used to bound
+         * the number of instance pixels that the template can cover;
+         * a candidate is skipped when that bound already fails the
+         * first half of the test.  This never changes the result. */
     rank = classer->rankhaus;
-    nahash = classer->nahash;
+    hmap = classer->hmap;
+    naasig = classer->naasig;
+    ret = 0;
     if (rank == 1.0) {
         for (i = 0; i < n; i++) {
             pix1 = pixaGetPix(pixa1, i, L_CLONE);
             pix2 = pixaGetPix(pixa2, i, L_CLONE);
             ptaGetPt(pta, i, &x1, &y1);
+            if ((nasig = jbGetSignature(pix1, sumtab)) == NULL) {
+                pixDestroy(&pix1);
+                pixDestroy(&pix2);
+                ret = ERROR_INT("nasig not made", procName, 1);
+                break;
+            }
+            numaGetIValue(nasig, 1, &area1);  /* fg count */
             nt = pixaGetCount(pixat);  /* number of templates */
             found = FALSE;
             findcontext = findSimilarSizedTemplatesInit(classer, pix1);
             while ((iclass = findSimilarSizedTemplatesNext(findcontext)) > -1) {
+                ptaGetPt(ptact, iclass, &x2, &y2);
+                nasigt = numaaGetNuma(naasig, iclass, L_CLONE);
+                testval = jbSignatureTest(nasig, nasigt, x1 - x2, y1 - y2,
+                                          area1);
+                numaDestroy(&nasigt);
+                if (!testval)
+                    continue;
+
                     /* Find score for this template */
                 pix3 = pixaGetPix(pixat, iclass, L_CLONE);
                 pix4 = pixaGetPix(pixatd, iclass, L_CLONE);
-                ptaGetPt(ptact, iclass, &x2, &y2);
                 testval = pixHaustest(pix1, pix2, pix3, pix4, x1 - x2, y1 - y2,
                                       MAX_DIFF_WIDTH, MAX_DIFF_HEIGHT);
                 pixDestroy(&pix3);
@@ -717,7 +771,14 @@ SEL        *sel;
                 }
             }
             findSimilarSizedTemplatesDestroy(&findcontext);
+            numaDestroy(&nasig);
             if (found == FALSE) {  /* new class */
+                if ((nasig = jbGetSignature(pix2, sumtab)) == NULL) {
+                    pixDestroy(&pix1);
+                    pixDestroy(&pix2);
+                    ret = ERROR_INT("template nasig not made", procName, 1);
+                    break;
+                }
                 numaAddNumber(naclass, nt);
                 numaAddNumber(napage, npages);
                 pixa = pixaCreate(0);
@@ -725,11 +786,12 @@ SEL        *sel;
                 pixaAddPix(pixa, pix, L_INSERT);
                 wt = pixGetWidth(pix);
                 ht = pixGetHeight(pix);
-                numaHashAdd(nahash, ht * wt, nt);
+                jbAddTemplateBySize(hmap, wt, ht, nt);
                 box = boxaGetBox(boxa, i, L_CLONE);
                 pixaAddBox(pixa, box, L_INSERT);
                 pixaaAddPixa(pixaa, pixa, L_INSERT);  /* unbordered instance */
                 ptaAddPt(ptact, x1, y1);
+                numaaAddNuma(naasig, nasig, L_INSERT);
                 pixaAddPix(pixat, pix1, L_INSERT);  /* bordered template */
                 pixaAddPix(pixatd, pix2, L_INSERT);  /* bordered dil template */
             }
@@ -749,15 +811,29 @@ SEL        *sel;
             numaGetIValue(nafg, i, &area1);
             pix2 = pixaGetPix(pixa2, i, L_CLONE);
             ptaGetPt(pta, i, &x1, &y1);   /* use pta for this page */
+            if ((nasig = jbGetSignature(pix1, sumtab)) == NULL) {
+                pixDestroy(&pix1);
+                pixDestroy(&pix2);
+                ret = ERROR_INT("nasig not made", procName, 1);
+                break;
+            }
+            thresh1 = (l_int32)(area1 * (1. - rank) + 0.5);
             nt = pixaGetCount(pixat);  /* number of templates */
             found = FALSE;
             findcontext = findSimilarSizedTemplatesInit(classer, pix1);
             while ((iclass = findSimilarSizedTemplatesNext(findcontext)) > -1) {
+                ptaGetPt(ptact, iclass, &x2, &y2);
+                nasigt = numaaGetNuma(naasig, iclass, L_CLONE);
+                testval = jbSignatureTest(nasig, nasigt, x1 - x2, y1 - y2,
+                                          area1 - thresh1);
+                numaDestroy(&nasigt);
+                if (!testval)
+                    continue;
+
                     /* Find score for this template */
                 pix3 = pixaGetPix(pixat, iclass, L_CLONE);
                 numaGetIValue(nafgt, iclass, &area3);
                 pix4 = pixaGetPix(pixatd, iclass, L_CLONE);
-                ptaGetPt(ptact, iclass, &x2, &y2);
                 testval = pixRankHaustest(pix1, pix2, pix3, pix4,
                                           x1 - x2, y1 - y2,
                                           MAX_DIFF_WIDTH, MAX_DIFF_HEIGHT,
@@ -780,7 +856,14 @@ SEL        *sel;
                 }
             }
             findSimilarSizedTemplatesDestroy(&findcontext);
+            numaDestroy(&nasig);
             if (found == FALSE) {  /* new class */
+                if ((nasig = jbGetSignature(pix2, sumtab)) == NULL) {
+                    pixDestroy(&pix1);
+                    pixDestroy(&pix2);
+                    ret = ERROR_INT("template nasig not made", procName, 1);
+                    break;
+                }
                 numaAddNumber(naclass, nt);
                 numaAddNumber(napage, npages);
                 pixa = pixaCreate(0);
@@ -788,11 +871,12 @@ SEL        *sel;
                 pixaAddPix(pixa, pix, L_INSERT);
                 wt = pixGetWidth(pix);
                 ht = pixGetHeight(pix);
-                numaHashAdd(nahash, ht * wt, nt);
+                jbAddTemplateBySize(hmap, wt, ht, nt);
                 box = boxaGetBox(boxa, i, L_CLONE);
                 pixaAddBox(pixa, box, L_INSERT);
                 pixaaAddPixa(pixaa, pixa, L_INSERT);  /* unbordered instance */
                 ptaAddPt(ptact, x1, y1);
+                numaaAddNuma(naasig, nasig, L_INSERT);
                 pixaAddPix(pixat, pix1, L_INSERT);  /* bordered template */
                 pixaAddPix(pixatd, pix2, L_INSERT);  /* ditto */
                 numaAddNumber(nafgt, area1);
@@ -812,7 +896,7 @@ SEL        *sel;
     pixaDestroy(&pixa1);
     pixaDestroy(&pixa2);
     selDestroy(&sel);
-    return 0;
+    return ret;
 }
 
 
@@ -850,8 +934,7 @@ pixHaustest(PIX       *pix1,
             l_int32    maxdiffw,
             l_int32    maxdiffh)
 {
-l_int32  wi, hi, wt, ht, delw, delh, idelx, idely, boolmatch;
-PIX     *pixt;
+l_int32  wi, hi, wt, ht, delw, delh, idelx, idely;
 
         /* Eliminate possible matches based on size difference */
     wi = pixGetWidth(pix1);
@@ -880,27 +963,20 @@ PIX     *pixt;
          *  is within a dilation distance of some pixel in pix3.  Namely,
          *  that pix4 entirely covers pix1:
          *       pixt = pixSubtract(NULL, pix1, pix4), including shift
-         *  where pixt has no ON pixels.  */
-    pixt = pixCreateTemplate(pix1);
-    pixRasterop(pixt, 0, 0, wi, hi, PIX_SRC, pix1, 0, 0);
-    pixRasterop(pixt, idelx, idely, wi, hi, PIX_DST & PIX_NOT(PIX_SRC),
-                pix4, 0, 0);
-    pixZero(pixt, &boolmatch);
-    if (boolmatch == 0) {
-        pixDestroy(&pixt);
+         *  where pixt has no ON pixels.  This is done word by word,
+         *  without making pixt, and stops at the first ON pixel.  */
+    if (hausCountUncovered(pix1, pix4, idelx, idely, 0, NULL) > 0)
         return FALSE;
-    }
 
         /*  Do 1-direction hausdorff, checking that every pixel in pix3
          *  is within a dilation distance of some pixel in pix1.  Namely,
          *  that pix2 entirely covers pix3:
          *      pixSubtract(pixt, pix3, pix2), including shift
          *  where pixt has no ON pixels. */
-    pixRasterop(pixt, idelx, idely, wt, ht, PIX_SRC, pix3, 0, 0);
-    pixRasterop(pixt, 0, 0, wt, ht, PIX_DST & PIX_NOT(PIX_SRC), pix2, 0, 0);
-    pixZero(pixt, &boolmatch);
-    pixDestroy(&pixt);
-    return boolmatch;
+    if (hausCountUncoveredTemplate(NULL, pix2, pix3, NULL, idelx, idely,
+                                   0, NULL) > 0)
+        return FALSE;
+    return TRUE;
 }
 
 
@@ -918,7 +994,7 @@ PIX     *pixt;
  *              area1  (fg pixels in pix1)
  *              area3  (fg pixels in pix3)
  *              rank   (rank value of test, each way)
- *              tab8   (table of pixel sums for byte)
+ *              tab8   (table of pixel sums for byte; can be null)
  *      Return: 0 (FALSE) if no match, 1 (TRUE) if the new
  *                 pix is in the same class as the exemplar.
  *
@@ -949,9 +1025,9 @@ pixRankHaustest(PIX       *pix1,
                 l_float32  rank,
                 l_int32   *tab8)
 {
-l_int32  wi, hi, wt, ht, delw, delh, idelx, idely, boolmatch;
-l_int32  thresh1, thresh3;
-PIX     *pixt;
+l_int32   wi, hi, wt, ht, delw, delh, idelx, idely, boolmatch;
+l_int32   thresh1, thresh3;
+l_int32  *tab;
 
         /* Eliminate possible matches based on size difference */
     wi = pixGetWidth(pix1);
@@ -980,34 +1056,35 @@ PIX     *pixt;
     else
         idely = (l_int32)(dely - 0.5);
 
-        /*  Do 1-direction hausdorff, checking that every pixel in pix1
-         *  is within a dilation distance of some pixel in pix3.  Namely,
-         *  that pix4 entirely covers pix1:
+        /*  Do 1-direction rank hausdorff, checking that no more than
+         *  thresh1 pixels in pix1 are beyond a dilation distance of
+         *  pix3.  Namely, that pix4 covers all but thresh1 pixels
+         *  of pix1:
          *       pixt = pixSubtract(NULL, pix1, pix4), including shift
-         *  where pixt has no ON pixels.  */
-    pixt = pixCreateTemplate(pix1);
-    pixRasterop(pixt, 0, 0, wi, hi, PIX_SRC, pix1, 0, 0);
-    pixRasterop(pixt, idelx, idely, wi, hi, PIX_DST & PIX_NOT(PIX_SRC),
-                pix4, 0, 0);
-    pixThresholdPixelSum(pixt, thresh1, &boolmatch, tab8);
-    if (boolmatch == 1) { /* above thresh1 */
-        pixDestroy(&pixt);
-        return FALSE;
+         *  where pixt has no more than thresh1 ON pixels.  This is done
+         *  word by word, without making pixt, and stops as soon as
+         *  the count is above thresh1.  */
+    if (!tab8)
+        tab = makePixelSumTab8();
+    else
+        tab = tab8;
+    boolmatch = FALSE;
+    if (hausCountUncovered(pix1, pix4, idelx, idely, thresh1, tab)
+            <= thresh1) {
+
+            /*  Do 1-direction rank hausdorff, checking that pix2 covers
+             *  all but thresh3 pixels of pix3:
+             *      pixSubtract(pixt, pix3, pix2), including shift
+             *  where pixt, which also holds what is left of the first
+             *  test outside of the shifted pix3, has no more than
+             *  thresh3 ON pixels. */
+        if (hausCountUncoveredTemplate(pix1, pix2, pix3, pix4, idelx, idely,
+                                       thresh3, tab) <= thresh3)
+            boolmatch = TRUE;
     }
 
-        /*  Do 1-direction hausdorff, checking that every pixel in pix3
-         *  is within a dilation distance of some pixel in pix1.  Namely,
-         *  that pix2 entirely covers pix3:
-         *      pixSubtract(pixt, pix3, pix2), including shift
-         *  where pixt has no ON pixels. */
-    pixRasterop(pixt, idelx, idely, wt, ht, PIX_SRC, pix3, 0, 0);
-    pixRasterop(pixt, 0, 0, wt, ht, PIX_DST & PIX_NOT(PIX_SRC), pix2, 0, 0);
-    pixThresholdPixelSum(pixt, thresh3, &boolmatch, tab8);
-    pixDestroy(&pixt);
-    if (boolmatch == 1)  /* above thresh3 */
-        return FALSE;
-    else
-        return TRUE;
+    if (!tab8) FREE(tab);
+    return boolmatch;
 }
 
 
@@ -1028,7 +1105,7 @@ jbClassifyCorrelation(JBCLASSER  *classer,
                       PIXA       *pixas)
 {
 l_int32     n, nt, i, iclass, wt, ht, found, area, area1, area2, npages,
-            overthreshold;
+            overthreshold, count, ret;
 l_int32    *sumtab, *centtab;
 l_uint32   *row, word;
 l_float32   x1, y1, x2, y2, xsum, ysum;
@@ -1037,8 +1114,11 @@ BOX        *box;
 NUMA       *naclass, *napage;
 NUMA       *nafgt;   /* fg area of all templates */
 NUMA       *naarea;   /* w * h area of all templates */
+NUMA       *nasig;   /* projection signature of the instance */
+NUMA       *nasigt;   /* projection signature of a template */
+NUMAA      *naasig;   /* projection signatures of all templates */
 JBFINDCTX  *findcontext;
-NUMAHASH   *nahash;
+L_HASHMAP  *hmap;
 PIX        *pix, *pix1, *pix2;
 PIXA       *pixa, *pixa1, *pixat;
 PIXAA      *pixaa;
@@ -1166,21 +1246,31 @@ l_uint8     byte;
          * be an unnecessary division of classes representing the
          * same character.  The weightfactor adds in some of the
          * difference (1.0 - thresh), depending on the heaviness
-         * of the template (measured as the fraction of fg pixels). */
+         * of the template (measured as the fraction of fg pixels).
+         * Before the bitmaps are compared, the projection signatures
+         * of instance and template give an upper bound on the count
+         * in the AND; if that bound is below the count required
+         * by the threshold, the template is skipped.  Because the
+         * bound is exact, this never changes the result. */
     thresh = classer->thresh;
     weight = classer->weightfactor;
     naarea = classer->naarea;
-    nahash = classer->nahash;
+    naasig = classer->naasig;
+    hmap = classer->hmap;
+    ret = 0;
     for (i = 0; i < n; i++) {
         pix1 = pixaGetPix(pixa1, i, L_CLONE);
         area1 = pixcts[i];
         ptaGetPt(pta, i, &x1, &y1);  /* centroid for this instance */
+        if ((nasig = jbGetSignature(pix1, sumtab)) == NULL) {
+            pixDestroy(&pix1);
+            ret = ERROR_INT("nasig not made", procName, 1);
+            break;
+        }
         nt = pixaGetCount(pixat);
         found = FALSE;
         findcontext = findSimilarSizedTemplatesInit(classer, pix1);
         while ( (iclass = findSimilarSizedTemplatesNext(findcontext)) > -1) {
-                /* Get the template */
-            pix2 = pixaGetPix(pixat, iclass, L_CLONE);
             numaGetIValue(nafgt, iclass, &area2);
             ptaGetPt(ptact, iclass, &x2, &y2);  /* template centroid */
 
@@ -1192,7 +1282,18 @@ l_uint8     byte;
             else
                 threshold = thresh;
 
+                /* Reject using the signatures; the required count is
+                 * found as in pixCorrelationScoreThresholded() */
+            count = (l_int32)ceil(sqrt(threshold * area1 * area2));
+            nasigt = numaaGetNuma(naasig, iclass, L_CLONE);
+            overthreshold = jbSignatureTest(nasig, nasigt, x1 - x2, y1 - y2,
+                                            count);
+            numaDestroy(&nasigt);
+            if (!overthreshold)
+                continue;
+
                 /* Find score for this template */
+            pix2 = pixaGetPix(pixat, iclass, L_CLONE);
             overthreshold = pixCorrelationScoreThresholded(pix1, pix2,
                                                            area1, area2,
                                                            x1 - x2, y1 - y2,
@@ -1255,12 +1356,13 @@ l_uint8     byte;
             pixaAddPix(pixa, pix, L_INSERT);
             wt = pixGetWidth(pix);
             ht = pixGetHeight(pix);
-            numaHashAdd(nahash, ht * wt, nt);
+            jbAddTemplateBySize(hmap, wt, ht, nt);
             box = boxaGetBox(boxa, i, L_CLONE);
             pixaAddBox(pixa, box, L_INSERT);
             pixaaAddPixa(pixaa, pixa, L_INSERT);  /* unbordered instance */
             ptaAddPt(ptact, x1, y1);
             numaAddNumber(nafgt, area1);
+            numaaAddNuma(naasig, nasig, L_INSERT);
             pixaAddPix(pixat, pix1, L_INSERT);   /* bordered template */
             area = (pixGetWidth(pix1) - 2 * JB_ADDED_PIXELS) *
                    (pixGetHeight(pix1) - 2 * JB_ADDED_PIXELS);
@@ -1268,6 +1370,7 @@ l_uint8     byte;
         }
         else {   /* don't save it */
             pixDestroy(&pix1);
+            numaDestroy(&nasig);
         }
     }
     classer->nclass = pixaGetCount(pixat);
@@ -1282,7 +1385,7 @@ l_uint8     byte;
     FREE(sumtab);
     ptaDestroy(&pta);
     pixaDestroy(&pixa1);
-    return 0;
+    return ret;
 }
 
 
@@ -1687,6 +1790,7 @@ JBCLASSER  *classer;
     classer->pixat = pixaCreate(0);
     classer->pixatd = pixaCreate(0);
     classer->nafgt = numaCreate(0);
+    classer->naasig = numaaCreate(0);
     classer->naarea = numaCreate(0);
     classer->ptac = ptaCreate(0);
     classer->ptact = ptaCreate(0);
@@ -1707,6 +1811,8 @@ JBCLASSER  *classer;
 void
 jbClasserDestroy(JBCLASSER  **pclasser)
 {
+l_int32     i;
+NUMA       *na;
 JBCLASSER  *classer;
 
     if (!pclasser)
@@ -1719,8 +1825,17 @@ JBCLASSER  *classer;
     pixaaDestroy(&classer->pixaa);
     pixaDestroy(&classer->pixat);
     pixaDestroy(&classer->pixatd);
-    numaHashDestroy(&classer->nahash);
+    if (classer->hmap) {
+        for (i = 0; i < classer->hmap->nalloc; i++) {
+            if (classer->hmap->items[i].used) {
+                na = (NUMA *)classer->hmap->items[i].ptr;
+                numaDestroy(&na);
+            }
+        }
+        l_hmapDestroy(&classer->hmap);
+    }
     numaDestroy(&classer->nafgt);
+    numaaDestroy(&classer->naasig);
     numaDestroy(&classer->naarea);
     ptaDestroy(&classer->ptac);
     ptaDestroy(&classer->ptact);
@@ -2295,11 +2410,12 @@ JBFINDCTX  *state;
  *      Input:  state (from findSimilarSizedTemplatesInit)
  *      Return: Next template number, or -1 when finished
  *
- *  We have a hash table mapping template area to a list of template
- *  numbers with that area.  We wish to find similar sized templates,
- *  so we first look for templates with the same width and height, and
- *  then with width + 1, etc.  This walk is guided by the
- *  two_by_two_walk array, above.
+ *  We have a hash map from template size (w, h) to a list of template
+ *  numbers with that size.  Because the key is the exact size, every
+ *  template in the list has the desired dimensions.  We wish to find
+ *  similar sized templates, so we first look for templates with the
+ *  same width and height, and then with width + 1, etc.  This walk is
+ *  guided by the two_by_two_walk array, above.
  *
  *  We don't want to have to collect the whole list of templates first because
  *  (we hope) to find it quickly.  So we keep the context for this walk in an
@@ -2308,8 +2424,9 @@ JBFINDCTX  *state;
 static l_int32
 findSimilarSizedTemplatesNext(JBFINDCTX  *state)
 {
-l_int32  desiredh, desiredw, size, templ;
-PIX     *pixt;
+l_int32      desiredh, desiredw, size, templ;
+l_uint64     key;
+L_HASHITEM  *item;
 
     while(1) {  /* Continue the walk over step 'i' */
         if (state->i >= 25) {  /* all done */
@@ -2325,27 +2442,22 @@ PIX     *pixt;
 
         if (!state->numa) {
                 /* We have yet to start walking the array for the step 'i' */
-            state->numa = numaHashGetNuma(state->classer->nahash,
-                                          desiredh * desiredw);
-            if (!state->numa) {  /* nothing there */
+            key = ((l_uint64)desiredw << 32) | (l_uint64)desiredh;
+            item = l_hmapLookup(state->classer->hmap, key, L_HMAP_CHECK);
+            if (!item) {  /* nothing there */
                 state->i++;
                 continue;
             }
 
+            state->numa = numaClone((NUMA *)item->ptr);
             state->n = 0;  /* OK, we got a numa. */
         }
 
             /* Continue working on this numa */
         size = numaGetCount(state->numa);
-        for ( ; state->n < size; ) {
+        if (state->n < size) {
             templ = (l_int32)(state->numa->array[state->n++] + 0.5);
-            pixt = pixaGetPix(state->classer->pixat, templ, L_CLONE);
-            if (pixGetWidth(pixt) - 2 * JB_ADDED_PIXELS == desiredw &&
-                pixGetHeight(pixt) - 2 * JB_ADDED_PIXELS == desiredh) {
-                pixDestroy(&pixt);
-                return templ;
-            }
-            pixDestroy(&pixt);
+            return templ;
         }
 
             /* Exhausted the numa; take another step and try again */
@@ -2356,6 +2468,475 @@ PIX     *pixt;
 }
 
 
+/*!
+ *  jbAddTemplateBySize()
+ *
+ *      Input:  hmap (of template size to numa of template indices)
+ *              w, h (size of the unbordered template)
+ *              index (of the template in classer->pixat)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) The key is the exact size, packed as (w << 32) | h, so there
+ *          are no collisions between different sizes, as there were
+ *          when the templates were hashed by area.
+ */
+static l_int32
+jbAddTemplateBySize(L_HASHMAP  *hmap,
+                    l_int32     w,
+                    l_int32     h,
+                    l_int32     index)
+{
+l_uint64     key;
+L_HASHITEM  *item;
+
+    PROCNAME("jbAddTemplateBySize");
+
+    if (!hmap)
+        return ERROR_INT("hmap not defined", procName, 1);
+
+    key = ((l_uint64)w << 32) | (l_uint64)h;
+    if ((item = l_hmapLookup(hmap, key, L_HMAP_CREATE)) == NULL)
+        return ERROR_INT("item not made", procName, 1);
+    if (!item->ptr)
+        item->ptr = (void *)numaCreate(4);
+    numaAddNumber((NUMA *)item->ptr, index);
+    return 0;
+}
+
+
+/*!
+ *  jbGetSignature()
+ *
+ *      Input:  pix (1 bpp; bordered instance or template)
+ *              tab8 (table of pixel sums for byte)
+ *      Return: na (projection signature), or null on error
+ *
+ *  Notes:
+ *      (1) The signature is a low-resolution version of the row and
+ *          column projections of the fg pixels, where the counts are
+ *          summed over bands of JB_SIG_BANDSIZE rows or columns.
+ *          It is stored as:
+ *             {nrowbands, fg count, row bands ..., column bands ...}
+ *      (2) With 4-pixel bands, each column band is the sum of one
+ *          nibble in each row, which tab8 also counts.
+ *      (3) Use jbSignatureTest() to compare two signatures.
+ */
+static NUMA *
+jbGetSignature(PIX      *pix,
+               l_int32  *tab8)
+{
+l_int32    i, j, k, w, h, wpl, nrb, ncb, endbits, rowsum, count;
+l_int32   *rowband, *colband;
+l_uint32   word, endmask;
+l_uint32  *line;
+NUMA      *na;
+
+    PROCNAME("jbGetSignature");
+
+    if (!pix || pixGetDepth(pix) != 1)
+        return (NUMA *)ERROR_PTR("pix undefined or not 1 bpp", procName, NULL);
+    if (!tab8)
+        return (NUMA *)ERROR_PTR("tab8 not defined", procName, NULL);
+
+    pixGetDimensions(pix, &w, &h, NULL);
+    wpl = pixGetWpl(pix);
+    nrb = (h + JB_SIG_BANDSIZE - 1) / JB_SIG_BANDSIZE;
+    ncb = (w + JB_SIG_BANDSIZE - 1) / JB_SIG_BANDSIZE;
+    endbits = w & 31;
+    endmask = (endbits == 0) ? 0xffffffff : 0xffffffff << (32 - endbits);
+    rowband = (l_int32 *)CALLOC(nrb, sizeof(l_int32));
+    colband = (l_int32 *)CALLOC(8 * wpl, sizeof(l_int32));
+    if (!rowband || !colband) {
+        FREE(rowband);
+        FREE(colband);
+        return (NUMA *)ERROR_PTR("bands not made", procName, NULL);
+    }
+
+    count = 0;
+    line = pixGetData(pix);
+    for (i = 0; i < h; i++, line += wpl) {
+        rowsum = 0;
+        for (j = 0; j < wpl; j++) {
+            word = (j == wpl - 1) ? line[j] & endmask : line[j];
+            if (word == 0)
+                continue;
+            for (k = 0; k < 8; k++) {
+                colband[8 * j + k] += tab8[(word >> (28 - 4 * k)) & 0xf];
+            }
+            rowsum += tab8[word & 0xff] + tab8[(word >> 8) & 0xff] +
+                      tab8[(word >> 16) & 0xff] + tab8[word >> 24];
+        }
+        rowband[i / JB_SIG_BANDSIZE] += rowsum;
+        count += rowsum;
+    }
+
+    if ((na = numaCreate(2 + nrb + ncb)) == NULL) {
+        FREE(rowband);
+        FREE(colband);
+        return (NUMA *)ERROR_PTR("na not made", procName, NULL);
+    }
+    numaAddNumber(na, nrb);
+    numaAddNumber(na, count);
+    for (i = 0; i < nrb; i++)
+        numaAddNumber(na, rowband[i]);
+    for (i = 0; i < ncb; i++)
+        numaAddNumber(na, colband[i]);
+    FREE(rowband);
+    FREE(colband);
+    return na;
+}
+
+
+/*!
+ *  jbSignatureTest()
+ *
+ *      Input:  na1 (signature of instance)
+ *              na2 (signature of template)
+ *              delx, dely (centroid difference, instance - template)
+ *              mincount (number of fg pixels required in the AND)
+ *      Return: 1 if the AND of the instance and the template, shifted as
+ *              in pixCorrelationScoreThresholded() and pixHaustest(),
+ *              can have mincount fg pixels; 0 if it cannot
+ *
+ *  Notes:
+ *      (1) The shift is rounded to the nearest integer in the same
+ *          way as in the matching functions.  The AND cannot hold
+ *          more pixels than either image, nor, for each band of
+ *          the instance, more than the template pixels in the one
+ *          or two bands that it overlaps.  Summing the latter over
+ *          the bands gives a bound for both rows and columns.
+ *      (2) This is a necessary condition only, and is used to skip
+ *          templates that cannot match without reading their bitmaps.
+ */
+static l_int32
+jbSignatureTest(NUMA      *na1,
+                NUMA      *na2,
+                l_float32  delx,
+                l_float32  dely,
+                l_int32    mincount)
+{
+l_int32     idelx, idely, nrb1, nrb2, ncb1, ncb2;
+l_float32  *sig1, *sig2;
+
+    sig1 = numaGetFArray(na1, L_NOCOPY);
+    sig2 = numaGetFArray(na2, L_NOCOPY);
+    if (sig1[1] < mincount || sig2[1] < mincount)
+        return 0;
+
+    if (delx >= 0)
+        idelx = (l_int32)(delx + 0.5);
+    else
+        idelx = (l_int32)(delx - 0.5);
+    if (dely >= 0)
+        idely = (l_int32)(dely + 0.5);
+    else
+        idely = (l_int32)(dely - 0.5);
+
+    nrb1 = (l_int32)sig1[0];
+    nrb2 = (l_int32)sig2[0];
+    ncb1 = numaGetCount(na1) - 2 - nrb1;
+    ncb2 = numaGetCount(na2) - 2 - nrb2;
+    if (!jbBandTest(sig1 + 2, nrb1, sig2 + 2, nrb2, idely, sig1[1],
+                    mincount))
+        return 0;
+    return jbBandTest(sig1 + 2 + nrb1, ncb1, sig2 + 2 + nrb2, ncb2, idelx,
+                      sig1[1], mincount);
+}
+
+
+/*!
+ *  jbBandTest()
+ *
+ *      Input:  band1 (band sums of instance)
+ *              n1 (number of bands in band1)
+ *              band2 (band sums of template)
+ *              n2 (number of bands in band2)
+ *              shift (of template relative to instance, in pixels)
+ *              total1 (sum of band1)
+ *              mincount (number of fg pixels required in the AND)
+ *      Return: 1 if the band sums allow mincount fg pixels in the AND;
+ *              0 otherwise
+ *
+ *  Notes:
+ *      (1) Pixel p of the instance is compared with pixel p - shift
+ *          of the template.
+ *      (2) The loop stops as soon as the running bound reaches
+ *          mincount, or is certain not to reach it.
+ */
+static l_int32
+jbBandTest(l_float32  *band1,
+           l_int32     n1,
+           l_float32  *band2,
+           l_int32     n2,
+           l_int32     shift,
+           l_float32   total1,
+           l_int32     mincount)
+{
+l_int32    i, lo, hi, jlo, jhi;
+l_float32  sum, bound, remaining;
+
+    bound = 0.0;
+    remaining = total1;
+    for (i = 0; i < n1; i++) {
+        if (band1[i] == 0.0)
+            continue;
+        lo = JB_SIG_BANDSIZE * i - shift;
+        hi = lo + JB_SIG_BANDSIZE - 1;
+        jlo = (lo >= 0) ? lo / JB_SIG_BANDSIZE :
+                          -((JB_SIG_BANDSIZE - 1 - lo) / JB_SIG_BANDSIZE);
+        jhi = (hi >= 0) ? hi / JB_SIG_BANDSIZE :
+                          -((JB_SIG_BANDSIZE - 1 - hi) / JB_SIG_BANDSIZE);
+        sum = 0.0;
+        if (jlo >= 0 && jlo < n2)
+            sum += band2[jlo];
+        if (jhi != jlo && jhi >= 0 && jhi < n2)
+            sum += band2[jhi];
+        bound += L_MIN(band1[i], sum);
+        remaining -= band1[i];
+        if (bound >= mincount)
+            return 1;
+        if (bound + remaining < mincount)
+            return 0;
+    }
+    return (bound >= mincount) ? 1 : 0;
+}
+
+
+/*!
+ *  hausCountUncovered()
+ *
+ *      Input:  pix1 (new pix, not dilated)
+ *              pix4 (exemplar pix, dilated)
+ *              idelx, idely (shift of pix4 relative to pix1)
+ *              thresh (stop counting when the count exceeds this)
+ *              tab8 (table of pixel sums for byte; can be null)
+ *      Return: number of fg pixels in pix1 that are not covered by
+ *              pix4, shifted by (idelx, idely); counting stops as
+ *              soon as thresh is exceeded.  If tab8 is null, the
+ *              return value is 1 if there is any such pixel and 0
+ *              otherwise.
+ *
+ *  Notes:
+ *      (1) This gives the same result as
+ *            pixt = pixSubtract(NULL, pix1, pix4), including shift
+ *          without making pixt.  The words of pix4 are shifted into
+ *          alignment with pix1 as they are needed.
+ *      (2) As with the rasterop, only the part of pix4 within the
+ *          size of pix1 is used.
+ */
+static l_int32
+hausCountUncovered(PIX      *pix1,
+                   PIX      *pix4,
+                   l_int32   idelx,
+                   l_int32   idely,
+                   l_int32   thresh,
+                   l_int32  *tab8)
+{
+l_int32    i, j, w1, h1, w4, h4, wpl1, wpl4, count;
+l_uint32   word, endmask;
+l_uint32  *data1, *data4, *line1, *line4;
+
+    pixGetDimensions(pix1, &w1, &h1, NULL);
+    pixGetDimensions(pix4, &w4, &h4, NULL);
+    w4 = L_MIN(w4, w1);  /* the rasterop only uses this part of pix4 */
+    h4 = L_MIN(h4, h1);
+    wpl1 = pixGetWpl(pix1);
+    wpl4 = pixGetWpl(pix4);
+    data1 = pixGetData(pix1);
+    data4 = pixGetData(pix4);
+    endmask = hausRangeMask(32 * (wpl1 - 1), 0, w1);
+
+    count = 0;
+    for (i = 0; i < h1; i++) {
+        line1 = data1 + i * wpl1;
+        if (i - idely >= 0 && i - idely < h4)
+            line4 = data4 + (i - idely) * wpl4;
+        else
+            line4 = NULL;
+        for (j = 0; j < wpl1; j++) {
+            word = (j == wpl1 - 1) ? line1[j] & endmask : line1[j];
+            if (word == 0)
+                continue;
+            word &= ~hausGetWord(line4, wpl4, w4, 32 * j - idelx);
+            if (word == 0)
+                continue;
+            if (!tab8)
+                return 1;
+            count += tab8[word & 0xff] + tab8[(word >> 8) & 0xff] +
+                     tab8[(word >> 16) & 0xff] + tab8[word >> 24];
+            if (count > thresh)
+                return count;
+        }
+    }
+    return count;
+}
+
+
+/*!
+ *  hausCountUncoveredTemplate()
+ *
+ *      Input:  pix1 (new pix, not dilated; can be null)
+ *              pix2 (new pix, dilated)
+ *              pix3 (exemplar pix, not dilated)
+ *              pix4 (exemplar pix, dilated; can be null)
+ *              idelx, idely (shift of pix3 relative to pix2)
+ *              thresh (stop counting when the count exceeds this)
+ *              tab8 (table of pixel sums for byte; can be null)
+ *      Return: number of fg pixels in pix3, shifted by (idelx, idely),
+ *              that are not covered by pix2; counting stops as soon
+ *              as thresh is exceeded.  If tab8 is null, the return
+ *              value is 1 if there is any such pixel and 0 otherwise.
+ *
+ *  Notes:
+ *      (1) This gives the same count as the second half of the
+ *          rasterop-based test, where pixt holds the result of the
+ *          first half and is of the size of pix2:
+ *            pixRasterop(pixt, idelx, idely, wt, ht, PIX_SRC, pix3, 0, 0);
+ *            pixRasterop(pixt, 0, 0, wt, ht, PIX_DST & PIX_NOT(PIX_SRC),
+ *                        pix2, 0, 0);
+ *          Pixels of pixt outside the rectangle covered by pix3 keep
+ *          the residue of the first half, pix1 - pix4, and pix2 is
+ *          only subtracted within the first wt columns and ht rows.
+ *      (2) When the first half left no residue, as in pixHaustest(),
+ *          pass null for pix1 and pix4.
+ */
+static l_int32
+hausCountUncoveredTemplate(PIX      *pix1,
+                           PIX      *pix2,
+                           PIX      *pix3,
+                           PIX      *pix4,
+                           l_int32   idelx,
+                           l_int32   idely,
+                           l_int32   thresh,
+                           l_int32  *tab8)
+{
+l_int32    i, j, w, h, w3, h3, w4, h4, wpl, wpl3, wpl4, count;
+l_uint32   word, res, endmask, rectmask, submask;
+l_uint32  *data1, *data2, *data3, *data4, *line1, *line2, *line3, *line4;
+
+    pixGetDimensions(pix2, &w, &h, NULL);
+    pixGetDimensions(pix3, &w3, &h3, NULL);
+    wpl = pixGetWpl(pix2);
+    wpl3 = pixGetWpl(pix3);
+    data2 = pixGetData(pix2);
+    data3 = pixGetData(pix3);
+    data1 = data4 = NULL;
+    w4 = h4 = wpl4 = 0;
+    if (pix1 && pix4) {
+        pixGetDimensions(pix4, &w4, &h4, NULL);
+        w4 = L_MIN(w4, w);
+        h4 = L_MIN(h4, h);
+        wpl4 = pixGetWpl(pix4);
+        data1 = pixGetData(pix1);
+        data4 = pixGetData(pix4);
+    }
+    endmask = hausRangeMask(32 * (wpl - 1), 0, w);
+
+    count = 0;
+    for (i = 0; i < h; i++) {
+        line2 = data2 + i * wpl;
+        if (i - idely >= 0 && i - idely < h3)
+            line3 = data3 + (i - idely) * wpl3;
+        else
+            line3 = NULL;
+        line1 = (data1) ? data1 + i * wpl : NULL;
+        if (data4 && i - idely >= 0 && i - idely < h4)
+            line4 = data4 + (i - idely) * wpl4;
+        else
+            line4 = NULL;
+        for (j = 0; j < wpl; j++) {
+            word = hausGetWord(line3, wpl3, w3, 32 * j - idelx);
+            if (line1) {  /* residue of the first half, outside pix3 */
+                res = line1[j] & ~hausGetWord(line4, wpl4, w4, 32 * j - idelx);
+                rectmask = (line3) ?
+                           hausRangeMask(32 * j, idelx, idelx + w3) : 0;
+                word |= res & ~rectmask;
+            }
+            if (j == wpl - 1)
+                word &= endmask;
+            if (word == 0)
+                continue;
+            if (i < h3) {
+                submask = hausRangeMask(32 * j, 0, w3);
+                word &= ~(line2[j] & submask);
+                if (word == 0)
+                    continue;
+            }
+            if (!tab8)
+                return 1;
+            count += tab8[word & 0xff] + tab8[(word >> 8) & 0xff] +
+                     tab8[(word >> 16) & 0xff] + tab8[word >> 24];
+            if (count > thresh)
+                return count;
+        }
+    }
+    return count;
+}
+
+
+/*!
+ *  hausGetWord()
+ *
+ *      Input:  line (raster line of a 1 bpp pix; can be null)
+ *              wpl (of the pix)
+ *              w (width of the pix)
+ *              x (pixel in line that goes to the MSB of the word)
+ *      Return: word of 32 pixels starting at x, with 0 for any pixel
+ *              that is not within [0, w), or if line is null
+ */
+static l_uint32
+hausGetWord(l_uint32  *line,
+            l_int32    wpl,
+            l_int32    w,
+            l_int32    x)
+{
+l_int32   q, r;
+l_uint32  word;
+
+    if (!line || x >= w || x <= -32)
+        return 0;
+    if (x >= 0) {
+        q = x >> 5;
+        r = x & 31;
+    }
+    else {
+        q = -1;
+        r = x + 32;
+    }
+    word = (q >= 0) ? line[q] << r : 0;
+    if (r > 0 && q + 1 < wpl)
+        word |= line[q + 1] >> (32 - r);
+    return word & hausRangeMask(x, 0, w);
+}
+
+
+/*!
+ *  hausRangeMask()
+ *
+ *      Input:  x (pixel at the MSB of the word)
+ *              xstart, xend (range of pixels [xstart, xend) to keep)
+ *      Return: mask with a 1 for each pixel in the word within the range
+ */
+static l_uint32
+hausRangeMask(l_int32  x,
+              l_int32  xstart,
+              l_int32  xend)
+{
+l_int32   a, b;
+l_uint32  mask;
+
+    a = L_MAX(xstart - x, 0);
+    b = L_MIN(xend - x, 32);
+    if (a >= b)
+        return 0;
+    mask = (a == 0) ? 0xffffffff : 0xffffffff >> a;
+    if (b < 32)
+        mask &= ~(0xffffffff >> b);
+    return mask;
+}
+
+
 /*!
  *  finalPositioningForAlignment()
  *
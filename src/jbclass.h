@@ -68,9 +68,11 @@ struct JbClasser
                                    /* and not dilated                        */
     struct Pixa     *pixatd;       /* templates for each class; bordered     */
                                    /* and dilated                            */
-    struct NumaHash *nahash;       /* Hash table to find templates by size   */
+    struct L_HashMap *hmap;        /* Hash map to find templates by size     */
     struct Numa     *nafgt;        /* fg areas of undilated templates;       */
                                    /* only used for rank < 1.0               */
+    struct Numaa    *naasig;       /* low-res projection signature of each   */
+                                   /* template; dilated for rank hausdorff   */
     struct Pta      *ptac;         /* centroids of all bordered cc           */
     struct Pta      *ptact;        /* centroids of all bordered template cc  */
     struct Numa     *naclass;      /* array of class ids for each component  */
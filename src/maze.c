@@ -86,6 +86,14 @@ struct MazeElement {
 };
 typedef struct MazeElement  MAZEEL;
 
+struct MazeGrayElement {
+    l_uint32   distance;  /* key for the radix heap; must be first */
+    l_int32    x;
+    l_int32    y;
+    l_uint32   val;  /* value of maze pixel at this location */
+};
+typedef struct MazeGrayElement  MAZEGEL;
+
 
 static MAZEEL *mazeelCreate(l_int32  x, l_int32  y, l_int32  dir);
 static l_int32 localSearchForBackground(PIX  *pix, l_int32  *px,
@@ -656,7 +664,12 @@ l_uint32  val;
  *      the queue, you're done, and you can trace the path backward,
  *      either always going downhill or using an auxiliary image to
  *      give you the direction to go at each step.  This is implemented
- *      here in searchGrayMaze().
+ *      here in searchGrayMaze().  Because the costs are integers and
+ *      the distance of each pixel put on the queue is never less than
+ *      that of the pixel last removed, the priority queue is a radix
+ *      heap (L_RHeap), which holds the elements by value.  Elements
+ *      whose distance has since been relaxed on the auxiliary image
+ *      are discarded when they are removed.
  *
  *      Do we really have to use a sorted queue?  Can we solve this
  *      generalized maze with an unsorted queue of pixels?  (Or even
@@ -737,12 +750,12 @@ l_int32   x, y, w, h, d;
 l_uint32  val, valr, vals, rpixel, gpixel, bpixel;
 void    **lines8, **liner32, **linep8;
 l_int32   cost, dist, distparent, sival, sivals;
-MAZEEL   *el, *elp;
+MAZEGEL   el, elp;
 PIX      *pixd;  /* optionally plot the path on this RGB version of pixs */
 PIX      *pixr;  /* for bookkeeping, to indicate the minimum distance */
                  /* to pixels already visited */
 PIX      *pixp;  /* for bookkeeping, to indicate direction to parent */
-L_HEAP   *lh;
+L_RHEAP  *rh;
 PTA      *pta;
 
     PROCNAME("pixSearchGrayMaze");
@@ -767,33 +780,32 @@ PTA      *pta;
     linep8 = pixGetLinePtrs(pixp, NULL);
     liner32 = pixGetLinePtrs(pixr, NULL);
 
-    lh = lheapCreate(0, L_SORT_INCREASING);  /* always remove closest pixels */
+    rh = rheapCreate(sizeof(MAZEGEL));  /* always remove closest pixels */
 
         /* Prime the heap with the first pixel */
     pixGetPixel(pixs, xi, yi, &val);
-    el = mazeelCreate(xi, yi, 0);  /* don't need direction here */
-    el->distance = 0;
-    pixGetPixel(pixs, xi, yi, &val);
-    el->val = val;
+    el.x = xi;
+    el.y = yi;
+    el.distance = 0;
+    el.val = val;
     pixSetPixel(pixr, xi, yi, 0);  /* distance is 0 */
-    lheapAdd(lh, el);
+    rheapAdd(rh, &el);
 
         /* Breadth-first search with priority queue (implemented by
            a heap), labeling direction to parents in pixp and minimum
            distance to visited pixels in pixr.  Stop when we pull
            the destination point (xf, yf) off the queue. */
-    while (lheapGetCount(lh) > 0) {
-        elp = (MAZEEL *)lheapRemove(lh);
-        if (!elp)
+    while (rheapGetCount(rh) > 0) {
+        if (rheapRemove(rh, &elp))
             return (PTA *)ERROR_PTR("heap broken!!", procName, NULL);
-        x = elp->x;
-        y = elp->y;
-        if (x == xf && y == yf) {  /* exit condition */
-            FREE(elp);
+        x = elp.x;
+        y = elp.y;
+        if (x == xf && y == yf)  /* exit condition */
             break;
-        }
-        distparent = (l_int32)elp->distance;
-        val = elp->val;
+        if (elp.distance > GET_DATA_FOUR_BYTES(liner32[y], x))
+            continue;  /* stale; relaxed after this was put on the heap */
+        distparent = (l_int32)elp.distance;
+        val = elp.val;
         sival = val;
 
         if (x > 0) {  /* check to west */
@@ -805,10 +817,11 @@ PTA      *pta;
             if (dist < valr) {  /* shortest path so far to this pixel */
                 SET_DATA_FOUR_BYTES(liner32[y], x - 1, dist);  /* new dist */
                 SET_DATA_BYTE(linep8[y], x - 1, DIR_EAST);  /* parent to E */
-                el = mazeelCreate(x - 1, y, 0);
-                el->val = vals;
-                el->distance = dist;
-                lheapAdd(lh, el);
+                el.x = x - 1;
+                el.y = y;
+                el.val = vals;
+                el.distance = dist;
+                rheapAdd(rh, &el);
             }
         }
         if (y > 0) {  /* check north */
@@ -820,10 +833,11 @@ PTA      *pta;
             if (dist < valr) {  /* shortest path so far to this pixel */
                 SET_DATA_FOUR_BYTES(liner32[y - 1], x, dist);  /* new dist */
                 SET_DATA_BYTE(linep8[y - 1], x, DIR_SOUTH);  /* parent to S */
-                el = mazeelCreate(x, y - 1, 0);
-                el->val = vals;
-                el->distance = dist;
-                lheapAdd(lh, el);
+                el.x = x;
+                el.y = y - 1;
+                el.val = vals;
+                el.distance = dist;
+                rheapAdd(rh, &el);
             }
         }
         if (x < w - 1) {  /* check east */
@@ -835,10 +849,11 @@ PTA      *pta;
             if (dist < valr) {  /* shortest path so far to this pixel */
                 SET_DATA_FOUR_BYTES(liner32[y], x + 1, dist);  /* new dist */
                 SET_DATA_BYTE(linep8[y], x + 1, DIR_WEST);  /* parent to W */
-                el = mazeelCreate(x + 1, y, 0);
-                el->val = vals;
-                el->distance = dist;
-                lheapAdd(lh, el);
+                el.x = x + 1;
+                el.y = y;
+                el.val = vals;
+                el.distance = dist;
+                rheapAdd(rh, &el);
             }
         }
         if (y < h - 1) {  /* check south */
@@ -850,16 +865,16 @@ PTA      *pta;
             if (dist < valr) {  /* shortest path so far to this pixel */
                 SET_DATA_FOUR_BYTES(liner32[y + 1], x, dist);  /* new dist */
                 SET_DATA_BYTE(linep8[y + 1], x, DIR_NORTH);  /* parent to N */
-                el = mazeelCreate(x, y + 1, 0);
-                el->val = vals;
-                el->distance = dist;
-                lheapAdd(lh, el);
+                el.x = x;
+                el.y = y + 1;
+                el.val = vals;
+                el.distance = dist;
+                rheapAdd(rh, &el);
             }
         }
-        FREE(elp);
     }
 
-    lheapDestroy(&lh, TRUE);
+    rheapDestroy(&rh);
 
     if (ppixd) {
         pixd = pixConvert8To32(pixs);
@@ -174,10 +174,10 @@ enum {
     L_ARITH_SUBTRACT  = 2,
     L_ARITH_MULTIPLY  = 3,   /* on numas only */
     L_ARITH_DIVIDE    = 4,   /* on numas only */
-    L_UNION           = 5,   /* on numas only */
-    L_INTERSECTION    = 6,   /* on numas only */
-    L_SUBTRACTION     = 7,   /* on numas only */
-    L_EXCLUSIVE_OR    = 8    /* on numas only */
+    L_UNION           = 5,   /* on numas and rles */
+    L_INTERSECTION    = 6,   /* on numas and rles */
+    L_SUBTRACTION     = 7,   /* on numas and rles */
+    L_EXCLUSIVE_OR    = 8    /* on numas and rles */
 };
 
 
@@ -75,6 +75,7 @@
  *          NUMA        *numaBinSort()
  *          NUMA        *numaGetSortIndex()
  *          NUMA        *numaGetBinSortIndex()
+ *          NUMA        *numaGetRadixSortIndex()
  *          NUMA        *numaSortByIndex()
  *          l_int32      numaIsSorted()
  *          l_int32      numaSortPair()
@@ -113,9 +114,14 @@
  *        numa by na[i].  This is conceptual only -- the numa is not an array!
  */
 
+#include <string.h>
 #include <math.h>
 #include "allheaders.h"
 
+    /* Above this size, numaSort() and numaGetSortIndex() use
+     * the O(n) radix sort instead of the shell sort */
+static const l_int32  MIN_COUNT_FOR_RADIX_SORT = 500;
+
 
 /*----------------------------------------------------------------------*
  *                Arithmetic and logical ops on Numas                   *
@@ -2100,15 +2106,18 @@ NUMA       *naiy;
  *      (1) Set naout = nain for in-place; otherwise, set naout = NULL.
  *      (2) Source: Shell sort, modified from K&R, 2nd edition, p.62.
  *          Slow but simple O(n logn) sort.
+ *      (3) For more than MIN_COUNT_FOR_RADIX_SORT numbers, this uses
+ *          the O(n) radix sort in numaGetRadixSortIndex().
  */
 NUMA *
 numaSort(NUMA    *naout,
          NUMA    *nain,
          l_int32  sortorder)
 {
-l_int32     i, n, gap, j;
+l_int32     i, n, gap, j, index;
 l_float32   tmp;
-l_float32  *array;
+l_float32  *array, *farray;
+NUMA       *naindex;
 
     PROCNAME("numaSort");
 
@@ -2116,13 +2125,36 @@ l_float32  *array;
         return (NUMA *)ERROR_PTR("nain not defined", procName, NULL);
 
         /* Make naout if necessary; otherwise do in-place */
-    if (!naout)
-        naout = numaCopy(nain);
+    if (!naout) {
+        if ((naout = numaCopy(nain)) == NULL)
+            return (NUMA *)ERROR_PTR("naout not made", procName, NULL);
+    }
     else if (nain != naout)
         return (NUMA *)ERROR_PTR("invalid: not in-place", procName, NULL);
     array = naout->array;  /* operate directly on the array */
     n = numaGetCount(naout);
 
+        /* Radix sort for large arrays */
+    if (n > MIN_COUNT_FOR_RADIX_SORT) {
+        naindex = numaGetRadixSortIndex(naout, sortorder);
+        farray = numaGetFArray(naout, L_COPY);
+        if (!naindex || !farray) {
+            numaDestroy(&naindex);
+            FREE(farray);
+            if (naout != nain)  /* not in-place; naout was made here */
+                numaDestroy(&naout);
+            return (NUMA *)ERROR_PTR("naindex or farray not made",
+                                     procName, NULL);
+        }
+        for (i = 0; i < n; i++) {
+            index = (l_int32)naindex->array[i];
+            array[i] = farray[index];
+        }
+        FREE(farray);
+        numaDestroy(&naindex);
+        return naout;
+    }
+
         /* Shell sort */
     for (gap = n/2; gap > 0; gap = gap / 2) {
         for (i = gap; i < n; i++) {
@@ -2186,6 +2218,11 @@ NUMA  *nat, *nad;
  *              sortorder (L_SORT_INCREASING or L_SORT_DECREASING)
  *      Return: na giving an array of indices that would sort
  *              the input array, or null on error
+ *
+ *  Notes:
+ *      (1) For up to MIN_COUNT_FOR_RADIX_SORT numbers, this uses a
+ *          shell sort.  For larger arrays, it uses the O(n) radix
+ *          sort in numaGetRadixSortIndex(), which is stable.
  */
 NUMA *
 numaGetSortIndex(NUMA    *na,
@@ -2205,6 +2242,9 @@ NUMA       *naisort;
         return (NUMA *)ERROR_PTR("invalid sortorder", procName, NULL);
 
     n = numaGetCount(na);
+    if (n > MIN_COUNT_FOR_RADIX_SORT)
+        return numaGetRadixSortIndex(na, sortorder);
+
     if ((array = numaGetFArray(na, L_COPY)) == NULL)
         return (NUMA *)ERROR_PTR("array not made", procName, NULL);
     if ((iarray = (l_float32 *)CALLOC(n, sizeof(l_float32))) == NULL)
@@ -2317,6 +2357,111 @@ L_PTRA    *paindex;
 }
 
 
+/*!
+ *  numaGetRadixSortIndex()
+ *
+ *      Input:  nas (of arbitrary numbers)
+ *              sortorder (L_SORT_INCREASING or L_SORT_DECREASING)
+ *      Return: na giving an array of indices that would sort
+ *              the input array, or null on error
+ *
+ *  Notes:
+ *      (1) This is an LSD radix sort on the 32 bits of each number,
+ *          taken 8 bits at a time.  Each float is mapped to an
+ *          unsigned int that has the same order, so it works for
+ *          negative and non-integer values, unlike the bin sort.
+ *      (2) A pass is skipped if all numbers have the same value in
+ *          its 8 bits.  For small non-negative integers, this usually
+ *          leaves only one or two passes.
+ *      (3) The sort is stable: numbers that are equal are in the
+ *          order they have in @nas, for either @sortorder.
+ *      (4) The time is O(n), and the extra memory is 4n words.
+ *          For more than a few hundred numbers, this is much faster
+ *          than the shell sort in numaGetSortIndex().
+ */
+NUMA *
+numaGetRadixSortIndex(NUMA    *nas,
+                      l_int32  sortorder)
+{
+l_int32    i, n, pass, shift, sum, cnt;
+l_int32    count[256];
+l_int32   *index, *indext, *itmp;
+l_uint32   u;
+l_uint32  *key, *keyt, *ktmp;
+NUMA      *nad;
+union {
+    l_float32  f;
+    l_uint32   u;
+} val;
+
+    PROCNAME("numaGetRadixSortIndex");
+
+    if (!nas)
+        return (NUMA *)ERROR_PTR("nas not defined", procName, NULL);
+    if (sortorder != L_SORT_INCREASING && sortorder != L_SORT_DECREASING)
+        return (NUMA *)ERROR_PTR("invalid sort order", procName, NULL);
+
+    n = numaGetCount(nas);
+    key = (l_uint32 *)CALLOC(L_MAX(n, 1), sizeof(l_uint32));
+    keyt = (l_uint32 *)CALLOC(L_MAX(n, 1), sizeof(l_uint32));
+    index = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32));
+    indext = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32));
+    if (!key || !keyt || !index || !indext) {
+        FREE(key);
+        FREE(keyt);
+        FREE(index);
+        FREE(indext);
+        return (NUMA *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+
+        /* Map each float to an unsigned int with the same order:
+         * flip all bits of negative numbers, and only the sign bit
+         * of positive numbers.  +0 and -0 get the same key. */
+    for (i = 0; i < n; i++) {
+        val.f = nas->array[i];
+        if (val.f == 0.0)
+            u = 0x80000000;
+        else if (val.u & 0x80000000)
+            u = ~val.u;
+        else
+            u = val.u | 0x80000000;
+        key[i] = (sortorder == L_SORT_INCREASING) ? u : ~u;
+        index[i] = i;
+    }
+
+    for (pass = 0; pass < 4; pass++) {
+        shift = 8 * pass;
+        memset(count, 0, 256 * sizeof(l_int32));
+        for (i = 0; i < n; i++)
+            count[(key[i] >> shift) & 0xff]++;
+        if (n == 0 || count[(key[0] >> shift) & 0xff] == n)
+            continue;  /* all the same in this byte */
+        for (i = 0, sum = 0; i < 256; i++) {
+            cnt = count[i];
+            count[i] = sum;
+            sum += cnt;
+        }
+        for (i = 0; i < n; i++) {
+            cnt = count[(key[i] >> shift) & 0xff]++;
+            keyt[cnt] = key[i];
+            indext[cnt] = index[i];
+        }
+        ktmp = key; key = keyt; keyt = ktmp;
+        itmp = index; index = indext; indext = itmp;
+    }
+
+    nad = numaCreate(n);
+    for (i = 0; i < n; i++)
+        numaAddNumber(nad, index[i]);
+
+    FREE(key);
+    FREE(keyt);
+    FREE(index);
+    FREE(indext);
+    return nad;
+}
+
+
 /*!
  *  numaSortByIndex()
  *
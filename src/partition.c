@@ -29,38 +29,62 @@
  *
  *      Whitespace block extraction
  *          BOXA            *boxaGetWhiteblocks()
+ *          BOXA            *boxaGetWhiteblocksGeneral()
  *
  *      Helpers
  *          static PARTEL   *partelCreate()
+ *          static void      partelRecycle()
  *          static void      partelDestroy()
  *          static l_int32   partelSetSize()
- *          static BOXA     *boxaGenerateSubboxes()
- *          static BOX      *boxaSelectPivotBox()
- *          static l_int32   boxaCheckIfOverlapIsSmall()
+ *          static l_int32   partelGenerateSubregions()
+ *          static l_int32   partelSelectPivot()
+ *          static l_int32   partelFindIntersecting()
+ *          static l_int32   boxCheckIfOverlapIsBig()
  *          BOXA            *boxaPruneSortedOnOverlap()
  */
 
 #include "allheaders.h"
 
+    /* A partition element holds a rectangular region, along with the
+     * indices of the boxes in the input boxa that intersect it, in
+     * increasing order.  The elements are recycled through a free list,
+     * keeping their index arrays, so that after the queue has grown to
+     * its largest size, elements are neither allocated nor freed. */
 struct PartitionElement {
-    l_float32  size;  /* sorting key */
-    BOX       *box;   /* region of the element */
-    BOXA      *boxa;  /* set of intersecting boxes */
+    l_float32  size;     /* sorting key; must be the first field        */
+    l_int32    x;        /* region of the element                       */
+    l_int32    y;
+    l_int32    w;
+    l_int32    h;
+    l_int32    n;        /* number of intersecting boxes                */
+    l_int32    nalloc;   /* size of allocated index array               */
+    l_int32   *index;    /* indices of intersecting boxes               */
+    struct PartitionElement  *next;  /* next element in the free list   */
 };
 typedef struct PartitionElement PARTEL;
 
-static PARTEL * partelCreate(BOX *box);
+static PARTEL * partelCreate(PARTEL **pfreelist, l_int32 x, l_int32 y,
+                             l_int32 w, l_int32 h, l_int32 nalloc);
+static void partelRecycle(PARTEL **pfreelist, PARTEL *partel);
 static void partelDestroy(PARTEL **ppartel);
 static l_int32 partelSetSize(PARTEL *partel, l_int32 sortflag);
-static BOXA * boxaGenerateSubboxes(BOX *box, BOXA *boxa, l_int32 maxperim,
-                                   l_float32  fract);
-static BOX * boxaSelectPivotBox(BOX *box, BOXA *boxa, l_int32 maxperim,
-                                l_float32 fract);
+static l_int32 partelGenerateSubregions(PARTEL *partel, L_BOXINDEX *bi,
+                                        l_int32 maxperim, l_float32 fract,
+                                        l_int32 *subx, l_int32 *suby,
+                                        l_int32 *subw, l_int32 *subh);
+static l_int32 partelSelectPivot(PARTEL *partel, L_BOXINDEX *bi,
+                                 l_int32 maxperim, l_float32 fract);
+static l_int32 partelFindIntersecting(PARTEL *parent, PARTEL *partel,
+                                      L_BOXINDEX *bi, l_int32 useindex,
+                                      l_int32 *buf);
 static l_int32 boxCheckIfOverlapIsBig(BOX *box, BOXA *boxa,
                                       l_float32 maxoverlap);
 
 static const l_int32  DEFAULT_MAX_POPS = 20000;  /* a big number! */
 
+    /* Number of pops between checks of the elapsed time */
+static const l_int32  POPS_PER_TIME_CHECK = 32;
+
 
 #ifndef  NO_CONSOLE_IO
 #define  OUTPUT_HEAP_STATS   0
@@ -172,6 +196,8 @@ static const l_int32  DEFAULT_MAX_POPS = 20000;  /* a big number! */
  *          between a box and any of the taller ones, and avoiding the
  *          use of any c.c. with a b.b. half perimeter greater than 200
  *          as a pivot.
+ *     (12) To limit the execution time directly, use
+ *          boxaGetWhiteblocksGeneral().
  */
 BOXA *
 boxaGetWhiteblocks(BOXA      *boxas,
@@ -183,19 +209,63 @@ boxaGetWhiteblocks(BOXA      *boxas,
                    l_float32  fract,
                    l_int32    maxpops)
 {
-l_int32  i, w, h, n, nsub, npush, npop;
-BOX     *boxsub;
-BOXA    *boxa, *boxa4, *boxasub, *boxad;
-PARTEL  *partel;
-L_HEAP  *lh;
+    return boxaGetWhiteblocksGeneral(boxas, box, sortflag, maxboxes,
+                                     maxoverlap, maxperim, fract,
+                                     maxpops, 0.0);
+}
 
-    PROCNAME("boxaGetWhiteblocks");
+
+/*!
+ *  boxaGetWhiteblocksGeneral()
+ *
+ *      Input:  boxas, box, sortflag, maxboxes, maxoverlap, maxperim,
+ *              fract, maxpops (see boxaGetWhiteblocks())
+ *              maxtime (maximum time, in seconds, to spend on the search;
+ *                       use 0.0 for no limit)
+ *      Return: boxa (of sorted whitespace boxes), or null on error
+ *
+ *  Notes:
+ *      (1) This is the same as boxaGetWhiteblocks(), but the search can
+ *          also be stopped after @maxtime seconds of elapsed time.
+ *          The whitespace boxes found up to that time are returned.
+ *          Because the result then depends on the speed of the machine,
+ *          use @maxpops instead if the result must be reproducible.
+ *      (2) The geometry of the boxes in @boxas is held in an L_BOXINDEX.
+ *          Each element in the queue has the indices of the boxes that
+ *          intersect its region, rather than a boxa of copies.  The
+ *          boxes that intersect a subregion are found from the list of
+ *          its parent, or from the index if the subregion is small.
+ *      (3) The elements are recycled, so that the number allocated is
+ *          the largest number in the queue at any time.
+ */
+BOXA *
+boxaGetWhiteblocksGeneral(BOXA      *boxas,
+                          BOX       *box,
+                          l_int32    sortflag,
+                          l_int32    maxboxes,
+                          l_float32  maxoverlap,
+                          l_int32    maxperim,
+                          l_float32  fract,
+                          l_int32    maxpops,
+                          l_float32  maxtime)
+{
+l_int32     i, w, h, n, nsub, npush, npop, useindex, ret;
+l_int32     sec0, usec0, sec, usec;
+l_int32     subx[4], suby[4], subw[4], subh[4];
+l_int32    *buf;
+BOX        *boxr;
+BOXA       *boxad;
+L_BOXINDEX *bi;
+PARTEL     *partel, *partelsub, *freelist;
+L_HEAP     *lh;
+
+    PROCNAME("boxaGetWhiteblocksGeneral");
 
     if (!boxas)
         return (BOXA *)ERROR_PTR("boxas not defined", procName, NULL);
     if (sortflag != L_SORT_BY_WIDTH && sortflag != L_SORT_BY_HEIGHT &&
         sortflag != L_SORT_BY_MIN_DIMENSION &&
-       	sortflag != L_SORT_BY_MAX_DIMENSION &&
+        sortflag != L_SORT_BY_MAX_DIMENSION &&
         sortflag != L_SORT_BY_PERIMETER && sortflag != L_SORT_BY_AREA)
         return (BOXA *)ERROR_PTR("invalid sort flag", procName, NULL);
     if (maxboxes < 1) {
@@ -206,68 +276,109 @@ L_HEAP  *lh;
         return (BOXA *)ERROR_PTR("invalid maxoverlap", procName, NULL);
     if (maxpops == 0)
         maxpops = DEFAULT_MAX_POPS;
+    if (fract < 0.0 || fract > 1.0) {
+        L_WARNING("fract out of bounds; using 0.0", procName);
+        fract = 0.0;
+    }
 
-    if (!box) {
-        boxaGetExtent(boxas, &w, &h, NULL);
-        box = boxCreate(0, 0, w, h);
+    if ((bi = boxindexCreate(boxas, 0)) == NULL)
+        return (BOXA *)ERROR_PTR("bi not made", procName, NULL);
+    n = boxindexGetCount(bi);
+    if ((buf = (l_int32 *)CALLOC(L_MAX(n, 1), sizeof(l_int32))) == NULL) {
+        boxindexDestroy(&bi);
+        return (BOXA *)ERROR_PTR("buf not made", procName, NULL);
+    }
+
+        /* The index ignores empty boxes, so it can only be used to
+         * find intersecting boxes when there are none. */
+    useindex = TRUE;
+    for (i = 0; i < n; i++) {
+        if (bi->right[i] < bi->left[i] || bi->bot[i] < bi->top[i]) {
+            useindex = FALSE;
+            break;
+        }
     }
 
-        /* Prime the heap */
+        /* Prime the heap.  The initial element holds all the boxes,
+         * whether or not they intersect the region. */
+    if (box) {
+        boxGetGeometry(box, &subx[0], &suby[0], &w, &h);
+    } else {
+        boxaGetExtent(boxas, &w, &h, NULL);
+        subx[0] = suby[0] = 0;
+    }
+    freelist = NULL;
     lh = lheapCreate(20, L_SORT_DECREASING);
-    partel = partelCreate(box);
-    partel->boxa = boxaCopy(boxas, L_CLONE);
+    partel = partelCreate(&freelist, subx[0], suby[0], w, h, n);
+    if (!lh || !partel) {
+        lheapDestroy(&lh, FALSE);
+        partelDestroy(&partel);
+        boxindexDestroy(&bi);
+        FREE(buf);
+        return (BOXA *)ERROR_PTR("lh or partel not made", procName, NULL);
+    }
+    for (i = 0; i < n; i++)
+        partel->index[i] = i;
+    partel->n = n;
     partelSetSize(partel, sortflag);
     lheapAdd(lh, partel);
 
     boxad = boxaCreate(0);
 
+    l_getCurrentTime(&sec0, &usec0);
     npush = npop = 0;
+    ret = 0;
     while (1) {
         if ((partel = (PARTEL *)lheapRemove(lh)) == NULL)  /* we're done */
             break;
 
         npop++;  /* How many boxes have we retrieved from the queue? */
-        if (npop > maxpops)
+        if (npop > maxpops) {
+            partelRecycle(&freelist, partel);
             break;
+        }
+        if (maxtime > 0.0 && npop % POPS_PER_TIME_CHECK == 0) {
+            l_getCurrentTime(&sec, &usec);
+            if ((sec - sec0) + 0.000001 * (usec - usec0) > maxtime) {
+                partelRecycle(&freelist, partel);
+                break;
+            }
+        }
 
-	    /* Extract the contents */
-        boxa = boxaCopy(partel->boxa, L_CLONE);
-        box = boxClone(partel->box);
-	partelDestroy(&partel);
-
-	    /* Can we output this one? */
-        n = boxaGetCount(boxa);
-        if (n == 0) {
-            if (boxCheckIfOverlapIsBig(box, boxad, maxoverlap) == 0)
-                boxaAddBox(boxad, box, L_INSERT);
+            /* Can we output this one? */
+        if (partel->n == 0) {
+            boxr = boxCreate(partel->x, partel->y, partel->w, partel->h);
+            if (boxCheckIfOverlapIsBig(boxr, boxad, maxoverlap) == 0)
+                boxaAddBox(boxad, boxr, L_INSERT);
             else
-                boxDestroy(&box);
-            boxaDestroy(&boxa);
+                boxDestroy(&boxr);
+            partelRecycle(&freelist, partel);
             if (boxaGetCount(boxad) >= maxboxes)  /* we're done */
                 break;
             continue;
         }
 
-
-	    /* Generate up to 4 subboxes and put them on the heap */
-        boxa4 = boxaGenerateSubboxes(box, boxa, maxperim, fract);
-	boxDestroy(&box);
-        nsub = boxaGetCount(boxa4);
+            /* Generate up to 4 subregions and put them on the heap */
+        nsub = partelGenerateSubregions(partel, bi, maxperim, fract,
+                                        subx, suby, subw, subh);
         for (i = 0; i < nsub; i++) {
-            boxsub = boxaGetBox(boxa4, i, L_CLONE);
-	    boxasub = boxaIntersectsBox(boxa, boxsub);
-            partel = partelCreate(boxsub);
-            partel->boxa = boxasub;
-            partelSetSize(partel, sortflag);
-            lheapAdd(lh, partel);
-	    boxDestroy(&boxsub);
+            if ((partelsub = partelCreate(&freelist, subx[i], suby[i],
+                                          subw[i], subh[i], 0)) == NULL) {
+                ret = 1;
+                break;
+            }
+            if (partelFindIntersecting(partel, partelsub, bi, useindex,
+                                       buf)) {
+                partelRecycle(&freelist, partelsub);
+                ret = 1;
+                break;
+            }
+            partelSetSize(partelsub, sortflag);
+            lheapAdd(lh, partelsub);
         }
         npush += nsub;  /* How many boxes have we put on the queue? */
-
-/*	boxaWriteStream(stderr, boxa4); */
-
-        boxaDestroy(&boxa4);
-        boxaDestroy(&boxa);
+        partelRecycle(&freelist, partel);
+        if (ret) break;
     }
 
 #if  OUTPUT_HEAP_STATS
@@ -276,11 +387,20 @@ L_HEAP  *lh;
     fprintf(stderr, "  Number of boxes popped: %d\n", npop);
 #endif  /* OUTPUT_HEAP_STATS */
 
-        /* Clean up the heap */
+        /* Clean up the heap and the free list */
     while ((partel = (PARTEL *)lheapRemove(lh)) != NULL)
         partelDestroy(&partel);
     lheapDestroy(&lh, FALSE);
-
+    while ((partel = freelist) != NULL) {
+        freelist = partel->next;
+        partelDestroy(&partel);
+    }
+    boxindexDestroy(&bi);
+    FREE(buf);
+    if (ret) {
+        boxaDestroy(&boxad);
+        return (BOXA *)ERROR_PTR("subregion not made", procName, NULL);
+    }
     return boxad;
 }
 
@@ -291,24 +411,73 @@ L_HEAP  *lh;
 /*!
  *  partelCreate()
  *
- *      Input:  box (region; inserts a copy)
+ *      Input:  &freelist (of recycled elements)
+ *              x, y, w, h (region)
+ *              nalloc (minimum size of the index array)
  *      Return: partel, or null on error
+ *
+ *  Notes:
+ *      (1) This takes an element from the free list if there is one.
+ *          The returned element has no intersecting boxes.
+ *      (2) If the index array can't be made, the element is destroyed.
  */
 static PARTEL *
-partelCreate(BOX  *box)
+partelCreate(PARTEL  **pfreelist,
+             l_int32   x,
+             l_int32   y,
+             l_int32   w,
+             l_int32   h,
+             l_int32   nalloc)
 {
 PARTEL  *partel;
 
     PROCNAME("partelCreate");
 
-    if ((partel = (PARTEL *)CALLOC(1, sizeof(PARTEL))) == NULL)
-        return (PARTEL *)ERROR_PTR("partel not made", procName, NULL);
+    if ((partel = *pfreelist) != NULL) {
+        *pfreelist = partel->next;
+    } else {
+        if ((partel = (PARTEL *)CALLOC(1, sizeof(PARTEL))) == NULL)
+            return (PARTEL *)ERROR_PTR("partel not made", procName, NULL);
+    }
+    if (nalloc > partel->nalloc) {
+        FREE(partel->index);
+        if ((partel->index = (l_int32 *)CALLOC(nalloc, sizeof(l_int32)))
+            == NULL) {
+            partelDestroy(&partel);
+            return (PARTEL *)ERROR_PTR("index not made", procName, NULL);
+        }
+        partel->nalloc = nalloc;
+    }
 
-    partel->box = boxCopy(box);
+    partel->x = x;
+    partel->y = y;
+    partel->w = w;
+    partel->h = h;
+    partel->n = 0;
+    partel->next = NULL;
     return partel;
 }
 
 
+/*!
+ *  partelRecycle()
+ *
+ *      Input:  &freelist (of recycled elements)
+ *              partel (to be put on the free list)
+ *      Return: void
+ */
+static void
+partelRecycle(PARTEL  **pfreelist,
+              PARTEL   *partel)
+{
+    if (!partel)
+        return;
+    partel->next = *pfreelist;
+    *pfreelist = partel;
+    return;
+}
+
+
 /*!
  *  partelDestroy()
  *
@@ -330,8 +499,7 @@ PARTEL  *partel;
     if ((partel = *ppartel) == NULL)
         return;
 
-    boxDestroy(&partel->box);
-    boxaDestroy(&partel->boxa);
+    FREE(partel->index);
     FREE(partel);
     *ppartel = NULL;
     return;
@@ -358,7 +526,8 @@ l_int32  w, h;
     if (!partel)
         return ERROR_INT("partel not defined", procName, 1);
 
-    boxGetGeometry(partel->box, NULL, NULL, &w, &h);
+    w = partel->w;
+    h = partel->h;
     if (sortflag == L_SORT_BY_WIDTH)
         partel->size = (l_float32)w;
     else if (sortflag == L_SORT_BY_HEIGHT)
@@ -378,137 +547,130 @@ l_int32  w, h;
 
 
 /*!
- *  boxaGenerateSubboxes()
+ *  partelGenerateSubregions()
  *
- *      Input:  box (region to be split into up to four overlapping subregions)
- *              boxa (boxes of rectangles intersecting the box)
+ *      Input:  partel (region to be split into up to four overlapping
+ *                      subregions, with at least one intersecting box)
+ *              bi (index of the geometry of all boxes)
  *              maxperim (maximum half-perimeter for which pivot
  *                        is selected by proximity to box centroid)
  *              fract (fraction of box diagonal that is an acceptable
  *                     distance from the box centroid to select the pivot)
- *      Return: boxa (of four or less overlapping subrectangles of the box),
- *              or null on error
+ *              subx, suby, subw, subh (<return> arrays of size 4 with
+ *                                      the subregions)
+ *      Return: number of subregions (0 to 4)
  */
-static BOXA *
-boxaGenerateSubboxes(BOX       *box,
-                     BOXA      *boxa,
-                     l_int32    maxperim,
-                     l_float32  fract)
+static l_int32
+partelGenerateSubregions(PARTEL     *partel,
+                         L_BOXINDEX *bi,
+                         l_int32     maxperim,
+                         l_float32   fract,
+                         l_int32    *subx,
+                         l_int32    *suby,
+                         l_int32    *subw,
+                         l_int32    *subh)
 {
-l_int32  x, y, w, h, xp, yp, wp, hp;
-BOX     *boxp;  /* pivot box */
-BOX     *boxsub;
-BOXA    *boxa4;
-
-    PROCNAME("boxaGenerateSubboxes");
-
-    if (!box)
-        return (BOXA *)ERROR_PTR("box not defined", procName, NULL);
-    if (!boxa)
-        return (BOXA *)ERROR_PTR("boxa not defined", procName, NULL);
-
-    boxa4 = boxaCreate(4);
-    boxp = boxaSelectPivotBox(box, boxa, maxperim, fract);
-    boxGetGeometry(box, &x, &y, &w, &h);
-    boxGetGeometry(boxp, &xp, &yp, &wp, &hp);
-    boxDestroy(&boxp);
+l_int32  x, y, w, h, xp, yp, wp, hp, ip, nsub;
+
+    ip = partelSelectPivot(partel, bi, maxperim, fract);
+    x = partel->x;
+    y = partel->y;
+    w = partel->w;
+    h = partel->h;
+    xp = bi->left[ip];
+    yp = bi->top[ip];
+    wp = bi->right[ip] - xp + 1;
+    hp = bi->bot[ip] - yp + 1;
+    nsub = 0;
     if (xp > x) {   /* left sub-box */
-        boxsub = boxCreate(x, y, xp - x, h);
-        boxaAddBox(boxa4, boxsub, L_INSERT);
+        subx[nsub] = x;
+        suby[nsub] = y;
+        subw[nsub] = xp - x;
+        subh[nsub++] = h;
     }
     if (yp > y) {   /* top sub-box */
-        boxsub = boxCreate(x, y, w, yp - y);
-        boxaAddBox(boxa4, boxsub, L_INSERT);
+        subx[nsub] = x;
+        suby[nsub] = y;
+        subw[nsub] = w;
+        subh[nsub++] = yp - y;
     }
     if (xp + wp < x + w) {   /* right sub-box */
-        boxsub = boxCreate(xp + wp, y, x + w - xp - wp, h);
-        boxaAddBox(boxa4, boxsub, L_INSERT);
+        subx[nsub] = xp + wp;
+        suby[nsub] = y;
+        subw[nsub] = x + w - xp - wp;
+        subh[nsub++] = h;
     }
     if (yp + hp < y + h) {   /* bottom sub-box */
-        boxsub = boxCreate(x, yp + hp, w, y + h - yp - hp);
-        boxaAddBox(boxa4, boxsub, L_INSERT);
+        subx[nsub] = x;
+        suby[nsub] = yp + hp;
+        subw[nsub] = w;
+        subh[nsub++] = y + h - yp - hp;
     }
 
-    return boxa4;
+    return nsub;
 }
 
 
 /*!
- *  boxaSelectPivotBox()
+ *  partelSelectPivot()
  *
- *      Input:  box (containing box; to be split by the pivot box)
- *              boxa (boxes of rectangles, from which 1 is to be chosen)
+ *      Input:  partel (containing region, with at least one box;
+ *                      to be split by the pivot box)
+ *              bi (index of the geometry of all boxes)
  *              maxperim (maximum half-perimeter for which pivot
  *                        is selected by proximity to box centroid)
  *              fract (fraction of box diagonal that is an acceptable
  *                     distance from the box centroid to select the pivot)
- *      Return: box (pivot box for subdivision into 4 rectangles), or
- *                   null on error
+ *      Return: index of the pivot box for subdivision into 4 rectangles
  *
  *  Notes:
  *      (1) This is a tricky piece that wasn't discussed in the
  *          Breuel's 2002 paper.
- *      (2) Selects a box from boxa whose centroid is reasonably close to
- *          the centroid of the containing box (xc, yc) and whose
- *          half-perimeter does not exceed the maxperim value.
- *      (3) If there are no boxes in the boxa that are small enough,
- *          then it selects the smallest of the larger boxes,
- *          without reference to its location in the containing box.
+ *      (2) Selects a box intersecting the region whose centroid is
+ *          reasonably close to the centroid of the region (xc, yc) and
+ *          whose half-perimeter does not exceed the maxperim value.
+ *      (3) If there are no boxes that are small enough, then it selects
+ *          the smallest of the larger boxes, without reference to its
+ *          location in the region.
  *      (4) If a small box has a centroid at a distance from the
- *          centroid of the containing box that is not more than
- *          the fraction 'fract' of the diagonal of the containing
- *          box, that box is chosen as the pivot, terminating the
- *          search for the nearest small box.
+ *          centroid of the region that is not more than the fraction
+ *          'fract' of the diagonal of the region, that box is chosen
+ *          as the pivot, terminating the search for the nearest small box.
  *      (5) Use fract in the range [0.0 ... 1.0].  Set fract = 0.0
  *          to choose the small box nearest the centroid.
  *      (6) Choose maxperim to represent a connected component that is
  *          small enough so that you don't care about the white space
  *          that could be inside of it.
  */
-static BOX *
-boxaSelectPivotBox(BOX       *box,
-                   BOXA      *boxa,
-                   l_int32    maxperim,
-                   l_float32  fract)
+static l_int32
+partelSelectPivot(PARTEL     *partel,
+                  L_BOXINDEX *bi,
+                  l_int32     maxperim,
+                  l_float32   fract)
 {
-l_int32    i, n, bw, bh, w, h;
-l_int32    smallfound, minindex, perim, minsize;
-l_float32  delx, dely, mindist, threshdist, dist, x, y, cx, cy;
-BOX       *boxt;
-
-    PROCNAME("boxaSelectPivotBox");
-
-    if (!box)
-        return (BOX *)ERROR_PTR("box not defined", procName, NULL);
-    if (!boxa)
-        return (BOX *)ERROR_PTR("boxa not defined", procName, NULL);
-    n = boxaGetCount(boxa);
-    if (n == 0)
-        return (BOX *)ERROR_PTR("no boxes in boxa", procName, NULL);
-    if (fract < 0.0 || fract > 1.0) {
-        L_WARNING("fract out of bounds; using 0.0", procName);
-        fract = 0.0;
-    }
-
-    boxGetGeometry(box, NULL, NULL, &w, &h);
-    boxGetCenter(box, &x, &y);
+l_int32    i, j, n, w, h, smallfound, minindex, perim, minsize;
+l_float32  delx, dely, mindist, threshdist, dist, x, y;
+
+    n = partel->n;
+    w = partel->w;
+    h = partel->h;
+    x = (l_float32)(partel->x + 0.5 * w);
+    y = (l_float32)(partel->y + 0.5 * h);
     threshdist = fract * (w * w + h * h);
     mindist = 1000000000.;
-    minindex = 0;
+    minindex = partel->index[0];
     smallfound = FALSE;
-    for (i = 0; i < n; i++) {
-        boxt = boxaGetBox(boxa, i, L_CLONE);
-        boxGetGeometry(boxt, NULL, NULL, &bw, &bh);
-        boxGetCenter(boxt, &cx, &cy);
-        boxDestroy(&boxt);
-        if (bw + bh > maxperim)
+    for (j = 0; j < n; j++) {
+        i = partel->index[j];
+        perim = bi->right[i] - bi->left[i] + bi->bot[i] - bi->top[i] + 2;
+        if (perim > maxperim)
             continue;
         smallfound = TRUE;
-        delx = cx - x;
-        dely = cy - y;
+        delx = bi->cx[i] - x;
+        dely = bi->cy[i] - y;
         dist = delx * delx + dely * dely;
         if (dist <= threshdist)
-            return boxaGetBox(boxa, i, L_COPY);
+            return i;
         if (dist < mindist) {
             minindex = i;
             mindist = dist;
@@ -516,22 +678,94 @@ BOX       *boxt;
     }
 
         /* If there are small boxes but none are within 'fract' of the
-	 * centroid, return the nearest one. */
+         * centroid, return the nearest one. */
     if (smallfound == TRUE)
-        return boxaGetBox(boxa, minindex, L_COPY);
+        return minindex;
 
         /* No small boxes; return the smallest of the large boxes */
     minsize = 1000000000;
-    minindex = 0;
-    for (i = 0; i < n; i++) {
-        boxaGetBoxGeometry(boxa, i, NULL, NULL, &bw, &bh);
-	perim = bw + bh;
+    minindex = partel->index[0];
+    for (j = 0; j < n; j++) {
+        i = partel->index[j];
+        perim = bi->right[i] - bi->left[i] + bi->bot[i] - bi->top[i] + 2;
         if (perim < minsize) {
             minsize = perim;
             minindex = i;
         }
     }
-    return boxaGetBox(boxa, minindex, L_COPY);
+    return minindex;
+}
+
+
+/*!
+ *  partelFindIntersecting()
+ *
+ *      Input:  parent (element that contains the region of partel)
+ *              partel (element whose intersecting boxes are to be found)
+ *              bi (index of the geometry of all boxes)
+ *              useindex (1 to allow use of the grid cells of the index)
+ *              buf (work array, with a size of at least the number
+ *                   of boxes in the index)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) Every box that intersects the region of @partel is among
+ *          the boxes of @parent, so these are tested in order.
+ *          However, if the region is small compared with the parent
+ *          and the parent has many boxes, it is faster to get the
+ *          boxes from the grid cells that the region overlaps.  Either
+ *          way, the boxes are found in increasing order of index.
+ */
+static l_int32
+partelFindIntersecting(PARTEL     *parent,
+                       PARTEL     *partel,
+                       L_BOXINDEX *bi,
+                       l_int32     useindex,
+                       l_int32    *buf)
+{
+l_int32  i, j, n, left, top, right, bot;
+NUMA    *na;
+BOX     *box;
+
+    PROCNAME("partelFindIntersecting");
+
+    left = partel->x;
+    top = partel->y;
+    right = partel->x + partel->w - 1;
+    bot = partel->y + partel->h - 1;
+    if (useindex && parent->n > 64 &&
+        (l_float64)partel->w * partel->h <
+        0.25 * (l_float64)parent->w * parent->h) {
+        box = boxCreate(partel->x, partel->y, partel->w, partel->h);
+        na = boxindexIntersectsBox(bi, box);
+        boxDestroy(&box);
+        if (!na)
+            return ERROR_INT("na not made", procName, 1);
+        n = numaGetCount(na);
+        for (j = 0; j < n; j++)
+            numaGetIValue(na, j, &buf[j]);
+        numaDestroy(&na);
+    } else {
+        for (j = 0, n = 0; j < parent->n; j++) {
+            i = parent->index[j];
+            if (bi->bot[i] >= top && bot >= bi->top[i] &&
+                right >= bi->left[i] && bi->right[i] >= left)
+                buf[n++] = i;
+        }
+    }
+
+    if (n > partel->nalloc) {
+        FREE(partel->index);
+        if ((partel->index = (l_int32 *)CALLOC(n, sizeof(l_int32))) == NULL) {
+            partel->nalloc = 0;
+            return ERROR_INT("index not made", procName, 1);
+        }
+        partel->nalloc = n;
+    }
+    for (j = 0; j < n; j++)
+        partel->index[j] = buf[j];
+    partel->n = n;
+    return 0;
 }
 
 
@@ -34,6 +34,7 @@
  *       struct Pix
  *       struct PixColormap
  *       struct RGBA_Quad
+ *       struct L_CmapNear
  *       struct Pixa
  *       struct Pixaa
  *       struct Box
@@ -46,8 +47,11 @@
  *       struct FPix
  *       struct FPixa
  *       struct DPix
+ *       struct L_Accum
  *       struct PixComp
  *       struct PixaComp
+ *       struct L_Rle
+ *       struct L_CCStats
  *
  *   Contains definitions for:
  *       Colors for RGB
@@ -134,6 +138,27 @@ struct RGBA_Quad
 typedef struct RGBA_Quad  RGBA_QUAD;
 
 
+    /* Accelerator for finding the nearest color in a colormap.
+     * Color space is divided into 2^(3 * level) cells, and each cell
+     * holds the (increasing) colormap indices of the only colors
+     * that can be nearest to some color within the cell.  Because it
+     * holds a copy of the colors, it is invalidated by any change
+     * to the colormap from which it was made. */
+struct L_CmapNear
+{
+    l_int32     metric;     /* L_MANHATTAN_DISTANCE or L_EUCLIDEAN_DISTANCE */
+    l_int32     level;      /* octcube level of the cell grid; 1 ... 5      */
+    l_int32     ncolors;    /* number of colors in the colormap             */
+    l_int32    *rmap;       /* red components of the colormap               */
+    l_int32    *gmap;       /* green components of the colormap             */
+    l_int32    *bmap;       /* blue components of the colormap              */
+    l_int32    *cellstart;  /* offset in @cands of the first candidate      */
+                            /* for each cell; cellstart[ncells] = ncands    */
+    l_int32    *cands;      /* candidate colormap indices for all cells     */
+};
+typedef struct L_CmapNear  L_CMAPNEAR;
+
+
 
 /*-------------------------------------------------------------------------*
  *                             Colors for 32 bpp                           *
@@ -533,6 +558,19 @@ struct DPix
 typedef struct DPix DPIX;
 
 
+/*-------------------------------------------------------------------------*
+ *          Accum: cached accumulators for windowed statistics             *
+ *-------------------------------------------------------------------------*/
+struct L_Accum
+{
+    l_int32              w;           /* width of source image             */
+    l_int32              h;           /* height of source image            */
+    struct Pix          *pixma;       /* 32 bpp accumulator of values      */
+    struct DPix         *dpixmsa;     /* accumulator of squared values     */
+};
+typedef struct L_Accum L_ACCUM;
+
+
 /*-------------------------------------------------------------------------*
  *                        PixComp: compressed pix                          *
  *-------------------------------------------------------------------------*/
@@ -571,6 +609,45 @@ struct PixaComp
 typedef struct PixaComp PIXAC;
 
 
+/*-------------------------------------------------------------------------*
+ *                 Rle: run-length encoded binary image                    *
+ *-------------------------------------------------------------------------*/
+struct L_Rle
+{
+    l_int32              w;           /* width in pixels                   */
+    l_int32              h;           /* height in pixels                  */
+    l_int32              n;           /* number of runs                    */
+    l_int32              nalloc;      /* size of allocated run arrays      */
+    l_int32             *rowstart;    /* index of first run on each line;  */
+                                      /* rowstart[h] = n                   */
+    l_int32             *xs;          /* first pixel of each run           */
+    l_int32             *xe;          /* last pixel of each run            */
+};
+typedef struct L_Rle L_RLE;
+
+
+/*-------------------------------------------------------------------------*
+ *          CCStats: statistics of labeled connected components            *
+ *-------------------------------------------------------------------------*/
+struct L_CCStats
+{
+    l_int32              n;           /* number of components              */
+    l_int32              nalloc;      /* size of allocated arrays          */
+    l_int32             *x;           /* left edge of bounding box         */
+    l_int32             *y;           /* top edge of bounding box          */
+    l_int32             *w;           /* width of bounding box             */
+    l_int32             *h;           /* height of bounding box            */
+    l_int32             *area;        /* number of fg pixels               */
+    l_float32           *cx;          /* x centroid of fg pixels           */
+    l_float32           *cy;          /* y centroid of fg pixels           */
+    l_int32             *perim;       /* number of fg/bg pixel edges       */
+};
+typedef struct L_CCStats L_CCSTATS;
+
+    /* Component filter: return 1 to keep component @index, 0 to drop it */
+typedef l_int32 (*L_CCFILTER)(L_CCSTATS *stats, l_int32 index, void *data);
+
+
 /*-------------------------------------------------------------------------*
  *                         Access and storage flags                        *
  *-------------------------------------------------------------------------*/
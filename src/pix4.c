@@ -76,6 +76,16 @@
 #include <math.h>
 #include "allheaders.h"
 
+    /* Histogram counts are spread over 4 banks, using the low 2 bits
+     * of a running pixel counter @k, so that a run of identical pixel
+     * values does not repeatedly update the same memory location.
+     * The banks are summed by histoBanksAccumulate(). */
+#define  HISTO_BANK(val, k)   (4 * (val) + ((k) & 3))
+
+static l_int32 *histoBanksCreate(l_int32 size);
+static void histoBanksAccumulate(l_int32 *hist, l_int32 size,
+                                 l_float32 *array);
+
 
 /*------------------------------------------------------------------*
  *                  Pixel histogram and averaging                   *
@@ -100,7 +110,9 @@ NUMA *
 pixGetGrayHistogram(PIX     *pixs,
                     l_int32  factor)
 {
-l_int32     i, j, w, h, d, wpl, val, size, count;
+l_int32     i, j, k, w, h, d, wpl, val, size, count, nw;
+l_int32    *hist;
+l_uint32    word;
 l_uint32   *data, *line;
 l_float32  *array;
 NUMA       *na;
@@ -136,42 +148,68 @@ PIX        *pixg;
         return na;
     }
 
+    if ((hist = histoBanksCreate(size)) == NULL) {
+        numaDestroy(&na);
+        pixDestroy(&pixg);
+        return (NUMA *)ERROR_PTR("hist not made", procName, NULL);
+    }
+
     wpl = pixGetWpl(pixg);
     data = pixGetData(pixg);
-    for (i = 0; i < h; i += factor) {
+    for (i = 0, k = 0; i < h; i += factor) {
         line = data + i * wpl;
         switch (d)
         {
         case 2:
-            for (j = 0; j < w; j += factor) {
+            for (j = 0; j < w; j += factor, k++) {
                 val = GET_DATA_DIBIT(line, j);
-                array[val] += 1.0;
+                hist[HISTO_BANK(val, k)]++;
             }
             break;
         case 4:
-            for (j = 0; j < w; j += factor) {
+            for (j = 0; j < w; j += factor, k++) {
                 val = GET_DATA_QBIT(line, j);
-                array[val] += 1.0;
+                hist[HISTO_BANK(val, k)]++;
             }
             break;
         case 8:
-            for (j = 0; j < w; j += factor) {
-                val = GET_DATA_BYTE(line, j);
-                array[val] += 1.0;
+            if (factor == 1) {  /* one word (4 pixels) at a time */
+                nw = w / 4;
+                for (j = 0; j < nw; j++) {
+                    word = line[j];
+                    hist[HISTO_BANK(word >> 24, 0)]++;
+                    hist[HISTO_BANK((word >> 16) & 0xff, 1)]++;
+                    hist[HISTO_BANK((word >> 8) & 0xff, 2)]++;
+                    hist[HISTO_BANK(word & 0xff, 3)]++;
+                }
+                for (j = 4 * nw; j < w; j++) {
+                    val = GET_DATA_BYTE(line, j);
+                    hist[HISTO_BANK(val, j)]++;
+                }
+            }
+            else {
+                for (j = 0; j < w; j += factor, k++) {
+                    val = GET_DATA_BYTE(line, j);
+                    hist[HISTO_BANK(val, k)]++;
+                }
             }
             break;
         case 16:
-            for (j = 0; j < w; j += factor) {
+            for (j = 0; j < w; j += factor, k++) {
                 val = GET_DATA_TWO_BYTES(line, j);
-                array[val] += 1.0;
+                hist[HISTO_BANK(val, k)]++;
             }
             break;
         default:
             numaDestroy(&na);
+            FREE(hist);
+            pixDestroy(&pixg);
             return (NUMA *)ERROR_PTR("illegal depth", procName, NULL);
         }
     }
 
+    histoBanksAccumulate(hist, size, array);
+    FREE(hist);
     pixDestroy(&pixg);
     return na;
 }
@@ -204,7 +242,8 @@ pixGetGrayHistogramMasked(PIX        *pixs,
                           l_int32     y,
                           l_int32     factor)
 {
-l_int32     i, j, w, h, wm, hm, dm, wplg, wplm, val;
+l_int32     i, j, k, w, h, wm, hm, dm, wplg, wplm, val;
+l_int32    *hist;
 l_uint32   *datag, *datam, *lineg, *linem;
 l_float32  *array;
 NUMA       *na;
@@ -230,6 +269,10 @@ PIX        *pixg;
         return (NUMA *)ERROR_PTR("na not made", procName, NULL);
     numaSetCount(na, 256);  /* all initialized to 0.0 */
     array = numaGetFArray(na, L_NOCOPY);
+    if ((hist = histoBanksCreate(256)) == NULL) {
+        numaDestroy(&na);
+        return (NUMA *)ERROR_PTR("hist not made", procName, NULL);
+    }
 
     if (pixGetColormap(pixs))
         pixg = pixRemoveColormap(pixs, REMOVE_CMAP_TO_GRAYSCALE);
@@ -242,7 +285,7 @@ PIX        *pixg;
     wplm = pixGetWpl(pixm);
 
         /* Generate the histogram */
-    for (i = 0; i < hm; i += factor) {
+    for (i = 0, k = 0; i < hm; i += factor) {
         if (y + i < 0 || y + i >= h) continue;
         lineg = datag + (y + i) * wplg;
         linem = datam + i * wplm;
@@ -250,11 +293,13 @@ PIX        *pixg;
             if (x + j < 0 || x + j >= w) continue;
             if (GET_DATA_BIT(linem, j)) {
                 val = GET_DATA_BYTE(lineg, x + j);
-                array[val] += 1.0;
+                hist[HISTO_BANK(val, k++)]++;
             }
         }
     }
 
+    histoBanksAccumulate(hist, 256, array);
+    FREE(hist);
     pixDestroy(&pixg);
     return na;
 }
@@ -281,7 +326,8 @@ pixGetGrayHistogramInRect(PIX     *pixs,
                           BOX     *box,
                           l_int32  factor)
 {
-l_int32     i, j, bx, by, bw, bh, w, h, wplg, val;
+l_int32     i, j, k, bx, by, bw, bh, w, h, wplg, val;
+l_int32    *hist;
 l_uint32   *datag, *lineg;
 l_float32  *array;
 NUMA       *na;
@@ -304,6 +350,10 @@ PIX        *pixg;
         return (NUMA *)ERROR_PTR("na not made", procName, NULL);
     numaSetCount(na, 256);  /* all initialized to 0.0 */
     array = numaGetFArray(na, L_NOCOPY);
+    if ((hist = histoBanksCreate(256)) == NULL) {
+        numaDestroy(&na);
+        return (NUMA *)ERROR_PTR("hist not made", procName, NULL);
+    }
 
     if (pixGetColormap(pixs))
         pixg = pixRemoveColormap(pixs, REMOVE_CMAP_TO_GRAYSCALE);
@@ -315,16 +365,18 @@ PIX        *pixg;
     boxGetGeometry(box, &bx, &by, &bw, &bh);
 
         /* Generate the histogram */
-    for (i = 0; i < bh; i += factor) {
+    for (i = 0, k = 0; i < bh; i += factor) {
         if (by + i < 0 || by + i >= h) continue;
         lineg = datag + (by + i) * wplg;
         for (j = 0; j < bw; j += factor) {
             if (bx + j < 0 || bx + j >= w) continue;
             val = GET_DATA_BYTE(lineg, bx + j);
-            array[val] += 1.0;
+            hist[HISTO_BANK(val, k++)]++;
         }
     }
 
+    histoBanksAccumulate(hist, 256, array);
+    FREE(hist);
     pixDestroy(&pixg);
     return na;
 }
@@ -352,10 +404,13 @@ pixGetColorHistogram(PIX     *pixs,
                      NUMA   **pnag,
                      NUMA   **pnab)
 {
-l_int32     i, j, w, h, d, wpl, index, rval, gval, bval;
+l_int32     i, j, k, w, h, d, wpl, index, rval, gval, bval, ncolors;
+l_int32    *hist, *rhist, *ghist, *bhist;
+l_uint32    pixel;
 l_uint32   *data, *line;
+l_float32   count;
 l_float32  *rarray, *garray, *barray;
-NUMA       *nar, *nag, *nab;
+NUMA       *nai, *nar, *nag, *nab;
 PIXCMAP    *cmap;
 
     PROCNAME("pixGetColorHistogram");
@@ -392,32 +447,40 @@ PIXCMAP    *cmap;
     data = pixGetData(pixs);
     wpl = pixGetWpl(pixs);
     if (cmap) {
-        for (i = 0; i < h; i += factor) {
-            line = data + i * wpl;
-            for (j = 0; j < w; j += factor) {
-                if (d == 8)
-                    index = GET_DATA_BYTE(line, j);
-                else if (d == 4)
-                    index = GET_DATA_QBIT(line, j);
-                else   /* 2 bpp */
-                    index = GET_DATA_DIBIT(line, j);
-                pixcmapGetColor(cmap, index, &rval, &gval, &bval);
-                rarray[rval] += 1.0;
-                garray[gval] += 1.0;
-                barray[bval] += 1.0;
-            }
+            /* Histogram the indices, and then map the counts through
+             * the colormap, instead of looking up each pixel */
+        if ((nai = pixGetCmapHistogram(pixs, factor)) == NULL)
+            return ERROR_INT("nai not made", procName, 1);
+        ncolors = pixcmapGetCount(cmap);
+        for (index = 0; index < ncolors; index++) {
+            numaGetFValue(nai, index, &count);
+            if (count == 0.0) continue;
+            pixcmapGetColor(cmap, index, &rval, &gval, &bval);
+            rarray[rval] += count;
+            garray[gval] += count;
+            barray[bval] += count;
         }
+        numaDestroy(&nai);
     }
     else {  /* 32 bpp rgb */
-        for (i = 0; i < h; i += factor) {
+        if ((hist = histoBanksCreate(3 * 256)) == NULL)
+            return ERROR_INT("hist not made", procName, 1);
+        rhist = hist;
+        ghist = hist + 4 * 256;
+        bhist = hist + 8 * 256;
+        for (i = 0, k = 0; i < h; i += factor) {
             line = data + i * wpl;
-            for (j = 0; j < w; j += factor) {
-                extractRGBValues(line[j], &rval, &gval, &bval);
-                rarray[rval] += 1.0;
-                garray[gval] += 1.0;
-                barray[bval] += 1.0;
+            for (j = 0; j < w; j += factor, k++) {
+                pixel = line[j];
+                rhist[HISTO_BANK((pixel >> L_RED_SHIFT) & 0xff, k)]++;
+                ghist[HISTO_BANK((pixel >> L_GREEN_SHIFT) & 0xff, k)]++;
+                bhist[HISTO_BANK((pixel >> L_BLUE_SHIFT) & 0xff, k)]++;
             }
         }
+        histoBanksAccumulate(rhist, 256, rarray);
+        histoBanksAccumulate(ghist, 256, garray);
+        histoBanksAccumulate(bhist, 256, barray);
+        FREE(hist);
     }
 
     return 0;
@@ -454,10 +517,14 @@ pixGetColorHistogramMasked(PIX        *pixs,
                            NUMA      **pnag,
                            NUMA      **pnab)
 {
-l_int32     i, j, w, h, d, wm, hm, dm, wpls, wplm, index, rval, gval, bval;
+l_int32     i, j, k, w, h, d, wm, hm, dm, wpls, wplm, index;
+l_int32     rval, gval, bval, ncolors;
+l_int32    *hist, *rhist, *ghist, *bhist;
+l_uint32    pixel;
 l_uint32   *datas, *datam, *lines, *linem;
+l_float32   count;
 l_float32  *rarray, *garray, *barray;
-NUMA       *nar, *nag, *nab;
+NUMA       *nai, *nar, *nag, *nab;
 PIXCMAP    *cmap;
 
     PROCNAME("pixGetColorHistogramMasked");
@@ -502,42 +569,47 @@ PIXCMAP    *cmap;
     datam = pixGetData(pixm);
     wplm = pixGetWpl(pixm);
     if (cmap) {
-        for (i = 0; i < hm; i += factor) {
-            if (y + i < 0 || y + i >= h) continue;
-            lines = datas + (y + i) * wpls;
-            linem = datam + i * wplm;
-            for (j = 0; j < wm; j += factor) {
-                if (x + j < 0 || x + j >= w) continue;
-                if (GET_DATA_BIT(linem, j)) {
-                    if (d == 8)
-                        index = GET_DATA_BYTE(lines, x + j);
-                    else if (d == 4)
-                        index = GET_DATA_QBIT(lines, x + j);
-                    else   /* 2 bpp */
-                        index = GET_DATA_DIBIT(lines, x + j);
-                    pixcmapGetColor(cmap, index, &rval, &gval, &bval);
-                    rarray[rval] += 1.0;
-                    garray[gval] += 1.0;
-                    barray[bval] += 1.0;
-                }
-            }
+            /* Histogram the indices, and then map the counts through
+             * the colormap, instead of looking up each pixel */
+        if ((nai = pixGetCmapHistogramMasked(pixs, pixm, x, y, factor))
+                == NULL)
+            return ERROR_INT("nai not made", procName, 1);
+        ncolors = pixcmapGetCount(cmap);
+        for (index = 0; index < ncolors; index++) {
+            numaGetFValue(nai, index, &count);
+            if (count == 0.0) continue;
+            pixcmapGetColor(cmap, index, &rval, &gval, &bval);
+            rarray[rval] += count;
+            garray[gval] += count;
+            barray[bval] += count;
         }
+        numaDestroy(&nai);
     }
     else {  /* 32 bpp rgb */
-        for (i = 0; i < hm; i += factor) {
+        if ((hist = histoBanksCreate(3 * 256)) == NULL)
+            return ERROR_INT("hist not made", procName, 1);
+        rhist = hist;
+        ghist = hist + 4 * 256;
+        bhist = hist + 8 * 256;
+        for (i = 0, k = 0; i < hm; i += factor) {
             if (y + i < 0 || y + i >= h) continue;
             lines = datas + (y + i) * wpls;
             linem = datam + i * wplm;
             for (j = 0; j < wm; j += factor) {
                 if (x + j < 0 || x + j >= w) continue;
                 if (GET_DATA_BIT(linem, j)) {
-                    extractRGBValues(lines[x + j], &rval, &gval, &bval);
-                    rarray[rval] += 1.0;
-                    garray[gval] += 1.0;
-                    barray[bval] += 1.0;
+                    pixel = lines[x + j];
+                    rhist[HISTO_BANK((pixel >> L_RED_SHIFT) & 0xff, k)]++;
+                    ghist[HISTO_BANK((pixel >> L_GREEN_SHIFT) & 0xff, k)]++;
+                    bhist[HISTO_BANK((pixel >> L_BLUE_SHIFT) & 0xff, k)]++;
+                    k++;
                 }
             }
         }
+        histoBanksAccumulate(rhist, 256, rarray);
+        histoBanksAccumulate(ghist, 256, garray);
+        histoBanksAccumulate(bhist, 256, barray);
+        FREE(hist);
     }
 
     return 0;
@@ -560,7 +632,8 @@ NUMA *
 pixGetCmapHistogram(PIX     *pixs,
                     l_int32  factor)
 {
-l_int32     i, j, w, h, d, wpl, val, size;
+l_int32     i, j, k, w, h, d, wpl, val, size;
+l_int32    *hist;
 l_uint32   *data, *line;
 l_float32  *array;
 NUMA       *na;
@@ -582,22 +655,28 @@ NUMA       *na;
         return (NUMA *)ERROR_PTR("na not made", procName, NULL);
     numaSetCount(na, size);  /* all initialized to 0.0 */
     array = numaGetFArray(na, L_NOCOPY);
+    if ((hist = histoBanksCreate(size)) == NULL) {
+        numaDestroy(&na);
+        return (NUMA *)ERROR_PTR("hist not made", procName, NULL);
+    }
 
     wpl = pixGetWpl(pixs);
     data = pixGetData(pixs);
-    for (i = 0; i < h; i += factor) {
+    for (i = 0, k = 0; i < h; i += factor) {
         line = data + i * wpl;
-        for (j = 0; j < w; j += factor) {
+        for (j = 0; j < w; j += factor, k++) {
             if (d == 8)
                 val = GET_DATA_BYTE(line, j);
             else if (d == 4)
                 val = GET_DATA_QBIT(line, j);
             else  /* d == 2 */
                 val = GET_DATA_DIBIT(line, j);
-            array[val] += 1.0;
+            hist[HISTO_BANK(val, k)]++;
         }
     }
 
+    histoBanksAccumulate(hist, size, array);
+    FREE(hist);
     return na;
 }
 
@@ -626,7 +705,8 @@ pixGetCmapHistogramMasked(PIX     *pixs,
                           l_int32  y,
                           l_int32  factor)
 {
-l_int32     i, j, w, h, d, wm, hm, dm, wpls, wplm, val, size;
+l_int32     i, j, k, w, h, d, wm, hm, dm, wpls, wplm, val, size;
+l_int32    *hist;
 l_uint32   *datas, *datam, *lines, *linem;
 l_float32  *array;
 NUMA       *na;
@@ -654,13 +734,17 @@ NUMA       *na;
         return (NUMA *)ERROR_PTR("na not made", procName, NULL);
     numaSetCount(na, size);  /* all initialized to 0.0 */
     array = numaGetFArray(na, L_NOCOPY);
+    if ((hist = histoBanksCreate(size)) == NULL) {
+        numaDestroy(&na);
+        return (NUMA *)ERROR_PTR("hist not made", procName, NULL);
+    }
 
     datas = pixGetData(pixs);
     wpls = pixGetWpl(pixs);
     datam = pixGetData(pixm);
     wplm = pixGetWpl(pixm);
 
-    for (i = 0; i < hm; i += factor) {
+    for (i = 0, k = 0; i < hm; i += factor) {
         if (y + i < 0 || y + i >= h) continue;
         lines = datas + (y + i) * wpls;
         linem = datam + i * wplm;
@@ -673,11 +757,13 @@ NUMA       *na;
                     val = GET_DATA_QBIT(lines, x + j);
                 else  /* d == 2 */
                     val = GET_DATA_DIBIT(lines, x + j);
-                array[val] += 1.0;
+                hist[HISTO_BANK(val, k++)]++;
             }
         }
     }
 
+    histoBanksAccumulate(hist, size, array);
+    FREE(hist);
     return na;
 }
 
@@ -702,7 +788,8 @@ pixGetCmapHistogramInRect(PIX     *pixs,
                           BOX     *box,
                           l_int32  factor)
 {
-l_int32     i, j, bx, by, bw, bh, w, h, d, wpls, val, size;
+l_int32     i, j, k, bx, by, bw, bh, w, h, d, wpls, val, size;
+l_int32    *hist;
 l_uint32   *datas, *lines;
 l_float32  *array;
 NUMA       *na;
@@ -727,12 +814,16 @@ NUMA       *na;
         return (NUMA *)ERROR_PTR("na not made", procName, NULL);
     numaSetCount(na, size);  /* all initialized to 0.0 */
     array = numaGetFArray(na, L_NOCOPY);
+    if ((hist = histoBanksCreate(size)) == NULL) {
+        numaDestroy(&na);
+        return (NUMA *)ERROR_PTR("hist not made", procName, NULL);
+    }
 
     datas = pixGetData(pixs);
     wpls = pixGetWpl(pixs);
     boxGetGeometry(box, &bx, &by, &bw, &bh);
 
-    for (i = 0; i < bh; i += factor) {
+    for (i = 0, k = 0; i < bh; i += factor) {
         if (by + i < 0 || by + i >= h) continue;
         lines = datas + (by + i) * wpls;
         for (j = 0; j < bw; j += factor) {
@@ -743,14 +834,60 @@ NUMA       *na;
                 val = GET_DATA_QBIT(lines, bx + j);
             else  /* d == 2 */
                 val = GET_DATA_DIBIT(lines, bx + j);
-            array[val] += 1.0;
+            hist[HISTO_BANK(val, k++)]++;
         }
     }
 
+    histoBanksAccumulate(hist, size, array);
+    FREE(hist);
     return na;
 }
 
 
+/*!
+ *  histoBanksCreate()
+ *
+ *      Input:  size (number of histogram bins)
+ *      Return: hist (4 zeroed banks of counts, interleaved by bin),
+ *                    or null on error
+ */
+static l_int32 *
+histoBanksCreate(l_int32  size)
+{
+    PROCNAME("histoBanksCreate");
+
+    if (size <= 0)
+        return (l_int32 *)ERROR_PTR("size <= 0", procName, NULL);
+    return (l_int32 *)CALLOC(4 * size, sizeof(l_int32));
+}
+
+
+/*!
+ *  histoBanksAccumulate()
+ *
+ *      Input:  hist (4 banks of counts, accessed with HISTO_BANK())
+ *              size (number of histogram bins)
+ *              array (float array of a numa of at least @size bins)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) The counts are summed over the banks and added to @array.
+ *          Because the counts are integers, they are exact even when
+ *          a bin gets more than 2^24 pixels.
+ */
+static void
+histoBanksAccumulate(l_int32    *hist,
+                     l_int32     size,
+                     l_float32  *array)
+{
+l_int32  i;
+
+    for (i = 0; i < size; i++, hist += 4)
+        array[i] += (l_float32)(hist[0] + hist[1] + hist[2] + hist[3]);
+    return;
+}
+
+
 /*!
  *  pixGetRankValue()
  *
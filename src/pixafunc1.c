@@ -60,10 +60,20 @@
 #include <string.h>
 #include "allheaders.h"
 
-    /* For more than this number of c.c. in a binarized image of
-     * semi-perimeter (w + h) about 5000 or less, the O(n) binsort
-     * is faster than the O(nlogn) shellsort.  */
-static const l_int32   MIN_COMPS_FOR_BIN_SORT = 500;
+    /* Size constraint for pixSelectBySize(), with a count of the
+     * components that fail it */
+struct SizeSelect
+{
+    l_int32    width;
+    l_int32    height;
+    l_int32    type;
+    l_int32    relation;
+    l_int32    nremoved;
+};
+typedef struct SizeSelect  SIZESELECT;
+
+static l_int32 selectBySizeFilter(L_CCSTATS *stats, l_int32 index,
+                                  void *data);
 
 
 /*---------------------------------------------------------------------*
@@ -168,6 +178,9 @@ static const l_int32   MIN_COMPS_FOR_BIN_SORT = 500;
  *          L_SELECT_IF_LTE.
  *          To keep large components, use relation = L_SELECT_IF_GT or
  *          L_SELECT_IF_GTE.
+ *      (5) The components are found and filtered by their bounding
+ *          boxes with pixConnCompSelect(), without making a pix
+ *          for each component.
  */
 PIX *
 pixSelectBySize(PIX      *pixs,
@@ -178,10 +191,9 @@ pixSelectBySize(PIX      *pixs,
                 l_int32   relation,
                 l_int32  *pchanged)
 {
-l_int32  w, h, empty, changed, count;
-BOXA    *boxa;
-PIX     *pixd;
-PIXA    *pixas, *pixad;
+l_int32     empty;
+PIX        *pixd;
+SIZESELECT  sel;
 
     PROCNAME("pixSelectBySize");
 
@@ -202,33 +214,72 @@ PIXA    *pixas, *pixad;
     if (empty)
         return pixCopy(NULL, pixs);
 
-        /* Identify and select the components */
-    boxa = pixConnComp(pixs, &pixas, connectivity);
-    pixad = pixaSelectBySize(pixas, width, height, type, relation, &changed);
-    boxaDestroy(&boxa);
-    pixaDestroy(&pixas);
-
-        /* Render the result */
-    if (!changed) {
-        pixaDestroy(&pixad);
+        /* Identify and render the selected components */
+    sel.width = width;
+    sel.height = height;
+    sel.type = type;
+    sel.relation = relation;
+    sel.nremoved = 0;
+    if ((pixd = pixConnCompSelect(pixs, connectivity, selectBySizeFilter,
+                                  &sel, NULL)) == NULL)
+        return (PIX *)ERROR_PTR("pixd not made", procName, NULL);
+
+    if (sel.nremoved == 0) {
+        pixDestroy(&pixd);
         return pixCopy(NULL, pixs);
     }
-    else {
-        if (pchanged) *pchanged = TRUE;
-        pixGetDimensions(pixs, &w, &h, NULL);
-        count = pixaGetCount(pixad);
-        if (count == 0)  /* return empty pix */
-            pixd = pixCreateTemplate(pixs);
-        else {
-            pixd = pixaDisplay(pixad, w, h);
-            pixCopyResolution(pixd, pixs);
-            pixCopyColormap(pixd, pixs);
-            pixCopyText(pixd, pixs);
-            pixCopyInputFormat(pixd, pixs);
-        }
-        pixaDestroy(&pixad);
-        return pixd;
-    }
+    if (pchanged) *pchanged = TRUE;
+    pixCopyColormap(pixd, pixs);
+    pixCopyText(pixd, pixs);
+    pixCopyInputFormat(pixd, pixs);
+    return pixd;
+}
+
+
+/*!
+ *  selectBySizeFilter()
+ *
+ *      Input:  stats (of connected components)
+ *              index (of component to test)
+ *              data (SIZESELECT constraint)
+ *      Return: 1 to keep the component, 0 to remove it
+ *
+ *  Notes:
+ *      (1) This applies the same test as boxaMakeSizeIndicator().
+ */
+static l_int32
+selectBySizeFilter(L_CCSTATS  *stats,
+                   l_int32     index,
+                   void       *data)
+{
+l_int32      w, h, width, height, relation, wok, hok, keep;
+SIZESELECT  *sel;
+
+    sel = (SIZESELECT *)data;
+    w = stats->w[index];
+    h = stats->h[index];
+    width = sel->width;
+    height = sel->height;
+    relation = sel->relation;
+    wok = (relation == L_SELECT_IF_LT && w < width) ||
+          (relation == L_SELECT_IF_GT && w > width) ||
+          (relation == L_SELECT_IF_LTE && w <= width) ||
+          (relation == L_SELECT_IF_GTE && w >= width);
+    hok = (relation == L_SELECT_IF_LT && h < height) ||
+          (relation == L_SELECT_IF_GT && h > height) ||
+          (relation == L_SELECT_IF_LTE && h <= height) ||
+          (relation == L_SELECT_IF_GTE && h >= height);
+    if (sel->type == L_SELECT_WIDTH)
+        keep = wok;
+    else if (sel->type == L_SELECT_HEIGHT)
+        keep = hok;
+    else if (sel->type == L_SELECT_IF_EITHER)
+        keep = wok || hok;
+    else  /* L_SELECT_IF_BOTH */
+        keep = wok && hok;
+    if (!keep)
+        sel->nremoved++;
+    return keep;
 }
 
 
@@ -911,6 +962,8 @@ PIX     *pix;
  *      (2) The copyflag refers to the pix and box copies that are
  *          inserted into the sorted pixa.  These are either L_COPY
  *          or L_CLONE.
+ *      (3) For more than a few hundred pix, the sort index is found
+ *          with an O(n) radix sort that is stable; see boxaSort().
  */
 PIXA *
 pixaSort(PIXA    *pixas,
@@ -948,13 +1001,6 @@ PIXA    *pixad;
     if (boxaGetCount(boxa) != n)
         return (PIXA *)ERROR_PTR("boxa and pixa counts differ", procName, NULL);
 
-        /* Use O(n) binsort if possible */
-    if (n > MIN_COMPS_FOR_BIN_SORT &&
-        ((sorttype == L_SORT_BY_X) || (sorttype == L_SORT_BY_Y) ||
-         (sorttype == L_SORT_BY_WIDTH) || (sorttype == L_SORT_BY_HEIGHT) ||
-         (sorttype == L_SORT_BY_PERIMETER)))
-        return pixaBinSort(pixas, sorttype, sortorder, pnaindex, copyflag);
-
         /* Build up numa of specific data */
     if ((na = numaCreate(n)) == NULL)
         return (PIXA *)ERROR_PTR("na not made", procName, NULL);
@@ -1031,9 +1077,9 @@ PIXA    *pixad;
  *          or L_CLONE.
  *      (3) For a large number of boxes (say, greater than 1000), this
  *          O(n) binsort is much faster than the O(nlogn) shellsort.
- *          For 5000 components, this is over 20x faster than boxaSort().
- *      (4) Consequently, pixaSort() calls this function if it will
- *          likely go much faster.
+ *      (4) The values must be non-negative integers.  pixaSort() is
+ *          equally fast for large pixa, because it uses a radix sort;
+ *          see numaGetRadixSortIndex().
  */
 PIXA *
 pixaBinSort(PIXA    *pixas,
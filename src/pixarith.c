@@ -103,8 +103,9 @@ l_int32
 pixAddConstantGray(PIX      *pixs,
                    l_int32   val)
 {
-l_int32    w, h, d, wpl;
-l_uint32  *data;
+l_int32          w, h, d, wpl;
+l_uint32        *data;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixAddConstantGray");
 
@@ -116,7 +117,8 @@ l_uint32  *data;
 
     data = pixGetData(pixs);
     wpl = pixGetWpl(pixs);
-    addConstantGrayLow(data, w, h, d, wpl, val);
+    dispatch = l_cpuGetDispatch();
+    dispatch->addConstantGrayLow(data, w, h, d, wpl, val);
 
     return 0;
 }
@@ -138,8 +140,9 @@ l_int32
 pixMultConstantGray(PIX       *pixs,
                     l_float32  val)
 {
-l_int32    w, h, d, wpl;
-l_uint32  *data;
+l_int32          w, h, d, wpl;
+l_uint32        *data;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixMultConstantGray");
 
@@ -153,7 +156,8 @@ l_uint32  *data;
 
     data = pixGetData(pixs);
     wpl = pixGetWpl(pixs);
-    multConstantGrayLow(data, w, h, d, wpl, val);
+    dispatch = l_cpuGetDispatch();
+    dispatch->multConstantGrayLow(data, w, h, d, wpl, val);
 
     return 0;
 }
@@ -188,8 +192,9 @@ pixAddGray(PIX  *pixd,
            PIX  *pixs1,
            PIX  *pixs2)
 {
-l_int32    d, ws, hs, w, h, wpls, wpld;
-l_uint32  *datas, *datad;
+l_int32          d, ws, hs, w, h, wpls, wpld;
+l_uint32        *datas, *datad;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixAddGray");
 
@@ -226,7 +231,8 @@ l_uint32  *datas, *datad;
     pixGetDimensions(pixd, &w, &h, NULL);
     w = L_MIN(ws, w);
     h = L_MIN(hs, h);
-    addGrayLow(datad, w, h, d, wpld, datas, wpls);
+    dispatch = l_cpuGetDispatch();
+    dispatch->addGrayLow(datad, w, h, d, wpld, datas, wpls);
 
     return pixd;
 }
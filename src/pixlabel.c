@@ -0,0 +1,536 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+/*
+ *  pixlabel.c
+ *
+ *    Connected component labeling, with per-component statistics
+ *
+ *      Label image and binary selection:
+ *           PIX        *pixConnCompLabel()
+ *           PIX        *pixConnCompSelect()
+ *
+ *      CCStats creation, destruction and accessors:
+ *           L_CCSTATS  *ccstatsCreate()
+ *           L_CCSTATS  *ccstatsCreateFromRle()
+ *           void        ccstatsDestroy()
+ *           l_int32     ccstatsGetCount()
+ *           BOXA       *ccstatsGetBoxa()
+ *
+ *      Static helper:
+ *           static l_int32  ccRunsFind()
+ *
+ *  The functions in conncomp.c erase each component in turn with
+ *  a seedfill, and pixConnComp() can also return a pix of each
+ *  component.  When only the sizes and locations of the components
+ *  are wanted, as when filtering out thousands of specks on a page,
+ *  it is much cheaper to find them all together in one raster scan.
+ *
+ *  The method here works with runs of fg pixels.  The image is
+ *  scanned once, finding the runs on each line, which are held in
+ *  an L_RLE (see rle.c).  Each run is joined
+ *  to the runs it touches on the line above, using a union-find
+ *  forest over the runs.  The statistics of each component, which
+ *  are all sums or extrema over its runs, are then accumulated in
+ *  a single pass over the runs, and stored in an L_CCSTATS, with
+ *  one array for each statistic.  The components are numbered
+ *  in the raster order of their first pixel, which is the order
+ *  used by pixConnComp().
+ *
+ *  An optional filter function can then look at the statistics of
+ *  each component, and decide whether it is kept.  Dropped components
+ *  are never rendered, and are removed from the returned statistics.
+ *  Finally, the runs of the remaining components are written into
+ *  either a 32 bpp label image or a 1 bpp mask.  No pix or box is
+ *  allocated for any component.
+ */
+
+#include "allheaders.h"
+
+static l_int32 ccRunsFind(l_int32 *parent, l_int32 k);
+
+static const l_int32  INITIAL_PTR_ARRAYSIZE = 1000;
+
+
+/*-----------------------------------------------------------------------*
+ *                  Label image and binary selection                     *
+ *-----------------------------------------------------------------------*/
+/*!
+ *  pixConnCompLabel()
+ *
+ *      Input:  pixs (1 bpp)
+ *              connectivity (4 or 8)
+ *              filter (<optional> function to select the components
+ *                      to keep; use NULL to keep all)
+ *              data (<optional> passed to @filter)
+ *              &stats (<optional return> statistics of the components)
+ *      Return: pixd (32 bpp label image), or null on error
+ *
+ *  Notes:
+ *      (1) Each fg pixel in pixd is labeled with the index, starting
+ *          at 1, of its component in @stats.  bg pixels are 0.
+ *      (2) The components are ordered by the raster position of their
+ *          first pixel, as in pixConnComp().  Then the box at index i
+ *          in the boxa from pixConnComp() is that of label i + 1.
+ *      (3) If @filter is given, it is called as
+ *              keep = filter(stats, index, data)
+ *          for every component, with index in [0 ... n - 1].
+ *          Components for which it returns 0 are removed from the
+ *          statistics, and get label 0 in pixd; the rest are
+ *          renumbered, in the same order.
+ *      (4) The statistics are the bounding box, the number of
+ *          fg pixels, the centroid of the fg pixels, and the perimeter,
+ *          measured as the number of sides between a fg pixel and
+ *          a bg pixel (including sides on the image boundary).
+ */
+PIX *
+pixConnCompLabel(PIX         *pixs,
+                 l_int32      connectivity,
+                 L_CCFILTER   filter,
+                 void        *data,
+                 L_CCSTATS  **pstats)
+{
+l_int32     i, j, k, w, h, wpld, label;
+l_int32    *labels;
+l_uint32   *datad, *lined;
+L_CCSTATS  *stats;
+L_RLE      *rle;
+PIX        *pixd;
+
+    PROCNAME("pixConnCompLabel");
+
+    if (pstats) *pstats = NULL;
+    if (!pixs || pixGetDepth(pixs) != 1)
+        return (PIX *)ERROR_PTR("pixs undefined or not 1 bpp", procName, NULL);
+    if (connectivity != 4 && connectivity != 8)
+        return (PIX *)ERROR_PTR("connectivity not 4 or 8", procName, NULL);
+
+    if ((rle = rleCreateFromPix(pixs)) == NULL)
+        return (PIX *)ERROR_PTR("rle not made", procName, NULL);
+    stats = ccstatsCreateFromRle(rle, connectivity, filter, data, &labels);
+    if (!stats) {
+        rleDestroy(&rle);
+        return (PIX *)ERROR_PTR("runs not labeled", procName, NULL);
+    }
+
+    pixGetDimensions(pixs, &w, &h, NULL);
+    if ((pixd = pixCreate(w, h, 32)) == NULL) {
+        rleDestroy(&rle);
+        FREE(labels);
+        ccstatsDestroy(&stats);
+        return (PIX *)ERROR_PTR("pixd not made", procName, NULL);
+    }
+    pixCopyResolution(pixd, pixs);
+    datad = pixGetData(pixd);
+    wpld = pixGetWpl(pixd);
+    for (i = 0; i < h; i++) {
+        lined = datad + i * wpld;
+        for (k = rle->rowstart[i]; k < rle->rowstart[i + 1]; k++) {
+            if ((label = labels[k]) == 0)
+                continue;
+            for (j = rle->xs[k]; j <= rle->xe[k]; j++)
+                lined[j] = label;
+        }
+    }
+
+    rleDestroy(&rle);
+    FREE(labels);
+    if (pstats)
+        *pstats = stats;
+    else
+        ccstatsDestroy(&stats);
+    return pixd;
+}
+
+
+/*!
+ *  pixConnCompSelect()
+ *
+ *      Input:  pixs (1 bpp)
+ *              connectivity (4 or 8)
+ *              filter (function to select the components to keep)
+ *              data (<optional> passed to @filter)
+ *              &stats (<optional return> statistics of the components kept)
+ *      Return: pixd (1 bpp, with the kept components), or null on error
+ *
+ *  Notes:
+ *      (1) This is the same as pixConnCompLabel(), except that the
+ *          components that are kept are rendered into a 1 bpp mask.
+ *          See pixConnCompLabel() for details.
+ *      (2) It is equivalent to, and much faster than, selecting
+ *          from the pixa returned by pixConnComp() and rendering
+ *          the selection with pixaDisplay().
+ */
+PIX *
+pixConnCompSelect(PIX         *pixs,
+                  l_int32      connectivity,
+                  L_CCFILTER   filter,
+                  void        *data,
+                  L_CCSTATS  **pstats)
+{
+L_CCSTATS  *stats;
+L_RLE      *rles, *rled;
+PIX        *pixd;
+
+    PROCNAME("pixConnCompSelect");
+
+    if (pstats) *pstats = NULL;
+    if (!pixs || pixGetDepth(pixs) != 1)
+        return (PIX *)ERROR_PTR("pixs undefined or not 1 bpp", procName, NULL);
+    if (connectivity != 4 && connectivity != 8)
+        return (PIX *)ERROR_PTR("connectivity not 4 or 8", procName, NULL);
+    if (!filter)
+        return (PIX *)ERROR_PTR("filter not defined", procName, NULL);
+
+    if ((rles = rleCreateFromPix(pixs)) == NULL)
+        return (PIX *)ERROR_PTR("rles not made", procName, NULL);
+    stats = rleConnComp(rles, connectivity, filter, data, &rled);
+    rleDestroy(&rles);
+    if (!stats)
+        return (PIX *)ERROR_PTR("runs not labeled", procName, NULL);
+
+    pixd = pixCreateFromRle(rled);
+    rleDestroy(&rled);
+    if (!pixd) {
+        ccstatsDestroy(&stats);
+        return (PIX *)ERROR_PTR("pixd not made", procName, NULL);
+    }
+    pixCopyResolution(pixd, pixs);
+    if (pstats)
+        *pstats = stats;
+    else
+        ccstatsDestroy(&stats);
+    return pixd;
+}
+
+
+/*-----------------------------------------------------------------------*
+ *            CCStats creation, destruction and accessors                *
+ *-----------------------------------------------------------------------*/
+/*!
+ *  ccstatsCreate()
+ *
+ *      Input:  n (initial number of components allocated; 0 for default)
+ *      Return: stats, or null on error
+ */
+L_CCSTATS *
+ccstatsCreate(l_int32  n)
+{
+L_CCSTATS  *stats;
+
+    PROCNAME("ccstatsCreate");
+
+    if (n <= 0)
+        n = INITIAL_PTR_ARRAYSIZE;
+    if ((stats = (L_CCSTATS *)CALLOC(1, sizeof(L_CCSTATS))) == NULL)
+        return (L_CCSTATS *)ERROR_PTR("stats not made", procName, NULL);
+    stats->nalloc = n;
+    stats->x = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    stats->y = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    stats->w = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    stats->h = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    stats->area = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    stats->cx = (l_float32 *)CALLOC(n, sizeof(l_float32));
+    stats->cy = (l_float32 *)CALLOC(n, sizeof(l_float32));
+    stats->perim = (l_int32 *)CALLOC(n, sizeof(l_int32));
+    if (!stats->x || !stats->y || !stats->w || !stats->h || !stats->area ||
+        !stats->cx || !stats->cy || !stats->perim) {
+        ccstatsDestroy(&stats);
+        return (L_CCSTATS *)ERROR_PTR("stats arrays not made", procName, NULL);
+    }
+    return stats;
+}
+
+
+/*!
+ *  ccstatsCreateFromRle()
+ *
+ *      Input:  rle
+ *              connectivity (4 or 8)
+ *              filter (<optional> function to select components)
+ *              data (<optional> passed to @filter)
+ *              &labels (<optional return> array with the component label
+ *                       of each run in @rle, starting at 1; 0 if dropped)
+ *      Return: stats (of the kept components), or null on error
+ *
+ *  Notes:
+ *      (1) A run on line i touches a run [xs, xe] on line i - 1 if the
+ *          two overlap, after extending [xs, xe] by 1 on each side
+ *          for 8-connectivity.  Because the runs on each line are in
+ *          order, all the touching runs are found by a merge of the
+ *          run lists on the two lines.
+ *      (2) The union always keeps the smaller run index as the root,
+ *          so every parent has a smaller index than its child, and
+ *          the root of each component is its first run in raster order.
+ *          Labels are then assigned in one pass over the runs, with
+ *          each run taking the (negated) label of its parent.
+ *      (3) Each run starts with 2 * length + 2 edges, and loses 2 for
+ *          each pixel it shares with a run on the line above.
+ *      (4) See pixConnCompLabel() for the statistics and the filter.
+ */
+L_CCSTATS *
+ccstatsCreateFromRle(L_RLE       *rle,
+                     l_int32      connectivity,
+                     L_CCFILTER   filter,
+                     void        *data,
+                     l_int32    **plabels)
+{
+l_int32     i, k, m, n, nruns, xs, xe, ext, nkept;
+l_int32     prevstart, prevend, ov, ra, rb, label;
+l_int32    *parent, *perim, *remap;
+l_float64  *sumx, *sumy;
+L_CCSTATS  *stats;
+
+    PROCNAME("ccstatsCreateFromRle");
+
+    if (plabels) *plabels = NULL;
+    if (!rle)
+        return (L_CCSTATS *)ERROR_PTR("rle not defined", procName, NULL);
+    if (connectivity != 4 && connectivity != 8)
+        return (L_CCSTATS *)ERROR_PTR("connectivity not 4 or 8",
+                                      procName, NULL);
+
+    nruns = rle->n;
+    parent = (l_int32 *)CALLOC(L_MAX(1, nruns), sizeof(l_int32));
+    perim = (l_int32 *)CALLOC(L_MAX(1, nruns), sizeof(l_int32));
+    stats = ccstatsCreate(L_MAX(1, nruns));
+    sumx = (l_float64 *)CALLOC(L_MAX(1, nruns), sizeof(l_float64));
+    sumy = (l_float64 *)CALLOC(L_MAX(1, nruns), sizeof(l_float64));
+    if (!parent || !perim || !stats || !sumx || !sumy) {
+        FREE(parent);
+        FREE(perim);
+        ccstatsDestroy(&stats);
+        FREE(sumx);
+        FREE(sumy);
+        return (L_CCSTATS *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+    ext = (connectivity == 8) ? 1 : 0;
+
+        /* Join each run to the runs that it touches on the line above */
+    for (m = 0; m < nruns; m++) {
+        parent[m] = m;
+        perim[m] = 2 * (rle->xe[m] - rle->xs[m] + 1) + 2;
+    }
+    for (i = 1; i < rle->h; i++) {
+        prevstart = rle->rowstart[i - 1];
+        prevend = rle->rowstart[i];
+        for (m = prevend, n = prevstart; m < rle->rowstart[i + 1]; m++) {
+            xs = rle->xs[m] - ext;
+            xe = rle->xe[m] + ext;
+            while (n < prevend && rle->xe[n] < xs)
+                n++;
+            for (k = n; k < prevend && rle->xs[k] <= xe; k++) {
+                ov = L_MIN(rle->xe[m], rle->xe[k]) -
+                     L_MAX(rle->xs[m], rle->xs[k]) + 1;
+                if (ov > 0)
+                    perim[m] -= 2 * ov;
+                ra = ccRunsFind(parent, m);
+                rb = ccRunsFind(parent, k);
+                if (ra < rb)
+                    parent[rb] = ra;
+                else if (rb < ra)
+                    parent[ra] = rb;
+            }
+        }
+    }
+
+        /* Label the components in order of their first run, and
+         * accumulate the statistics of each one */
+    n = 0;
+    for (i = 0; i < rle->h; i++) {
+        for (m = rle->rowstart[i]; m < rle->rowstart[i + 1]; m++) {
+            if (parent[m] == m) {  /* first run of a new component */
+                parent[m] = -(n + 1);
+                stats->x[n] = rle->xs[m];
+                stats->y[n] = i;
+                stats->w[n] = rle->xe[m];  /* right edge, for now */
+                stats->h[n] = i;  /* bottom edge, for now */
+                n++;
+            }
+            else  /* the parent is an earlier run, and holds -label */
+                parent[m] = parent[parent[m]];
+            label = -parent[m] - 1;
+            xs = rle->xs[m];
+            xe = rle->xe[m];
+            stats->x[label] = L_MIN(stats->x[label], xs);
+            stats->w[label] = L_MAX(stats->w[label], xe);
+            stats->h[label] = i;
+            stats->area[label] += xe - xs + 1;
+            stats->perim[label] += perim[m];
+            sumx[label] += 0.5 * (xe - xs + 1) * (xs + xe);
+            sumy[label] += (l_float64)(xe - xs + 1) * i;
+        }
+    }
+    stats->n = n;
+    for (m = 0; m < nruns; m++)
+        parent[m] = -parent[m];
+    for (k = 0; k < n; k++) {
+        stats->w[k] = stats->w[k] - stats->x[k] + 1;
+        stats->h[k] = stats->h[k] - stats->y[k] + 1;
+        stats->cx[k] = (l_float32)(sumx[k] / stats->area[k]);
+        stats->cy[k] = (l_float32)(sumy[k] / stats->area[k]);
+    }
+    FREE(sumx);
+    FREE(sumy);
+    FREE(perim);
+
+        /* Filter the components, compacting the statistics in place */
+    if (filter) {
+        if ((remap = (l_int32 *)CALLOC(n + 1, sizeof(l_int32))) == NULL) {
+            ccstatsDestroy(&stats);
+            FREE(parent);
+            return (L_CCSTATS *)ERROR_PTR("remap not made", procName, NULL);
+        }
+        for (k = 0, nkept = 0; k < n; k++) {
+            if (!filter(stats, k, data))
+                continue;
+            remap[k + 1] = nkept + 1;
+            stats->x[nkept] = stats->x[k];
+            stats->y[nkept] = stats->y[k];
+            stats->w[nkept] = stats->w[k];
+            stats->h[nkept] = stats->h[k];
+            stats->area[nkept] = stats->area[k];
+            stats->cx[nkept] = stats->cx[k];
+            stats->cy[nkept] = stats->cy[k];
+            stats->perim[nkept] = stats->perim[k];
+            nkept++;
+        }
+        stats->n = nkept;
+        for (m = 0; m < nruns; m++)
+            parent[m] = remap[parent[m]];
+        FREE(remap);
+    }
+
+    if (plabels)
+        *plabels = parent;
+    else
+        FREE(parent);
+    return stats;
+}
+
+
+/*!
+ *  ccstatsDestroy()
+ *
+ *      Input:  &stats (<to be nulled>)
+ *      Return: void
+ */
+void
+ccstatsDestroy(L_CCSTATS  **pstats)
+{
+L_CCSTATS  *stats;
+
+    PROCNAME("ccstatsDestroy");
+
+    if (pstats == NULL) {
+        L_WARNING("ptr address is null!", procName);
+        return;
+    }
+    if ((stats = *pstats) == NULL)
+        return;
+
+    FREE(stats->x);
+    FREE(stats->y);
+    FREE(stats->w);
+    FREE(stats->h);
+    FREE(stats->area);
+    FREE(stats->cx);
+    FREE(stats->cy);
+    FREE(stats->perim);
+    FREE(stats);
+    *pstats = NULL;
+    return;
+}
+
+
+/*!
+ *  ccstatsGetCount()
+ *
+ *      Input:  stats
+ *      Return: number of components, or 0 on error
+ */
+l_int32
+ccstatsGetCount(L_CCSTATS  *stats)
+{
+    PROCNAME("ccstatsGetCount");
+
+    if (!stats)
+        return ERROR_INT("stats not defined", procName, 0);
+    return stats->n;
+}
+
+
+/*!
+ *  ccstatsGetBoxa()
+ *
+ *      Input:  stats
+ *      Return: boxa (of component bounding boxes), or null on error
+ */
+BOXA *
+ccstatsGetBoxa(L_CCSTATS  *stats)
+{
+l_int32  i;
+BOX     *box;
+BOXA    *boxa;
+
+    PROCNAME("ccstatsGetBoxa");
+
+    if (!stats)
+        return (BOXA *)ERROR_PTR("stats not defined", procName, NULL);
+
+    if ((boxa = boxaCreate(stats->n)) == NULL)
+        return (BOXA *)ERROR_PTR("boxa not made", procName, NULL);
+    for (i = 0; i < stats->n; i++) {
+        box = boxCreate(stats->x[i], stats->y[i], stats->w[i], stats->h[i]);
+        boxaAddBox(boxa, box, L_INSERT);
+    }
+    return boxa;
+}
+
+
+/*-----------------------------------------------------------------------*
+ *                           Static helper                               *
+ *-----------------------------------------------------------------------*/
+/*!
+ *  ccRunsFind()
+ *
+ *      Input:  parent (union-find parent array)
+ *              k (index of run)
+ *      Return: root of the tree containing k
+ *
+ *  Notes:
+ *      (1) This uses path halving to keep the trees shallow.
+ */
+static l_int32
+ccRunsFind(l_int32  *parent,
+           l_int32   k)
+{
+    while (parent[k] != k) {
+        parent[k] = parent[parent[k]];
+        k = parent[k];
+    }
+    return k;
+}
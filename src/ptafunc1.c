@@ -79,9 +79,6 @@
 #include <string.h>
 #include "allheaders.h"
 
-    /* Default spreading factor for hashing pts in a plane */
-static const l_int32  DEFAULT_SPREADING_FACTOR = 7500;
-
 
 /*---------------------------------------------------------------------*
  *                           Pta rearrangements                        *
@@ -434,75 +431,47 @@ PTA       *ptad;
  *  ptaRemoveDuplicates()
  *
  *      Input:  ptas (assumed to be integer values)
- *              factor (should be larger than the largest point value;
- *                      use 0 for default)
+ *              factor (ignored; kept for compatibility; use 0)
  *      Return: ptad (with duplicates removed), or null on error
+ *
+ *  Notes:
+ *      (1) The first occurrence of each point is kept, in the order
+ *          they appear in @ptas.
+ *      (2) The points are stored in a hash map keyed by the exact
+ *          (x, y) values, so the time is linear in the number of
+ *          points and no points are compared exhaustively.
  */
 PTA *
 ptaRemoveDuplicates(PTA      *ptas,
                     l_uint32  factor)
 {
-l_int32    nsize, i, j, k, index, n, nvals;
-l_int32    x, y, xk, yk;
-l_int32   *ia;
-PTA       *ptad;
-NUMA      *na;
-NUMAHASH  *nahash;
+l_int32      i, n, x, y;
+l_uint64     key;
+L_HASHITEM  *item;
+L_HASHMAP   *hmap;
+PTA         *ptad;
 
     PROCNAME("ptaRemoveDuplicates");
 
     if (!ptas)
         return (PTA *)ERROR_PTR("ptas not defined", procName, NULL);
-    if (factor == 0)
-        factor = DEFAULT_SPREADING_FACTOR;
-
-        /* Build up numaHash of indices, hashed by a key that is
-         * a large linear combination of x and y values designed to
-         * randomize the key. */
-    nsize = 5507;  /* buckets in hash table; prime */
-    nahash = numaHashCreate(nsize, 2);
+
     n = ptaGetCount(ptas);
+    if ((hmap = l_hmapCreate(n, L_HMAP_INT_KEY)) == NULL)
+        return (PTA *)ERROR_PTR("hmap not made", procName, NULL);
+    if ((ptad = ptaCreate(n)) == NULL) {
+        l_hmapDestroy(&hmap);
+        return (PTA *)ERROR_PTR("ptad not made", procName, NULL);
+    }
     for (i = 0; i < n; i++) {
         ptaGetIPt(ptas, i, &x, &y);
-        numaHashAdd(nahash, factor * x + y, (l_float32)i);
-    }
-
-    if ((ptad = ptaCreate(n)) == NULL)
-        return (PTA *)ERROR_PTR("ptad not made", procName, NULL);
-    for (i = 0; i < nsize; i++) {
-        na = numaHashGetNuma(nahash, i);
-        if (!na) continue;
-
-        nvals = numaGetCount(na);
-            /* If more than 1 pt, compare exhaustively with double loop;
-             * otherwise, just enter it. */
-        if (nvals > 1) {
-            if ((ia = (l_int32 *)CALLOC(nvals, sizeof(l_int32))) == NULL)
-                return (PTA *)ERROR_PTR("ia not made", procName, NULL);
-            for (j = 0; j < nvals; j++) {
-                if (ia[j] == 1) continue;
-                numaGetIValue(na, j, &index);
-                ptaGetIPt(ptas, index, &x, &y);
-                ptaAddPt(ptad, x, y);
-                for (k = j + 1; k < nvals; k++) {
-                    if (ia[k] == 1) continue;
-                    numaGetIValue(na, k, &index);
-                    ptaGetIPt(ptas, index, &xk, &yk);
-                    if (x == xk && y == yk)  /* duplicate */
-                        ia[k] = 1;
-                }
-            }
-            FREE(ia);
-        }
-        else {
-            numaGetIValue(na, 0, &index);
-            ptaGetIPt(ptas, index, &x, &y);
+        key = ((l_uint64)(l_uint32)x << 32) | (l_uint64)(l_uint32)y;
+        item = l_hmapLookup(hmap, key, L_HMAP_CREATE);
+        if (item && item->count == 1)  /* first occurrence */
             ptaAddPt(ptad, x, y);
-        }
-        numaDestroy(&na);  /* the clone */
     }
 
-    numaHashDestroy(&nahash);
+    l_hmapDestroy(&hmap);
     return ptad;
 }
 
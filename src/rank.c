@@ -103,21 +103,46 @@
  *        pixel, the average number of bins summed over, both in the
  *        coarse and fine histograms, is thus 16.
  *
- *  If someone has a better method, please let me know!
+ *  Updating the two histograms as the filter moves still requires
+ *  adding and removing a full side of the filter at each pixel, so
+ *  the cost is proportional to the filter width or height.  This is
+ *  removed by the method of Perreault and Hebert (IEEE Trans. Image
+ *  Processing 16(9), 2007):
+ *
+ *      * Keep a histogram for each column of the image, over the hf
+ *        rows of the filter.  When the filter moves down by a row,
+ *        each column histogram has one pixel removed and one added.
+ *
+ *      * The filter histogram is the sum of wf column histograms.
+ *        When the filter moves to the right, one column histogram
+ *        is added and another subtracted.  This is O(1) per pixel,
+ *        independent of the filter size.
+ *
+ *      * Do this with both the coarse and fine histograms.  The coarse
+ *        (16 bin) filter histogram is always kept current, but each
+ *        16 bin segment of the fine histogram is only brought up to
+ *        date when the rank value falls in it.  For typical images,
+ *        only a few segments are ever used on a row.
+ *
+ *  For rgb, the three components are filtered together, in a single
+ *  traversal of the image.
  *
  *  The rank filtering operation is relatively expensive, compared to most
- *  of the other imaging operations.  The speed is only weakly dependent
- *  on the size of the rank filter.  On standard hardware, it runs at
- *  about 10 Mpix/sec for a 50 x 50 filter, and 25 Mpix/sec for
- *  a 5 x 5 filter.   For applications where the rank filter can be
- *  performed on a downscaled image, significant speedup can be
- *  achieved because the time goes as the square of the scaling factor.
- *  We provide an interface that handles the details, and only
+ *  of the other imaging operations.  The speed is nearly independent
+ *  of the size of the rank filter.  For applications where the rank
+ *  filter can be performed on a downscaled image, significant speedup
+ *  can be achieved because the time goes as the square of the scaling
+ *  factor.  We provide an interface that handles the details, and only
  *  requires the amount of downscaling to be input.
  */
 
 #include "allheaders.h"
 
+static l_int32 rankFilterLow(PIX *pixt, PIX *pixd, l_int32 wf, l_int32 hf,
+                             l_int32 rankloc, l_int32 nc);
+static void rankSegmentUpdate(l_int32 *hseg, l_uint16 *colf, l_int32 jold,
+                              l_int32 jnew, l_int32 wf, l_int32 stride);
+
 /*----------------------------------------------------------------------*
  *                           Rank order filter                          *
  *----------------------------------------------------------------------*/
@@ -186,7 +211,10 @@ l_int32  d;
  *          order, we choose the component such that rank*(wf*hf-1)
  *          pixels have a lower or equal value and
  *          (1-rank)*(wf*hf-1) pixels have an equal or greater value.
- *      (2) Apply gray rank filtering to each component independently.
+ *      (2) Gray rank filtering is applied to each component
+ *          independently.  The three components are filtered in a
+ *          single pass over the image, without splitting it into
+ *          three 8 bpp images.
  *      (3) See notes in pixRankFilterGray() for further details.
  */
 PIX  *
@@ -195,7 +223,8 @@ pixRankFilterRGB(PIX       *pixs,
                  l_int32    hf,
                  l_float32  rank)
 {
-PIX  *pixr, *pixg, *pixb, *pixrf, *pixgf, *pixbf, *pixd;
+l_int32  rankloc;
+PIX     *pixr, *pixg, *pixb, *pixrf, *pixgf, *pixbf, *pixt, *pixd;
 
     PROCNAME("pixRankFilterRGB");
 
@@ -210,21 +239,37 @@ PIX  *pixr, *pixg, *pixb, *pixrf, *pixgf, *pixbf, *pixd;
     if (wf == 1 && hf == 1)   /* no-op */
         return pixCopy(NULL, pixs);
 
-    pixr = pixGetRGBComponent(pixs, COLOR_RED);
-    pixg = pixGetRGBComponent(pixs, COLOR_GREEN);
-    pixb = pixGetRGBComponent(pixs, COLOR_BLUE);
-
-    pixrf = pixRankFilterGray(pixr, wf, hf, rank);
-    pixgf = pixRankFilterGray(pixg, wf, hf, rank);
-    pixbf = pixRankFilterGray(pixb, wf, hf, rank);
-
-    pixd = pixCreateRGBImage(pixrf, pixgf, pixbf);
-    pixDestroy(&pixr);
-    pixDestroy(&pixg);
-    pixDestroy(&pixb);
-    pixDestroy(&pixrf);
-    pixDestroy(&pixgf);
-    pixDestroy(&pixbf);
+        /* For erosion and dilation, use grayscale morphology on
+         * each component; see pixRankFilterGray() */
+    if ((wf % 2 && hf % 2) && (rank == 0.0 || rank == 1.0)) {
+        pixr = pixGetRGBComponent(pixs, COLOR_RED);
+        pixg = pixGetRGBComponent(pixs, COLOR_GREEN);
+        pixb = pixGetRGBComponent(pixs, COLOR_BLUE);
+        pixrf = pixRankFilterGray(pixr, wf, hf, rank);
+        pixgf = pixRankFilterGray(pixg, wf, hf, rank);
+        pixbf = pixRankFilterGray(pixb, wf, hf, rank);
+        pixd = pixCreateRGBImage(pixrf, pixgf, pixbf);
+        pixDestroy(&pixr);
+        pixDestroy(&pixg);
+        pixDestroy(&pixb);
+        pixDestroy(&pixrf);
+        pixDestroy(&pixgf);
+        pixDestroy(&pixbf);
+        return pixd;
+    }
+    if (rank == 0.0) rank = 0.0001;
+    if (rank == 1.0) rank = 0.9999;
+    rankloc = (l_int32)(rank * wf * hf);
+
+    if ((pixt = pixAddMirroredBorder(pixs, wf / 2, wf / 2, hf / 2, hf / 2))
+        == NULL)
+        return (PIX *)ERROR_PTR("pixt not made", procName, NULL);
+    pixd = pixCreateTemplate(pixs);
+    if (rankFilterLow(pixt, pixd, wf, hf, rankloc, 3))
+        pixDestroy(&pixd);
+    pixDestroy(&pixt);
+    if (!pixd)
+        return (PIX *)ERROR_PTR("pixd not made", procName, NULL);
     return pixd;
 }
 
@@ -252,8 +297,9 @@ PIX  *pixr, *pixg, *pixb, *pixrf, *pixgf, *pixbf, *pixd;
  *      (4) This dispatches to grayscale erosion or dilation if the
  *          filter dimensions are odd and the rank is 0.0 or 1.0, rsp.
  *      (5) Returns a copy if both wf and hf are 1.
- *      (6) Uses row-major or column-major incremental updates to the
- *          histograms depending on whether hf > wf or hv <= wf, rsp.
+ *      (6) The time per pixel is nearly independent of the filter
+ *          size; see rankFilterLow() and the discussion at the top
+ *          of this file.
  */
 PIX  *
 pixRankFilterGray(PIX       *pixs,
@@ -261,10 +307,8 @@ pixRankFilterGray(PIX       *pixs,
                   l_int32    hf,
                   l_float32  rank)
 {
-l_int32    w, h, d, i, j, k, m, n, rankloc, wplt, wpld, val, sum;
-l_int32   *histo, *histo16;
-l_uint32  *datat, *linet, *datad, *lined;
-PIX       *pixt, *pixd;
+l_int32  w, h, d, rankloc;
+PIX     *pixt, *pixd;
 
     PROCNAME("pixRankFilterGray");
 
@@ -304,134 +348,231 @@ PIX       *pixt, *pixd;
         == NULL)
         return (PIX *)ERROR_PTR("pixt not made", procName, NULL);
 
-        /* Set up the two histogram arrays. */
-    histo = (l_int32 *)CALLOC(256, sizeof(l_int32));
-    histo16 = (l_int32 *)CALLOC(16, sizeof(l_int32));
     rankloc = (l_int32)(rank * wf * hf);
-
-        /* Place the filter center at (0, 0).  This is just a
-         * convenient location, because it allows us to perform
-         * the rank filter over x:(0 ... w - 1) and y:(0 ... h - 1). */
     pixd = pixCreateTemplate(pixs);
+    if (rankFilterLow(pixt, pixd, wf, hf, rankloc, 1))
+        pixDestroy(&pixd);
+    pixDestroy(&pixt);
+    if (!pixd)
+        return (PIX *)ERROR_PTR("pixd not made", procName, NULL);
+    return pixd;
+}
+
+
+/*!
+ *  rankFilterLow()
+ *
+ *      Input:  pixt (8 or 32 bpp src, with a mirrored border of wf/2
+ *                    on the left and right, and hf/2 on top and bottom)
+ *              pixd (8 or 32 bpp dest, of the size without border)
+ *              wf, hf  (width and height of filter)
+ *              rankloc (the rank value is the smallest value for which
+ *                       more than rankloc pixels are less or equal;
+ *                       0 <= rankloc < wf * hf)
+ *              nc (number of components: 1 for 8 bpp, 3 for rgb)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) For each row of pixd, there is a coarse (16 bin) and fine
+ *          (256 bin) histogram for every column of pixt, over the
+ *          hf rows of the filter, and for each component.
+ *          The bins for the components of a column are adjacent.
+ *      (2) The coarse filter histogram is updated as the filter moves
+ *          right, by adding the column entering on the right and
+ *          subtracting the column leaving on the left.
+ *      (3) Each 16 bin segment of the fine filter histogram is updated
+ *          only when it is needed.  @stamp holds the filter position
+ *          at which it was last made current.  It is then updated
+ *          either incrementally, or from scratch if that is cheaper.
+ */
+static l_int32
+rankFilterLow(PIX     *pixt,
+              PIX     *pixd,
+              l_int32  wf,
+              l_int32  hf,
+              l_int32  rankloc,
+              l_int32  nc)
+{
+l_int32    i, j, k, m, n, c, w, h, nx, wplt, wpld, val, sum;
+l_int32    shift[3], histc[3][16], histf[3][256], stamp[3][16], rankval[3];
+l_int32   *hc;
+l_uint16  *colc, *colf, *pc, *pf;
+l_uint32   pixel;
+l_uint32  *datat, *datad, *linet, *lineo, *lined;
+
+    PROCNAME("rankFilterLow");
+
+    pixGetDimensions(pixd, &w, &h, NULL);
+    nx = w + wf - 1;  /* number of column histograms used */
+    colc = (l_uint16 *)CALLOC(nx * nc * 16, sizeof(l_uint16));
+    colf = (l_uint16 *)CALLOC(nx * nc * 256, sizeof(l_uint16));
+    if (!colc || !colf) {
+        FREE(colc);
+        FREE(colf);
+        return ERROR_INT("column histograms not made", procName, 1);
+    }
+    shift[0] = (nc == 1) ? 0 : L_RED_SHIFT;
+    shift[1] = L_GREEN_SHIFT;
+    shift[2] = L_BLUE_SHIFT;
+
     datat = pixGetData(pixt);
     wplt = pixGetWpl(pixt);
     datad = pixGetData(pixd);
     wpld = pixGetWpl(pixd);
-
-        /* If hf > wf, it's more efficient to use row-major scanning.
-         * Otherwise, traverse the image in use column-major order.  */
-    if (hf > wf) {
-        for (j = 0; j < w; j++) {  /* row-major */
-                /* Start each column with clean histogram arrays. */
-            for (n = 0; n < 256; n++)
-                histo[n] = 0;
-            for (n = 0; n < 16; n++)
-                histo16[n] = 0;
-
-            for (i = 0; i < h; i++) {  /* fast scan on columns */
-                    /* Update the histos for the new location */
-                lined = datad + i * wpld;
-                if (i == 0) {  /* do full histo */
-                    for (k = 0; k < hf; k++) {
-                        linet = datat + (i + k) * wplt;
-                        for (m = 0; m < wf; m++) {
-                            val = GET_DATA_BYTE(linet, j + m);
-                            histo[val]++;
-                            histo16[val >> 4]++;
-                        }
-                    }
-                } else {  /* incremental update */
-                    linet = datat + (i - 1) * wplt;
-                    for (m = 0; m < wf; m++) {  /* remove top line */
-                        val = GET_DATA_BYTE(linet, j + m);
-                        histo[val]--;
-                        histo16[val >> 4]--;
-                    }
-                    linet = datat + (i + hf -  1) * wplt;
-                    for (m = 0; m < wf; m++) {  /* add bottom line */
-                        val = GET_DATA_BYTE(linet, j + m);
-                        histo[val]++;
-                        histo16[val >> 4]++;
+    for (i = 0; i < h; i++) {
+            /* Update the column histograms for this row: add the
+             * bottom row of the filter, and remove the one above the
+             * top.  For the first row, add all hf rows. */
+        for (k = (i == 0) ? 0 : hf - 1; k < hf; k++) {
+            linet = datat + (i + k) * wplt;
+            lineo = (i == 0) ? NULL : datat + (i - 1) * wplt;
+            for (j = 0; j < nx; j++) {
+                pc = colc + j * nc * 16;
+                pf = colf + j * nc * 256;
+                for (c = 0; c < nc; c++, pc += 16, pf += 256) {
+                    if (nc == 1)
+                        val = GET_DATA_BYTE(linet, j);
+                    else
+                        val = (linet[j] >> shift[c]) & 0xff;
+                    pc[val >> 4]++;
+                    pf[val]++;
+                    if (lineo) {
+                        if (nc == 1)
+                            val = GET_DATA_BYTE(lineo, j);
+                        else
+                            val = (lineo[j] >> shift[c]) & 0xff;
+                        pc[val >> 4]--;
+                        pf[val]--;
                     }
                 }
+            }
+        }
 
-                    /* Find the rank value */
-                sum = 0;
-                for (n = 0; n < 16; n++) {  /* search over coarse histo */
-                    sum += histo16[n];
-                    if (sum > rankloc) {
-                        sum -= histo16[n];
-                        break;
-                    }
-                }
-                k = 16 * n;  /* starting value in fine histo */
-                for (m = 0; m < 16; m++) {
-                    sum += histo[k];
-                    if (sum > rankloc) {
-                        SET_DATA_BYTE(lined, j, k);
-                        break;
-                    }
-                    k++;
-                }
+            /* Initialize the coarse filter histograms at the left side;
+             * all segments of the fine histograms are out of date */
+        for (c = 0; c < nc; c++) {
+            for (n = 0; n < 16; n++) {
+                histc[c][n] = 0;
+                stamp[c][n] = -wf;
             }
         }
-    } else {  /* wf >= hf */
-        for (i = 0; i < h; i++) {  /* column-major */
-                /* Start each row with clean histogram arrays. */
-            for (n = 0; n < 256; n++)
-                histo[n] = 0;
-            for (n = 0; n < 16; n++)
-                histo16[n] = 0;
-            lined = datad + i * wpld;
-            for (j = 0; j < w; j++) {  /* fast scan on rows */
-                    /* Update the histos for the new location */
-                if (j == 0) {  /* do full histo */
-                    for (k = 0; k < hf; k++) {
-                        linet = datat + (i + k) * wplt;
-                        for (m = 0; m < wf; m++) {
-                            val = GET_DATA_BYTE(linet, j + m);
-                            histo[val]++;
-                            histo16[val >> 4]++;
-                        }
-                    }
-                } else {  /* incremental update at left and right sides */
-                    for (k = 0; k < hf; k++) {
-                        linet = datat + (i + k) * wplt;
-                        val = GET_DATA_BYTE(linet, j - 1);
-                        histo[val]--;
-                        histo16[val >> 4]--;
-                        val = GET_DATA_BYTE(linet, j + wf - 1);
-                        histo[val]++;
-                        histo16[val >> 4]++;
-                    }
+        for (j = 0; j < wf; j++) {
+            pc = colc + j * nc * 16;
+            for (c = 0; c < nc; c++, pc += 16) {
+                for (n = 0; n < 16; n++)
+                    histc[c][n] += pc[n];
+            }
+        }
+
+        lined = datad + i * wpld;
+        for (j = 0; j < w; j++) {
+            if (j > 0) {  /* move the filter one pixel to the right */
+                pc = colc + (j + wf - 1) * nc * 16;
+                pf = colc + (j - 1) * nc * 16;  /* leaving on the left */
+                for (c = 0; c < nc; c++, pc += 16, pf += 16) {
+                    hc = histc[c];
+                    for (n = 0; n < 16; n++)
+                        hc[n] += pc[n] - pf[n];
                 }
+            }
 
-                    /* Find the rank value */
+            for (c = 0; c < nc; c++) {
+                    /* Search over the coarse histogram.  The bins hold
+                     * all wf * hf pixels of the filter, and the callers
+                     * clip rank below 1.0, so rankloc < wf * hf and the
+                     * search always stops at a bin n < 16. */
+                hc = histc[c];
                 sum = 0;
-                for (n = 0; n < 16; n++) {  /* search over coarse histo */
-                    sum += histo16[n];
+                for (n = 0; n < 16; n++) {
+                    sum += hc[n];
                     if (sum > rankloc) {
-                        sum -= histo16[n];
+                        sum -= hc[n];
                         break;
                     }
                 }
-                k = 16 * n;  /* starting value in fine histo */
-                for (m = 0; m < 16; m++) {
-                    sum += histo[k];
-                    if (sum > rankloc) {
-                        SET_DATA_BYTE(lined, j, k);
+
+                    /* Make this segment of the fine histogram current */
+                if (stamp[c][n] != j) {
+                    rankSegmentUpdate(histf[c] + 16 * n,
+                                      colf + c * 256 + 16 * n,
+                                      stamp[c][n], j, wf, nc * 256);
+                    stamp[c][n] = j;
+                }
+
+                    /* Search over the segment of the fine histogram */
+                k = 16 * n;
+                for (m = 0; m < 15; m++, k++) {
+                    sum += histf[c][k];
+                    if (sum > rankloc)
                         break;
-                    }
-                    k++;
                 }
+                rankval[c] = k;
+            }
+
+            if (nc == 1) {
+                SET_DATA_BYTE(lined, j, rankval[0]);
+            }
+            else {
+                composeRGBPixel(rankval[0], rankval[1], rankval[2], &pixel);
+                lined[j] = pixel;
             }
         }
     }
 
-    pixDestroy(&pixt);
-    FREE(histo);
-    FREE(histo16);
-    return pixd;
+    FREE(colc);
+    FREE(colf);
+    return 0;
+}
+
+
+/*!
+ *  rankSegmentUpdate()
+ *
+ *      Input:  hseg (segment of 16 bins in the fine filter histogram)
+ *              colf (corresponding segment in the fine histogram
+ *                    of column 0)
+ *              jold (filter position where hseg was last current;
+ *                    jold <= jnew - wf if it was never made current)
+ *              jnew (current filter position)
+ *              wf (filter width)
+ *              stride (between column histograms in colf)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) If the filter has moved by fewer than wf/2 pixels since
+ *          the segment was current, the columns that entered and left
+ *          are added and subtracted.  Otherwise, the segment is
+ *          summed from scratch over the wf columns in the filter.
+ */
+static void
+rankSegmentUpdate(l_int32   *hseg,
+                  l_uint16  *colf,
+                  l_int32    jold,
+                  l_int32    jnew,
+                  l_int32    wf,
+                  l_int32    stride)
+{
+l_int32    j, n;
+l_uint16  *pa, *ps;
+
+    if (2 * (jnew - jold) < wf) {
+        for (j = jold + 1; j <= jnew; j++) {
+            pa = colf + (j + wf - 1) * stride;
+            ps = colf + (j - 1) * stride;
+            for (n = 0; n < 16; n++)
+                hseg[n] += pa[n] - ps[n];
+        }
+    }
+    else {
+        for (n = 0; n < 16; n++)
+            hseg[n] = 0;
+        for (j = jnew; j < jnew + wf; j++) {
+            pa = colf + j * stride;
+            for (n = 0; n < 16; n++)
+                hseg[n] += pa[n];
+        }
+    }
+    return;
 }
 
 
@@ -0,0 +1,1170 @@
+/*====================================================================*
+ -  Copyright (C) 2001 Leptonica.  All rights reserved.
+ -
+ -  Redistribution and use in source and binary forms, with or without
+ -  modification, are permitted provided that the following conditions
+ -  are met:
+ -  1. Redistributions of source code must retain the above copyright
+ -     notice, this list of conditions and the following disclaimer.
+ -  2. Redistributions in binary form must reproduce the above
+ -     copyright notice, this list of conditions and the following
+ -     disclaimer in the documentation and/or other materials
+ -     provided with the distribution.
+ -
+ -  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ -  ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ -  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ -  A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL ANY
+ -  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ -  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ -  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ -  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ -  OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ -  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ -  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *====================================================================*/
+
+/*
+ *  rle.c
+ *
+ *    Run-length encoded binary images
+ *
+ *      Create/destroy/copy
+ *           L_RLE     *rleCreate()
+ *           void       rleDestroy()
+ *           L_RLE     *rleCopy()
+ *
+ *      Accessors
+ *           l_int32    rleGetDimensions()
+ *           l_int32    rleGetCount()
+ *
+ *      Conversion to and from pix
+ *           L_RLE     *rleCreateFromPix()
+ *           PIX       *pixCreateFromRle()
+ *
+ *      Pixel counting
+ *           l_int32    rleCountPixels()
+ *
+ *      Logical operations
+ *           L_RLE     *rleInvert()
+ *           L_RLE     *rleLogicalOp()
+ *
+ *      Brick morphology
+ *           L_RLE     *rleDilateBrick()
+ *           L_RLE     *rleErodeBrick()
+ *           L_RLE     *rleOpenBrick()
+ *           L_RLE     *rleCloseBrick()
+ *
+ *      Connected components
+ *           L_CCSTATS *rleConnComp()
+ *
+ *      Static helpers
+ *           static l_int32  rleAddRun()
+ *           static l_int32  rleRowUnion()
+ *           static l_int32  rleRowIntersect()
+ *           static l_int32  rleRowSubtract()
+ *           static l_int32  rleRowXor()
+ *           static L_RLE   *rleDilateHoriz(), rleDilateVert()
+ *           static L_RLE   *rleErodeHoriz(), rleErodeVert()
+ *
+ *  An L_RLE holds the fg pixels of a binary image as a list of runs.
+ *  The runs on each line are in order, and are maximal: no two runs
+ *  on a line overlap or touch.  The runs on line i have indices
+ *  from rowstart[i] to rowstart[i + 1] - 1.
+ *
+ *  Scanned text pages are mostly white, so the number of runs is
+ *  typically a few percent of the number of 32-bit words in the
+ *  image.  All the operations here work directly on the runs, taking
+ *  time and memory proportional to the number of runs rather than to
+ *  the image area.  The exception is the vertical part of brick
+ *  dilation and erosion, where each line is made from vsize source
+ *  lines, so the time is proportional to vsize times the number of
+ *  runs.  The results are identical to those of the
+ *  corresponding operations on pix:
+ *      rleLogicalOp()          pixOr(), pixAnd(), pixSubtract(), pixXor()
+ *      rleDilateBrick(), etc.  pixDilateBrick(), etc., including the
+ *                              boundary condition set by MORPH_BC
+ *      rleCountPixels()        pixCountPixels()
+ *      rleConnComp()           pixConnCompLabel()
+ */
+
+#include <string.h>
+#include "allheaders.h"
+
+    /* MORPH_BC is set in morph.c */
+extern l_int32  MORPH_BC;
+
+static l_int32 rleAddRun(L_RLE *rle, l_int32 y, l_int32 xs, l_int32 xe);
+static l_int32 rleRowUnion(L_RLE *rled, l_int32 y, l_int32 *xs1,
+                           l_int32 *xe1, l_int32 n1, l_int32 *xs2,
+                           l_int32 *xe2, l_int32 n2);
+static l_int32 rleRowIntersect(L_RLE *rled, l_int32 y, l_int32 *xs1,
+                               l_int32 *xe1, l_int32 n1, l_int32 *xs2,
+                               l_int32 *xe2, l_int32 n2);
+static l_int32 rleRowSubtract(L_RLE *rled, l_int32 y, l_int32 *xs1,
+                              l_int32 *xe1, l_int32 n1, l_int32 *xs2,
+                              l_int32 *xe2, l_int32 n2);
+static l_int32 rleRowXor(L_RLE *rled, l_int32 y, l_int32 *xs1,
+                         l_int32 *xe1, l_int32 n1, l_int32 *xs2,
+                         l_int32 *xe2, l_int32 n2);
+static L_RLE *rleDilateHoriz(L_RLE *rles, l_int32 size);
+static L_RLE *rleDilateVert(L_RLE *rles, l_int32 size);
+static L_RLE *rleErodeHoriz(L_RLE *rles, l_int32 size);
+static L_RLE *rleErodeVert(L_RLE *rles, l_int32 size);
+
+static const l_int32  INITIAL_PTR_ARRAYSIZE = 1000;
+
+
+/*---------------------------------------------------------------------*
+ *                         Create/destroy/copy                         *
+ *---------------------------------------------------------------------*/
+/*!
+ *  rleCreate()
+ *
+ *      Input:  w, h (image size)
+ *              nalloc (initial number of runs allocated; 0 for default)
+ *      Return: rle (with no runs), or null on error
+ */
+L_RLE *
+rleCreate(l_int32  w,
+          l_int32  h,
+          l_int32  nalloc)
+{
+L_RLE  *rle;
+
+    PROCNAME("rleCreate");
+
+    if (w <= 0 || h <= 0)
+        return (L_RLE *)ERROR_PTR("w and h must be > 0", procName, NULL);
+    if (nalloc <= 0)
+        nalloc = INITIAL_PTR_ARRAYSIZE;
+
+    if ((rle = (L_RLE *)CALLOC(1, sizeof(L_RLE))) == NULL)
+        return (L_RLE *)ERROR_PTR("rle not made", procName, NULL);
+    rle->w = w;
+    rle->h = h;
+    rle->nalloc = nalloc;
+    rle->rowstart = (l_int32 *)CALLOC(h + 1, sizeof(l_int32));
+    rle->xs = (l_int32 *)CALLOC(nalloc, sizeof(l_int32));
+    rle->xe = (l_int32 *)CALLOC(nalloc, sizeof(l_int32));
+    if (!rle->rowstart || !rle->xs || !rle->xe) {
+        rleDestroy(&rle);
+        return (L_RLE *)ERROR_PTR("rle arrays not made", procName, NULL);
+    }
+    return rle;
+}
+
+
+/*!
+ *  rleDestroy()
+ *
+ *      Input:  &rle (<to be nulled>)
+ *      Return: void
+ */
+void
+rleDestroy(L_RLE  **prle)
+{
+L_RLE  *rle;
+
+    PROCNAME("rleDestroy");
+
+    if (prle == NULL) {
+        L_WARNING("ptr address is null!", procName);
+        return;
+    }
+    if ((rle = *prle) == NULL)
+        return;
+
+    FREE(rle->rowstart);
+    FREE(rle->xs);
+    FREE(rle->xe);
+    FREE(rle);
+    *prle = NULL;
+    return;
+}
+
+
+/*!
+ *  rleCopy()
+ *
+ *      Input:  rles
+ *      Return: rled, or null on error
+ */
+L_RLE *
+rleCopy(L_RLE  *rles)
+{
+l_int32  i;
+L_RLE   *rled;
+
+    PROCNAME("rleCopy");
+
+    if (!rles)
+        return (L_RLE *)ERROR_PTR("rles not defined", procName, NULL);
+
+    if ((rled = rleCreate(rles->w, rles->h, L_MAX(1, rles->n))) == NULL)
+        return (L_RLE *)ERROR_PTR("rled not made", procName, NULL);
+    for (i = 0; i <= rles->h; i++)
+        rled->rowstart[i] = rles->rowstart[i];
+    for (i = 0; i < rles->n; i++) {
+        rled->xs[i] = rles->xs[i];
+        rled->xe[i] = rles->xe[i];
+    }
+    rled->n = rles->n;
+    return rled;
+}
+
+
+/*---------------------------------------------------------------------*
+ *                              Accessors                              *
+ *---------------------------------------------------------------------*/
+/*!
+ *  rleGetDimensions()
+ *
+ *      Input:  rle
+ *              &w, &h (<optional return> image size)
+ *      Return: 0 if OK, 1 on error
+ */
+l_int32
+rleGetDimensions(L_RLE    *rle,
+                 l_int32  *pw,
+                 l_int32  *ph)
+{
+    PROCNAME("rleGetDimensions");
+
+    if (pw) *pw = 0;
+    if (ph) *ph = 0;
+    if (!rle)
+        return ERROR_INT("rle not defined", procName, 1);
+    if (pw) *pw = rle->w;
+    if (ph) *ph = rle->h;
+    return 0;
+}
+
+
+/*!
+ *  rleGetCount()
+ *
+ *      Input:  rle
+ *      Return: number of runs, or 0 on error
+ */
+l_int32
+rleGetCount(L_RLE  *rle)
+{
+    PROCNAME("rleGetCount");
+
+    if (!rle)
+        return ERROR_INT("rle not defined", procName, 0);
+    return rle->n;
+}
+
+
+/*---------------------------------------------------------------------*
+ *                     Conversion to and from pix                      *
+ *---------------------------------------------------------------------*/
+/*!
+ *  rleCreateFromPix()
+ *
+ *      Input:  pixs (1 bpp)
+ *      Return: rle, or null on error
+ *
+ *  Notes:
+ *      (1) Words of the image that are all 0 or all 1 are skipped
+ *          over in one step.
+ */
+L_RLE *
+rleCreateFromPix(PIX  *pixs)
+{
+l_int32    i, j, w, h, wpls, xs;
+l_uint32  *datas, *lines;
+L_RLE     *rle;
+
+    PROCNAME("rleCreateFromPix");
+
+    if (!pixs || pixGetDepth(pixs) != 1)
+        return (L_RLE *)ERROR_PTR("pixs undefined or not 1 bpp",
+                                  procName, NULL);
+
+    pixGetDimensions(pixs, &w, &h, NULL);
+    if ((rle = rleCreate(w, h, 0)) == NULL)
+        return (L_RLE *)ERROR_PTR("rle not made", procName, NULL);
+    datas = pixGetData(pixs);
+    wpls = pixGetWpl(pixs);
+    for (i = 0; i < h; i++) {
+        lines = datas + i * wpls;
+        j = 0;
+        while (j < w) {
+            if ((j & 31) == 0 && lines[j >> 5] == 0) {  /* skip empty word */
+                j += 32;
+                continue;
+            }
+            if (!GET_DATA_BIT(lines, j)) {
+                j++;
+                continue;
+            }
+            xs = j;
+            while (j < w && GET_DATA_BIT(lines, j)) {
+                if ((j & 31) == 0 && j + 32 <= w && lines[j >> 5] == 0xffffffff)
+                    j += 32;
+                else
+                    j++;
+            }
+            if (rleAddRun(rle, i, xs, j - 1)) {
+                rleDestroy(&rle);
+                return (L_RLE *)ERROR_PTR("run not added", procName, NULL);
+            }
+        }
+        rle->rowstart[i + 1] = rle->n;
+    }
+
+    return rle;
+}
+
+
+/*!
+ *  pixCreateFromRle()
+ *
+ *      Input:  rle
+ *      Return: pixd (1 bpp), or null on error
+ *
+ *  Notes:
+ *      (1) Each run is written with masks on the end words and
+ *          full word stores in between.
+ */
+PIX *
+pixCreateFromRle(L_RLE  *rle)
+{
+l_int32    i, k, m, wpld, ws, we;
+l_uint32   masks, maske;
+l_uint32  *datad, *lined;
+PIX       *pixd;
+
+    PROCNAME("pixCreateFromRle");
+
+    if (!rle)
+        return (PIX *)ERROR_PTR("rle not defined", procName, NULL);
+
+    if ((pixd = pixCreate(rle->w, rle->h, 1)) == NULL)
+        return (PIX *)ERROR_PTR("pixd not made", procName, NULL);
+    datad = pixGetData(pixd);
+    wpld = pixGetWpl(pixd);
+    for (i = 0; i < rle->h; i++) {
+        lined = datad + i * wpld;
+        for (k = rle->rowstart[i]; k < rle->rowstart[i + 1]; k++) {
+            ws = rle->xs[k] >> 5;
+            we = rle->xe[k] >> 5;
+            masks = 0xffffffff >> (rle->xs[k] & 31);
+            maske = 0xffffffff << (31 - (rle->xe[k] & 31));
+            if (ws == we) {
+                lined[ws] |= masks & maske;
+                continue;
+            }
+            lined[ws] |= masks;
+            for (m = ws + 1; m < we; m++)
+                lined[m] = 0xffffffff;
+            lined[we] |= maske;
+        }
+    }
+
+    return pixd;
+}
+
+
+/*---------------------------------------------------------------------*
+ *                           Pixel counting                            *
+ *---------------------------------------------------------------------*/
+/*!
+ *  rleCountPixels()
+ *
+ *      Input:  rle
+ *              &count (<return> number of fg pixels)
+ *      Return: 0 if OK, 1 on error
+ */
+l_int32
+rleCountPixels(L_RLE    *rle,
+               l_int32  *pcount)
+{
+l_int32  i, sum;
+
+    PROCNAME("rleCountPixels");
+
+    if (!pcount)
+        return ERROR_INT("&count not defined", procName, 1);
+    *pcount = 0;
+    if (!rle)
+        return ERROR_INT("rle not defined", procName, 1);
+
+    sum = rle->n;
+    for (i = 0; i < rle->n; i++)
+        sum += rle->xe[i] - rle->xs[i];
+    *pcount = sum;
+    return 0;
+}
+
+
+/*---------------------------------------------------------------------*
+ *                         Logical operations                          *
+ *---------------------------------------------------------------------*/
+/*!
+ *  rleInvert()
+ *
+ *      Input:  rles
+ *      Return: rled (with fg and bg exchanged), or null on error
+ */
+L_RLE *
+rleInvert(L_RLE  *rles)
+{
+l_int32  i, k, x, ret;
+L_RLE   *rled;
+
+    PROCNAME("rleInvert");
+
+    if (!rles)
+        return (L_RLE *)ERROR_PTR("rles not defined", procName, NULL);
+
+    if ((rled = rleCreate(rles->w, rles->h, rles->n + rles->h)) == NULL)
+        return (L_RLE *)ERROR_PTR("rled not made", procName, NULL);
+    ret = 0;
+    for (i = 0; i < rles->h; i++) {
+        x = 0;
+        for (k = rles->rowstart[i]; k < rles->rowstart[i + 1]; k++) {
+            if (rles->xs[k] > x)
+                ret |= rleAddRun(rled, i, x, rles->xs[k] - 1);
+            x = rles->xe[k] + 1;
+        }
+        if (x < rles->w)
+            ret |= rleAddRun(rled, i, x, rles->w - 1);
+        if (ret) {
+            rleDestroy(&rled);
+            return (L_RLE *)ERROR_PTR("runs not added", procName, NULL);
+        }
+        rled->rowstart[i + 1] = rled->n;
+    }
+
+    return rled;
+}
+
+
+/*!
+ *  rleLogicalOp()
+ *
+ *      Input:  rle1, rle2 (same size)
+ *              op (L_UNION, L_INTERSECTION, L_SUBTRACTION, L_EXCLUSIVE_OR)
+ *      Return: rled, or null on error
+ *
+ *  Notes:
+ *      (1) L_SUBTRACTION gives the fg pixels of rle1 that are not in rle2.
+ *      (2) Each line is done with a single merge of the two run lists.
+ */
+L_RLE *
+rleLogicalOp(L_RLE   *rle1,
+             L_RLE   *rle2,
+             l_int32  op)
+{
+l_int32   i, s1, n1, s2, n2, ret;
+L_RLE    *rled;
+
+    PROCNAME("rleLogicalOp");
+
+    if (!rle1 || !rle2)
+        return (L_RLE *)ERROR_PTR("rle1 and rle2 not both defined",
+                                  procName, NULL);
+    if (rle1->w != rle2->w || rle1->h != rle2->h)
+        return (L_RLE *)ERROR_PTR("rle sizes differ", procName, NULL);
+    if (op != L_UNION && op != L_INTERSECTION && op != L_SUBTRACTION &&
+        op != L_EXCLUSIVE_OR)
+        return (L_RLE *)ERROR_PTR("invalid op", procName, NULL);
+
+    if ((rled = rleCreate(rle1->w, rle1->h, rle1->n + rle2->n + 1)) == NULL)
+        return (L_RLE *)ERROR_PTR("rled not made", procName, NULL);
+    for (i = 0; i < rle1->h; i++) {
+        s1 = rle1->rowstart[i];
+        n1 = rle1->rowstart[i + 1] - s1;
+        s2 = rle2->rowstart[i];
+        n2 = rle2->rowstart[i + 1] - s2;
+        if (op == L_UNION)
+            ret = rleRowUnion(rled, i, rle1->xs + s1, rle1->xe + s1, n1,
+                              rle2->xs + s2, rle2->xe + s2, n2);
+        else if (op == L_INTERSECTION)
+            ret = rleRowIntersect(rled, i, rle1->xs + s1, rle1->xe + s1, n1,
+                                  rle2->xs + s2, rle2->xe + s2, n2);
+        else if (op == L_SUBTRACTION)
+            ret = rleRowSubtract(rled, i, rle1->xs + s1, rle1->xe + s1, n1,
+                                 rle2->xs + s2, rle2->xe + s2, n2);
+        else  /* L_EXCLUSIVE_OR */
+            ret = rleRowXor(rled, i, rle1->xs + s1, rle1->xe + s1, n1,
+                            rle2->xs + s2, rle2->xe + s2, n2);
+        if (ret) {
+            rleDestroy(&rled);
+            return (L_RLE *)ERROR_PTR("runs not added", procName, NULL);
+        }
+        rled->rowstart[i + 1] = rled->n;
+    }
+
+    return rled;
+}
+
+
+/*---------------------------------------------------------------------*
+ *                          Brick morphology                           *
+ *---------------------------------------------------------------------*/
+/*!
+ *  rleDilateBrick()
+ *
+ *      Input:  rles
+ *              hsize (width of brick Sel)
+ *              vsize (height of brick Sel)
+ *      Return: rled, or null on error
+ *
+ *  Notes:
+ *      (1) This gives the same result as pixDilateBrick(), with the
+ *          Sel origin at (hsize / 2, vsize / 2).
+ *      (2) The dilation is separable.  Horizontally, each run is
+ *          extended and merged with its neighbors.  Vertically,
+ *          each line is the union of vsize lines of the source,
+ *          so that part takes time proportional to vsize.
+ *      (3) If hsize = vsize = 1, returns a copy.
+ */
+L_RLE *
+rleDilateBrick(L_RLE   *rles,
+               l_int32  hsize,
+               l_int32  vsize)
+{
+L_RLE  *rlet, *rled;
+
+    PROCNAME("rleDilateBrick");
+
+    if (!rles)
+        return (L_RLE *)ERROR_PTR("rles not defined", procName, NULL);
+    if (hsize < 1 || vsize < 1)
+        return (L_RLE *)ERROR_PTR("hsize and vsize not >= 1", procName, NULL);
+
+    if (hsize == 1 && vsize == 1)
+        return rleCopy(rles);
+    if (vsize == 1)
+        return rleDilateHoriz(rles, hsize);
+    if (hsize == 1)
+        return rleDilateVert(rles, vsize);
+    if ((rlet = rleDilateHoriz(rles, hsize)) == NULL)
+        return (L_RLE *)ERROR_PTR("rlet not made", procName, NULL);
+    rled = rleDilateVert(rlet, vsize);
+    rleDestroy(&rlet);
+    return rled;
+}
+
+
+/*!
+ *  rleErodeBrick()
+ *
+ *      Input:  rles
+ *              hsize (width of brick Sel)
+ *              vsize (height of brick Sel)
+ *      Return: rled, or null on error
+ *
+ *  Notes:
+ *      (1) This gives the same result as pixErodeBrick(), with the
+ *          Sel origin at (hsize / 2, vsize / 2), for either setting
+ *          of MORPH_BC.
+ *      (2) Horizontally, each run is shortened at both ends.
+ *          Vertically, each line is the intersection of up to vsize
+ *          lines of the source, so that part takes time proportional
+ *          to vsize.
+ *      (3) If hsize = vsize = 1, returns a copy.
+ */
+L_RLE *
+rleErodeBrick(L_RLE   *rles,
+              l_int32  hsize,
+              l_int32  vsize)
+{
+L_RLE  *rlet, *rled;
+
+    PROCNAME("rleErodeBrick");
+
+    if (!rles)
+        return (L_RLE *)ERROR_PTR("rles not defined", procName, NULL);
+    if (hsize < 1 || vsize < 1)
+        return (L_RLE *)ERROR_PTR("hsize and vsize not >= 1", procName, NULL);
+
+    if (hsize == 1 && vsize == 1)
+        return rleCopy(rles);
+    if (vsize == 1)
+        return rleErodeHoriz(rles, hsize);
+    if (hsize == 1)
+        return rleErodeVert(rles, vsize);
+    if ((rlet = rleErodeHoriz(rles, hsize)) == NULL)
+        return (L_RLE *)ERROR_PTR("rlet not made", procName, NULL);
+    rled = rleErodeVert(rlet, vsize);
+    rleDestroy(&rlet);
+    return rled;
+}
+
+
+/*!
+ *  rleOpenBrick()
+ *
+ *      Input:  rles
+ *              hsize (width of brick Sel)
+ *              vsize (height of brick Sel)
+ *      Return: rled, or null on error
+ *
+ *  Notes:
+ *      (1) This is an erosion followed by a dilation, and gives
+ *          the same result as pixOpenBrick().
+ */
+L_RLE *
+rleOpenBrick(L_RLE   *rles,
+             l_int32  hsize,
+             l_int32  vsize)
+{
+L_RLE  *rlet, *rled;
+
+    PROCNAME("rleOpenBrick");
+
+    if (!rles)
+        return (L_RLE *)ERROR_PTR("rles not defined", procName, NULL);
+
+    if ((rlet = rleErodeBrick(rles, hsize, vsize)) == NULL)
+        return (L_RLE *)ERROR_PTR("rlet not made", procName, NULL);
+    rled = rleDilateBrick(rlet, hsize, vsize);
+    rleDestroy(&rlet);
+    return rled;
+}
+
+
+/*!
+ *  rleCloseBrick()
+ *
+ *      Input:  rles
+ *              hsize (width of brick Sel)
+ *              vsize (height of brick Sel)
+ *      Return: rled, or null on error
+ *
+ *  Notes:
+ *      (1) This is a dilation followed by an erosion, and gives
+ *          the same result as pixCloseBrick().
+ */
+L_RLE *
+rleCloseBrick(L_RLE   *rles,
+              l_int32  hsize,
+              l_int32  vsize)
+{
+L_RLE  *rlet, *rled;
+
+    PROCNAME("rleCloseBrick");
+
+    if (!rles)
+        return (L_RLE *)ERROR_PTR("rles not defined", procName, NULL);
+
+    if ((rlet = rleDilateBrick(rles, hsize, vsize)) == NULL)
+        return (L_RLE *)ERROR_PTR("rlet not made", procName, NULL);
+    rled = rleErodeBrick(rlet, hsize, vsize);
+    rleDestroy(&rlet);
+    return rled;
+}
+
+
+/*---------------------------------------------------------------------*
+ *                        Connected components                         *
+ *---------------------------------------------------------------------*/
+/*!
+ *  rleConnComp()
+ *
+ *      Input:  rles
+ *              connectivity (4 or 8)
+ *              filter (<optional> function to select the components
+ *                      to keep; use NULL to keep all)
+ *              data (<optional> passed to @filter)
+ *              &rled (<optional return> runs of the components kept)
+ *      Return: stats (of the components kept), or null on error
+ *
+ *  Notes:
+ *      (1) This finds the components directly from the runs.  See
+ *          pixConnCompLabel() for the statistics and the filter.
+ */
+L_CCSTATS *
+rleConnComp(L_RLE       *rles,
+            l_int32      connectivity,
+            L_CCFILTER   filter,
+            void        *data,
+            L_RLE      **prled)
+{
+l_int32     i, k;
+l_int32    *labels;
+L_CCSTATS  *stats;
+L_RLE      *rled;
+
+    PROCNAME("rleConnComp");
+
+    if (prled) *prled = NULL;
+    if (!rles)
+        return (L_CCSTATS *)ERROR_PTR("rles not defined", procName, NULL);
+    if (connectivity != 4 && connectivity != 8)
+        return (L_CCSTATS *)ERROR_PTR("connectivity not 4 or 8",
+                                      procName, NULL);
+
+    labels = NULL;
+    stats = ccstatsCreateFromRle(rles, connectivity, filter, data,
+                                 (prled) ? &labels : NULL);
+    if (!stats)
+        return (L_CCSTATS *)ERROR_PTR("stats not made", procName, NULL);
+    if (!prled)
+        return stats;
+
+    if ((rled = rleCreate(rles->w, rles->h, L_MAX(1, rles->n))) == NULL) {
+        FREE(labels);
+        ccstatsDestroy(&stats);
+        return (L_CCSTATS *)ERROR_PTR("rled not made", procName, NULL);
+    }
+    for (i = 0; i < rles->h; i++) {
+        for (k = rles->rowstart[i]; k < rles->rowstart[i + 1]; k++) {
+            if (labels[k] != 0 &&
+                rleAddRun(rled, i, rles->xs[k], rles->xe[k])) {
+                FREE(labels);
+                ccstatsDestroy(&stats);
+                rleDestroy(&rled);
+                return (L_CCSTATS *)ERROR_PTR("run not added", procName, NULL);
+            }
+        }
+        rled->rowstart[i + 1] = rled->n;
+    }
+    FREE(labels);
+    *prled = rled;
+    return stats;
+}
+
+
+/*---------------------------------------------------------------------*
+ *                            Static helpers                           *
+ *---------------------------------------------------------------------*/
+/*!
+ *  rleAddRun()
+ *
+ *      Input:  rle
+ *              y (line being made; runs on earlier lines are complete)
+ *              xs, xe (first and last pixel of the run)
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) Runs on a line must be added in order of xs.  A run that
+ *          overlaps or touches the previous run on the line is merged
+ *          with it, so that the runs stay maximal.
+ *      (2) The caller sets rowstart[y + 1] when line y is complete.
+ */
+static l_int32
+rleAddRun(L_RLE   *rle,
+          l_int32  y,
+          l_int32  xs,
+          l_int32  xe)
+{
+l_int32   n;
+l_int32  *xsnew, *xenew;
+
+    PROCNAME("rleAddRun");
+
+    n = rle->n;
+    if (n > rle->rowstart[y] && xs <= rle->xe[n - 1] + 1) {
+        rle->xe[n - 1] = L_MAX(rle->xe[n - 1], xe);
+        return 0;
+    }
+
+        /* Both arrays are replaced only if both can be extended,
+         * so that rle is unchanged on failure */
+    if (n >= rle->nalloc) {
+        xsnew = (l_int32 *)CALLOC(2 * rle->nalloc, sizeof(l_int32));
+        xenew = (l_int32 *)CALLOC(2 * rle->nalloc, sizeof(l_int32));
+        if (!xsnew || !xenew) {
+            FREE(xsnew);
+            FREE(xenew);
+            return ERROR_INT("run arrays not extended", procName, 1);
+        }
+        memcpy(xsnew, rle->xs, n * sizeof(l_int32));
+        memcpy(xenew, rle->xe, n * sizeof(l_int32));
+        FREE(rle->xs);
+        FREE(rle->xe);
+        rle->xs = xsnew;
+        rle->xe = xenew;
+        rle->nalloc *= 2;
+    }
+    rle->xs[n] = xs;
+    rle->xe[n] = xe;
+    rle->n++;
+    return 0;
+}
+
+
+/*!
+ *  rleRowUnion()
+ *
+ *      Input:  rled (runs are added to line y)
+ *              y
+ *              xs1, xe1, n1 (runs of the first line)
+ *              xs2, xe2, n2 (runs of the second line)
+ *      Return: 0 if OK, 1 on error
+ */
+static l_int32
+rleRowUnion(L_RLE    *rled,
+            l_int32   y,
+            l_int32  *xs1,
+            l_int32  *xe1,
+            l_int32   n1,
+            l_int32  *xs2,
+            l_int32  *xe2,
+            l_int32   n2)
+{
+l_int32  i, j;
+
+    i = j = 0;
+    while (i < n1 || j < n2) {
+        if (j == n2 || (i < n1 && xs1[i] <= xs2[j])) {
+            if (rleAddRun(rled, y, xs1[i], xe1[i]))
+                return 1;
+            i++;
+        }
+        else {
+            if (rleAddRun(rled, y, xs2[j], xe2[j]))
+                return 1;
+            j++;
+        }
+    }
+    return 0;
+}
+
+
+/*!
+ *  rleRowIntersect()
+ *
+ *      Input:  rled, y, xs1, xe1, n1, xs2, xe2, n2 (see rleRowUnion())
+ *      Return: 0 if OK, 1 on error
+ */
+static l_int32
+rleRowIntersect(L_RLE    *rled,
+                l_int32   y,
+                l_int32  *xs1,
+                l_int32  *xe1,
+                l_int32   n1,
+                l_int32  *xs2,
+                l_int32  *xe2,
+                l_int32   n2)
+{
+l_int32  i, j, xs, xe;
+
+    i = j = 0;
+    while (i < n1 && j < n2) {
+        xs = L_MAX(xs1[i], xs2[j]);
+        xe = L_MIN(xe1[i], xe2[j]);
+        if (xs <= xe && rleAddRun(rled, y, xs, xe))
+            return 1;
+        if (xe1[i] < xe2[j])
+            i++;
+        else
+            j++;
+    }
+    return 0;
+}
+
+
+/*!
+ *  rleRowSubtract()
+ *
+ *      Input:  rled, y, xs1, xe1, n1, xs2, xe2, n2 (see rleRowUnion())
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) This adds the parts of the first runs not in the second.
+ */
+static l_int32
+rleRowSubtract(L_RLE    *rled,
+               l_int32   y,
+               l_int32  *xs1,
+               l_int32  *xe1,
+               l_int32   n1,
+               l_int32  *xs2,
+               l_int32  *xe2,
+               l_int32   n2)
+{
+l_int32  i, j, x;
+
+    for (i = 0, j = 0; i < n1; i++) {
+        x = xs1[i];
+        while (j < n2 && xe2[j] < x)
+            j++;
+        while (j < n2 && xs2[j] <= xe1[i]) {
+            if (xs2[j] > x && rleAddRun(rled, y, x, xs2[j] - 1))
+                return 1;
+            x = xe2[j] + 1;
+            if (xe2[j] > xe1[i])  /* may also cover the next run */
+                break;
+            j++;
+        }
+        if (x <= xe1[i] && rleAddRun(rled, y, x, xe1[i]))
+            return 1;
+    }
+    return 0;
+}
+
+
+/*!
+ *  rleRowXor()
+ *
+ *      Input:  rled, y, xs1, xe1, n1, xs2, xe2, n2 (see rleRowUnion())
+ *      Return: 0 if OK, 1 on error
+ *
+ *  Notes:
+ *      (1) The boundaries of a line are the positions where runs
+ *          start, and one past where they end.  The boundaries of the
+ *          xor are those of the two lines, except that a boundary
+ *          appearing in both cancels.  The two sorted lists of
+ *          boundaries are merged, and the result is taken in pairs.
+ */
+static l_int32
+rleRowXor(L_RLE    *rled,
+          l_int32   y,
+          l_int32  *xs1,
+          l_int32  *xe1,
+          l_int32   n1,
+          l_int32  *xs2,
+          l_int32  *xe2,
+          l_int32   n2)
+{
+l_int32  i, j, b1, b2, b, start, instart;
+
+    i = j = 0;  /* boundary indices: 2 * run + (0 for start, 1 for end) */
+    instart = FALSE;
+    start = 0;
+    while (i < 2 * n1 || j < 2 * n2) {
+        b1 = (i < 2 * n1) ? ((i & 1) ? xe1[i >> 1] + 1 : xs1[i >> 1])
+                          : rled->w + 1;
+        b2 = (j < 2 * n2) ? ((j & 1) ? xe2[j >> 1] + 1 : xs2[j >> 1])
+                          : rled->w + 1;
+        if (b1 == b2) {  /* cancels */
+            i++;
+            j++;
+            continue;
+        }
+        if (b1 < b2) {
+            b = b1;
+            i++;
+        }
+        else {
+            b = b2;
+            j++;
+        }
+        if (!instart) {
+            start = b;
+            instart = TRUE;
+        }
+        else {
+            if (rleAddRun(rled, y, start, b - 1))
+                return 1;
+            instart = FALSE;
+        }
+    }
+    return 0;
+}
+
+
+/*!
+ *  rleDilateHoriz()
+ *
+ *      Input:  rles
+ *              size (width of the horizontal Sel)
+ *      Return: rled, or null on error
+ */
+static L_RLE *
+rleDilateHoriz(L_RLE   *rles,
+               l_int32  size)
+{
+l_int32  i, k, left, right;
+L_RLE   *rled;
+
+    PROCNAME("rleDilateHoriz");
+
+    if ((rled = rleCreate(rles->w, rles->h, L_MAX(1, rles->n))) == NULL)
+        return (L_RLE *)ERROR_PTR("rled not made", procName, NULL);
+    left = size / 2;  /* the Sel origin */
+    right = size - 1 - left;
+    for (i = 0; i < rles->h; i++) {
+        for (k = rles->rowstart[i]; k < rles->rowstart[i + 1]; k++) {
+            if (rleAddRun(rled, i, L_MAX(0, rles->xs[k] - left),
+                          L_MIN(rles->w - 1, rles->xe[k] + right))) {
+                rleDestroy(&rled);
+                return (L_RLE *)ERROR_PTR("run not added", procName, NULL);
+            }
+        }
+        rled->rowstart[i + 1] = rled->n;
+    }
+    return rled;
+}
+
+
+/*!
+ *  rleErodeHoriz()
+ *
+ *      Input:  rles
+ *              size (width of the horizontal Sel)
+ *      Return: rled, or null on error
+ *
+ *  Notes:
+ *      (1) With SYMMETRIC_MORPH_BC, pixels outside the image are ON,
+ *          so runs touching the left or right side are not shortened
+ *          on that side.
+ */
+static L_RLE *
+rleErodeHoriz(L_RLE   *rles,
+              l_int32  size)
+{
+l_int32  i, k, left, right, xs, xe;
+L_RLE   *rled;
+
+    PROCNAME("rleErodeHoriz");
+
+    if ((rled = rleCreate(rles->w, rles->h, L_MAX(1, rles->n))) == NULL)
+        return (L_RLE *)ERROR_PTR("rled not made", procName, NULL);
+    left = size / 2;  /* the Sel origin */
+    right = size - 1 - left;
+    for (i = 0; i < rles->h; i++) {
+        for (k = rles->rowstart[i]; k < rles->rowstart[i + 1]; k++) {
+            xs = rles->xs[k];
+            xe = rles->xe[k];
+            if (MORPH_BC == ASYMMETRIC_MORPH_BC || xs > 0)
+                xs += left;
+            if (MORPH_BC == ASYMMETRIC_MORPH_BC || xe < rles->w - 1)
+                xe -= right;
+            if (xs <= xe && rleAddRun(rled, i, xs, xe)) {
+                rleDestroy(&rled);
+                return (L_RLE *)ERROR_PTR("run not added", procName, NULL);
+            }
+        }
+        rled->rowstart[i + 1] = rled->n;
+    }
+    return rled;
+}
+
+
+/*!
+ *  rleDilateVert()
+ *
+ *      Input:  rles
+ *              size (height of the vertical Sel)
+ *      Return: rled, or null on error
+ *
+ *  Notes:
+ *      (1) Line i of the result is the union of source lines
+ *          i - (size - 1 - size / 2) to i + size / 2.  The union is
+ *          accumulated in two single-line buffers.
+ */
+static L_RLE *
+rleDilateVert(L_RLE   *rles,
+              l_int32  size)
+{
+l_int32  i, k, r, rs, re, s, ret;
+L_RLE   *rled, *rla, *rlb, *rlt;
+
+    PROCNAME("rleDilateVert");
+
+    rled = rleCreate(rles->w, rles->h, L_MAX(1, rles->n));
+    rla = rleCreate(rles->w, 1, 0);
+    rlb = rleCreate(rles->w, 1, 0);
+    if (!rled || !rla || !rlb) {
+        rleDestroy(&rled);
+        rleDestroy(&rla);
+        rleDestroy(&rlb);
+        return (L_RLE *)ERROR_PTR("rles not made", procName, NULL);
+    }
+    ret = 0;
+    for (i = 0; !ret && i < rles->h; i++) {
+        rs = L_MAX(0, i - (size - 1 - size / 2));
+        re = L_MIN(rles->h - 1, i + size / 2);
+        rla->n = 0;
+        for (r = rs; !ret && r <= re; r++) {
+            s = rles->rowstart[r];
+            rlb->n = 0;
+            ret = rleRowUnion(rlb, 0, rla->xs, rla->xe, rla->n, rles->xs + s,
+                              rles->xe + s, rles->rowstart[r + 1] - s);
+            rlt = rla;
+            rla = rlb;
+            rlb = rlt;
+        }
+        for (k = 0; !ret && k < rla->n; k++)
+            ret = rleAddRun(rled, i, rla->xs[k], rla->xe[k]);
+        rled->rowstart[i + 1] = rled->n;
+    }
+
+    rleDestroy(&rla);
+    rleDestroy(&rlb);
+    if (ret) {
+        rleDestroy(&rled);
+        return (L_RLE *)ERROR_PTR("runs not added", procName, NULL);
+    }
+    return rled;
+}
+
+
+/*!
+ *  rleErodeVert()
+ *
+ *      Input:  rles
+ *              size (height of the vertical Sel)
+ *      Return: rled, or null on error
+ *
+ *  Notes:
+ *      (1) Line i of the result is the intersection of source lines
+ *          i - size / 2 to i + (size - 1 - size / 2).  Lines outside
+ *          the image are empty with ASYMMETRIC_MORPH_BC, and full
+ *          (so they can be skipped) with SYMMETRIC_MORPH_BC.
+ */
+static L_RLE *
+rleErodeVert(L_RLE   *rles,
+             l_int32  size)
+{
+l_int32  i, k, r, rs, re, s, ret;
+L_RLE   *rled, *rla, *rlb, *rlt;
+
+    PROCNAME("rleErodeVert");
+
+    rled = rleCreate(rles->w, rles->h, L_MAX(1, rles->n));
+    rla = rleCreate(rles->w, 1, 0);
+    rlb = rleCreate(rles->w, 1, 0);
+    if (!rled || !rla || !rlb) {
+        rleDestroy(&rled);
+        rleDestroy(&rla);
+        rleDestroy(&rlb);
+        return (L_RLE *)ERROR_PTR("rles not made", procName, NULL);
+    }
+    ret = 0;
+    for (i = 0; !ret && i < rles->h; i++) {
+        rs = i - size / 2;
+        re = i + (size - 1 - size / 2);
+        if (MORPH_BC == ASYMMETRIC_MORPH_BC &&
+            (rs < 0 || re > rles->h - 1)) {
+            rled->rowstart[i + 1] = rled->n;
+            continue;
+        }
+        rs = L_MAX(0, rs);
+        re = L_MIN(rles->h - 1, re);
+        s = rles->rowstart[rs];
+        rla->n = 0;
+        for (k = s; !ret && k < rles->rowstart[rs + 1]; k++)
+            ret = rleAddRun(rla, 0, rles->xs[k], rles->xe[k]);
+        for (r = rs + 1; !ret && r <= re && rla->n > 0; r++) {
+            s = rles->rowstart[r];
+            rlb->n = 0;
+            ret = rleRowIntersect(rlb, 0, rla->xs, rla->xe, rla->n,
+                                  rles->xs + s, rles->xe + s,
+                                  rles->rowstart[r + 1] - s);
+            rlt = rla;
+            rla = rlb;
+            rlb = rlt;
+        }
+        for (k = 0; !ret && k < rla->n; k++)
+            ret = rleAddRun(rled, i, rla->xs[k], rla->xe[k]);
+        rled->rowstart[i + 1] = rled->n;
+    }
+
+    rleDestroy(&rla);
+    rleDestroy(&rlb);
+    if (ret) {
+        rleDestroy(&rled);
+        return (L_RLE *)ERROR_PTR("runs not added", procName, NULL);
+    }
+    return rled;
+}
@@ -198,7 +198,8 @@ pixRasterop(PIX     *pixd,
             l_int32  sx,
             l_int32  sy)
 {
-l_int32  dd;
+l_int32          dd;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixRasterop");
 
@@ -210,12 +211,13 @@ l_int32  dd;
 
         /* Check if operation is only on dest */
     dd = pixGetDepth(pixd);
+    dispatch = l_cpuGetDispatch();
     if (op == PIX_CLR || op == PIX_SET || op == PIX_NOT(PIX_DST)) {
-        rasteropUniLow(pixGetData(pixd),
-                       pixGetWidth(pixd), pixGetHeight(pixd), dd,
-                        pixGetWpl(pixd),
-                       dx, dy, dw, dh,
-                       op);
+        dispatch->rasteropUniLow(pixGetData(pixd),
+                                 pixGetWidth(pixd), pixGetHeight(pixd), dd,
+                                 pixGetWpl(pixd),
+                                 dx, dy, dw, dh,
+                                 op);
         return 0;
     }
 
@@ -226,15 +228,15 @@ l_int32  dd;
     if (dd != pixGetDepth(pixs))
         return ERROR_INT("depths of pixs and pixd differ", procName, 1);
 
-    rasteropLow(pixGetData(pixd),
-                pixGetWidth(pixd), pixGetHeight(pixd), dd,
-                pixGetWpl(pixd),
-                dx, dy, dw, dh,
-                op,
-                pixGetData(pixs),
-                pixGetWidth(pixs), pixGetHeight(pixs),
-                pixGetWpl(pixs),
-                sx, sy);
+    dispatch->rasteropLow(pixGetData(pixd),
+                          pixGetWidth(pixd), pixGetHeight(pixd), dd,
+                          pixGetWpl(pixd),
+                          dx, dy, dw, dh,
+                          op,
+                          pixGetData(pixs),
+                          pixGetWidth(pixs), pixGetHeight(pixs),
+                          pixGetWpl(pixs),
+                          sx, sy);
 
     return 0;
 }
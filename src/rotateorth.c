@@ -200,9 +200,8 @@ PIX *
 pixFlipLR(PIX  *pixd,
           PIX  *pixs)
 {
-l_uint8   *tab;
 l_int32    w, h, d, wpld;
-l_uint32  *datad, *buffer;
+l_uint32  *datad;
 
     PROCNAME("pixFlipLR");
 
@@ -219,29 +218,8 @@ l_uint32  *datad, *buffer;
 
     datad = pixGetData(pixd);
     wpld = pixGetWpl(pixd);
-    switch (d)
-    {
-    case 1:
-        tab = makeReverseByteTab1();
-        break;
-    case 2:
-        tab = makeReverseByteTab2();
-        break;
-    case 4:
-        tab = makeReverseByteTab4();
-        break;
-    default:
-        tab = NULL;
-        break;
-    }
-
-    if ((buffer = (l_uint32 *)CALLOC(wpld, sizeof(l_uint32))) == NULL)
-        return (PIX *)ERROR_PTR("buffer not made", procName, NULL);
-
-    flipLRLow(datad, w, h, d, wpld, tab, buffer);
+    flipLRLow(datad, w, h, d, wpld);
 
-    FREE(buffer);
-    if (tab) FREE(tab);
     return pixd;
 }
 
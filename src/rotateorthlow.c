@@ -47,6 +47,29 @@
 #include "allheaders.h"
 
 
+    /* Size of the square tiles, in words, used for the transposes */
+static const l_int32  ROT_TILE = 32;
+
+static void rotate90Low32(l_uint32 *datad, l_int32 wd, l_int32 hd,
+                          l_int32 wpld, l_uint32 *datas, l_int32 wpls,
+                          l_int32 direction);
+static void rotate90Low16(l_uint32 *datad, l_int32 wd, l_int32 hd,
+                          l_int32 wpld, l_uint32 *datas, l_int32 wpls,
+                          l_int32 direction);
+static void rotate90Low8(l_uint32 *datad, l_int32 wd, l_int32 hd,
+                         l_int32 wpld, l_uint32 *datas, l_int32 wpls,
+                         l_int32 direction);
+static void rotate90Low1(l_uint32 *datad, l_int32 wd, l_int32 hd,
+                         l_int32 wpld, l_uint32 *datas, l_int32 wpls,
+                         l_int32 direction);
+static void rotate90EdgeLow(l_uint32 *datad, l_int32 wd, l_int32 hd,
+                            l_int32 d, l_int32 wpld, l_uint32 *datas,
+                            l_int32 wpls, l_int32 direction,
+                            l_int32 nbrows, l_int32 nbcols);
+static void transpose32Low(l_uint32 *a);
+static l_uint32 reverseWordPixels(l_uint32 word, l_int32 d);
+
+
 /*------------------------------------------------------------------*
  *                           90 degree rotation                     *
  *------------------------------------------------------------------*/
@@ -59,6 +82,13 @@
  *  Notes:
  *      (1) The dest must be cleared in advance because not
  *          all source pixels are written to the destination.
+ *      (2) For 1, 8, 16 and 32 bpp, the rotation is done in square
+ *          tiles of ROT_TILE words, so that both the source and the
+ *          dest lines that are touched stay in cache.  Within a tile,
+ *          blocks of pixels are transposed in registers: 32x32 for
+ *          1 bpp, 4x4 for 8 bpp and 2x2 for 16 bpp.  Pixels at the
+ *          right and bottom edges that don't fill a block are moved
+ *          one at a time.
  */
 void
 rotate90Low(l_uint32  *datad,
@@ -70,47 +100,33 @@ rotate90Low(l_uint32  *datad,
             l_int32    wpls,
             l_int32    direction)
 {
-l_int32    i, j, k, m, iend, nswords;
-l_uint32   val, word;
+l_int32    i, j;
+l_uint32   val;
 l_uint32  *lines, *lined;
 
     PROCNAME("rotate90Low");
 
+    switch (d)
+    {
+        case 32:
+            rotate90Low32(datad, wd, hd, wpld, datas, wpls, direction);
+            return;
+        case 16:
+            rotate90Low16(datad, wd, hd, wpld, datas, wpls, direction);
+            return;
+        case 8:
+            rotate90Low8(datad, wd, hd, wpld, datas, wpls, direction);
+            return;
+        case 1:
+            rotate90Low1(datad, wd, hd, wpld, datas, wpls, direction);
+            return;
+        default:
+            break;
+    }
+
     if (direction == 1) {  /* clockwise */
         switch (d)
         {
-            case 32:
-                for (i = 0; i < hd; i++) {
-                    lined = datad + i * wpld;
-                    lines = datas + (wd - 1) * wpls;
-                    for (j = 0; j < wd; j++) {
-                        lined[j] = lines[i];
-                        lines -= wpls;
-                    }
-                }
-                break;
-            case 16:
-                for (i = 0; i < hd; i++) {
-                    lined = datad + i * wpld;
-                    lines = datas + (wd - 1) * wpls;
-                    for (j = 0; j < wd; j++) {
-                        if ((val = GET_DATA_TWO_BYTES(lines, i)))
-                            SET_DATA_TWO_BYTES(lined, j, val);
-                        lines -= wpls;
-                    }
-                }
-                break;
-            case 8:
-                for (i = 0; i < hd; i++) {
-                    lined = datad + i * wpld;
-                    lines = datas + (wd - 1) * wpls;
-                    for (j = 0; j < wd; j++) {
-                        if ((val = GET_DATA_BYTE(lines, i)))
-                            SET_DATA_BYTE(lined, j, val);
-                        lines -= wpls;
-                    }
-                }
-                break;
             case 4:
                 for (i = 0; i < hd; i++) {
                     lined = datad + i * wpld;
@@ -133,33 +149,6 @@ l_uint32  *lines, *lined;
                     }
                 }
                 break;
-            case 1:
-                nswords = hd / 32;
-                for (j = 0; j < wd; j++) {
-                    lined = datad;
-                    lines = datas + (wd - 1 - j) * wpls;
-                    for (k = 0; k < nswords; k++) {
-                        word = lines[k];
-                        if (!word) {
-                            lined += 32 * wpld;
-                            continue;
-                        }
-                        else {
-                            iend = 32 * (k + 1);
-                            for (m = 0, i = 32 * k; i < iend; i++, m++) {
-                                if ((word << m) & 0x80000000)
-                                    SET_DATA_BIT(lined, j);
-                                lined += wpld;
-                            }
-                        }
-                    }
-                    for (i = 32 * nswords; i < hd; i++) {
-                        if (GET_DATA_BIT(lines, i))
-                            SET_DATA_BIT(lined, j);
-                        lined += wpld;
-                    }
-                }
-                break;
             default:
                 L_ERROR("illegal depth", procName);
         }
@@ -167,38 +156,6 @@ l_uint32  *lines, *lined;
     else  {     /* direction counter-clockwise */
         switch (d)
         {
-            case 32:
-                for (i = 0; i < hd; i++) {
-                    lined = datad + i * wpld;
-                    lines = datas;
-                    for (j = 0; j < wd; j++) {
-                        lined[j] = lines[hd - 1 - i];
-                        lines += wpls;
-                    }
-                }
-                break;
-            case 16:
-                for (i = 0; i < hd; i++) {
-                    lined = datad + i * wpld;
-                    lines = datas;
-                    for (j = 0; j < wd; j++) {
-                        if ((val = GET_DATA_TWO_BYTES(lines, hd - 1 - i)))
-                            SET_DATA_TWO_BYTES(lined, j, val);
-                        lines += wpls;
-                    }
-                }
-                break;
-            case 8:
-                for (i = 0; i < hd; i++) {
-                    lined = datad + i * wpld;
-                    lines = datas;
-                    for (j = 0; j < wd; j++) {
-                        if ((val = GET_DATA_BYTE(lines, hd - 1 - i)))
-                            SET_DATA_BYTE(lined, j, val);
-                        lines += wpls;
-                    }
-                }
-                break;
             case 4:
                 for (i = 0; i < hd; i++) {
                     lined = datad + i * wpld;
@@ -221,38 +178,333 @@ l_uint32  *lines, *lined;
                     }
                 }
                 break;
-            case 1:
-                nswords = hd / 32;
-                for (j = 0; j < wd; j++) {
-                    lined = datad + (hd - 1) * wpld;
-                    lines = datas + (wd - 1 - j) * wpls;
-                    for (k = 0; k < nswords; k++) {
-                        word = lines[k];
-                        if (!word) {
-                            lined -= 32 * wpld;
-                            continue;
-                        }
-                        else {
-                            iend = 32 * (k + 1);
-                            for (m = 0, i = 32 * k; i < iend; i++, m++) {
-                                if ((word << m) & 0x80000000)
-                                    SET_DATA_BIT(lined, wd - 1 - j);
-                                lined -= wpld;
-                            }
-                        }
+            default:
+                L_ERROR("illegal depth", procName);
+        }
+    }
+
+    return;
+}
+
+
+/*!
+ *  rotate90Low32()
+ *
+ *  Notes:
+ *      (1) Tiled word copy.  For cw rotation, dest pixel (j, i)
+ *          comes from src pixel (i, wd - 1 - j); for ccw rotation,
+ *          from src pixel (hd - 1 - i, j).
+ */
+static void
+rotate90Low32(l_uint32  *datad,
+              l_int32    wd,
+              l_int32    hd,
+              l_int32    wpld,
+              l_uint32  *datas,
+              l_int32    wpls,
+              l_int32    direction)
+{
+l_int32    i, j, ib, jb, iend, jend;
+l_uint32  *lines, *lined;
+
+    for (ib = 0; ib < hd; ib += ROT_TILE) {
+        iend = L_MIN(ib + ROT_TILE, hd);
+        for (jb = 0; jb < wd; jb += ROT_TILE) {
+            jend = L_MIN(jb + ROT_TILE, wd);
+            for (i = ib; i < iend; i++) {
+                lined = datad + i * wpld;
+                if (direction == 1) {
+                    lines = datas + (wd - 1 - jb) * wpls + i;
+                    for (j = jb; j < jend; j++, lines -= wpls)
+                        lined[j] = *lines;
+                }
+                else {
+                    lines = datas + jb * wpls + hd - 1 - i;
+                    for (j = jb; j < jend; j++, lines += wpls)
+                        lined[j] = *lines;
+                }
+            }
+        }
+    }
+    return;
+}
+
+
+/*!
+ *  rotate90Low16()
+ *
+ *  Notes:
+ *      (1) Each src word holds 2 pixels, which go to 2 adjacent dest
+ *          rows.  Each dest word gets its 2 pixels from 2 adjacent
+ *          src lines.  The 2x2 block is transposed in registers.
+ */
+static void
+rotate90Low16(l_uint32  *datad,
+              l_int32    wd,
+              l_int32    hd,
+              l_int32    wpld,
+              l_uint32  *datas,
+              l_int32    wpls,
+              l_int32    direction)
+{
+l_int32    c, jw, cb, jb, cend, jend, nwc, nwd, row0, row1;
+l_uint32   s0, s1;
+l_uint32  *lines;
+
+    nwc = hd / 2;  /* full src words in the columns of interest */
+    nwd = wd / 2;  /* full dest words */
+    for (cb = 0; cb < nwc; cb += ROT_TILE) {
+        cend = L_MIN(cb + ROT_TILE, nwc);
+        for (jb = 0; jb < nwd; jb += ROT_TILE) {
+            jend = L_MIN(jb + ROT_TILE, nwd);
+            for (c = cb; c < cend; c++) {
+                if (direction == 1) {
+                    row0 = 2 * c;
+                    row1 = row0 + 1;
+                }
+                else {
+                    row0 = hd - 1 - 2 * c;
+                    row1 = row0 - 1;
+                }
+                for (jw = jb; jw < jend; jw++) {
+                    if (direction == 1) {
+                        lines = datas + (wd - 1 - 2 * jw) * wpls + c;
+                        s0 = *lines;
+                        s1 = *(lines - wpls);
                     }
-                    for (i = 32 * nswords; i < hd; i++) {
-                        if (GET_DATA_BIT(lines, i))
-                            SET_DATA_BIT(lined, wd - 1 - j);
-                        lined -= wpld;
+                    else {
+                        lines = datas + 2 * jw * wpls + c;
+                        s0 = *lines;
+                        s1 = *(lines + wpls);
                     }
+                    datad[row0 * wpld + jw] = (s0 & 0xffff0000) | (s1 >> 16);
+                    datad[row1 * wpld + jw] = (s0 << 16) | (s1 & 0xffff);
                 }
-                break;
-            default:
-                L_ERROR("illegal depth", procName);
+            }
         }
     }
 
+    rotate90EdgeLow(datad, wd, hd, 16, wpld, datas, wpls, direction,
+                    2 * nwc, 2 * nwd);
+    return;
+}
+
+
+/*!
+ *  rotate90Low8()
+ *
+ *  Notes:
+ *      (1) Each src word holds 4 pixels, which go to 4 adjacent dest
+ *          rows.  Each dest word gets its 4 pixels from 4 adjacent
+ *          src lines.  The 4x4 block of bytes is transposed in registers.
+ */
+static void
+rotate90Low8(l_uint32  *datad,
+             l_int32    wd,
+             l_int32    hd,
+             l_int32    wpld,
+             l_uint32  *datas,
+             l_int32    wpls,
+             l_int32    direction)
+{
+l_int32    c, jw, cb, jb, cend, jend, nwc, nwd, row, rowinc, srcinc;
+l_uint32   s0, s1, s2, s3;
+l_uint32  *lines, *lined;
+
+    nwc = hd / 4;  /* full src words in the columns of interest */
+    nwd = wd / 4;  /* full dest words */
+    rowinc = (direction == 1) ? wpld : -wpld;
+    srcinc = (direction == 1) ? -wpls : wpls;
+    for (cb = 0; cb < nwc; cb += ROT_TILE) {
+        cend = L_MIN(cb + ROT_TILE, nwc);
+        for (jb = 0; jb < nwd; jb += ROT_TILE) {
+            jend = L_MIN(jb + ROT_TILE, nwd);
+            for (c = cb; c < cend; c++) {
+                row = (direction == 1) ? 4 * c : hd - 1 - 4 * c;
+                for (jw = jb; jw < jend; jw++) {
+                    if (direction == 1)
+                        lines = datas + (wd - 1 - 4 * jw) * wpls + c;
+                    else
+                        lines = datas + 4 * jw * wpls + c;
+                    s0 = *lines;
+                    s1 = *(lines + srcinc);
+                    s2 = *(lines + 2 * srcinc);
+                    s3 = *(lines + 3 * srcinc);
+                    lined = datad + row * wpld + jw;
+                    *lined = (s0 & 0xff000000) | ((s1 >> 8) & 0xff0000) |
+                             ((s2 >> 16) & 0xff00) | (s3 >> 24);
+                    lined += rowinc;
+                    *lined = ((s0 << 8) & 0xff000000) | (s1 & 0xff0000) |
+                             ((s2 >> 8) & 0xff00) | ((s3 >> 16) & 0xff);
+                    lined += rowinc;
+                    *lined = ((s0 << 16) & 0xff000000) |
+                             ((s1 << 8) & 0xff0000) |
+                             (s2 & 0xff00) | ((s3 >> 8) & 0xff);
+                    lined += rowinc;
+                    *lined = (s0 << 24) | ((s1 << 16) & 0xff0000) |
+                             ((s2 << 8) & 0xff00) | (s3 & 0xff);
+                }
+            }
+        }
+    }
+
+    rotate90EdgeLow(datad, wd, hd, 8, wpld, datas, wpls, direction,
+                    4 * nwc, 4 * nwd);
+    return;
+}
+
+
+/*!
+ *  rotate90Low1()
+ *
+ *  Notes:
+ *      (1) Each 32x32 block of bits is gathered from 32 src lines,
+ *          transposed in registers, and written to 32 dest lines.
+ *          Blocks with no fg pixels are skipped, because the dest
+ *          has been cleared.
+ */
+static void
+rotate90Low1(l_uint32  *datad,
+             l_int32    wd,
+             l_int32    hd,
+             l_int32    wpld,
+             l_uint32  *datas,
+             l_int32    wpls,
+             l_int32    direction)
+{
+l_int32    c, jw, k, cb, jb, cend, jend, nwc, nwd, row, rowinc, srcinc;
+l_uint32   accum;
+l_uint32   block[32];
+l_uint32  *lines, *lined;
+
+    nwc = hd / 32;  /* full src words in the columns of interest */
+    nwd = wd / 32;  /* full dest words */
+    rowinc = (direction == 1) ? wpld : -wpld;
+    srcinc = (direction == 1) ? -wpls : wpls;
+    for (cb = 0; cb < nwc; cb += ROT_TILE) {
+        cend = L_MIN(cb + ROT_TILE, nwc);
+        for (jb = 0; jb < nwd; jb += ROT_TILE) {
+            jend = L_MIN(jb + ROT_TILE, nwd);
+            for (c = cb; c < cend; c++) {
+                row = (direction == 1) ? 32 * c : hd - 1 - 32 * c;
+                for (jw = jb; jw < jend; jw++) {
+                    if (direction == 1)
+                        lines = datas + (wd - 1 - 32 * jw) * wpls + c;
+                    else
+                        lines = datas + 32 * jw * wpls + c;
+                    accum = 0;
+                    for (k = 0; k < 32; k++, lines += srcinc) {
+                        block[k] = *lines;
+                        accum |= block[k];
+                    }
+                    if (!accum)
+                        continue;
+                    transpose32Low(block);
+                    lined = datad + row * wpld + jw;
+                    for (k = 0; k < 32; k++, lined += rowinc)
+                        *lined = block[k];
+                }
+            }
+        }
+    }
+
+    rotate90EdgeLow(datad, wd, hd, 1, wpld, datas, wpls, direction,
+                    32 * nwc, 32 * nwd);
+    return;
+}
+
+
+/*!
+ *  rotate90EdgeLow()
+ *
+ *      Input:  datad, wd, hd, d, wpld, datas, wpls, direction
+ *              nbrows (number of dest rows written by the block transposes)
+ *              nbcols (number of dest columns written by the block
+ *                      transposes)
+ *
+ *  Notes:
+ *      (1) This does the pixels, for d = 1, 8 or 16, that are not in
+ *          the full blocks handled by the block transposes.
+ *          For cw rotation, these blocks fill the first nbrows dest
+ *          rows; for ccw rotation, they fill the last nbrows dest rows.
+ *          In both cases they fill the first nbcols dest columns.
+ */
+static void
+rotate90EdgeLow(l_uint32  *datad,
+                l_int32    wd,
+                l_int32    hd,
+                l_int32    d,
+                l_int32    wpld,
+                l_uint32  *datas,
+                l_int32    wpls,
+                l_int32    direction,
+                l_int32    nbrows,
+                l_int32    nbcols)
+{
+l_int32    i, j, inblock, xs;
+l_uint32   val;
+l_uint32  *lines, *lined;
+
+    for (i = 0; i < hd; i++) {
+        lined = datad + i * wpld;
+        if (direction == 1) {
+            inblock = (i < nbrows);
+            xs = i;
+        }
+        else {
+            inblock = (i >= hd - nbrows);
+            xs = hd - 1 - i;
+        }
+        for (j = (inblock) ? nbcols : 0; j < wd; j++) {
+            if (direction == 1)
+                lines = datas + (wd - 1 - j) * wpls;
+            else
+                lines = datas + j * wpls;
+            if (d == 1) {
+                if (GET_DATA_BIT(lines, xs))
+                    SET_DATA_BIT(lined, j);
+            }
+            else if (d == 8) {
+                if ((val = GET_DATA_BYTE(lines, xs)))
+                    SET_DATA_BYTE(lined, j, val);
+            }
+            else {  /* d == 16 */
+                if ((val = GET_DATA_TWO_BYTES(lines, xs)))
+                    SET_DATA_TWO_BYTES(lined, j, val);
+            }
+        }
+    }
+    return;
+}
+
+
+/*!
+ *  transpose32Low()
+ *
+ *      Input:  a (array of 32 words, representing a 32x32 bit matrix,
+ *                 with the MSB of each word in the first column)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) In-place transpose of the bit matrix, by recursively
+ *          swapping the off-diagonal blocks of size 16, 8, 4, 2 and 1
+ *          with masks and shifts.  This takes 5 * 16 word swaps,
+ *          compared with 1024 single-bit operations.
+ */
+static void
+transpose32Low(l_uint32  *a)
+{
+l_int32   j, k;
+l_uint32  m, t;
+
+    m = 0x0000ffff;
+    for (j = 16; j != 0; j = j >> 1, m = m ^ (m << j)) {
+        for (k = 0; k < 32; k = (k + j + 1) & ~j) {
+            t = (a[k] ^ (a[k + j] >> j)) & m;
+            a[k] = a[k] ^ t;
+            a[k + j] = a[k + j] ^ (t << j);
+        }
+    }
     return;
 }
 
@@ -265,14 +517,14 @@ l_uint32  *lines, *lined;
  *
  *  Notes:
  *      (1) The pixel access routines allow a trivial implementation.
- *          However, for d < 8, it is more efficient to right-justify
- *          each line to a 32-bit boundary and then extract bytes and
- *          do pixel reversing.   In those cases, as in the 180 degree
- *          rotation, we right-shift the data (if necessary) to
- *          right-justify on the 32 bit boundary, and then read the
- *          bytes off each raster line in reverse order, reversing
- *          the pixels in each byte using a table.  These functions
- *          for 1, 2 and 4 bpp were tested against the "trivial"
+ *          However, it is more efficient to right-justify each line
+ *          to a 32-bit boundary and then reverse the order of the
+ *          words, reversing the pixels within each word.   As in the
+ *          180 degree rotation, we right-shift the data (if necessary)
+ *          to right-justify on the 32 bit boundary.  The pixels in
+ *          each word are reversed with a few shift-and-mask operations
+ *          (see reverseWordPixels()), rather than by table lookup on
+ *          each byte.  These functions were tested against the "trivial"
  *          version (shown here for 4 bpp):
  *              for (i = 0; i < h; i++) {
  *                  line = data + i * wpl;
@@ -282,120 +534,92 @@ l_uint32  *lines, *lined;
  *                        SET_DATA_QBIT(line, j, val);
  *                  }
  *              }
- *      (2) This operation is in-place.
+ *      (2) This operation is in-place.  The words at the two ends of
+ *          each line are swapped, so no line buffer is required.
  */
 void
 flipLRLow(l_uint32  *data,
           l_int32    w,
           l_int32    h,
           l_int32    d,
-          l_int32    wpl,
-          l_uint8   *tab,
-          l_uint32  *buffer)
+          l_int32    wpl)
 {
-l_int32    extra, shift, databpl, bpl, i, j;
+l_int32    extra, shift, nw, i, j, k;
 l_uint32   val;
 l_uint32  *line;
 
     PROCNAME("flipLRLow");
 
-    bpl = 4 * wpl;
-    switch (d)
-    {
-        case 32:
-            for (i = 0; i < h; i++) {
-                line = data + i * wpl;
-                memcpy(buffer, line, bpl);
-                for (j = 0; j < w; j++)
-                    line[j] = buffer[w - 1 - j];
-            }
-            break;
-        case 16:
-            for (i = 0; i < h; i++) {
-                line = data + i * wpl;
-                memcpy(buffer, line, bpl);
-                for (j = 0; j < w; j++) {
-                    val = GET_DATA_TWO_BYTES(buffer, w - 1 - j);
-                    SET_DATA_TWO_BYTES(line, j, val);
-                }
-            }
-            break;
-        case 8:
-            for (i = 0; i < h; i++) {
-                line = data + i * wpl;
-                memcpy(buffer, line, bpl);
-                for (j = 0; j < w; j++) {
-                    val = GET_DATA_BYTE(buffer, w - 1 - j);
-                    SET_DATA_BYTE(line, j, val);
-                }
-            }
-            break;
-        case 4:
-            extra = (w * d) & 31;
-            if (extra)
-                shift = 8 - extra / 4;
-            else
-                shift = 0;
-            if (shift)
-                rasteropHipLow(data, h, d, wpl, 0, h, shift);
-
-            databpl = (w + 1) / 2;
-            for (i = 0; i < h; i++) {
-                line = data + i * wpl;
-                memcpy(buffer, line, bpl);
-                for (j = 0; j < databpl; j++) {
-                    val = GET_DATA_BYTE(buffer, bpl - 1 - j);
-                    SET_DATA_BYTE(line, j, tab[val]);
-                }
-            }
-            break;
-        case 2:
-            extra = (w * d) & 31;
-            if (extra)
-                shift = 16 - extra / 2;
-            else
-                shift = 0;
-            if (shift)
-                rasteropHipLow(data, h, d, wpl, 0, h, shift);
-
-            databpl = (w + 3) / 4;
-            for (i = 0; i < h; i++) {
-                line = data + i * wpl;
-                memcpy(buffer, line, bpl);
-                for (j = 0; j < databpl; j++) {
-                    val = GET_DATA_BYTE(buffer, bpl - 1 - j);
-                    SET_DATA_BYTE(line, j, tab[val]);
-                }
-            }
-            break;
-        case 1:
-            extra = (w * d) & 31;
-            if (extra)
-                shift = 32 - extra;
-            else
-                shift = 0;
-            if (shift)
-                rasteropHipLow(data, h, d, wpl, 0, h, shift);
-
-            databpl = (w + 7) / 8;
-            for (i = 0; i < h; i++) {
-                line = data + i * wpl;
-                memcpy(buffer, line, bpl);
-                for (j = 0; j < databpl; j++) {
-                    val = GET_DATA_BYTE(buffer, bpl - 1 - j);
-                    SET_DATA_BYTE(line, j, tab[val]);
-                }
+    if (d != 1 && d != 2 && d != 4 && d != 8 && d != 16 && d != 32) {
+        L_ERROR("depth not permitted for LR rot", procName);
+        return;
+    }
+
+    if (d == 32) {
+        for (i = 0; i < h; i++) {
+            line = data + i * wpl;
+            for (j = 0, k = w - 1; j < k; j++, k--) {
+                val = line[j];
+                line[j] = line[k];
+                line[k] = val;
             }
-            break;
-        default:
-            L_ERROR("depth not permitted for LR rot", procName);
-            return;
+        }
+        return;
+    }
+
+        /* Right-justify the image data in each line */
+    extra = (w * d) & 31;
+    if (extra)
+        shift = (32 - extra) / d;
+    else
+        shift = 0;
+    if (shift)
+        rasteropHipLow(data, h, d, wpl, 0, h, shift);
+
+    nw = (w * d + 31) / 32;
+    for (i = 0; i < h; i++) {
+        line = data + i * wpl;
+        for (j = 0, k = nw - 1; j < k; j++, k--) {
+            val = reverseWordPixels(line[j], d);
+            line[j] = reverseWordPixels(line[k], d);
+            line[k] = val;
+        }
+        if (j == k)  /* odd number of words; reverse the middle one */
+            line[j] = reverseWordPixels(line[j], d);
     }
 
     return;
 }
 
 
+/*!
+ *  reverseWordPixels()
+ *
+ *      Input:  word
+ *              d (depth of the pixels in the word: 1, 2, 4, 8 or 16)
+ *      Return: word with the order of the pixels reversed
+ *
+ *  Notes:
+ *      (1) Swap adjacent pixels, then adjacent pairs, and so on up
+ *          to the two 16 bit halves, skipping the swaps of fields
+ *          smaller than a pixel.
+ */
+static l_uint32
+reverseWordPixels(l_uint32  word,
+                  l_int32   d)
+{
+    if (d == 1)
+        word = ((word >> 1) & 0x55555555) | ((word & 0x55555555) << 1);
+    if (d <= 2)
+        word = ((word >> 2) & 0x33333333) | ((word & 0x33333333) << 2);
+    if (d <= 4)
+        word = ((word >> 4) & 0x0f0f0f0f) | ((word & 0x0f0f0f0f) << 4);
+    if (d <= 8)
+        word = ((word >> 8) & 0x00ff00ff) | ((word & 0x00ff00ff) << 8);
+    return (word >> 16) | (word << 16);
+}
+
+
 /*------------------------------------------------------------------*
  *                            Top/bottom flip                       *
  *------------------------------------------------------------------*/
@@ -73,6 +73,9 @@
  *          SARRAY    *sarraySelectByRange()
  *          l_int32    sarrayParseRange()
  *
+ *      Remove duplicates
+ *          SARRAY    *sarrayRemoveDupsByHash()
+ *
  *      Sort
  *          SARRAY    *sarraySort()
  *          l_int32    stringCompareLexical()
@@ -137,6 +140,9 @@
 static const l_int32  INITIAL_PTR_ARRAYSIZE = 50;     /* n'importe quoi */
 static const l_int32  L_BUF_SIZE = 512;
 
+static void sarrayMergeSortArray(char **array, char **temp, l_int32 n,
+                                 l_int32 sortorder);
+
 
 /*--------------------------------------------------------------------------*
  *                   String array create/destroy/copy/extend                *
@@ -1304,6 +1310,52 @@ l_int32  n, i, offset, found;
 }
 
 
+/*----------------------------------------------------------------------*
+ *                          Remove duplicates                           *
+ *----------------------------------------------------------------------*/
+/*!
+ *  sarrayRemoveDupsByHash()
+ *
+ *      Input:  sain (input sarray)
+ *      Return: saout (output sarray, without duplicate strings),
+ *              or null on error
+ *
+ *  Notes:
+ *      (1) This makes @saout with a copy of the first occurrence of
+ *          each string in @sain, in the order they appear in @sain.
+ *      (2) The strings are stored in a hash map, so the time is
+ *          linear in the number of strings.
+ */
+SARRAY *
+sarrayRemoveDupsByHash(SARRAY  *sain)
+{
+char        *str;
+l_int32      n, i;
+L_HASHITEM  *item;
+L_HASHMAP   *hmap;
+SARRAY      *saout;
+
+    PROCNAME("sarrayRemoveDupsByHash");
+
+    if (!sain)
+        return (SARRAY *)ERROR_PTR("sain not defined", procName, NULL);
+
+    n = sarrayGetCount(sain);
+    if ((hmap = l_hmapCreate(n, L_HMAP_STRING_KEY)) == NULL)
+        return (SARRAY *)ERROR_PTR("hmap not made", procName, NULL);
+    saout = sarrayCreate(n);
+    for (i = 0; i < n; i++) {
+        str = sarrayGetString(sain, i, L_NOCOPY);
+        item = l_hmapLookupString(hmap, str, L_HMAP_CREATE);
+        if (item && item->count == 1)  /* first occurrence */
+            sarrayAddString(saout, str, L_COPY);
+    }
+
+    l_hmapDestroy(&hmap);
+    return saout;
+}
+
+
 /*----------------------------------------------------------------------*
  *                                   Sort                               *
  *----------------------------------------------------------------------*/
@@ -1317,17 +1369,17 @@ l_int32  n, i, offset, found;
  *
  *  Notes:
  *      (1) Set saout = sain for in-place; otherwise, set naout = NULL.
- *      (2) Shell sort, modified from K&R, 2nd edition, p.62.
- *          Slow but simple O(n logn) sort.
+ *      (2) This is a bottom-up merge sort on the string ptrs.  It is
+ *          O(n logn) in the number of string comparisons, even in the
+ *          worst case, and is stable.
  */
 SARRAY *
 sarraySort(SARRAY  *saout,
            SARRAY  *sain,
            l_int32  sortorder)
 {
-char   **array;
-char    *tmp;
-l_int32  n, i, j, gap;
+char   **array, **temp;
+l_int32  n;
 
     PROCNAME("sarraySort");
 
@@ -1341,25 +1393,68 @@ l_int32  n, i, j, gap;
         return (SARRAY *)ERROR_PTR("invalid: not in-place", procName, NULL);
     array = saout->array;  /* operate directly on the array */
     n = sarrayGetCount(saout);
+    if (n < 2)
+        return saout;
+
+    if ((temp = (char **)CALLOC(n, sizeof(char *))) == NULL)
+        return (SARRAY *)ERROR_PTR("temp not made", procName, NULL);
+    sarrayMergeSortArray(array, temp, n, sortorder);
+    FREE(temp);
+    return saout;
+}
 
-        /* Shell sort */
-    for (gap = n/2; gap > 0; gap = gap / 2) {
-        for (i = gap; i < n; i++) {
-            for (j = i - gap; j >= 0; j -= gap) {
-                if ((sortorder == L_SORT_INCREASING &&
-                     stringCompareLexical(array[j], array[j + gap])) ||
-                    (sortorder == L_SORT_DECREASING &&
-                     stringCompareLexical(array[j + gap], array[j])))
-                {
-                    tmp = array[j];
-                    array[j] = array[j + gap];
-                    array[j + gap] = tmp;
-                }
+
+/*!
+ *  sarrayMergeSortArray()
+ *
+ *      Input:  array (of string ptrs, sorted in-place)
+ *              temp (work array of n ptrs)
+ *              n (number of strings)
+ *              sortorder (L_SORT_INCREASING or L_SORT_DECREASING)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) Runs of width 1, 2, 4, ... are merged alternately from
+ *          @array to @temp and back.  A string is taken from the
+ *          right run only if it strictly precedes the string at the
+ *          head of the left run, so equal strings keep their order.
+ */
+static void
+sarrayMergeSortArray(char   **array,
+                     char   **temp,
+                     l_int32  n,
+                     l_int32  sortorder)
+{
+char   **src, **dst, **tmp;
+l_int32  width, lo, mid, hi, i, j, k, takeright;
+
+    src = array;
+    dst = temp;
+    for (width = 1; width < n; width *= 2) {
+        for (lo = 0; lo < n; lo += 2 * width) {
+            mid = L_MIN(lo + width, n);
+            hi = L_MIN(lo + 2 * width, n);
+            i = lo;
+            j = mid;
+            for (k = lo; k < hi; k++) {
+                if (i >= mid)
+                    takeright = TRUE;
+                else if (j >= hi)
+                    takeright = FALSE;
+                else if (sortorder == L_SORT_INCREASING)
+                    takeright = stringCompareLexical(src[i], src[j]);
+                else
+                    takeright = stringCompareLexical(src[j], src[i]);
+                dst[k] = (takeright) ? src[j++] : src[i++];
             }
         }
+        tmp = src; src = dst; dst = tmp;
     }
 
-    return saout;
+        /* Copy back if the last merge went to temp */
+    if (src != array)
+        memcpy(array, src, n * sizeof(char *));
+    return;
 }
 
 
@@ -430,10 +430,11 @@ pixScaleColorLI(PIX      *pixs,
                l_float32  scalex,
                l_float32  scaley)
 {
-l_int32    ws, hs, wpls, wd, hd, wpld;
-l_uint32  *datas, *datad;
-l_float32  maxscale;
-PIX       *pixd;
+l_int32          ws, hs, wpls, wd, hd, wpld;
+l_uint32        *datas, *datad;
+l_float32        maxscale;
+PIX             *pixd;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixScaleColorLI");
 
@@ -465,7 +466,8 @@ PIX       *pixd;
     pixScaleResolution(pixd, scalex, scaley);
     datad = pixGetData(pixd);
     wpld = pixGetWpl(pixd);
-    scaleColorLILow(datad, wd, hd, wpld, datas, ws, hs, wpls);
+    dispatch = l_cpuGetDispatch();
+    dispatch->scaleColorLILow(datad, wd, hd, wpld, datas, ws, hs, wpls);
     return pixd;
 }
 
@@ -641,10 +643,11 @@ pixScaleGrayLI(PIX       *pixs,
                l_float32  scalex,
                l_float32  scaley)
 {
-l_int32    ws, hs, wpls, wd, hd, wpld;
-l_uint32  *datas, *datad;
-l_float32  maxscale;
-PIX       *pixd;
+l_int32          ws, hs, wpls, wd, hd, wpld;
+l_uint32        *datas, *datad;
+l_float32        maxscale;
+PIX             *pixd;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixScaleGrayLI");
 
@@ -678,7 +681,8 @@ PIX       *pixd;
     pixScaleResolution(pixd, scalex, scaley);
     datad = pixGetData(pixd);
     wpld = pixGetWpl(pixd);
-    scaleGrayLILow(datad, wd, hd, wpld, datas, ws, hs, wpls);
+    dispatch = l_cpuGetDispatch();
+    dispatch->scaleGrayLILow(datad, wd, hd, wpld, datas, ws, hs, wpls);
     return pixd;
 }
 
@@ -1238,10 +1242,11 @@ pixScaleAreaMap(PIX       *pix,
                 l_float32  scalex,
                 l_float32  scaley)
 {
-l_int32    ws, hs, d, wd, hd, wpls, wpld;
-l_uint32  *datas, *datad;
-l_float32  maxscale;
-PIX       *pixs, *pixd, *pixt1, *pixt2, *pixt3;
+l_int32          ws, hs, d, wd, hd, wpls, wpld;
+l_uint32        *datas, *datad;
+l_float32        maxscale;
+PIX             *pixs, *pixd, *pixt1, *pixt2, *pixt3;
+L_CPU_DISPATCH  *dispatch;
 
     PROCNAME("pixScaleAreaMap");
 
@@ -1315,10 +1320,13 @@ PIX       *pixs, *pixd, *pixt1, *pixt2, *pixt3;
     pixScaleResolution(pixd, scalex, scaley);
     datad = pixGetData(pixd);
     wpld = pixGetWpl(pixd);
+    dispatch = l_cpuGetDispatch();
     if (d == 8)
-        scaleGrayAreaMapLow(datad, wd, hd, wpld, datas, ws, hs, wpls);
+        dispatch->scaleGrayAreaMapLow(datad, wd, hd, wpld, datas, ws, hs,
+                                      wpls);
     else  /* RGB, d == 32 */
-        scaleColorAreaMapLow(datad, wd, hd, wpld, datas, ws, hs, wpls);
+        dispatch->scaleColorAreaMapLow(datad, wd, hd, wpld, datas, ws, hs,
+                                       wpls);
 
     pixDestroy(&pixs);
     return pixd;
@@ -1706,7 +1714,6 @@ pixScaleToGray2(PIX  *pixs)
 l_uint8   *valtab;
 l_int32    ws, hs, wd, hd;
 l_int32    wpld, wpls;
-l_uint32  *sumtab;
 l_uint32  *datas, *datad;
 PIX       *pixd;
 
@@ -1732,14 +1739,11 @@ PIX       *pixd;
     wpls = pixGetWpl(pixs);
     wpld = pixGetWpl(pixd);
 
-    if ((sumtab = makeSumTabSG2()) == NULL)
-        return (PIX *)ERROR_PTR("sumtab not made", procName, NULL);
     if ((valtab = makeValTabSG2()) == NULL)
         return (PIX *)ERROR_PTR("valtab not made", procName, NULL);
 
-    scaleToGray2Low(datad, wd, hd, wpld, datas, wpls, sumtab, valtab);
+    scaleToGray2Low(datad, wd, hd, wpld, datas, wpls, valtab);
 
-    FREE(sumtab);
     FREE(valtab);
     return pixd;
 }
@@ -1819,7 +1823,6 @@ pixScaleToGray4(PIX  *pixs)
 l_uint8   *valtab;
 l_int32    ws, hs, wd, hd;
 l_int32    wpld, wpls;
-l_uint32  *sumtab;
 l_uint32  *datas, *datad;
 PIX       *pixd;
 
@@ -1845,14 +1848,11 @@ PIX       *pixd;
     wpls = pixGetWpl(pixs);
     wpld = pixGetWpl(pixd);
 
-    if ((sumtab = makeSumTabSG4()) == NULL)
-        return (PIX *)ERROR_PTR("sumtab not made", procName, NULL);
     if ((valtab = makeValTabSG4()) == NULL)
         return (PIX *)ERROR_PTR("valtab not made", procName, NULL);
 
-    scaleToGray4Low(datad, wd, hd, wpld, datas, wpls, sumtab, valtab);
+    scaleToGray4Low(datad, wd, hd, wpld, datas, wpls, valtab);
 
-    FREE(sumtab);
     FREE(valtab);
     return pixd;
 }
@@ -1926,7 +1926,6 @@ pixScaleToGray8(PIX  *pixs)
 l_uint8   *valtab;
 l_int32    ws, hs, wd, hd;
 l_int32    wpld, wpls;
-l_int32   *tab8;
 l_uint32  *datas, *datad;
 PIX       *pixd;
 
@@ -1952,14 +1951,11 @@ PIX       *pixd;
     wpls = pixGetWpl(pixs);
     wpld = pixGetWpl(pixd);
 
-    if ((tab8 = makePixelSumTab8()) == NULL)
-        return (PIX *)ERROR_PTR("tab8 not made", procName, NULL);
     if ((valtab = makeValTabSG8()) == NULL)
         return (PIX *)ERROR_PTR("valtab not made", procName, NULL);
 
-    scaleToGray8Low(datad, wd, hd, wpld, datas, wpls, tab8, valtab);
+    scaleToGray8Low(datad, wd, hd, wpld, datas, wpls, valtab);
 
-    FREE(tab8);
     FREE(valtab);
     return pixd;
 }
@@ -1977,7 +1973,6 @@ pixScaleToGray16(PIX  *pixs)
 {
 l_int32    ws, hs, wd, hd;
 l_int32    wpld, wpls;
-l_int32   *tab8;
 l_uint32  *datas, *datad;
 PIX       *pixd;
 
@@ -2003,12 +1998,8 @@ PIX       *pixd;
     wpls = pixGetWpl(pixs);
     wpld = pixGetWpl(pixd);
 
-    if ((tab8 = makePixelSumTab8()) == NULL)
-        return (PIX *)ERROR_PTR("tab8 not made", procName, NULL);
-
-    scaleToGray16Low(datad, wd, hd, wpld, datas, wpls, tab8);
+    scaleToGray16Low(datad, wd, hd, wpld, datas, wpls);
 
-    FREE(tab8);
     return pixd;
 }
 
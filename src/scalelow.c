@@ -95,6 +95,9 @@
 #include <string.h>
 #include "allheaders.h"
 
+static void scaleToGray2Sums(l_uint32 word1, l_uint32 word2,
+                             l_uint32 *pe, l_uint32 *po);
+
 #ifndef  NO_CONSOLE_IO
 #define  DEBUG_OVERFLOW   0
 #define  DEBUG_UNROLLING  0
@@ -1691,19 +1694,16 @@ l_float32  wratio, hratio;
  *  scaleToGray2Low()
  *
  *      Input:  usual image variables
- *              sumtab  (made from makeSumTabSG2())
  *              valtab  (made from makeValTabSG2())
  *      Return: 0 if OK; 1 on error.
  *
- *  The output is processed in sets of 4 output bytes on a row,
- *  corresponding to 4 2x2 bit-blocks in the input image.
- *  Two lookup tables are used.  The first, sumtab, gets the
- *  sum of ON pixels in 4 sets of two adjacent bits,
- *  storing the result in 4 adjacent bytes.  After sums from
- *  two rows have been added, the second table, valtab,
- *  converts from the sum of ON pixels in the 2x2 block to
- *  an 8 bpp grayscale value between 0 (for 4 bits ON)
- *  and 255 (for 0 bits ON).
+ *  The output is processed in sets of 16 output bytes on a row,
+ *  corresponding to the 16 2x2 bit-blocks in one src word from
+ *  each of two lines.  The ON pixels in each block are counted
+ *  in parallel within the word, using shifts and masks, without
+ *  a lookup table.  The lookup table valtab then converts from
+ *  the sum of ON pixels in the 2x2 block to an 8 bpp grayscale
+ *  value between 0 (for 4 bits ON) and 255 (for 0 bits ON).
  */
 void
 scaleToGray2Low(l_uint32  *datad,
@@ -1712,49 +1712,82 @@ scaleToGray2Low(l_uint32  *datad,
                 l_int32    wpld,
                 l_uint32  *datas,
                 l_int32    wpls,
-                l_uint32  *sumtab,
                 l_uint8   *valtab)
 {
-l_int32    i, j, l, k, m, wd4, extra;
-l_uint32   sbyte1, sbyte2, sum;
+l_int32    i, j, l, c, q, nwd, shift;
+l_uint32   e, o, sum;
 l_uint32  *lines, *lined;
 
         /* i indexes the dest lines
          * l indexes the source lines
-         * j indexes the dest bytes
-         * k indexes the source bytes
-         * We take two bytes from the source (in 2 lines of 8 pixels
-         * each) and convert them into four 8 bpp bytes of the dest. */
-    wd4 = wd & 0xfffffffc;
-    extra = wd - wd4;
+         * c indexes the source words
+         * We take one word from each of 2 source lines (16 2x2 blocks),
+         * and convert it into four 8 bpp words of the dest.  Counts
+         * for adjacent pixel pairs are made in 2-bit fields, and then
+         * the two lines are summed in 4-bit fields, separately for the
+         * odd (o) and even (e) blocks, so that nothing overflows. */
+    nwd = wd / 4;  /* full dest words */
     for (i = 0, l = 0; i < hd; i++, l += 2) {
         lines = datas + l * wpls;
         lined = datad + i * wpld;
-        for (j = 0, k = 0; j < wd4; j += 4, k++) {
-            sbyte1 = GET_DATA_BYTE(lines, k);
-            sbyte2 = GET_DATA_BYTE(lines + wpls, k);
-            sum = sumtab[sbyte1] + sumtab[sbyte2];
-            SET_DATA_BYTE(lined, j, valtab[sum >> 24]);
-            SET_DATA_BYTE(lined, j + 1, valtab[(sum >> 16) & 0xff]);
-            SET_DATA_BYTE(lined, j + 2, valtab[(sum >> 8) & 0xff]);
-            SET_DATA_BYTE(lined, j + 3, valtab[sum & 0xff]);
-        }
-        if (extra > 0) {
-            sbyte1 = GET_DATA_BYTE(lines, k);
-            sbyte2 = GET_DATA_BYTE(lines + wpls, k);
-            sum = sumtab[sbyte1] + sumtab[sbyte2];
-            for (m = 0; m < extra; m++) {
-                SET_DATA_BYTE(lined, j + m,
-                              valtab[((sum >> (24 - 8 * m)) & 0xff)]);
+        for (c = 0; 4 * c < wd; c++) {
+            scaleToGray2Sums(lines[c], lines[wpls + c], &e, &o);
+            for (q = 0; q < 4; q++) {
+                j = 4 * (4 * c + q);  /* first dest pixel */
+                if (j >= wd) break;
+                shift = 28 - 8 * q;
+                if (4 * c + q < nwd) {
+                    lined[4 * c + q] =
+                        (valtab[(o >> shift) & 0xf] << 24) |
+                        (valtab[(e >> shift) & 0xf] << 16) |
+                        (valtab[(o >> (shift - 4)) & 0xf] << 8) |
+                        valtab[(e >> (shift - 4)) & 0xf];
+                }
+                else {  /* partial word at the end of the line */
+                    sum = ((o >> shift) & 0xf) << 24 |
+                          ((e >> shift) & 0xf) << 16 |
+                          ((o >> (shift - 4)) & 0xf) << 8 |
+                          ((e >> (shift - 4)) & 0xf);
+                    for (; j < wd; j++)
+                        SET_DATA_BYTE(lined, j,
+                               valtab[(sum >> (24 - 8 * (j & 3))) & 0xff]);
+                }
             }
         }
-
     }
 
     return;
 }
 
 
+/*!
+ *  scaleToGray2Sums()
+ *
+ *      Input:  word1, word2 (corresponding src words in 2 adjacent lines)
+ *              &e (<return> sums of pixels in the odd-numbered 2x2
+ *                  blocks, in 4-bit fields)
+ *              &o (<return> sums of pixels in the even-numbered 2x2
+ *                  blocks, in 4-bit fields)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) Block 0 is at the MSB end; its sum is in the top 4 bits of o.
+ *          Block 1 is in the top 4 bits of e, and so on.
+ */
+static void
+scaleToGray2Sums(l_uint32   word1,
+                 l_uint32   word2,
+                 l_uint32  *pe,
+                 l_uint32  *po)
+{
+    word1 = (word1 & 0x55555555) + ((word1 >> 1) & 0x55555555);
+    word2 = (word2 & 0x55555555) + ((word2 >> 1) & 0x55555555);
+    *pe = (word1 & 0x33333333) + (word2 & 0x33333333);
+    *po = ((word1 >> 2) & 0x33333333) + ((word2 >> 2) & 0x33333333);
+    return;
+}
+
+
 /*!
  *  makeSumTabSG2()
  *
@@ -1975,19 +2008,17 @@ l_uint8  *tab;
  *  scaleToGray4Low()
  *
  *      Input:  usual image variables
- *              sumtab  (made from makeSumTabSG4())
  *              valtab  (made from makeValTabSG4())
  *      Return: 0 if OK; 1 on error.
  *
- *  The output is processed in sets of 2 output bytes on a row,
- *  corresponding to 2 4x4 bit-blocks in the input image.
- *  Two lookup tables are used.  The first, sumtab, gets the
- *  sum of ON pixels in two sets of four adjacent bits,
- *  storing the result in 2 adjacent bytes.  After sums from
- *  four rows have been added, the second table, valtab,
- *  converts from the sum of ON pixels in the 4x4 block to
- *  an 8 bpp grayscale value between 0 (for 16 bits ON)
- *  and 255 (for 0 bits ON).
+ *  The output is processed in sets of 8 output bytes on a row,
+ *  corresponding to the 8 4x4 bit-blocks in one src word from
+ *  each of four lines.  The ON pixels in each set of 4 adjacent
+ *  bits are counted in parallel within the word, and the counts
+ *  from the four lines are summed in byte fields.  The lookup
+ *  table valtab then converts from the sum of ON pixels in the
+ *  4x4 block to an 8 bpp grayscale value between 0 (for 16 bits
+ *  ON) and 255 (for 0 bits ON).
  */
 void
 scaleToGray4Low(l_uint32  *datad,
@@ -1996,31 +2027,49 @@ scaleToGray4Low(l_uint32  *datad,
                 l_int32    wpld,
                 l_uint32  *datas,
                 l_int32    wpls,
-                l_uint32  *sumtab,
                 l_uint8   *valtab)
 {
-l_int32    i, j, l, k;
-l_uint32   sbyte1, sbyte2, sbyte3, sbyte4, sum;
+l_int32    i, j, k, l, c, q, nwd, shift;
+l_uint32   word, e, o;
 l_uint32  *lines, *lined;
 
         /* i indexes the dest lines
          * l indexes the source lines
-         * j indexes the dest bytes
-         * k indexes the source bytes
-         * We take four bytes from the source (in 4 lines of 8 pixels
-         * each) and convert it into two 8 bpp bytes of the dest. */
+         * c indexes the source words
+         * We take one word from each of 4 source lines (8 4x4 blocks)
+         * and convert it into two 8 bpp words of the dest.  The counts
+         * in each 4-bit field of each line are summed into 8-bit fields,
+         * separately for the even (o) and odd (e) blocks. */
+    nwd = wd / 4;  /* full dest words */
     for (i = 0, l = 0; i < hd; i++, l += 4) {
         lines = datas + l * wpls;
         lined = datad + i * wpld;
-        for (j = 0, k = 0; j < wd; j += 2, k++) {
-            sbyte1 = GET_DATA_BYTE(lines, k);
-            sbyte2 = GET_DATA_BYTE(lines + wpls, k);
-            sbyte3 = GET_DATA_BYTE(lines + 2 * wpls, k);
-            sbyte4 = GET_DATA_BYTE(lines + 3 * wpls, k);
-            sum = sumtab[sbyte1] + sumtab[sbyte2] +
-                  sumtab[sbyte3] + sumtab[sbyte4];
-            SET_DATA_BYTE(lined, j, valtab[GET_DATA_BYTE(&sum, 2)]);
-            SET_DATA_BYTE(lined, j + 1, valtab[GET_DATA_BYTE(&sum, 3)]);
+        for (c = 0; 8 * c < wd; c++) {
+            e = o = 0;
+            for (k = 0; k < 4; k++) {
+                word = lines[k * wpls + c];
+                word = word - ((word >> 1) & 0x55555555);
+                word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+                e += word & 0x0f0f0f0f;
+                o += (word >> 4) & 0x0f0f0f0f;
+            }
+            for (q = 0; q < 2; q++) {
+                shift = 24 - 16 * q;
+                if (2 * c + q < nwd) {
+                    lined[2 * c + q] =
+                        (valtab[(o >> shift) & 0xff] << 24) |
+                        (valtab[(e >> shift) & 0xff] << 16) |
+                        (valtab[(o >> (shift - 8)) & 0xff] << 8) |
+                        valtab[(e >> (shift - 8)) & 0xff];
+                }
+                else {  /* partial word at the end of the line */
+                    for (j = 4 * (2 * c + q); j < wd; j++) {
+                        word = (j & 1) ? e : o;
+                        SET_DATA_BYTE(lined, j,
+                               valtab[(word >> (24 - 8 * ((j & 7) / 2))) & 0xff]);
+                    }
+                }
+            }
         }
     }
 
@@ -2237,15 +2286,14 @@ l_uint8  *tab;
  *  scaleToGray8Low()
  *
  *      Input:  usual image variables
- *              tab8  (made from makePixelSumTab8())
  *              valtab  (made from makeValTabSG8())
  *      Return: 0 if OK; 1 on error.
  *
- *  The output is processed one dest byte at a time,
- *  corresponding to 8 rows of src bytes in the input image.
- *  Two lookup tables are used.  The first, tab8, gets the
- *  sum of ON pixels in a byte.  After sums from 8 rows have
- *  been added, the second table, valtab, converts from this
+ *  The output is processed one dest word at a time,
+ *  corresponding to 8 rows of one src word in the input image.
+ *  The ON pixels in each byte of the src word are counted in
+ *  parallel, and the counts from 8 rows are summed in byte
+ *  fields.  The lookup table valtab then converts from this
  *  value (which is between 0 and 64) to an 8 bpp grayscale
  *  value between 0 (for all 64 bits ON) and 255 (for 0 bits ON).
  */
@@ -2256,35 +2304,41 @@ scaleToGray8Low(l_uint32  *datad,
                 l_int32    wpld,
                 l_uint32  *datas,
                 l_int32    wpls,
-                l_int32   *tab8,
                 l_uint8   *valtab)
 {
-l_int32    i, j, k;
-l_int32    sbyte0, sbyte1, sbyte2, sbyte3, sbyte4, sbyte5, sbyte6, sbyte7, sum;
+l_int32    i, j, k, l, c, nwd;
+l_uint32   word, sum;
 l_uint32  *lines, *lined;
 
         /* i indexes the dest lines
-         * k indexes the source lines
-         * j indexes the src and dest bytes
-         * We take 8 bytes from the source (in 8 lines of 8 pixels
-         * each) and convert it into one 8 bpp byte of the dest. */
-    for (i = 0, k = 0; i < hd; i++, k += 8) {
-        lines = datas + k * wpls;
+         * l indexes the source lines
+         * c indexes the src and dest words
+         * We take one word from each of 8 source lines (4 8x8 blocks)
+         * and convert it into one 8 bpp word of the dest.  The pixel
+         * counts of each line are made in 8-bit fields and summed. */
+    nwd = wd / 4;  /* full dest words */
+    for (i = 0, l = 0; i < hd; i++, l += 8) {
+        lines = datas + l * wpls;
         lined = datad + i * wpld;
-        for (j = 0; j < wd; j++) {
-            sbyte0 = GET_DATA_BYTE(lines, j);
-            sbyte1 = GET_DATA_BYTE(lines + wpls, j);
-            sbyte2 = GET_DATA_BYTE(lines + 2 * wpls, j);
-            sbyte3 = GET_DATA_BYTE(lines + 3 * wpls, j);
-            sbyte4 = GET_DATA_BYTE(lines + 4 * wpls, j);
-            sbyte5 = GET_DATA_BYTE(lines + 5 * wpls, j);
-            sbyte6 = GET_DATA_BYTE(lines + 6 * wpls, j);
-            sbyte7 = GET_DATA_BYTE(lines + 7 * wpls, j);
-            sum = tab8[sbyte0] + tab8[sbyte1] +
-                  tab8[sbyte2] + tab8[sbyte3] +
-                  tab8[sbyte4] + tab8[sbyte5] +
-                  tab8[sbyte6] + tab8[sbyte7];
-            SET_DATA_BYTE(lined, j, valtab[sum]);
+        for (c = 0; 4 * c < wd; c++) {
+            sum = 0;
+            for (k = 0; k < 8; k++) {
+                word = lines[k * wpls + c];
+                word = word - ((word >> 1) & 0x55555555);
+                word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+                sum += (word + (word >> 4)) & 0x0f0f0f0f;
+            }
+            if (c < nwd) {
+                lined[c] = (valtab[sum >> 24] << 24) |
+                           (valtab[(sum >> 16) & 0xff] << 16) |
+                           (valtab[(sum >> 8) & 0xff] << 8) |
+                           valtab[sum & 0xff];
+            }
+            else {  /* partial word at the end of the line */
+                for (j = 4 * c; j < wd; j++)
+                    SET_DATA_BYTE(lined, j,
+                                  valtab[(sum >> (24 - 8 * (j & 3))) & 0xff]);
+            }
         }
     }
 
@@ -2325,75 +2379,53 @@ l_uint8  *tab;
  *  scaleToGray16Low()
  *
  *      Input:  usual image variables
- *              tab8  (made from makePixelSumTab8())
  *      Return: 0 if OK; 1 on error.
  *
- *  The output is processed one dest byte at a time, corresponding
- *  to 16 rows consisting each of 2 src bytes in the input image.
- *  This uses one lookup table, tab8, which gives the sum of
- *  ON pixels in a byte.  After summing for all ON pixels in the
- *  32 src bytes, which is between 0 and 256, this is converted
+ *  The output is processed two dest bytes at a time, corresponding
+ *  to 16 rows of one src word in the input image.  The ON pixels
+ *  in each byte of the src word are counted in parallel, and the
+ *  counts from 16 rows are summed in byte fields.  The sum for
+ *  each pair of bytes, which is between 0 and 256, is converted
  *  to an 8 bpp grayscale value between 0 (for 255 or 256 bits ON)
  *  and 255 (for 0 bits ON).
  */
 void
 scaleToGray16Low(l_uint32  *datad,
-                  l_int32    wd,
+                 l_int32    wd,
                  l_int32    hd,
                  l_int32    wpld,
                  l_uint32  *datas,
-                 l_int32    wpls,
-                 l_int32   *tab8)
+                 l_int32    wpls)
 {
-l_int32    i, j, k, m;
-l_int32    sum;
+l_int32    i, j, k, l, c, val;
+l_uint32   word, sum;
 l_uint32  *lines, *lined;
 
         /* i indexes the dest lines
-         * k indexes the source lines
-         * j indexes the dest bytes
-         * m indexes the src bytes
-         * We take 32 bytes from the source (in 16 lines of 16 pixels
-         * each) and convert it into one 8 bpp byte of the dest. */
-    for (i = 0, k = 0; i < hd; i++, k += 16) {
-        lines = datas + k * wpls;
+         * l indexes the source lines
+         * c indexes the src words
+         * We take one word from each of 16 source lines (2 16x16 blocks)
+         * and convert it into two 8 bpp bytes of the dest.  The pixel
+         * counts of each line are made in 8-bit fields and summed;
+         * each 8-bit field can hold the sum (at most 128) over 16 lines. */
+    for (i = 0, l = 0; i < hd; i++, l += 16) {
+        lines = datas + l * wpls;
         lined = datad + i * wpld;
-        for (j = 0; j < wd; j++) {
-            m = 2 * j;
-            sum = tab8[GET_DATA_BYTE(lines, m)];
-            sum += tab8[GET_DATA_BYTE(lines, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 2 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 2 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 3 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 3 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 4 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 4 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 5 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 5 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 6 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 6 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 7 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 7 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 8 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 8 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 9 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 9 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 10 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 10 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 11 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 11 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 12 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 12 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 13 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 13 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 14 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 14 * wpls, m + 1)];
-            sum += tab8[GET_DATA_BYTE(lines + 15 * wpls, m)];
-            sum += tab8[GET_DATA_BYTE(lines + 15 * wpls, m + 1)];
-            sum = L_MIN(sum, 255);
-            SET_DATA_BYTE(lined, j, 255 - sum);
+        for (c = 0; 2 * c < wd; c++) {
+            sum = 0;
+            for (k = 0; k < 16; k++) {
+                word = lines[k * wpls + c];
+                word = word - ((word >> 1) & 0x55555555);
+                word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+                sum += (word + (word >> 4)) & 0x0f0f0f0f;
+            }
+            j = 2 * c;
+            val = (sum >> 24) + ((sum >> 16) & 0xff);
+            SET_DATA_BYTE(lined, j, 255 - L_MIN(val, 255));
+            if (j + 1 < wd) {
+                val = ((sum >> 8) & 0xff) + (sum & 0xff);
+                SET_DATA_BYTE(lined, j + 1, 255 - L_MIN(val, 255));
+            }
         }
     }
 
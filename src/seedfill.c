@@ -55,6 +55,10 @@
  *      Distance function (source: Luc Vincent)
  *               PIX      *pixDistanceFunction()
  *
+ *      Exact Euclidean distance (source: Meijster et al)
+ *               PIX      *pixEuclideanDistance()
+ *               FPIX     *pixEuclideanDistanceFPix()
+ *
  *      Seed spread (based on distance function)
  *               PIX      *pixSeedspread()
  *
@@ -153,6 +157,7 @@
  *              setting the out-of-bound pixels in m to OFF.)
  */
 
+#include <math.h>
 #include "allheaders.h"
 
 #ifndef  NO_CONSOLE_IO
@@ -1001,6 +1006,140 @@ PIX       *pixd;
 }
 
 
+/*-----------------------------------------------------------------------*
+ *                       Exact Euclidean distance                        *
+ *-----------------------------------------------------------------------*/
+/*!
+ *  pixEuclideanDistance()
+ *
+ *      Input:  pixs  (1 bpp source)
+ *              boundcond (L_BOUNDARY_BG, L_BOUNDARY_FG)
+ *      Return: pixd (32 bpp, squared distance), or null on error
+ *
+ *  Notes:
+ *      (1) This computes the square of the exact Euclidean distance
+ *          of each pixel from the nearest background pixel.  All bg
+ *          pixels have a distance of 0.  As with pixDistanceFunction(),
+ *          invert the input to get the distance from the nearest
+ *          fg pixel.
+ *      (2) With L_BOUNDARY_BG, all pixels outside the image are taken
+ *          to be bg, so the distance to the nearest image edge is
+ *          an upper bound.  With L_BOUNDARY_FG, only the bg pixels
+ *          in the image are used, and it is an error if there are none.
+ *      (3) The algorithm (A. Meijster, J. Roerdink and W. Hesselink,
+ *          "A general algorithm for computing distance transforms in
+ *          linear time", 2000) is separable.  The distance to the
+ *          nearest bg pixel in each column is found with a pass
+ *          down and a pass up the image.  Then on each row, the
+ *          squared distance is the lower envelope of a set of parabolas,
+ *          one centered on each column, which is found in linear time.
+ *          The total time is linear in the number of pixels, and
+ *          independent of the distances; unlike pixDistanceFunction(),
+ *          there are no chamfer errors.
+ *      (4) The rows in the second phase are independent of each other,
+ *          as are the columns in the first phase.
+ *      (5) Because the result is computed in 32 bit integers, the sum
+ *          w + h must be less than about 46000.
+ */
+PIX *
+pixEuclideanDistance(PIX     *pixs,
+                     l_int32  boundcond)
+{
+l_int32    w, h, wpls, wpld, count;
+l_int32   *g, *s, *t;
+l_uint32  *datas, *datad;
+PIX       *pixd;
+
+    PROCNAME("pixEuclideanDistance");
+
+    if (!pixs || pixGetDepth(pixs) != 1)
+        return (PIX *)ERROR_PTR("!pixs or pixs not 1 bpp", procName, NULL);
+    if (boundcond != L_BOUNDARY_BG && boundcond != L_BOUNDARY_FG)
+        return (PIX *)ERROR_PTR("invalid boundcond", procName, NULL);
+    pixGetDimensions(pixs, &w, &h, NULL);
+    if (w + h > 46000)
+        return (PIX *)ERROR_PTR("pixs too large", procName, NULL);
+    if (boundcond == L_BOUNDARY_FG) {
+        pixCountPixels(pixs, &count, NULL);
+        if (count == w * h)
+            return (PIX *)ERROR_PTR("no bg pixels", procName, NULL);
+    }
+
+    if ((pixd = pixCreate(w, h, 32)) == NULL)
+        return (PIX *)ERROR_PTR("pixd not made", procName, NULL);
+    g = (l_int32 *)CALLOC(w, sizeof(l_int32));
+    s = (l_int32 *)CALLOC(w, sizeof(l_int32));
+    t = (l_int32 *)CALLOC(w, sizeof(l_int32));
+    if (!g || !s || !t) {
+        FREE(g);
+        FREE(s);
+        FREE(t);
+        pixDestroy(&pixd);
+        return (PIX *)ERROR_PTR("work arrays not made", procName, NULL);
+    }
+
+    datas = pixGetData(pixs);
+    wpls = pixGetWpl(pixs);
+    datad = pixGetData(pixd);
+    wpld = pixGetWpl(pixd);
+    euclideanDistanceLow(datad, w, h, wpld, datas, wpls, boundcond, g, s, t);
+
+    FREE(g);
+    FREE(s);
+    FREE(t);
+    return pixd;
+}
+
+
+/*!
+ *  pixEuclideanDistanceFPix()
+ *
+ *      Input:  pixs  (1 bpp source)
+ *              boundcond (L_BOUNDARY_BG, L_BOUNDARY_FG)
+ *      Return: fpixd (Euclidean distance), or null on error
+ *
+ *  Notes:
+ *      (1) This returns the square root of the result of
+ *          pixEuclideanDistance().  See that function for details.
+ */
+FPIX *
+pixEuclideanDistanceFPix(PIX     *pixs,
+                         l_int32  boundcond)
+{
+l_int32     i, j, w, h, wplt, wpld;
+l_uint32   *datat, *linet;
+l_float32  *datad, *lined;
+FPIX       *fpixd;
+PIX        *pixt;
+
+    PROCNAME("pixEuclideanDistanceFPix");
+
+    if (!pixs || pixGetDepth(pixs) != 1)
+        return (FPIX *)ERROR_PTR("!pixs or pixs not 1 bpp", procName, NULL);
+
+    if ((pixt = pixEuclideanDistance(pixs, boundcond)) == NULL)
+        return (FPIX *)ERROR_PTR("pixt not made", procName, NULL);
+    pixGetDimensions(pixt, &w, &h, NULL);
+    if ((fpixd = fpixCreate(w, h)) == NULL) {
+        pixDestroy(&pixt);
+        return (FPIX *)ERROR_PTR("fpixd not made", procName, NULL);
+    }
+    datat = pixGetData(pixt);
+    wplt = pixGetWpl(pixt);
+    datad = fpixGetData(fpixd);
+    wpld = fpixGetWpl(fpixd);
+    for (i = 0; i < h; i++) {
+        linet = datat + i * wplt;
+        lined = datad + i * wpld;
+        for (j = 0; j < w; j++)
+            lined[j] = (l_float32)sqrt((l_float64)linet[j]);
+    }
+
+    pixDestroy(&pixt);
+    return fpixd;
+}
+
+
 /*-----------------------------------------------------------------------*
  *                Seed spread (based on distance function)               *
  *-----------------------------------------------------------------------*/
@@ -34,24 +34,26 @@
  *               void   seedfillGrayInvLow()
  *               void   seedfillGrayLowSimple()
  *               void   seedfillGrayInvLowSimple()
+ *               static void   seedfillGrayRowMax3()
+ *               static void   seedfillGrayRowMin3()
  *
  *      Distance function:
  *               void   distanceFunctionLow()
  *
+ *      Exact Euclidean distance:
+ *               void   euclideanDistanceLow()
+ *
  *      Seed spread:
  *               void   seedspreadLow()
  *
  */
 
+#include <string.h>
 #include <math.h>
 #include "allheaders.h"
 
-struct L_Pixel
-{
-    l_int32    x;
-    l_int32    y;
-};
-typedef struct L_Pixel  L_PIXEL;
+static void seedfillGrayRowMax3(l_uint32 *line, l_int32 w, l_uint8 *buf);
+static void seedfillGrayRowMin3(l_uint8 *buf, l_int32 w);
 
 
 /*-----------------------------------------------------------------------*
@@ -303,6 +305,26 @@ l_uint32  *lines, *linem;
  *            L. Vincent, Morphological grayscale reconstruction in image
  *            analysis: applications and efficient algorithms, IEEE Transactions
  *            on  Image Processing, vol. 2, no. 2, pp. 176-201, 1993.
+ *      (4) The propagation step uses a L_BucketQ, which is a queue
+ *          with a fifo for each pixel value, and removes pixels with
+ *          the largest value first.  Because propagation never
+ *          increases a value, a pixel removed from the queue already
+ *          has its final value, so each pixel is propagated at most
+ *          once; entries for pixels that have since been raised to
+ *          a larger value are skipped.  The result is the same as
+ *          with a single fifo, and the queue items are pooled, so
+ *          there is no allocation per pixel.
+ *      (5) In the raster and anti-raster scans, the result for the
+ *          previous pixel in the row is carried in a register rather
+ *          than read back from the image.
+ *      (6) With 8-connectivity, before each row is scanned, the max
+ *          over the 3 neighbors in the adjacent (already scanned) row
+ *          is put in a line buffer.  For the anti-raster scan, a second
+ *          line buffer holds the min over the same neighbors (q) of
+ *          those values J(q) that are less than I(q), so that the
+ *          test for adding a pixel to the queue is a single comparison.
+ *          The buffers are made without the serial dependence of the
+ *          row scans, which roughly halves the time for the two scans.
  */
 void
 seedfillGrayLow(l_uint32  *datas,
@@ -314,11 +336,11 @@ seedfillGrayLow(l_uint32  *datas,
                 l_int32    connectivity)
 {
 l_uint8    val1, val2, val3, val4, val5, val6, val7, val8;
-l_uint8    val, maxval, maskval, boolval;
-l_int32    i, j, imax, jmax, queue_size;
-l_uint32  *lines, *linem;
-L_PIXEL *pixel;
-L_QUEUE  *lq_pixel;
+l_uint8    val, maxval, minval, maskval, boolval;
+l_uint8   *bufmax, *bufmin;
+l_int32     i, j, imax, jmax, pval;
+l_uint32   *lines, *linem;
+L_BUCKETQ  *bq;
 
     PROCNAME("seedfillGrayLow");
 
@@ -326,10 +348,15 @@ L_QUEUE  *lq_pixel;
     jmax = w - 1;
 
         /* In the worst case, most of the pixels could be pushed
-         * onto the FIFO queue during anti-raster scan.  However this
-         * will rarely happen, and we initialize the queue ptr size to
-         * the image perimeter. */
-    lq_pixel = lqueueCreate(2 * (w + h));
+         * onto the queue during anti-raster scan.  However this
+         * will rarely happen, and we initialize the item pool size to
+         * the image perimeter.  The queue gives the pixels with the
+         * largest value first; see note (4). */
+    if ((bq = bqueueCreate(256, L_SORT_DECREASING, 2 * (w + h))) == NULL) {
+        L_ERROR("bq not made", procName);
+        return;
+    }
+    bufmax = bufmin = NULL;
 
     switch (connectivity)
     {
@@ -343,20 +370,19 @@ L_QUEUE  *lq_pixel;
         for (i = 0; i < h; i++) {
             lines = datas + i * wpls;
             linem = datam + i * wplm;
+            val4 = 0;  /* the pixel to the left is carried in the scan */
             for (j = 0; j < w; j++) {
+                val = GET_DATA_BYTE(lines, j);
                 if ((maskval = GET_DATA_BYTE(linem, j)) > 0) {
-                    maxval = 0;
-                    if (i > 0)
-                        maxval = GET_DATA_BYTE(lines - wpls, j);
-                    if (j > 0) {
-                        val4 = GET_DATA_BYTE(lines, j - 1);
-                        maxval = L_MAX(maxval, val4);
+                    maxval = L_MAX(val4, val);
+                    if (i > 0) {
+                        val2 = GET_DATA_BYTE(lines - wpls, j);
+                        maxval = L_MAX(maxval, val2);
                     }
-                    val = GET_DATA_BYTE(lines, j);
-                    maxval = L_MAX(maxval, val);
                     val = L_MIN(maxval, maskval);
                     SET_DATA_BYTE(lines, j, val);
                 }
+                val4 = val;
             }
         }
 
@@ -367,18 +393,15 @@ L_QUEUE  *lq_pixel;
         for (i = imax; i >= 0; i--) {
             lines = datas + i * wpls;
             linem = datam + i * wplm;
+            val5 = 0;  /* the pixel to the right is carried in the scan */
             for (j = jmax; j >= 0; j--) {
-                boolval = FALSE;
+                val = GET_DATA_BYTE(lines, j);
                 if ((maskval = GET_DATA_BYTE(linem, j)) > 0) {
-                    maxval = 0;
-                    if (i < imax)
-                        maxval = GET_DATA_BYTE(lines + wpls, j);
-                    if (j < jmax) {
-                        val5 = GET_DATA_BYTE(lines, j + 1);
-                        maxval = L_MAX(maxval, val5);
+                    maxval = L_MAX(val5, val);
+                    if (i < imax) {
+                        val7 = GET_DATA_BYTE(lines + wpls, j);
+                        maxval = L_MAX(maxval, val7);
                     }
-                    val = GET_DATA_BYTE(lines, j);
-                    maxval = L_MAX(maxval, val);
                     val = L_MIN(maxval, maskval);
                     SET_DATA_BYTE(lines, j, val);
 
@@ -387,27 +410,19 @@ L_QUEUE  *lq_pixel;
                          * neighbors in anti-raster order such that J(q) < J(p)
                          * and J(q) < I(q) then
                          * fifo_add(p) */
+                    boolval = FALSE;
                     if (i < imax) {
-                        val7 = GET_DATA_BYTE(lines + wpls, j);
-                        if ((val7 < val) &&
-                            (val7 < GET_DATA_BYTE(linem + wplm, j))) {
-                            boolval = TRUE;
-                        }
+                        boolval |= (val7 < val) &
+                            (val7 < GET_DATA_BYTE(linem + wplm, j));
                     }
                     if (j < jmax) {
-                        val5 = GET_DATA_BYTE(lines, j + 1);
-                        if (!boolval && (val5 < val) &&
-                            (val5 < GET_DATA_BYTE(linem, j + 1))) {
-                            boolval = TRUE;
-                        }
-                    }
-                    if (boolval) {
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        boolval |= (val5 < val) &
+                            (val5 < GET_DATA_BYTE(linem, j + 1));
                     }
+                    if (boolval)
+                        bqueueAdd(bq, val, j, i, 0);
                 }
+                val5 = val;
             }
         }
 
@@ -421,25 +436,20 @@ L_QUEUE  *lq_pixel;
              *            end
              *          end
              *        end */
-        queue_size = lqueueGetCount(lq_pixel);
-        while (queue_size) {
-            pixel = (L_PIXEL *)lqueueRemove(lq_pixel);
-            i = pixel->x;
-            j = pixel->y;
-            FREE(pixel);
+        while (bqueueGetCount(bq) > 0) {
+            bqueueRemove(bq, &pval, &j, &i, NULL);
             lines = datas + i * wpls;
             linem = datam + i * wplm;
 
-            if ((val = GET_DATA_BYTE(lines, j)) > 0) {
+            if ((val = GET_DATA_BYTE(lines, j)) != pval)
+                continue;  /* already propagated from a larger value */
+            if (val > 0) {
                 if (i > 0) {
                     val2 = GET_DATA_BYTE(lines - wpls, j);
                     maskval = GET_DATA_BYTE(linem - wplm, j);
                     if (val > val2 && val2 != maskval) {
                         SET_DATA_BYTE(lines - wpls, j, L_MIN(val, maskval));
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i - 1;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, L_MIN(val, maskval), j, i - 1, 0);
                     }
 
                 }
@@ -448,10 +458,7 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem, j - 1);
                     if (val > val4 && val4 != maskval) {
                         SET_DATA_BYTE(lines, j - 1, L_MIN(val, maskval));
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j - 1;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, L_MIN(val, maskval), j - 1, i, 0);
                     }
                 }
                 if (i < imax) {
@@ -459,10 +466,7 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem + wplm, j);
                     if (val > val7 && val7 != maskval) {
                         SET_DATA_BYTE(lines + wpls, j, L_MIN(val, maskval));
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i + 1;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, L_MIN(val, maskval), j, i + 1, 0);
                     }
                 }
                 if (j < jmax) {
@@ -470,20 +474,25 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem, j + 1);
                     if (val > val5 && val5 != maskval) {
                         SET_DATA_BYTE(lines, j + 1, L_MIN(val, maskval));
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j + 1;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, L_MIN(val, maskval), j + 1, i, 0);
                     }
                 }
             }
 
-            queue_size = lqueueGetCount(lq_pixel);
         }
 
         break;
 
     case 8:
+            /* The max of the 3 neighbors in the adjacent row is
+             * found once for the row; see note (6). */
+        bufmax = (l_uint8 *)CALLOC(w, sizeof(l_uint8));
+        bufmin = (l_uint8 *)CALLOC(w, sizeof(l_uint8));
+        if (!bufmax || !bufmin) {
+            L_ERROR("line buffers not made", procName);
+            break;
+        }
+
             /* UL --> LR scan  (Raster Order)
              * If I : mask image
              *    J : marker image
@@ -493,28 +502,18 @@ L_QUEUE  *lq_pixel;
         for (i = 0; i < h; i++) {
             lines = datas + i * wpls;
             linem = datam + i * wplm;
+            if (i > 0)  /* max over the 3 neighbors in the row above */
+                seedfillGrayRowMax3(lines - wpls, w, bufmax);
+            val4 = 0;  /* the pixel to the left is carried in the scan */
             for (j = 0; j < w; j++) {
+                val = GET_DATA_BYTE(lines, j);
                 if ((maskval = GET_DATA_BYTE(linem, j)) > 0) {
-                    maxval = 0;
-                    if (i > 0) {
-                        if (j > 0)
-                            maxval = GET_DATA_BYTE(lines - wpls, j - 1);
-                        if (j < jmax) {
-                            val3 = GET_DATA_BYTE(lines - wpls, j + 1);
-                            maxval = L_MAX(maxval, val3);
-                        }
-                        val2 = GET_DATA_BYTE(lines - wpls, j);
-                        maxval = L_MAX(maxval, val2);
-                    }
-                    if (j > 0) {
-                        val4 = GET_DATA_BYTE(lines, j - 1);
-                        maxval = L_MAX(maxval, val4);
-                    }
-                    val = GET_DATA_BYTE(lines, j);
-                    maxval = L_MAX(maxval, val);
+                    maxval = L_MAX(val4, val);
+                    maxval = L_MAX(maxval, bufmax[j]);
                     val = L_MIN(maxval, maskval);
                     SET_DATA_BYTE(lines, j, val);
                 }
+                val4 = val;
             }
         }
 
@@ -522,30 +521,29 @@ L_QUEUE  *lq_pixel;
              * Let p be the currect pixel;
              * J(p) <- (max{J(p) union J(p) neighbors in anti-raster order})
              *          intersection I(p) */
+        memset(bufmax, 0, w);
+        memset(bufmin, 255, w);
         for (i = imax; i >= 0; i--) {
             lines = datas + i * wpls;
             linem = datam + i * wplm;
+            if (i < imax) {
+                    /* For the 3 neighbors in the row below, get the max,
+                     * and the min of those with J(q) < I(q) */
+                seedfillGrayRowMax3(lines + wpls, w, bufmax);
+                for (j = 0; j < w; j++) {
+                    val7 = GET_DATA_BYTE(lines + wpls, j);
+                    maskval = GET_DATA_BYTE(linem + wplm, j);
+                    bufmin[j] = (val7 < maskval) ? val7 : 255;
+                }
+                seedfillGrayRowMin3(bufmin, w);
+            }
+            val5 = 0;  /* the pixel to the right is carried in the scan, */
+            minval = 255;  /* along with its value if J(q) < I(q) */
             for (j = jmax; j >= 0; j--) {
-                boolval = FALSE;
+                val = GET_DATA_BYTE(lines, j);
                 if ((maskval = GET_DATA_BYTE(linem, j)) > 0) {
-                    maxval = 0;
-                    if (i < imax) {
-                        if (j > 0) {
-                            maxval = GET_DATA_BYTE(lines + wpls, j - 1);
-                        }
-                        if (j < jmax) {
-                            val8 = GET_DATA_BYTE(lines + wpls, j + 1);
-                            maxval = L_MAX(maxval, val8);
-                        }
-                        val7 = GET_DATA_BYTE(lines + wpls, j);
-                        maxval = L_MAX(maxval, val7);
-                    }
-                    if (j < jmax) {
-                        val5 = GET_DATA_BYTE(lines, j + 1);
-                        maxval = L_MAX(maxval, val5);
-                    }
-                    val = GET_DATA_BYTE(lines, j);
-                    maxval = L_MAX(maxval, val);
+                    maxval = L_MAX(val5, val);
+                    maxval = L_MAX(maxval, bufmax[j]);
                     val = L_MIN(maxval, maskval);
                     SET_DATA_BYTE(lines, j, val);
 
@@ -553,41 +551,11 @@ L_QUEUE  *lq_pixel;
                          * neighbors in anti-raster order such that J(q) < J(p)
                          * and J(q) < I(q) then
                          * fifo_add(p) */
-                    if (i < imax) {
-                        if (j > 0) {
-                            val6 = GET_DATA_BYTE(lines + wpls, j - 1);
-                            if ((val6 < val) &&
-                                (val6 < GET_DATA_BYTE(linem + wplm, j - 1))) {
-                                boolval = TRUE;
-                            }
-                        }
-                        if (j < jmax) {
-                            val8 = GET_DATA_BYTE(lines + wpls, j + 1);
-                            if (!boolval && (val8 < val) &&
-                                (val8 < GET_DATA_BYTE(linem + wplm, j + 1))) {
-                                boolval = TRUE;
-                            }
-                        }
-                        val7 = GET_DATA_BYTE(lines + wpls, j);
-                        if (!boolval && (val7 < val) &&
-                            (val7 < GET_DATA_BYTE(linem + wplm, j))) {
-                            boolval = TRUE;
-                        }
-                    }
-                    if (j < jmax) {
-                        val5 = GET_DATA_BYTE(lines, j + 1);
-                        if (!boolval && (val5 < val) &&
-                            (val5 < GET_DATA_BYTE(linem, j + 1))) {
-                            boolval = TRUE;
-                        }
-                    }
-                    if (boolval) {
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
-                    }
+                    if (minval < val || bufmin[j] < val)
+                        bqueueAdd(bq, val, j, i, 0);
                 }
+                val5 = val;
+                minval = (val < maskval) ? val : 255;
             }
         }
 
@@ -601,26 +569,21 @@ L_QUEUE  *lq_pixel;
              *            end
              *          end
              *        end */
-        queue_size = lqueueGetCount(lq_pixel);
-        while (queue_size) {
-            pixel = (L_PIXEL *)lqueueRemove(lq_pixel);
-            i = pixel->x;
-            j = pixel->y;
-            FREE(pixel);
+        while (bqueueGetCount(bq) > 0) {
+            bqueueRemove(bq, &pval, &j, &i, NULL);
             lines = datas + i * wpls;
             linem = datam + i * wplm;
 
-            if ((val = GET_DATA_BYTE(lines, j)) > 0) {
+            if ((val = GET_DATA_BYTE(lines, j)) != pval)
+                continue;  /* already propagated from a larger value */
+            if (val > 0) {
                 if (i > 0) {
                     if (j > 0) {
                         val1 = GET_DATA_BYTE(lines - wpls, j - 1);
                         maskval = GET_DATA_BYTE(linem - wplm, j - 1);
                         if (val > val1 && val1 != maskval) {
                             SET_DATA_BYTE(lines - wpls, j - 1, L_MIN(val, maskval));
-                            pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                            pixel->x = i - 1;
-                            pixel->y = j - 1;
-                            lqueueAdd(lq_pixel, pixel);
+                            bqueueAdd(bq, L_MIN(val, maskval), j - 1, i - 1, 0);
                         }
                     }
                     if (j < jmax) {
@@ -628,20 +591,14 @@ L_QUEUE  *lq_pixel;
                         maskval = GET_DATA_BYTE(linem - wplm, j + 1);
                         if (val > val3 && val3 != maskval) {
                             SET_DATA_BYTE(lines - wpls, j + 1, L_MIN(val, maskval));
-                            pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                            pixel->x = i - 1;
-                            pixel->y = j + 1;
-                            lqueueAdd(lq_pixel, pixel);
+                            bqueueAdd(bq, L_MIN(val, maskval), j + 1, i - 1, 0);
                         }
                     }
                     val2 = GET_DATA_BYTE(lines - wpls, j);
                     maskval = GET_DATA_BYTE(linem - wplm, j);
                     if (val > val2 && val2 != maskval) {
                         SET_DATA_BYTE(lines - wpls, j, L_MIN(val, maskval));
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i - 1;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, L_MIN(val, maskval), j, i - 1, 0);
                     }
 
                 }
@@ -650,10 +607,7 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem, j - 1);
                     if (val > val4 && val4 != maskval) {
                         SET_DATA_BYTE(lines, j - 1, L_MIN(val, maskval));
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j - 1;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, L_MIN(val, maskval), j - 1, i, 0);
                     }
                 }
                 if (i < imax) {
@@ -662,10 +616,7 @@ L_QUEUE  *lq_pixel;
                         maskval = GET_DATA_BYTE(linem + wplm, j - 1);
                         if (val > val6 && val6 != maskval) {
                             SET_DATA_BYTE(lines + wpls, j - 1, L_MIN(val, maskval));
-                            pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                            pixel->x = i + 1;
-                            pixel->y = j - 1;
-                            lqueueAdd(lq_pixel, pixel);
+                            bqueueAdd(bq, L_MIN(val, maskval), j - 1, i + 1, 0);
                         }
                     }
                     if (j < jmax) {
@@ -673,20 +624,14 @@ L_QUEUE  *lq_pixel;
                         maskval = GET_DATA_BYTE(linem + wplm, j + 1);
                         if (val > val8 && val8 != maskval) {
                             SET_DATA_BYTE(lines + wpls, j + 1, L_MIN(val, maskval));
-                            pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                            pixel->x = i + 1;
-                            pixel->y = j + 1;
-                            lqueueAdd(lq_pixel, pixel);
+                            bqueueAdd(bq, L_MIN(val, maskval), j + 1, i + 1, 0);
                         }
                     }
                     val7 = GET_DATA_BYTE(lines + wpls, j);
                     maskval = GET_DATA_BYTE(linem + wplm, j);
                     if (val > val7 && val7 != maskval) {
                         SET_DATA_BYTE(lines + wpls, j, L_MIN(val, maskval));
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i + 1;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, L_MIN(val, maskval), j, i + 1, 0);
                     }
                 }
                 if (j < jmax) {
@@ -694,24 +639,21 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem, j + 1);
                     if (val > val5 && val5 != maskval) {
                         SET_DATA_BYTE(lines, j + 1, L_MIN(val, maskval));
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j + 1;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, L_MIN(val, maskval), j + 1, i, 0);
                     }
                 }
             }
 
-            queue_size = lqueueGetCount(lq_pixel);
         }
         break;
 
     default:
         L_ERROR("connectivity must be 4 or 8", procName);
-        lqueueDestroy(&lq_pixel, TRUE);
     }
 
-    lqueueDestroy(&lq_pixel, TRUE);
+    bqueueDestroy(&bq);
+    FREE(bufmax);
+    FREE(bufmin);
     return;
 }
 
@@ -748,6 +690,12 @@ L_QUEUE  *lq_pixel;
  *            L. Vincent, Morphological grayscale reconstruction in image
  *            analysis: applications and efficient algorithms, IEEE Transactions
  *            on  Image Processing, vol. 2, no. 2, pp. 176-201, 1993.
+ *      (5) As with seedfillGrayLow(), the propagation step uses
+ *          a L_BucketQ that removes pixels with the largest value first,
+ *          so that each pixel is propagated at most once.
+ *      (6) As with seedfillGrayLow(), 8-connected scans use line
+ *          buffers for the adjacent row.  Here the second buffer
+ *          holds the min over the 3 neighbors (q) of max{J(q), I(q)}.
  */
 void
 seedfillGrayInvLow(l_uint32  *datas,
@@ -759,11 +707,11 @@ seedfillGrayInvLow(l_uint32  *datas,
                    l_int32    connectivity)
 {
 l_uint8    val1, val2, val3, val4, val5, val6, val7, val8;
-l_uint8    val, maxval, maskval, boolval;
-l_int32    i, j, imax, jmax, queue_size;
-l_uint32  *lines, *linem;
-L_PIXEL *pixel;
-L_QUEUE  *lq_pixel;
+l_uint8    val, maxval, minval, maskval, boolval;
+l_uint8   *bufmax, *bufmin;
+l_int32     i, j, imax, jmax, pval;
+l_uint32   *lines, *linem;
+L_BUCKETQ  *bq;
 
     PROCNAME("seedfillGrayInvLow");
 
@@ -771,10 +719,15 @@ L_QUEUE  *lq_pixel;
     jmax = w - 1;
 
         /* In the worst case, most of the pixels could be pushed
-         * onto the FIFO queue during anti-raster scan.  However this
-         * will rarely happen, and we initialize the queue ptr size to
-         * the image perimeter. */
-    lq_pixel = lqueueCreate(2 * (w + h));
+         * onto the queue during anti-raster scan.  However this
+         * will rarely happen, and we initialize the item pool size to
+         * the image perimeter.  The queue gives the pixels with the
+         * largest value first; see note (5). */
+    if ((bq = bqueueCreate(256, L_SORT_DECREASING, 2 * (w + h))) == NULL) {
+        L_ERROR("bq not made", procName);
+        return;
+    }
+    bufmax = bufmin = NULL;
 
     switch (connectivity)
     {
@@ -790,20 +743,21 @@ L_QUEUE  *lq_pixel;
         for (i = 0; i < h; i++) {
             lines = datas + i * wpls;
             linem = datam + i * wplm;
+            val4 = 0;  /* the pixel to the left is carried in the scan */
             for (j = 0; j < w; j++) {
+                val = GET_DATA_BYTE(lines, j);
                 if ((maskval = GET_DATA_BYTE(linem, j)) < 255) {
-                    maxval = GET_DATA_BYTE(lines, j);
+                    maxval = L_MAX(val4, val);
                     if (i > 0) {
                         val2 = GET_DATA_BYTE(lines - wpls, j);
                         maxval = L_MAX(maxval, val2);
                     }
-                    if (j > 0) {
-                        val4 = GET_DATA_BYTE(lines, j - 1);
-                        maxval = L_MAX(maxval, val4);
+                    if (maxval > maskval) {
+                        val = maxval;
+                        SET_DATA_BYTE(lines, j, val);
                     }
-                    if (maxval > maskval)
-                        SET_DATA_BYTE(lines, j, maxval);
                 }
+                val4 = val;
             }
         }
 
@@ -818,48 +772,38 @@ L_QUEUE  *lq_pixel;
         for (i = imax; i >= 0; i--) {
             lines = datas + i * wpls;
             linem = datam + i * wplm;
+            val5 = 0;  /* the pixel to the right is carried in the scan */
             for (j = jmax; j >= 0; j--) {
-                boolval = FALSE;
+                val = GET_DATA_BYTE(lines, j);
                 if ((maskval = GET_DATA_BYTE(linem, j)) < 255) {
-                    val = maxval = GET_DATA_BYTE(lines, j);
+                    maxval = L_MAX(val5, val);
                     if (i < imax) {
                         val7 = GET_DATA_BYTE(lines + wpls, j);
                         maxval = L_MAX(maxval, val7);
                     }
-                    if (j < jmax) {
-                        val5 = GET_DATA_BYTE(lines, j + 1);
-                        maxval = L_MAX(maxval, val5);
+                    if (maxval > maskval) {
+                        val = maxval;
+                        SET_DATA_BYTE(lines, j, val);
                     }
-                    if (maxval > maskval)
-                        SET_DATA_BYTE(lines, j, maxval);
-                    val = GET_DATA_BYTE(lines, j);
 
                         /*
                          * If there exists a point (q) which belongs to J(p)
                          * neighbors in anti-raster order such that J(q) < J(p)
                          * and J(p) > I(q) then
                          * fifo_add(p) */
+                    boolval = FALSE;
                     if (i < imax) {
-                        val7 = GET_DATA_BYTE(lines + wpls, j);
-                        if ((val7 < val) &&
-                            (val > GET_DATA_BYTE(linem + wplm, j))) {
-                            boolval = TRUE;
-                        }
+                        boolval |= (val7 < val) &
+                            (val > GET_DATA_BYTE(linem + wplm, j));
                     }
                     if (j < jmax) {
-                        val5 = GET_DATA_BYTE(lines, j + 1);
-                        if (!boolval && (val5 < val) &&
-                            (val > GET_DATA_BYTE(linem, j + 1))) {
-                            boolval = TRUE;
-                        }
-                    }
-                    if (boolval) {
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        boolval |= (val5 < val) &
+                            (val > GET_DATA_BYTE(linem, j + 1));
                     }
+                    if (boolval)
+                        bqueueAdd(bq, val, j, i, 0);
                 }
+                val5 = val;
             }
         }
 
@@ -873,25 +817,20 @@ L_QUEUE  *lq_pixel;
              *            end
              *          end
              *        end */
-        queue_size = lqueueGetCount(lq_pixel);
-        while (queue_size) {
-            pixel = (L_PIXEL *)lqueueRemove(lq_pixel);
-            i = pixel->x;
-            j = pixel->y;
-            FREE(pixel);
+        while (bqueueGetCount(bq) > 0) {
+            bqueueRemove(bq, &pval, &j, &i, NULL);
             lines = datas + i * wpls;
             linem = datam + i * wplm;
 
-            if ((val = GET_DATA_BYTE(lines, j)) > 0) {
+            if ((val = GET_DATA_BYTE(lines, j)) != pval)
+                continue;  /* already propagated from a larger value */
+            if (val > 0) {
                 if (i > 0) {
                     val2 = GET_DATA_BYTE(lines - wpls, j);
                     maskval = GET_DATA_BYTE(linem - wplm, j);
                     if (val > val2 && val > maskval) {
                         SET_DATA_BYTE(lines - wpls, j, val);
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i - 1;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, val, j, i - 1, 0);
                     }
 
                 }
@@ -900,10 +839,7 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem, j - 1);
                     if (val > val4 && val > maskval) {
                         SET_DATA_BYTE(lines, j - 1, val);
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j - 1;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, val, j - 1, i, 0);
                     }
                 }
                 if (i < imax) {
@@ -911,10 +847,7 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem + wplm, j);
                     if (val > val7 && val > maskval) {
                         SET_DATA_BYTE(lines + wpls, j, val);
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i + 1;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, val, j, i + 1, 0);
                     }
                 }
                 if (j < jmax) {
@@ -922,20 +855,25 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem, j + 1);
                     if (val > val5 && val > maskval) {
                         SET_DATA_BYTE(lines, j + 1, val);
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j + 1;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, val, j + 1, i, 0);
                     }
                 }
             }
 
-            queue_size = lqueueGetCount(lq_pixel);
         }
 
         break;
 
     case 8:
+            /* The max of the 3 neighbors in the adjacent row is
+             * found once for the row; see note (6). */
+        bufmax = (l_uint8 *)CALLOC(w, sizeof(l_uint8));
+        bufmin = (l_uint8 *)CALLOC(w, sizeof(l_uint8));
+        if (!bufmax || !bufmin) {
+            L_ERROR("line buffers not made", procName);
+            break;
+        }
+
             /* UL --> LR scan  (Raster Order)
              * If I : mask image
              *    J : marker image
@@ -947,28 +885,20 @@ L_QUEUE  *lq_pixel;
         for (i = 0; i < h; i++) {
             lines = datas + i * wpls;
             linem = datam + i * wplm;
+            if (i > 0)  /* max over the 3 neighbors in the row above */
+                seedfillGrayRowMax3(lines - wpls, w, bufmax);
+            val4 = 0;  /* the pixel to the left is carried in the scan */
             for (j = 0; j < w; j++) {
+                val = GET_DATA_BYTE(lines, j);
                 if ((maskval = GET_DATA_BYTE(linem, j)) < 255) {
-                    maxval = GET_DATA_BYTE(lines, j);
-                    if (i > 0) {
-                        if (j > 0) {
-                            val1 = GET_DATA_BYTE(lines - wpls, j - 1);
-                            maxval = L_MAX(maxval, val1);
-                        }
-                        if (j < jmax) {
-                            val3 = GET_DATA_BYTE(lines - wpls, j + 1);
-                            maxval = L_MAX(maxval, val3);
-                        }
-                        val2 = GET_DATA_BYTE(lines - wpls, j);
-                        maxval = L_MAX(maxval, val2);
+                    maxval = L_MAX(val4, val);
+                    maxval = L_MAX(maxval, bufmax[j]);
+                    if (maxval > maskval) {
+                        val = maxval;
+                        SET_DATA_BYTE(lines, j, val);
                     }
-                    if (j > 0) {
-                        val4 = GET_DATA_BYTE(lines, j - 1);
-                        maxval = L_MAX(maxval, val4);
-                    }
-                    if (maxval > maskval)
-                        SET_DATA_BYTE(lines, j, maxval);
                 }
+                val4 = val;
             }
         }
 
@@ -980,73 +910,44 @@ L_QUEUE  *lq_pixel;
              * if (tmp > I(p))
              *   J(p) <- tmp
              * end */
+        memset(bufmax, 0, w);
+        memset(bufmin, 255, w);
         for (i = imax; i >= 0; i--) {
             lines = datas + i * wpls;
             linem = datam + i * wplm;
+            if (i < imax) {
+                    /* For the 3 neighbors in the row below, get the max,
+                     * and the min of max{J(q), I(q)} */
+                seedfillGrayRowMax3(lines + wpls, w, bufmax);
+                for (j = 0; j < w; j++) {
+                    val7 = GET_DATA_BYTE(lines + wpls, j);
+                    maskval = GET_DATA_BYTE(linem + wplm, j);
+                    bufmin[j] = L_MAX(val7, maskval);
+                }
+                seedfillGrayRowMin3(bufmin, w);
+            }
+            val5 = 0;  /* the pixel to the right is carried in the scan, */
+            minval = 255;  /* along with max{J(q), I(q)} */
             for (j = jmax; j >= 0; j--) {
-                boolval = FALSE;
+                val = GET_DATA_BYTE(lines, j);
                 if ((maskval = GET_DATA_BYTE(linem, j)) < 255) {
-                    maxval = GET_DATA_BYTE(lines, j);
-                    if (i < imax) {
-                        if (j > 0) {
-                            val6 = GET_DATA_BYTE(lines + wpls, j - 1);
-                            maxval = L_MAX(maxval, val6);
-                        }
-                        if (j < jmax) {
-                            val8 = GET_DATA_BYTE(lines + wpls, j + 1);
-                            maxval = L_MAX(maxval, val8);
-                        }
-                        val7 = GET_DATA_BYTE(lines + wpls, j);
-                        maxval = L_MAX(maxval, val7);
-                    }
-                    if (j < jmax) {
-                        val5 = GET_DATA_BYTE(lines, j + 1);
-                        maxval = L_MAX(maxval, val5);
+                    maxval = L_MAX(val5, val);
+                    maxval = L_MAX(maxval, bufmax[j]);
+                    if (maxval > maskval) {
+                        val = maxval;
+                        SET_DATA_BYTE(lines, j, val);
                     }
-                    if (maxval > maskval)
-                        SET_DATA_BYTE(lines, j, maxval);
-                    val = GET_DATA_BYTE(lines, j);
 
                         /*
                          * If there exists a point (q) which belongs to J(p)
                          * neighbors in anti-raster order such that J(q) < J(p)
                          * and J(p) > I(q) then
                          * fifo_add(p) */
-                    if (i < imax) {
-                        if (j > 0) {
-                            val6 = GET_DATA_BYTE(lines + wpls, j - 1);
-                            if ((val6 < val) &&
-                                (val > GET_DATA_BYTE(linem + wplm, j - 1))) {
-                                boolval = TRUE;
-                            }
-                        }
-                        if (j < jmax) {
-                            val8 = GET_DATA_BYTE(lines + wpls, j + 1);
-                            if (!boolval && (val8 < val) &&
-                                (val > GET_DATA_BYTE(linem + wplm, j + 1))) {
-                                boolval = TRUE;
-                            }
-                        }
-                        val7 = GET_DATA_BYTE(lines + wpls, j);
-                        if (!boolval && (val7 < val) &&
-                            (val > GET_DATA_BYTE(linem + wplm, j))) {
-                            boolval = TRUE;
-                        }
-                    }
-                    if (j < jmax) {
-                        val5 = GET_DATA_BYTE(lines, j + 1);
-                        if (!boolval && (val5 < val) &&
-                            (val > GET_DATA_BYTE(linem, j + 1))) {
-                            boolval = TRUE;
-                        }
-                    }
-                    if (boolval) {
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
-                    }
+                    if (val > minval || val > bufmin[j])
+                        bqueueAdd(bq, val, j, i, 0);
                 }
+                val5 = val;
+                minval = L_MAX(val, maskval);
             }
         }
 
@@ -1060,26 +961,21 @@ L_QUEUE  *lq_pixel;
              *            end
              *          end
              *        end */
-        queue_size = lqueueGetCount(lq_pixel);
-        while (queue_size) {
-            pixel = (L_PIXEL *)lqueueRemove(lq_pixel);
-            i = pixel->x;
-            j = pixel->y;
-            FREE(pixel);
+        while (bqueueGetCount(bq) > 0) {
+            bqueueRemove(bq, &pval, &j, &i, NULL);
             lines = datas + i * wpls;
             linem = datam + i * wplm;
 
-            if ((val = GET_DATA_BYTE(lines, j)) > 0) {
+            if ((val = GET_DATA_BYTE(lines, j)) != pval)
+                continue;  /* already propagated from a larger value */
+            if (val > 0) {
                 if (i > 0) {
                     if (j > 0) {
                         val1 = GET_DATA_BYTE(lines - wpls, j - 1);
                         maskval = GET_DATA_BYTE(linem - wplm, j - 1);
                         if (val > val1 && val > maskval) {
                             SET_DATA_BYTE(lines - wpls, j - 1, val);
-                            pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                            pixel->x = i - 1;
-                            pixel->y = j - 1;
-                            lqueueAdd(lq_pixel, pixel);
+                            bqueueAdd(bq, val, j - 1, i - 1, 0);
                         }
                     }
                     if (j < jmax) {
@@ -1087,20 +983,14 @@ L_QUEUE  *lq_pixel;
                         maskval = GET_DATA_BYTE(linem - wplm, j + 1);
                         if (val > val3 && val > maskval) {
                             SET_DATA_BYTE(lines - wpls, j + 1, val);
-                            pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                            pixel->x = i - 1;
-                            pixel->y = j + 1;
-                            lqueueAdd(lq_pixel, pixel);
+                            bqueueAdd(bq, val, j + 1, i - 1, 0);
                         }
                     }
                     val2 = GET_DATA_BYTE(lines - wpls, j);
                     maskval = GET_DATA_BYTE(linem - wplm, j);
                     if (val > val2 && val > maskval) {
                         SET_DATA_BYTE(lines - wpls, j, val);
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i - 1;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, val, j, i - 1, 0);
                     }
 
                 }
@@ -1109,10 +999,7 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem, j - 1);
                     if (val > val4 && val > maskval) {
                         SET_DATA_BYTE(lines, j - 1, val);
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j - 1;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, val, j - 1, i, 0);
                     }
                 }
                 if (i < imax) {
@@ -1121,10 +1008,7 @@ L_QUEUE  *lq_pixel;
                         maskval = GET_DATA_BYTE(linem + wplm, j - 1);
                         if (val > val6 && val > maskval) {
                             SET_DATA_BYTE(lines + wpls, j - 1, val);
-                            pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                            pixel->x = i + 1;
-                            pixel->y = j - 1;
-                            lqueueAdd(lq_pixel, pixel);
+                            bqueueAdd(bq, val, j - 1, i + 1, 0);
                         }
                     }
                     if (j < jmax) {
@@ -1132,20 +1016,14 @@ L_QUEUE  *lq_pixel;
                         maskval = GET_DATA_BYTE(linem + wplm, j + 1);
                         if (val > val8 && val > maskval) {
                             SET_DATA_BYTE(lines + wpls, j + 1, val);
-                            pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                            pixel->x = i + 1;
-                            pixel->y = j + 1;
-                            lqueueAdd(lq_pixel, pixel);
+                            bqueueAdd(bq, val, j + 1, i + 1, 0);
                         }
                     }
                     val7 = GET_DATA_BYTE(lines + wpls, j);
                     maskval = GET_DATA_BYTE(linem + wplm, j);
                     if (val > val7 && val > maskval) {
                         SET_DATA_BYTE(lines + wpls, j, val);
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i + 1;
-                        pixel->y = j;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, val, j, i + 1, 0);
                     }
                 }
                 if (j < jmax) {
@@ -1153,27 +1031,88 @@ L_QUEUE  *lq_pixel;
                     maskval = GET_DATA_BYTE(linem, j + 1);
                     if (val > val5 && val > maskval) {
                         SET_DATA_BYTE(lines, j + 1, val);
-                        pixel = (L_PIXEL *)CALLOC(1, sizeof(L_PIXEL));
-                        pixel->x = i;
-                        pixel->y = j + 1;
-                        lqueueAdd(lq_pixel, pixel);
+                        bqueueAdd(bq, val, j + 1, i, 0);
                     }
                 }
             }
 
-            queue_size = lqueueGetCount(lq_pixel);
         }
         break;
 
     default:
-        lqueueDestroy(&lq_pixel, TRUE);
         L_ERROR("connectivity must be 4 or 8", procName);
     }
 
-    lqueueDestroy(&lq_pixel, TRUE);
+    bqueueDestroy(&bq);
+    FREE(bufmax);
+    FREE(bufmin);
     return;
 }
 
+
+/*!
+ *  seedfillGrayRowMax3()
+ *
+ *      Input:  line (of 8 bpp image)
+ *              w (width of image)
+ *              buf (<return> w bytes)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) buf[j] is the max of the pixel values at j - 1, j and j + 1.
+ */
+static void
+seedfillGrayRowMax3(l_uint32  *line,
+                    l_int32    w,
+                    l_uint8   *buf)
+{
+l_int32  j;
+l_uint8  val, valleft, valright, maxval;
+
+    valleft = 0;
+    val = GET_DATA_BYTE(line, 0);
+    for (j = 0; j < w - 1; j++) {
+        valright = GET_DATA_BYTE(line, j + 1);
+        maxval = L_MAX(valleft, val);
+        buf[j] = L_MAX(maxval, valright);
+        valleft = val;
+        val = valright;
+    }
+    buf[w - 1] = L_MAX(valleft, val);
+    return;
+}
+
+
+/*!
+ *  seedfillGrayRowMin3()
+ *
+ *      Input:  buf (w bytes; replaced in-place)
+ *              w (width of image)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) buf[j] is replaced by the min of the input values
+ *          at j - 1, j and j + 1.
+ */
+static void
+seedfillGrayRowMin3(l_uint8  *buf,
+                    l_int32   w)
+{
+l_int32  j;
+l_uint8  val, valleft, minval;
+
+    valleft = 255;
+    for (j = 0; j < w - 1; j++) {
+        val = buf[j];
+        minval = L_MIN(valleft, val);
+        buf[j] = L_MIN(minval, buf[j + 1]);
+        valleft = val;
+    }
+    buf[w - 1] = L_MIN(valleft, buf[w - 1]);
+    return;
+}
+
+
 /*-----------------------------------------------------------------------*
  *                 Vincent's Iterative Grayscale Seedfill                *
  *-----------------------------------------------------------------------*/
@@ -1675,6 +1614,148 @@ l_uint32  *lined;
 }
 
 
+/*-----------------------------------------------------------------------*
+ *                      Exact Euclidean distance                         *
+ *-----------------------------------------------------------------------*/
+/*!
+ *  euclideanDistanceLow()
+ *
+ *      Input:  datad (32 bpp dest)
+ *              w, h, wpld
+ *              datas (1 bpp source)
+ *              wpls
+ *              boundcond (L_BOUNDARY_BG, L_BOUNDARY_FG)
+ *              g, s, t (work arrays of size w)
+ *      Return: void
+ *
+ *  Notes:
+ *      (1) See pixEuclideanDistance() for a description of the algorithm,
+ *          which is due to Meijster, Roerdink and Hesselink.
+ *      (2) The first phase finds, for each pixel, the distance to the
+ *          nearest bg pixel in the same column.  This is done with a
+ *          downward and an upward scan, each of which processes a full
+ *          row at a time.  The result is stored in datad.
+ *      (3) The second phase is independent for each row.  It finds the
+ *          lower envelope of the parabolas (x - u)^2 + g(u)^2, where
+ *          g(u) is the column distance found in the first phase, and
+ *          writes the squared distance to datad.
+ *      (4) A column with no bg pixel has distance @inf = w + h, which
+ *          is larger than any distance to an actual bg pixel.
+ *      (5) With L_BOUNDARY_FG, the squares of @inf in the second phase
+ *          can overflow 32 bits, so the squared distances are compared
+ *          in 64 bits.  Each result is the distance to an actual bg
+ *          pixel, which is less than 2^31 for w + h <= 46000.
+ */
+void
+euclideanDistanceLow(l_uint32  *datad,
+                     l_int32    w,
+                     l_int32    h,
+                     l_int32    wpld,
+                     l_uint32  *datas,
+                     l_int32    wpls,
+                     l_int32    boundcond,
+                     l_int32   *g,
+                     l_int32   *s,
+                     l_int32   *t)
+{
+l_int32    i, j, q, u, inf, val, fval;
+l_int64    gq, gu, num, sep, dist;
+l_uint32  *lines, *lined, *linep;
+
+        /* Downward scan.  For L_BOUNDARY_BG, the row above the image
+         * is taken to be bg. */
+    inf = w + h;
+    for (i = 0; i < h; i++) {
+        lines = datas + i * wpls;
+        lined = datad + i * wpld;
+        linep = (i == 0) ? NULL : lined - wpld;
+        for (j = 0; j < w; j++) {
+            if (!GET_DATA_BIT(lines, j))
+                val = 0;
+            else if (linep)
+                val = L_MIN(linep[j] + 1, inf);
+            else
+                val = (boundcond == L_BOUNDARY_BG) ? 1 : inf;
+            lined[j] = val;
+        }
+    }
+
+        /* Upward scan, taking the row below the image as bg
+         * for L_BOUNDARY_BG. */
+    if (boundcond == L_BOUNDARY_BG) {
+        lined = datad + (h - 1) * wpld;
+        for (j = 0; j < w; j++)
+            lined[j] = L_MIN(lined[j], 1);
+    }
+    for (i = h - 2; i >= 0; i--) {
+        lined = datad + i * wpld;
+        linep = lined + wpld;
+        for (j = 0; j < w; j++) {
+            if (linep[j] + 1 < lined[j])
+                lined[j] = linep[j] + 1;
+        }
+    }
+
+        /* Lower envelope of parabolas on each row.  The parabola
+         * for column s[q] is lowest starting at column t[q]. */
+    for (i = 0; i < h; i++) {
+        lined = datad + i * wpld;
+        for (j = 0; j < w; j++)
+            g[j] = lined[j];
+
+        q = 0;
+        s[0] = 0;
+        t[0] = 0;
+        for (u = 1; u < w; u++) {
+            gu = g[u];
+            while (q >= 0) {
+                j = t[q] - s[q];
+                fval = t[q] - u;
+                gq = g[s[q]];
+                if ((l_int64)j * j + gq * gq <= (l_int64)fval * fval + gu * gu)
+                    break;
+                q--;
+            }
+            if (q < 0) {
+                q = 0;
+                s[0] = u;
+            }
+            else {  /* sep = floor(num / den), for den > 0 */
+                j = s[q];
+                gq = g[j];
+                num = (l_int64)u * u - (l_int64)j * j + gu * gu - gq * gq;
+                if (num >= 0)
+                    sep = num / (2 * (u - j));
+                else
+                    sep = -((-num + 2 * (u - j) - 1) / (2 * (u - j)));
+                sep++;
+                if (sep < w) {
+                    q++;
+                    s[q] = u;
+                    t[q] = sep;
+                }
+            }
+        }
+
+        for (u = w - 1; u >= 0; u--) {
+            j = u - s[q];
+            gq = g[s[q]];
+            dist = (l_int64)j * j + gq * gq;
+            val = (l_int32)L_MIN(dist, 0x7fffffff);
+            if (boundcond == L_BOUNDARY_BG) {  /* bg to the left and right */
+                val = L_MIN(val, (u + 1) * (u + 1));
+                val = L_MIN(val, (w - u) * (w - u));
+            }
+            lined[u] = val;
+            if (u == t[q])
+                q--;
+        }
+    }
+
+    return;
+}
+
+
 /*-----------------------------------------------------------------------*
  *                 Seed spread (based on distance function)              *
  *-----------------------------------------------------------------------*/
@@ -41,6 +41,13 @@
  *          l_int32    pixFindSkewSweepAndSearchScore()
  *          l_int32    pixFindSkewSweepAndSearchScorePivot()
  *
+ *      Angle finding from projections of pixel counts
+ *          l_int32    pixFindSkewProjected()
+ *          NUMA      *pixFindSkewProjectedScores()
+ *          static SKEWCELLS  *skewCellsCreate()
+ *          static void        skewCellsDestroy()
+ *          static l_float32   skewCellsScore()
+ *
  *      Search over arbitrary range of angles in orthogonal directions
  *          l_int32    pixFindSkewOrthogonalRange()
  *
@@ -126,6 +133,29 @@ static const l_float32  MINSCORE_THRESHOLD_CONSTANT = 0.000002;
     /* Default binarization threshold value */
 static const l_int32  DEFAULT_BINARY_THRESHOLD = 130;
 
+    /* Counts of fg pixels in short horizontal cells, for scoring
+     * the row profile of a sheared image without making it */
+struct SkewCells
+{
+    l_int32     w, h;        /* size of image                              */
+    l_int32     cellw;       /* width of each cell: 1, 2, 4 or 8 pixels    */
+    l_int32     ncols;       /* number of cells on a line                  */
+    l_int32     n;           /* number of non-empty cells                  */
+    l_int32     nalloc;      /* size of allocated arrays                   */
+    l_int32    *y;           /* line of each cell                          */
+    l_int32    *col;         /* column index of each cell                  */
+    l_int32    *count;       /* number of fg pixels in each cell           */
+    l_int32    *shift;       /* work array: shear shift of each column     */
+};
+typedef struct SkewCells  SKEWCELLS;
+
+static const l_int32  INITIAL_CELL_ARRAYSIZE = 4096;
+
+static SKEWCELLS *skewCellsCreate(PIX *pixs, l_float32 maxangle);
+static void skewCellsDestroy(SKEWCELLS **pcells);
+static l_float32 skewCellsScore(SKEWCELLS *cells, l_float32 angle,
+                                l_int32 *profile);
+
 #ifndef  NO_CONSOLE_IO
 #define  DEBUG_PRINT_SCORES     0
 #define  DEBUG_PRINT_SWEEP      0
@@ -910,6 +940,461 @@ cleanup:
 }
 
 
+/*---------------------------------------------------------------------*
+ *           Angle finding from projections of pixel counts            *
+ *---------------------------------------------------------------------*/
+/*!
+ *  pixFindSkewProjected()
+ *
+ *      Input:  pixs  (1 bpp)
+ *              &angle   (<return> angle required to deskew; in degrees)
+ *              &conf    (<return> confidence given by ratio of max/min score)
+ *              redsweep  (sweep reduction factor = 1, 2, 4 or 8)
+ *              redsearch  (binary search reduction factor = 1, 2, 4 or 8;
+ *                          and must not exceed redsweep)
+ *              sweeprange   (half the full range, taken about 0; in degrees)
+ *              sweepdelta   (angle increment of sweep; in degrees)
+ *              minbsdelta   (min binary search increment angle; in degrees)
+ *      Return: 0 if OK, 1 on error or if angle measurment not valid
+ *
+ *  Notes:
+ *      (1) This is a faster version of pixFindSkewSweepAndSearch(),
+ *          with the same sweep and binary search and the same score,
+ *          confidence and validity tests.  The difference is in how
+ *          the score is found for each angle.  Instead of shearing
+ *          the image and counting the pixels on each line, the image
+ *          is summarized once at each of the two reductions by the
+ *          number of fg pixels in short horizontal cells (up to 8
+ *          pixels wide).  The row profile of the sheared image is
+ *          then made by adding each cell count into the line to which
+ *          the shear moves the center of the cell.  The cost of each
+ *          angle is proportional to the number of non-empty cells,
+ *          which for a text page is a small fraction of the area.
+ *      (2) The cell width is chosen so that the vertical error from
+ *          using the cell center is at most half a line over the
+ *          sweep range.  The angle found typically agrees with that
+ *          from pixFindSkewSweepAndSearch() to within @minbsdelta.
+ *      (3) The search terminates early:
+ *            - after the sweep, if the largest score is too small for
+ *              a valid result, or is at the end of the range
+ *            - in the binary search, when the scores at the center
+ *              and both neighbors are equal, so that halving the
+ *              interval cannot discriminate further.
+ *      (4) The scores for a set of angles can also be found directly
+ *          with pixFindSkewProjectedScores().
+ */
+l_int32
+pixFindSkewProjected(PIX        *pixs,
+                     l_float32  *pangle,
+                     l_float32  *pconf,
+                     l_int32     redsweep,
+                     l_int32     redsearch,
+                     l_float32   sweeprange,
+                     l_float32   sweepdelta,
+                     l_float32   minbsdelta)
+{
+l_int32     ret, bzero, i, nangles, ratio, maxindex, minloc;
+l_int32     width, height;
+l_float32   maxscore, maxangle, minscore, minthresh, rangeleft;
+l_float32   centerangle, delta;
+l_float32   bsearchscore[5];
+l_int32    *profile;
+NUMA       *nascore;
+PIX        *pixsw, *pixsch;
+SKEWCELLS  *cellsw, *cellsch;
+
+    PROCNAME("pixFindSkewProjected");
+
+    if (!pangle)
+        return ERROR_INT("&angle not defined", procName, 1);
+    if (!pconf)
+        return ERROR_INT("&conf not defined", procName, 1);
+    *pangle = 0.0;
+    *pconf = 0.0;
+    if (!pixs || pixGetDepth(pixs) != 1)
+        return ERROR_INT("pixs not defined or not 1 bpp", procName, 1);
+    if (redsweep != 1 && redsweep != 2 && redsweep != 4 && redsweep != 8)
+        return ERROR_INT("redsweep must be in {1,2,4,8}", procName, 1);
+    if (redsearch != 1 && redsearch != 2 && redsearch != 4 && redsearch != 8)
+        return ERROR_INT("redsearch must be in {1,2,4,8}", procName, 1);
+    if (redsearch > redsweep)
+        return ERROR_INT("redsearch must not exceed redsweep", procName, 1);
+    if (sweepdelta <= 0.0)
+        return ERROR_INT("sweepdelta must be > 0", procName, 1);
+
+        /* Generate reduced images for binary search and sweep */
+    if (redsearch == 1)
+        pixsch = pixClone(pixs);
+    else if (redsearch == 2)
+        pixsch = pixReduceRankBinaryCascade(pixs, 1, 0, 0, 0);
+    else if (redsearch == 4)
+        pixsch = pixReduceRankBinaryCascade(pixs, 1, 1, 0, 0);
+    else  /* redsearch == 8 */
+        pixsch = pixReduceRankBinaryCascade(pixs, 1, 1, 2, 0);
+    if (!pixsch)
+        return ERROR_INT("pixsch not made", procName, 1);
+    pixZero(pixsch, &bzero);
+    if (bzero) {
+        pixDestroy(&pixsch);
+        return 1;
+    }
+    ratio = redsweep / redsearch;
+    if (ratio == 1)
+        pixsw = pixClone(pixsch);
+    else if (ratio == 2)
+        pixsw = pixReduceRankBinaryCascade(pixsch, 1, 0, 0, 0);
+    else if (ratio == 4)
+        pixsw = pixReduceRankBinaryCascade(pixsch, 1, 2, 0, 0);
+    else  /* ratio == 8 */
+        pixsw = pixReduceRankBinaryCascade(pixsch, 1, 2, 2, 0);
+    if (!pixsw) {  /* e.g., pixs is too small to reduce */
+        pixDestroy(&pixsch);
+        return ERROR_INT("pixsw not made", procName, 1);
+    }
+
+        /* Summarize each image by its cell counts, once */
+    cellsw = skewCellsCreate(pixsw, sweeprange + sweepdelta);
+    cellsch = skewCellsCreate(pixsch, sweeprange + sweepdelta);
+    width = pixGetWidth(pixsch);
+    height = pixGetHeight(pixsch);
+    profile = (l_int32 *)CALLOC(height, sizeof(l_int32));
+    nascore = numaCreate(0);
+    pixDestroy(&pixsw);
+    if (!cellsw || !cellsch || !profile || !nascore) {
+        ret = ERROR_INT("cells or arrays not made", procName, 1);
+        goto cleanup;
+    }
+    ret = 0;
+
+        /* Do sweep */
+    nangles = (l_int32)((2. * sweeprange) / sweepdelta + 1);
+    rangeleft = -sweeprange;
+    maxscore = -1.0;
+    maxindex = 0;
+    for (i = 0; i < nangles; i++) {
+        bsearchscore[0] = skewCellsScore(cellsw, rangeleft + i * sweepdelta,
+                                         profile);
+        if (bsearchscore[0] > maxscore) {
+            maxscore = bsearchscore[0];
+            maxindex = i;
+        }
+    }
+    maxangle = rangeleft + maxindex * sweepdelta;
+    *pangle = maxangle;
+
+        /* Terminate early if the sweep result is not usable */
+    if (maxindex == 0 || maxindex == nangles - 1) {
+        L_WARNING("max found at sweep edge", procName);
+        goto cleanup;
+    }
+    if (maxscore < MIN_VALID_MAXSCORE)
+        goto cleanup;
+
+        /* Do binary search, starting with three points */
+    centerangle = maxangle;
+    bsearchscore[2] = skewCellsScore(cellsch, centerangle, profile);
+    bsearchscore[0] = skewCellsScore(cellsch, centerangle - sweepdelta,
+                                     profile);
+    bsearchscore[4] = skewCellsScore(cellsch, centerangle + sweepdelta,
+                                     profile);
+    numaAddNumber(nascore, bsearchscore[2]);
+    numaAddNumber(nascore, bsearchscore[0]);
+    numaAddNumber(nascore, bsearchscore[4]);
+    maxscore = bsearchscore[2];
+    delta = 0.5 * sweepdelta;
+    while (delta >= minbsdelta) {
+        bsearchscore[1] = skewCellsScore(cellsch, centerangle - delta,
+                                         profile);
+        bsearchscore[3] = skewCellsScore(cellsch, centerangle + delta,
+                                         profile);
+        numaAddNumber(nascore, bsearchscore[1]);
+        numaAddNumber(nascore, bsearchscore[3]);
+
+            /* Find the maximum of the center three scores */
+        maxscore = bsearchscore[1];
+        maxindex = 1;
+        for (i = 2; i < 4; i++) {
+            if (bsearchscore[i] > maxscore) {
+                maxscore = bsearchscore[i];
+                maxindex = i;
+            }
+        }
+        if (bsearchscore[1] == bsearchscore[2] &&
+            bsearchscore[3] == bsearchscore[2])  /* flat; stop at center */
+            break;
+        centerangle = centerangle + delta * (maxindex - 2);
+
+            /* Set up score array for the next iteration */
+        bsearchscore[0] = bsearchscore[maxindex - 1];
+        bsearchscore[4] = bsearchscore[maxindex + 1];
+        bsearchscore[2] = maxscore;
+        delta = 0.5 * delta;
+    }
+    *pangle = centerangle;
+
+        /* Confidence, as in pixFindSkewSweepAndSearchScorePivot() */
+    numaGetMin(nascore, &minscore, &minloc);
+    minthresh = MINSCORE_THRESHOLD_CONSTANT * width * width * height;
+    if (minscore > minthresh)
+        *pconf = maxscore / minscore;
+    if ((centerangle > rangeleft + 2 * sweeprange - sweepdelta) ||
+        (centerangle < rangeleft + sweepdelta) ||
+        (maxscore < MIN_VALID_MAXSCORE))
+        *pconf = 0.0;
+
+cleanup:
+    skewCellsDestroy(&cellsw);
+    skewCellsDestroy(&cellsch);
+    pixDestroy(&pixsch);
+    FREE(profile);
+    numaDestroy(&nascore);
+    return ret;
+}
+
+
+/*!
+ *  pixFindSkewProjectedScores()
+ *
+ *      Input:  pixs  (1 bpp)
+ *              naangles (angles at which to score; in degrees)
+ *      Return: nascores (score for each angle), or null on error
+ *
+ *  Notes:
+ *      (1) The score for each angle approximates that from
+ *          pixFindDifferentialSquareSum() on pixs after a vertical
+ *          shear about the UL corner by that angle.  See
+ *          pixFindSkewProjected() for the method.
+ *      (2) pixs is summarized once, and each angle then costs time
+ *          proportional to the number of non-empty cells.
+ *      (3) This uses no static or global data, and does not modify
+ *          pixs.  To sweep a large set of angles in parallel, split
+ *          the angles among threads and call this in each.
+ */
+NUMA *
+pixFindSkewProjectedScores(PIX   *pixs,
+                           NUMA  *naangles)
+{
+l_int32     i, n;
+l_int32    *profile;
+l_float32   angle, maxangle;
+NUMA       *nascores;
+SKEWCELLS  *cells;
+
+    PROCNAME("pixFindSkewProjectedScores");
+
+    if (!pixs || pixGetDepth(pixs) != 1)
+        return (NUMA *)ERROR_PTR("pixs not defined or not 1 bpp",
+                                 procName, NULL);
+    if (!naangles)
+        return (NUMA *)ERROR_PTR("naangles not defined", procName, NULL);
+
+    n = numaGetCount(naangles);
+    maxangle = 0.0;
+    for (i = 0; i < n; i++) {
+        numaGetFValue(naangles, i, &angle);
+        maxangle = L_MAX(maxangle, L_ABS(angle));
+    }
+    if ((cells = skewCellsCreate(pixs, maxangle)) == NULL)
+        return (NUMA *)ERROR_PTR("cells not made", procName, NULL);
+    profile = (l_int32 *)CALLOC(pixGetHeight(pixs), sizeof(l_int32));
+    nascores = numaCreate(n);
+    if (!profile || !nascores) {
+        skewCellsDestroy(&cells);
+        FREE(profile);
+        numaDestroy(&nascores);
+        return (NUMA *)ERROR_PTR("arrays not made", procName, NULL);
+    }
+    for (i = 0; i < n; i++) {
+        numaGetFValue(naangles, i, &angle);
+        numaAddNumber(nascores, skewCellsScore(cells, angle, profile));
+    }
+
+    skewCellsDestroy(&cells);
+    FREE(profile);
+    return nascores;
+}
+
+
+/*!
+ *  skewCellsCreate()
+ *
+ *      Input:  pixs (1 bpp)
+ *              maxangle (largest angle to be scored; in degrees)
+ *      Return: cells, or null on error
+ *
+ *  Notes:
+ *      (1) Each line is divided into cells of cellw pixels, where
+ *          cellw is 8, 4, 2 or 1, the largest for which
+ *          (cellw - 1) * tan(maxangle) <= 1.  Then no pixel is more
+ *          than half a line from where the shear of its cell center
+ *          puts it.  The non-empty cells are saved, with their line,
+ *          column and fg pixel count.
+ */
+static SKEWCELLS *
+skewCellsCreate(PIX       *pixs,
+                l_float32  maxangle)
+{
+l_int32     i, j, k, w, h, wpl, nbytes, cellw, ncell, count, size;
+l_int32    *tab;
+l_uint32    byte, mask, endmask;
+l_uint32   *data, *line;
+l_float64   tanmax;
+SKEWCELLS  *cells;
+
+    PROCNAME("skewCellsCreate");
+
+    if (!pixs)
+        return (SKEWCELLS *)ERROR_PTR("pixs not defined", procName, NULL);
+
+    tanmax = tan(L_ABS(maxangle) * 3.1415926535 / 180.);
+    for (cellw = 8; cellw > 1 && (cellw - 1) * tanmax > 1.0; cellw /= 2)
+        ;
+    ncell = 8 / cellw;
+
+    if ((cells = (SKEWCELLS *)CALLOC(1, sizeof(SKEWCELLS))) == NULL)
+        return (SKEWCELLS *)ERROR_PTR("cells not made", procName, NULL);
+    pixGetDimensions(pixs, &w, &h, NULL);
+    cells->w = w;
+    cells->h = h;
+    cells->nalloc = INITIAL_CELL_ARRAYSIZE;
+    cells->cellw = cellw;
+    cells->ncols = (w + cellw - 1) / cellw;
+    cells->y = (l_int32 *)CALLOC(cells->nalloc, sizeof(l_int32));
+    cells->col = (l_int32 *)CALLOC(cells->nalloc, sizeof(l_int32));
+    cells->count = (l_int32 *)CALLOC(cells->nalloc, sizeof(l_int32));
+    cells->shift = (l_int32 *)CALLOC(cells->ncols + 8, sizeof(l_int32));
+    tab = makePixelSumTab8();
+    if (!cells->y || !cells->col || !cells->count || !cells->shift || !tab) {
+        FREE(tab);
+        skewCellsDestroy(&cells);
+        return (SKEWCELLS *)ERROR_PTR("cell arrays not made", procName, NULL);
+    }
+
+        /* pixs is not modified, so the pad bits in the last byte
+         * of each line are masked out as it is read. */
+    data = pixGetData(pixs);
+    wpl = pixGetWpl(pixs);
+    nbytes = (w + 7) / 8;
+    endmask = (0xff << (8 * nbytes - w)) & 0xff;
+    mask = (0xff << (8 - cellw)) & 0xff;
+    for (i = 0; i < h; i++) {
+        line = data + i * wpl;
+        for (j = 0; j < nbytes; j++) {
+            if ((j & 3) == 0 && line[j >> 2] == 0) {  /* skip empty word */
+                j += 3;
+                continue;
+            }
+            byte = GET_DATA_BYTE(line, j);
+            if (j == nbytes - 1)
+                byte &= endmask;
+            if (byte == 0)
+                continue;
+            for (k = 0; k < ncell; k++) {
+                if ((count = tab[byte & (mask >> (k * cellw))]) == 0)
+                    continue;
+                if (cells->n >= cells->nalloc) {
+                    size = cells->nalloc * sizeof(l_int32);
+                    if ((cells->y = (l_int32 *)reallocNew((void **)&cells->y,
+                                                 size, 2 * size)) == NULL ||
+                        (cells->col = (l_int32 *)reallocNew(
+                                 (void **)&cells->col, size, 2 * size)) == NULL ||
+                        (cells->count = (l_int32 *)reallocNew(
+                                 (void **)&cells->count, size, 2 * size)) == NULL) {
+                        FREE(tab);
+                        skewCellsDestroy(&cells);
+                        return (SKEWCELLS *)ERROR_PTR("cell arrays not extended",
+                                                      procName, NULL);
+                    }
+                    cells->nalloc *= 2;
+                }
+                cells->y[cells->n] = i;
+                cells->col[cells->n] = j * ncell + k;
+                cells->count[cells->n] = count;
+                cells->n++;
+            }
+        }
+    }
+
+    FREE(tab);
+    return cells;
+}
+
+
+/*!
+ *  skewCellsDestroy()
+ *
+ *      Input:  &cells (<to be nulled>)
+ *      Return: void
+ */
+static void
+skewCellsDestroy(SKEWCELLS  **pcells)
+{
+SKEWCELLS  *cells;
+
+    if ((cells = *pcells) == NULL)
+        return;
+    FREE(cells->y);
+    FREE(cells->col);
+    FREE(cells->count);
+    FREE(cells->shift);
+    FREE(cells);
+    *pcells = NULL;
+    return;
+}
+
+
+/*!
+ *  skewCellsScore()
+ *
+ *      Input:  cells
+ *              angle (of vertical shear about the UL corner; in degrees)
+ *              profile (work array of size h)
+ *      Return: score (differential square sum of the sheared profile)
+ *
+ *  Notes:
+ *      (1) The shear moves the cell with center at x down by the
+ *          nearest integer to x * tan(angle), as pixVShearCorner()
+ *          does for the pixels in that column.  The shift is found
+ *          once for each column of cells.  Counts moved off the
+ *          image are dropped.
+ *      (2) The lines skipped at top and bottom are the same as in
+ *          pixFindDifferentialSquareSum().
+ */
+static l_float32
+skewCellsScore(SKEWCELLS  *cells,
+               l_float32   angle,
+               l_int32    *profile)
+{
+l_int32    i, k, h, y, sign, skip, nskip;
+l_int32   *shift;
+l_float32  tanangle;
+l_float64  diff, sum;
+
+    h = cells->h;
+    for (i = 0; i < h; i++)
+        profile[i] = 0;
+    tanangle = tan(L_ABS(angle) * 3.1415926535 / 180.);
+    sign = L_SIGN(angle);
+    shift = cells->shift;
+    for (i = 0; i < cells->ncols; i++)
+        shift[i] = sign * (l_int32)((i + 0.5) * cells->cellw * tanangle + 0.5);
+    for (k = 0; k < cells->n; k++) {
+        y = cells->y[k] + shift[cells->col[k]];
+        if (y >= 0 && y < h)
+            profile[y] += cells->count[k];
+    }
+
+    skip = L_MIN(h / 10, (l_int32)(0.05 * cells->w));
+    nskip = L_MAX(skip / 2, 1);
+    sum = 0.0;
+    for (i = nskip; i < h - nskip; i++) {
+        diff = (l_float64)(profile[i] - profile[i - 1]);
+        sum += diff * diff;
+    }
+    return (l_float32)sum;
+}
+
+
 /*---------------------------------------------------------------------*
  *    Search over arbitrary range of angles in orthogonal directions   *
  *---------------------------------------------------------------------*/
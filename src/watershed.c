@@ -38,8 +38,6 @@
  *            static l_int32   wshedGetHeight()
  *            static void      pushNewPixel()
  *            static void      popNewPixel()
- *            static void      pushWSPixel()
- *            static void      popWSPixel()
  *            static void      debugPrintLUT()
  *            static void      debugWshedMerge()
  *
@@ -118,22 +116,6 @@
 
 static const l_uint32  MAX_LABEL_VALUE = 0x7fffffff;  /* largest l_int32 */
 
-struct L_NewPixel
-{
-    l_int32    x;
-    l_int32    y;
-};
-typedef struct L_NewPixel  L_NEWPIXEL;
-
-struct L_WSPixel
-{
-    l_float32  val;    /* pixel value */
-    l_int32    x;
-    l_int32    y;
-    l_int32    index;  /* label for set to which pixel belongs */
-};
-typedef struct L_WSPixel  L_WSPIXEL;
-
 
     /* Static functions for obtaining bitmap of watersheds  */
 static void wshedSaveBasin(L_WSHED *wshed, l_int32 index, l_int32 level);
@@ -150,17 +132,11 @@ static l_int32 mergeLookup(L_WSHED *wshed, l_int32 sindex, l_int32 dindex);
 static l_int32 wshedGetHeight(L_WSHED *wshed, l_int32 val, l_int32 label,
                               l_int32 *pheight);
 
-    /* Static accessors for NewPixel on a queue */
-static void pushNewPixel(L_QUEUE *lq, l_int32 x, l_int32 y,
+    /* Static accessors for new pixels on a fifo queue */
+static void pushNewPixel(L_BUCKETQ *bq, l_int32 x, l_int32 y,
                          l_int32 *pminx, l_int32 *pmaxx,
                          l_int32 *pminy, l_int32 *pmaxy);
-static void popNewPixel(L_QUEUE *lq, l_int32 *px, l_int32 *py);
-
-    /* Static accessors for WSPixel on a heap */
-static void pushWSPixel(L_HEAP *lh, L_STACK *stack, l_int32 val,
-                        l_int32 x, l_int32 y, l_int32 index);
-static void popWSPixel(L_HEAP *lh, L_STACK *stack, l_int32 *pval,
-                       l_int32 *px, l_int32 *py, l_int32 *pindex);
+static void popNewPixel(L_BUCKETQ *bq, l_int32 *px, l_int32 *py);
 
     /* Static debug print output */
 static void debugPrintLUT(l_int32 *lut, l_int32 size, l_int32 debug);
@@ -289,11 +265,14 @@ L_WSHED  *wshed;
  *      Input:  wshed (generated from wshedCreate())
  *      Return: 0 if OK, 1 on error
  *
- *  Iportant note:
+ *  Important notes:
  *      (1) This is buggy.  It seems to locate watersheds that are
  *          duplicates.  The watershed extraction after complete fill
  *          grabs some regions belonging to existing watersheds.
  *          See prog/watershedtest.c for testing.
+ *      (2) The priority queue is a L_BucketQ with one bucket for each
+ *          8 bpp pixel value.  Pixels at the same level are flooded
+ *          in the order in which they were reached.
  */
 l_int32
 wshedApply(L_WSHED  *wshed)
@@ -315,11 +294,10 @@ l_uint32  ulabel, uval;
 void    **lines8, **linelab32;
 NUMA     *nalut, *nalevels, *nash, *namh, *nasi;
 NUMA    **links;
-L_HEAP   *lh;
-PIX      *pixmin, *pixsd;
-PIXA     *pixad;
-L_STACK  *rstack;
-PTA      *ptas, *ptao;
+PIX        *pixmin, *pixsd;
+PIXA       *pixad;
+PTA        *ptas, *ptao;
+L_BUCKETQ  *bq;
 
     PROCNAME("wshedApply");
 
@@ -330,9 +308,8 @@ PTA      *ptas, *ptao;
      *  Initialize priority queue and pixlab with seeds and minima  *
      * ------------------------------------------------------------ */
 
-    lh = lheapCreate(0, L_SORT_INCREASING);  /* remove lowest values first */
-    rstack = lstackCreate(0);  /* for reusing the WSPixels */
     pixGetDimensions(wshed->pixs, &w, &h, NULL);
+    bq = bqueueCreate(256, L_SORT_INCREASING, w * h / 4);  /* lowest first */
     lines8 = wshed->lines8;  /* wshed owns this */
     linelab32 = wshed->linelab32;  /* ditto */
 
@@ -343,7 +320,7 @@ PTA      *ptas, *ptao;
     for (i = 0; i < nseeds; i++) {
         ptaGetIPt(ptas, i, &x, &y);
         uval = GET_DATA_BYTE(lines8[y], x);
-        pushWSPixel(lh, rstack, (l_int32)uval, x, y, i);
+        bqueueAdd(bq, (l_int32)uval, x, y, i);
     }
     wshed->ptas = ptas;
     nasi = numaMakeConstant(1, nseeds);  /* indicator array */
@@ -365,7 +342,7 @@ PTA      *ptas, *ptao;
     for (i = 0; i < nother; i++) {
         ptaGetIPt(ptao, i, &x, &y);
         uval = GET_DATA_BYTE(lines8[y], x);
-        pushWSPixel(lh, rstack, (l_int32)uval, x, y, nseeds + i);
+        bqueueAdd(bq, (l_int32)uval, x, y, nseeds + i);
     }
     wshed->namh = namh;
 
@@ -396,8 +373,8 @@ PTA      *ptas, *ptao;
     nalevels = numaCreate(nseeds);
     wshed->nalevels = nalevels;  /* wshed owns this */
     L_INFO_INT2("nseeds = %d, nother = %d\n", procName, nseeds, nother);
-    while (lheapGetCount(lh) > 0) {
-        popWSPixel(lh, rstack, &val, &x, &y, &index);
+    while (bqueueGetCount(bq) > 0) {
+        bqueueRemove(bq, &val, &x, &y, &index);
 /*        fprintf(stderr, "x = %d, y = %d, index = %d\n", x, y, index); */
         ulabel = GET_DATA_FOUR_BYTES(linelab32[y], x);
         if (ulabel == MAX_LABEL_VALUE)
@@ -417,7 +394,7 @@ PTA      *ptas, *ptao;
                 for (j = jmin; j <= jmax; j++) {
                     if (i == y && j == x) continue;
                     uval = GET_DATA_BYTE(lines8[i], j);
-                    pushWSPixel(lh, rstack, (l_int32)uval, j, i, cindex);
+                    bqueueAdd(bq, (l_int32)uval, j, i, cindex);
                 }
             }
         }
@@ -527,8 +504,7 @@ PTA      *ptas, *ptao;
     pixDestroy(&pixmin);
     pixDestroy(&pixsd);
     ptaDestroy(&ptao);
-    lheapDestroy(&lh, TRUE);
-    lstackDestroy(&rstack, TRUE);
+    bqueueDestroy(&bq);
     return 0;
 }
 
@@ -606,8 +582,8 @@ l_int32  *lut;
 l_uint32  label, bval, lval;
 void    **lines8, **linelab32, **linet1;
 BOX      *box;
-PIX      *pixs, *pixlab, *pixt, *pixd;
-L_QUEUE  *lq;
+PIX        *pixs, *pixlab, *pixt, *pixd;
+L_BUCKETQ  *bq;
 
     PROCNAME("identifyWatershedBasin");
 
@@ -620,9 +596,8 @@ L_QUEUE  *lq;
     if (!wshed)
         return ERROR_INT("wshed not defined", procName, 1);
 
-        /* Make a queue and an auxiliary stack */
-    lq = lqueueCreate(0);
-    lq->stack = lstackCreate(0);
+        /* Make a fifo queue (a bucket queue with a single bucket) */
+    bq = bqueueCreate(1, L_SORT_INCREASING, 0);
 
     pixs = wshed->pixs;
     pixlab = wshed->pixlab;
@@ -638,7 +613,7 @@ L_QUEUE  *lq;
     maxx = maxy = 0;
     ptaGetIPt(wshed->ptas, index, &x, &y);
     pixSetPixel(pixt, x, y, 1);
-    pushNewPixel(lq, x, y, &minx, &maxx, &miny, &maxy);
+    pushNewPixel(bq, x, y, &minx, &maxx, &miny, &maxy);
     if (wshed->debug) fprintf(stderr, "prime: (x,y) = (%d, %d)\n", x, y);
 
         /* Each pixel in a spreading breadth-first search is inspected.
@@ -648,8 +623,8 @@ L_QUEUE  *lq;
          *     (2) The pixel value is less than @level, the overflow
          *         height at which the two basins join.
          *     (3) It has not yet been seen in this search.  */
-    while (lqueueGetCount(lq) > 0) {
-        popNewPixel(lq, &x, &y);
+    while (bqueueGetCount(bq) > 0) {
+        popNewPixel(bq, &x, &y);
         imin = L_MAX(0, y - 1);
         imax = L_MIN(h - 1, y + 1);
         jmin = L_MAX(0, x - 1);
@@ -664,7 +639,7 @@ L_QUEUE  *lq;
                 lval = GET_DATA_BYTE(lines8[i], j);
                 if (lval >= level) continue;  /* too high */
                 SET_DATA_BIT(linet1[i], j);
-                pushNewPixel(lq, j, i, &minx, &maxx, &miny, &maxy);
+                pushNewPixel(bq, j, i, &minx, &maxx, &miny, &maxy);
             }
         }
     }
@@ -678,7 +653,7 @@ L_QUEUE  *lq;
     *pbox = box;
     *ppixd = pixd;
 
-    lqueueDestroy(&lq, 1);
+    bqueueDestroy(&bq);
     return 0;
 }
 
@@ -798,31 +773,28 @@ l_int32  minval;
 /*
  *  pushNewPixel()
  *
- *      Input:  lqueue
+ *      Input:  bqueue (with a single bucket)
  *              x, y   (pixel coordinates)
  *              &minx, &maxx, &miny, &maxy  (<return> bounding box update)
  *      Return: void
  *
  *  Notes:
- *      (1) This is a wrapper for adding a NewPixel to a queue, which
- *          updates the bounding box for all pixels on that queue and
- *          uses the storage stack to retrieve a NewPixel.
+ *      (1) This is a wrapper for adding a new pixel to a fifo queue,
+ *          which updates the bounding box for all pixels on that queue.
  */
 static void
-pushNewPixel(L_QUEUE  *lq,
-             l_int32   x,
-             l_int32   y,
-             l_int32  *pminx,
-             l_int32  *pmaxx,
-             l_int32  *pminy,
-             l_int32  *pmaxy)
+pushNewPixel(L_BUCKETQ  *bq,
+             l_int32     x,
+             l_int32     y,
+             l_int32    *pminx,
+             l_int32    *pmaxx,
+             l_int32    *pminy,
+             l_int32    *pmaxy)
 {
-L_NEWPIXEL  *np;
-
     PROCNAME("pushNewPixel");
 
-    if (!lq) {
-        L_ERROR(procName, "queue not defined");
+    if (!bq) {
+        L_ERROR("queue not defined", procName);
         return;
     }
 
@@ -832,15 +804,7 @@ L_NEWPIXEL  *np;
     *pminy = L_MIN(*pminy, y);
     *pmaxy = L_MAX(*pmaxy, y);
 
-        /* Get a newpixel to use */
-    if (lstackGetCount(lq->stack) > 0)
-        np = (L_NEWPIXEL *)lstackRemove(lq->stack);
-    else
-        np = (L_NEWPIXEL *)CALLOC(1, sizeof(L_NEWPIXEL));
-
-    np->x = x;
-    np->y = y;
-    lqueueAdd(lq, np);
+    bqueueAdd(bq, 0, x, y, 0);
     return;
 }
 
@@ -848,135 +812,27 @@ L_NEWPIXEL  *np;
 /*
  *  popNewPixel()
  *
- *      Input:  lqueue
+ *      Input:  bqueue (with a single bucket)
  *              &x, &y   (<return> pixel coordinates)
  *      Return: void
  *
  *   Notes:
- *       (1) This is a wrapper for removing a NewPixel from a queue,
- *           which returns the pixel coordinates and saves the NewPixel
- *           on the storage stack.
+ *       (1) This is a wrapper for removing a new pixel from a fifo
+ *           queue, which returns the pixel coordinates.
  */
 static void
-popNewPixel(L_QUEUE  *lq,
-            l_int32  *px,
-            l_int32  *py)
+popNewPixel(L_BUCKETQ  *bq,
+            l_int32    *px,
+            l_int32    *py)
 {
-L_NEWPIXEL  *np;
-
     PROCNAME("popNewPixel");
 
-    if (!lq) {
-        L_ERROR(procName, "lqueue not defined");
+    if (!bq) {
+        L_ERROR("queue not defined", procName);
         return;
     }
 
-    if ((np = (L_NEWPIXEL *)lqueueRemove(lq)) == NULL)
-        return;
-    *px = np->x;
-    *py = np->y;
-    lstackAdd(lq->stack, np);  /* save for re-use */
-    return;
-}
-
-
-/*
- *  pushWSPixel()
- *
- *      Input:  lh  (priority queue)
- *              stack  (of reusable WSPixels)
- *              val  (pixel value: used for ordering the heap)
- *              x, y  (pixel coordinates)
- *              index  (label for set to which pixel belongs)
- *      Return: void
- *
- *  Notes:
- *      (1) This is a wrapper for adding a WSPixel to a heap.  It
- *          uses the storage stack to retrieve a WSPixel.
- */
-static void
-pushWSPixel(L_HEAP   *lh,
-            L_STACK  *stack,
-            l_int32   val,
-            l_int32   x,
-            l_int32   y,
-            l_int32   index)
-{
-L_WSPIXEL  *wsp;
-
-    PROCNAME("pushWSPixel");
-
-    if (!lh) {
-        L_ERROR(procName, "heap not defined");
-        return;
-    }
-    if (!stack) {
-        L_ERROR(procName, "stack not defined");
-        return;
-    }
-
-        /* Get a wspixel to use */
-    if (lstackGetCount(stack) > 0)
-        wsp = (L_WSPIXEL *)lstackRemove(stack);
-    else
-        wsp = (L_WSPIXEL *)CALLOC(1, sizeof(L_WSPIXEL));
-
-    wsp->val = (l_float32)val;
-    wsp->x = x;
-    wsp->y = y;
-    wsp->index = index;
-    lheapAdd(lh, wsp);
-    return;
-}
-
-
-/*
- *  popWSPixel()
- *
- *      Input:  lh  (priority queue)
- *              stack  (of reusable WSPixels)
- *              &val  (<return> pixel value)
- *              &x, &y  (<return> pixel coordinates)
- *              &index  (<return> label for set to which pixel belongs)
- *      Return: void
- *
- *   Notes:
- *       (1) This is a wrapper for removing a WSPixel from a heap,
- *           which returns the WSPixel data and saves the WSPixel
- *           on the storage stack.
- */
-static void
-popWSPixel(L_HEAP   *lh,
-           L_STACK  *stack,
-           l_int32  *pval,
-           l_int32  *px,
-           l_int32  *py,
-           l_int32  *pindex)
-{
-L_WSPIXEL  *wsp;
-
-    PROCNAME("popWSPixel");
-
-    if (!lh) {
-        L_ERROR(procName, "lheap not defined");
-        return;
-    }
-    if (!stack) {
-        L_ERROR(procName, "stack not defined");
-        return;
-    }
-    if (!pval || !px || !py || !pindex) {
-        L_ERROR(procName, "data can't be returned");
-        return;
-    }
-
-    if ((wsp = (L_WSPIXEL *)lheapRemove(lh)) == NULL)
-        return;
-    *pval = (l_int32)wsp->val;
-    *px = wsp->x;
-    *py = wsp->y;
-    *pindex = wsp->index;
-    lstackAdd(stack, wsp);  /* save for re-use */
+    bqueueRemove(bq, NULL, px, py, NULL);
     return;
 }
 